@@ -42,6 +42,14 @@ rs2_context* rs2_create_context(int api_version, rs2_error** error);
 *             raw: leave all formats from camera as they are
 *         options-update-interval: 1000 - (uint32_t) time interval in milliseconds for option value change notifications
 *             (see rs2_set_options_changed_callback)
+*         zero-copy-frames: 0           - (uint32_t) max number of frames per stream that may reference capture buffers
+*             directly instead of copying them (Linux/V4L2 only); 0 disables; the buffers only return to the driver
+*             once these frames are released; frames still held when the sensor is closed get a copy of their data
+*             at the same address
+*         v4l-capture: {}               - (Linux/V4L2 only) service the capture of all devices on a shared pool of threads:
+*             threads: 0                - (int) number of threads [0-64]; 0 keeps a capture thread per device
+*             cpus: []                  - (array of int) CPUs the threads are restricted to
+*             priority: 0               - (int) SCHED_FIFO priority of the threads [1-99]; 0 keeps the default policy
 * \param[out] error  If non-null, receives any error that occurs during this call, otherwise, errors are ignored.
 * \return            Context object
 */
@@ -219,6 +219,36 @@ void rs2_release_frame(rs2_frame* frame);
 */
 void rs2_keep_frame(rs2_frame* frame);
 
+/** \brief Counters of the pool that recycles data buffers between frames of the same stream */
+typedef struct rs2_frame_buffer_pool_stats
+{
+    unsigned long long hits;      /**< Number of frames whose data buffer was recycled from previous frames */
+    unsigned long long misses;    /**< Number of frames that required a newly allocated data buffer */
+    unsigned long long evictions; /**< Number of recycled buffers that were released, either unused for too long or with no room left in the pool */
+} rs2_frame_buffer_pool_stats;
+
+/**
+* retrieve the counters of the buffer pool that allocated the frame
+* The pool is shared by all frames of the same stream coming from the same sensor or processing block
+* \param[in] frame      handle returned from a callback
+* \param[out] stats     Pointer to a user allocated struct, which contains the pool counters after a successful return
+* \param[out] error     if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_get_frame_buffer_pool_stats(const rs2_frame* frame, rs2_frame_buffer_pool_stats* stats, rs2_error** error);
+
+/**
+* retrieve a DMABUF file descriptor that refers to the frame data, for sharing it with other devices or processes
+* Only available (on Linux) for frames that reference the capture buffer in-place - see the 'zero-copy-frames' context setting
+* The capture buffer is exported on the first call, which must happen before the sensor is closed
+* The descriptor is owned by the library and refers to the capture buffer, not to the frame: it holds this frame's data
+* only while the frame is held, as the driver then re-queues the buffer for later frames. Do not close it; a dup() of it
+* stays open, but does not keep the data any longer either
+* \param[in] frame      handle returned from a callback
+* \param[out] error     if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return               the file descriptor, or -1 if the frame data cannot be exported
+*/
+int rs2_frame_get_dmabuf_fd(const rs2_frame* frame, rs2_error** error);
+
 /**
 * When called on Points frame type, this method returns a pointer to an array of 3D vertices of the model
 * The coordinate system is: X right, Y up, Z away from the camera. Units: Meters
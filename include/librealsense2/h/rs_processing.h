@@ -131,6 +131,24 @@ void rs2_start_processing(rs2_processing_block* block, rs2_frame_callback* on_fr
 */
 void rs2_start_processing_fptr(rs2_processing_block* block, rs2_frame_callback_ptr on_frame, void* user, rs2_error** error);
 
+/**
+* This method is used to place the data of frames produced by the processing block in memory provided by the user
+* \param[in] block          Processing block
+* \param[in] allocator      Allocator object created from c++ application, or null to restore the default allocation. Ownership over the allocator object is moved into the processing block
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_set_processing_block_frame_allocator(rs2_processing_block* block, rs2_frame_allocator* allocator, rs2_error** error);
+
+/**
+* This method is used to place the data of frames produced by the processing block in memory provided by the user
+* \param[in] block          Processing block
+* \param[in] allocate       Function returning memory for a frame of the given size in bytes; if it returns null, the frame falls back to internal memory. Pass null to restore the default allocation
+* \param[in] deallocate     Function called with the memory and size returned by 'allocate' once the frame is released
+* \param[in] user           User context for both functions (can be anything or null)
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_set_processing_block_frame_allocator_fptr(rs2_processing_block* block, rs2_frame_allocate_ptr allocate, rs2_frame_deallocate_ptr deallocate, void* user, rs2_error** error);
+
 /**
 * This method is used to direct the output from the processing block to a dedicated queue object
 * \param[in] block          Processing block
@@ -249,6 +267,14 @@ rs2_processing_block* rs2_create_disparity_transform_block(unsigned char transfo
 */
 rs2_processing_block* rs2_create_hole_filling_filter_block(rs2_error** error);
 
+/**
+* Creates Depth post-processing fused filter block. The filter applies decimation, threshold, spatial, temporal and hole filling
+* (in disparity domain) to Depth frames of stereo sensors with a single output frame allocation, and has the options of those filters.
+* Setting an option that several of them share sets it in all of them.
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+rs2_processing_block* rs2_create_fused_depth_filter_block(rs2_error** error);
+
 /**
 * Creates a rates printer block. The printer prints the actual FPS of the invoked frame stream.
 * The block ignores reapiting frames and calculats the FPS only if the frame number of the relevant frame was changed.
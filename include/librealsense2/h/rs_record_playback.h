@@ -15,6 +15,7 @@ extern "C" {
 #endif
 
 #include "rs_types.h"
+#include "rs_sensor.h"
 
 typedef enum rs2_playback_status
 {
@@ -29,8 +30,34 @@ const char* rs2_playback_status_to_string(rs2_playback_status status);
 
 typedef void (*rs2_playback_status_changed_callback_ptr)(rs2_playback_status);
 
+/** \brief What a recording device gives up once the frames waiting to be written reach its memory limit */
+typedef enum rs2_record_drop_policy
+{
+    RS2_RECORD_DROP_POLICY_DROP_NEWEST,           /**< The arriving frame is dropped. This is the default */
+    RS2_RECORD_DROP_POLICY_DROP_OLDEST,           /**< The oldest waiting frames are dropped to make room */
+    RS2_RECORD_DROP_POLICY_DROP_LOWEST_PRIORITY,  /**< The oldest frames of the lowest-priority streams are dropped, the arriving frame included (see rs2_record_device_set_stream_priority) */
+    RS2_RECORD_DROP_POLICY_BLOCK,                 /**< The sensor waits until there is room, so nothing is dropped by the recorder */
+    RS2_RECORD_DROP_POLICY_COUNT
+} rs2_record_drop_policy;
+
+const char* rs2_record_drop_policy_to_string(rs2_record_drop_policy policy);
+
+/** \brief State of the queue of frames waiting to be written by a recording device */
+typedef struct rs2_record_queue_stats
+{
+    unsigned long long queued_bytes;        /**< Size of the frames waiting to be written */
+    unsigned long long peak_queued_bytes;   /**< Highest queued_bytes since recording started */
+    unsigned long long queued_frames;       /**< Number of frames waiting to be written */
+    unsigned long long written_frames;      /**< Number of frames written to file */
+    unsigned long long dropped_frames;      /**< Number of frames dropped by the drop policy, all streams together */
+    double             average_latency;     /**< Average time, in milliseconds, from a frame's arrival until it was written */
+    double             max_latency;         /**< Longest time, in milliseconds, from a frame's arrival until it was written */
+} rs2_record_queue_stats;
+
 /**
  * Creates a recording device to record the given device and save it to the given file
+ * Frames wait in memory until they are written. Past about 250MB (one second of 1080p RGBA at 30 FPS), arriving
+ * frames are dropped rather than stalling the sensors; see rs2_record_device_set_queue_limit
  * \param[in]  device    The device to record
  * \param[in]  file      The desired path to which the recorder should save the data
  * \param[out] error     If non-null, receives any error that occurs during this call, otherwise, errors are ignored
@@ -48,6 +75,17 @@ rs2_device* rs2_create_record_device(const rs2_device* device, const char* file,
 */
 rs2_device* rs2_create_record_device_ex(const rs2_device* device, const char* file, int compression_enabled, rs2_error** error);
 
+/**
+* Creates a recording device that compresses the recorded data on background threads, and saves it to the given file
+* \param[in]  device                The device to record
+* \param[in]  file                  The desired path to which the recorder should save the data
+* \param[in]  compression_level     0 for LZ4, otherwise the LZ4-HC level (1 to 12): smaller files for more CPU
+* \param[in]  compression_threads   Number of compression threads, 0 to pick one from the available cores
+* \param[out] error     If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return A pointer to a device that records its data to file, or null in case of failure
+*/
+rs2_device* rs2_create_record_device_compressed(const rs2_device* device, const char* file, int compression_level, int compression_threads, rs2_error** error);
+
 /**
 * Pause the recording device without stopping the actual device from streaming.
 * Pausing will cause the device to stop writing new data to the file, in particular, frames and changes to extensions
@@ -71,6 +109,44 @@ void rs2_record_device_resume(const rs2_device* device, rs2_error** error);
 */
 const char* rs2_record_device_filename(const rs2_device* device, rs2_error** error);
 
+/**
+* Limits the memory taken by frames waiting to be written, and sets what is given up when that limit is reached
+* By default, the limit is about 250MB and RS2_RECORD_DROP_POLICY_DROP_NEWEST applies. The first frame dropped of
+* each stream is logged as a warning
+* \param[in]  device            A recording device
+* \param[in]  max_queued_bytes  The most frame data allowed to wait for the file, in bytes
+* \param[in]  policy            What to do with frames that would go past that limit
+* \param[out] error             If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_record_device_set_queue_limit(const rs2_device* device, unsigned long long max_queued_bytes, rs2_record_drop_policy policy, rs2_error** error);
+
+/**
+* Sets the priority of a stream for RS2_RECORD_DROP_POLICY_DROP_LOWEST_PRIORITY. Streams default to priority 0
+* \param[in]  device    A recording device
+* \param[in]  stream    The stream type
+* \param[in]  priority  Frames of higher priority streams are dropped last
+* \param[out] error     If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_record_device_set_stream_priority(const rs2_device* device, rs2_stream stream, int priority, rs2_error** error);
+
+/**
+* Gets the state of the queue of frames waiting to be written
+* \param[in]  device    A recording device
+* \param[out] stats     Receives the queue counters
+* \param[out] error     If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_record_device_get_queue_stats(const rs2_device* device, rs2_record_queue_stats* stats, rs2_error** error);
+
+/**
+* Gets the number of frames of a stream that were dropped by the drop policy
+* \param[in]  device    A recording device
+* \param[in]  stream    The stream type
+* \param[in]  index     The stream index
+* \param[out] error     If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return The number of frames dropped
+*/
+unsigned long long rs2_record_device_get_dropped_frames(const rs2_device* device, rs2_stream stream, int index, rs2_error** error);
+
 /**
 * Creates a playback device to play the content of the given file
 * \param[in]  file      Path to the file to play
@@ -150,6 +226,35 @@ void rs2_playback_device_set_real_time(const rs2_device* device, int real_time,
  */
 int rs2_playback_device_is_real_time(const rs2_device* device, rs2_error** error);
 
+/**
+ * Set how many frames each stream may read ahead of the application in non real time mode
+ *
+ * With 0 (the default), non real time playback waits for each callback to return before reading the next frame.
+ * Otherwise, playback keeps reading while up to that many frames per stream wait for their callback, and waits for
+ * room only when a stream's queue is full, so reading and decompressing the file overlaps with the application's
+ * processing and no frame is dropped. In real time mode, the same number of frames per stream may queue up before
+ * the oldest are dropped.
+ * Takes effect when the sensors are next opened.
+ * \param[in] device     A playback device
+ * \param[in] frames     Number of frames per stream that may wait for their callback
+ * \param[out] error     If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+ */
+void rs2_playback_device_set_read_ahead(const rs2_device* device, unsigned int frames, rs2_error** error);
+
+/**
+ * Limit playback to a time range of the file
+ *
+ * Starting the sensors reads from the start of the range, and reaching its end finishes playback as if the file ended
+ * there. A frame at the end time itself belongs to the next range, so several playback devices opened on the same file
+ * can each play one of a set of consecutive ranges, e.g. to process a long recording in parallel, and together play
+ * every frame exactly once.
+ * \param[in] device     A playback device
+ * \param[in] start      Start of the range, in nanoseconds from the start of the file
+ * \param[in] end        End of the range, in nanoseconds from the start of the file; 0 for the end of the file
+ * \param[out] error     If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+ */
+void rs2_playback_device_set_range(const rs2_device* device, long long int start, long long int end, rs2_error** error);
+
 /**
  * Register to receive callback from playback device upon its status changes
  *
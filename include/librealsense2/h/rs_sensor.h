@@ -291,6 +291,25 @@ void rs2_set_notifications_callback(const rs2_sensor* sensor, rs2_notification_c
 */
 void rs2_set_notifications_callback_cpp(const rs2_sensor* sensor, rs2_notifications_callback* callback, rs2_error** error);
 
+/**
+* set a custom allocator for the data of frames produced by the sensor, e.g. to place frames in huge-page, NUMA-local or shared memory
+* frame data is written directly into the allocated memory, and handed back to the allocator once the frame is released
+* \param[in] sensor      RealSense sensor
+* \param[in] allocate    function returning memory for a frame of the given size in bytes; if it returns null, the frame falls back to internal memory. Pass null to restore the default allocation
+* \param[in] deallocate  function called with the memory and size returned by 'allocate' once the frame is released
+* \param[in] user        user context passed to both functions (can be anything or null)
+* \param[out] error      if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_set_frame_allocator(const rs2_sensor* sensor, rs2_frame_allocate_ptr allocate, rs2_frame_deallocate_ptr deallocate, void* user, rs2_error** error);
+
+/**
+* set a custom allocator for the data of frames produced by the sensor
+* \param[in] sensor      RealSense sensor
+* \param[in] allocator   allocator object created from c++ application, or null to restore the default allocation. ownership over the allocator object is moved into the sensor
+* \param[out] error      if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_set_frame_allocator_cpp(const rs2_sensor* sensor, rs2_frame_allocator* allocator, rs2_error** error);
+
 /**
 * retrieve description from notification handle
 * \param[in] notification      handle returned from a callback
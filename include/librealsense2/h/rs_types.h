@@ -237,6 +237,7 @@ typedef struct rs2_stream_profile_list rs2_stream_profile_list;
 typedef struct rs2_processing_block_list rs2_processing_block_list;
 typedef struct rs2_stream_profile rs2_stream_profile;
 typedef struct rs2_frame_callback rs2_frame_callback;
+typedef struct rs2_frame_allocator rs2_frame_allocator;
 typedef struct rs2_log_callback rs2_log_callback;
 typedef struct rs2_syncer rs2_syncer;
 typedef struct rs2_device_serializer rs2_device_serializer;
@@ -264,6 +265,8 @@ typedef void (*rs2_notification_callback_ptr)(rs2_notification*, void*);
 typedef void (*rs2_software_device_destruction_callback_ptr)(void*);
 typedef void (*rs2_devices_changed_callback_ptr)(rs2_device_list*, rs2_device_list*, void*);
 typedef void (*rs2_frame_callback_ptr)(rs2_frame*, void*);
+typedef void* (*rs2_frame_allocate_ptr)(int size, void*);
+typedef void (*rs2_frame_deallocate_ptr)(void* data, int size, void*);
 typedef void (*rs2_frame_processor_callback_ptr)(rs2_frame*, rs2_source*, void*);
 typedef void (*rs2_update_progress_callback_ptr)(const float, void*);
 typedef void (*rs2_options_changed_callback_ptr)(const rs2_options_list *);
@@ -540,6 +540,32 @@ namespace rs2
             return r;
         }
 
+        /**
+        * retrieve the counters of the buffer pool this frame was allocated from
+        * \return               hits, misses and evictions of the pool shared by all frames of this stream
+        */
+        rs2_frame_buffer_pool_stats get_buffer_pool_stats() const
+        {
+            rs2_frame_buffer_pool_stats stats;
+            rs2_error* e = nullptr;
+            rs2_get_frame_buffer_pool_stats(frame_ref, &stats, &e);
+            error::handle(e);
+            return stats;
+        }
+
+        /**
+        * retrieve a DMABUF file descriptor referring to the capture buffer of the frame, which holds the frame data only
+        * while the frame is held (see rs2_frame_get_dmabuf_fd)
+        * \return               the file descriptor, or -1 if the frame data is not exported
+        */
+        int get_dmabuf_fd() const
+        {
+            rs2_error* e = nullptr;
+            auto r = rs2_frame_get_dmabuf_fd(frame_ref, &e);
+            error::handle(e);
+            return r;
+        }
+
         /**
         * retrieve data from frame handle
         * \return               the pointer to the start of the frame data
@@ -1180,5 +1206,26 @@ namespace rs2
 
         void release() override { delete this; }
     };
+
+    template<class A, class D>
+    class frame_allocator : public rs2_frame_allocator
+    {
+        A allocate_function;
+        D deallocate_function;
+    public:
+        frame_allocator(A allocate, D deallocate) : allocate_function(allocate), deallocate_function(deallocate) {}
+
+        void* allocate(int size) override
+        {
+            return allocate_function(size);
+        }
+
+        void deallocate(void* data, int size) override
+        {
+            deallocate_function(data, size);
+        }
+
+        void release() override { delete this; }
+    };
 }
 #endif // LIBREALSENSE_RS2_FRAME_HPP
@@ -278,6 +278,19 @@ namespace rs2
             return on_frame;
         }
         /**
+        * Place the data of frames produced by the processing block in memory provided by the user
+        *
+        * \param[in] allocate      function returning memory for a frame of the given size in bytes, or nullptr to use internal memory
+        * \param[in] deallocate    function called with the memory and size returned by allocate, once the frame is released
+        */
+        template<class A, class D>
+        void set_frame_allocator(A allocate, D deallocate)
+        {
+            rs2_error* e = nullptr;
+            rs2_set_processing_block_frame_allocator(get(), new frame_allocator<A, D>(std::move(allocate), std::move(deallocate)), &e);
+            error::handle(e);
+        }
+        /**
         * Ask processing block to process the frame
         *
         * \param[in] on_frame      frame to be processed.
@@ -1086,6 +1099,31 @@ namespace rs2
         }
     };
 
+    class fused_depth_filter : public filter
+    {
+    public:
+        /**
+        * Create fused depth filter
+        * The processing is that of decimation, threshold, depth to disparity, spatial, temporal, hole filling and
+        * disparity to depth filters in sequence, with the options of those filters.
+        */
+        fused_depth_filter() : filter(init(), 1) {}
+
+    private:
+        friend class context;
+
+        std::shared_ptr<rs2_processing_block> init()
+        {
+            rs2_error* e = nullptr;
+            auto block = std::shared_ptr<rs2_processing_block>(
+                rs2_create_fused_depth_filter_block(&e),
+                rs2_delete_processing_block);
+            error::handle(e);
+
+            return block;
+        }
+    };
+
     class rates_printer : public filter
     {
     public:
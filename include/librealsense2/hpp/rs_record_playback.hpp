@@ -126,6 +126,36 @@ namespace rs2
             error::handle(e);
         }
 
+        /**
+        * Set how many frames each stream may read ahead of the application in non real time mode
+        *
+        * With 0 (the default), non real time playback waits for each callback to return before reading the next frame.
+        * Otherwise, playback keeps reading while up to that many frames per stream wait for their callback, and waits
+        * for room only when a stream's queue is full, so no frame is dropped. Takes effect when the sensors are next opened.
+        * \param[in] frames  Number of frames per stream that may wait for their callback
+        */
+        void set_read_ahead(unsigned int frames) const
+        {
+            rs2_error* e = nullptr;
+            rs2_playback_device_set_read_ahead(_dev.get(), frames, &e);
+            error::handle(e);
+        }
+
+        /**
+        * Limit playback to the time range [start, end) of the file
+        *
+        * Several playback devices opened on the same file can each play one of a set of consecutive ranges, and
+        * together play every frame exactly once.
+        * \param[in] start  Start of the range, from the start of the file
+        * \param[in] end    End of the range, from the start of the file; zero for the end of the file
+        */
+        void set_range(std::chrono::nanoseconds start, std::chrono::nanoseconds end) const
+        {
+            rs2_error* e = nullptr;
+            rs2_playback_device_set_range(_dev.get(), start.count(), end.count(), &e);
+            error::handle(e);
+        }
+
         /**
         * Set the playing speed
         * \param[in] speed  Indicates a multiplication of the speed to play (e.g: 1 = normal, 0.5 twice as slow)
@@ -234,6 +264,22 @@ namespace rs2
             rs2::error::handle(e);
         }
 
+        /**
+        * Creates a recording device that compresses on background threads, and saves to the given file as rosbag format
+        * \param[in]  file                  The desired path to which the recorder should save the data
+        * \param[in]  device                The device to record
+        * \param[in]  compression_level     0 for LZ4, otherwise the LZ4-HC level (1 to 12)
+        * \param[in]  compression_threads   Number of compression threads, 0 to pick one from the available cores
+        */
+        recorder(const std::string& file, rs2::device dev, int compression_level, int compression_threads)
+        {
+            rs2_error* e = nullptr;
+            _dev = std::shared_ptr<rs2_device>(
+                rs2_create_record_device_compressed(dev.get().get(), file.c_str(), compression_level, compression_threads, &e),
+                rs2_delete_device);
+            rs2::error::handle(e);
+        }
+
 
         /**
         * Pause the recording device without stopping the actual device from streaming.
@@ -266,6 +312,58 @@ namespace rs2
             error::handle(e);
             return filename;
         }
+
+        /**
+        * Limits the memory taken by frames waiting to be written, and sets what is given up when that limit is reached
+        * By default, the limit is about 250MB and RS2_RECORD_DROP_POLICY_DROP_NEWEST applies
+        * \param[in]  max_queued_bytes  The most frame data allowed to wait for the file, in bytes
+        * \param[in]  policy            What to do with frames that would go past that limit
+        */
+        void set_queue_limit(unsigned long long max_queued_bytes, rs2_record_drop_policy policy)
+        {
+            rs2_error* e = nullptr;
+            rs2_record_device_set_queue_limit(_dev.get(), max_queued_bytes, policy, &e);
+            error::handle(e);
+        }
+
+        /**
+        * Sets the priority of a stream for RS2_RECORD_DROP_POLICY_DROP_LOWEST_PRIORITY. Streams default to priority 0
+        * \param[in]  stream    The stream type
+        * \param[in]  priority  Frames of higher priority streams are dropped last
+        */
+        void set_stream_priority(rs2_stream stream, int priority)
+        {
+            rs2_error* e = nullptr;
+            rs2_record_device_set_stream_priority(_dev.get(), stream, priority, &e);
+            error::handle(e);
+        }
+
+        /**
+        * Gets the state of the queue of frames waiting to be written
+        * \return The queued bytes and frames, written and dropped frames, and write latency
+        */
+        rs2_record_queue_stats get_queue_stats() const
+        {
+            rs2_error* e = nullptr;
+            rs2_record_queue_stats stats;
+            rs2_record_device_get_queue_stats(_dev.get(), &stats, &e);
+            error::handle(e);
+            return stats;
+        }
+
+        /**
+        * Gets the number of frames of a stream that were dropped by the drop policy
+        * \param[in]  stream    The stream type
+        * \param[in]  index     The stream index
+        * \return The number of frames dropped
+        */
+        unsigned long long get_dropped_frames(rs2_stream stream, int index = 0) const
+        {
+            rs2_error* e = nullptr;
+            auto dropped = rs2_record_device_get_dropped_frames(_dev.get(), stream, index, &e);
+            error::handle(e);
+            return dropped;
+        }
     protected:
         explicit recorder(std::shared_ptr<rs2_device> dev) : device(dev)
         {
@@ -212,6 +212,20 @@ namespace rs2
             error::handle(e);
         }
 
+        /**
+        * place the data of frames produced by the sensor in memory provided by the user
+        * \param[in] allocate     function returning memory for a frame of the given size in bytes, or nullptr to use internal memory
+        * \param[in] deallocate   function called with the memory and size returned by allocate, once the frame is released
+        */
+        template<class A, class D>
+        void set_frame_allocator(A allocate, D deallocate) const
+        {
+            rs2_error* e = nullptr;
+            rs2_set_frame_allocator_cpp(_sensor.get(),
+                new frame_allocator<A, D>(std::move(allocate), std::move(deallocate)), &e);
+            error::handle(e);
+        }
+
         /**
         * Retrieves the list of stream profiles supported by the sensor.
         * \return   list of stream profiles that given sensor can provide
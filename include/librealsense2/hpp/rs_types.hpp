@@ -30,6 +30,15 @@ struct rs2_frame_callback
 };
 typedef std::shared_ptr<rs2_frame_callback> rs2_frame_callback_sptr;
 
+struct rs2_frame_allocator
+{
+    virtual void *                          allocate(int size) = 0;
+    virtual void                            deallocate(void * data, int size) = 0;
+    virtual void                            release() = 0;
+    virtual                                 ~rs2_frame_allocator() {}
+};
+typedef std::shared_ptr<rs2_frame_allocator> rs2_frame_allocator_sptr;
+
 struct rs2_frame_processor_callback
 {
     virtual void                            on_frame(rs2_frame * f, rs2_source * source) = 0;
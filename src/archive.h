@@ -5,6 +5,9 @@
 
 #include "core/frame-additional-data.h"
 #include "callback-invocation.h"
+#include "frame-buffer-pool.h"
+
+#include <librealsense2/hpp/rs_types.hpp>
 
 
 namespace librealsense
@@ -21,6 +24,11 @@ namespace librealsense
 
         virtual std::shared_ptr<metadata_parser_map> get_md_parsers() const = 0;
 
+        virtual frame_buffer_pool_stats get_buffer_pool_stats() const = 0;
+
+        // Frame data will be taken from the given allocator, when possible; nullptr restores the built-in pool
+        virtual void set_frame_allocator( rs2_frame_allocator_sptr allocator ) = 0;
+
         virtual std::shared_ptr< sensor_interface > get_sensor() const = 0;
         virtual void set_sensor( const std::weak_ptr< sensor_interface > & ) = 0;
 
@@ -34,6 +42,7 @@ namespace librealsense
 
     std::shared_ptr<archive_interface> make_archive(rs2_extension type,
         std::atomic<uint32_t>* in_max_frame_queue_size,
+        uint32_t pool_slab_size,
         std::shared_ptr<metadata_parser_map> parsers);
 
 }
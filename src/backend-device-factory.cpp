@@ -161,6 +161,7 @@ backend_device_factory::backend_device_factory( std::shared_ptr< context > const
               }
           } ) )
 {
+    _device_watcher->get_backend()->configure( ctx->get_settings() );  // NOTE: can throw!
 }
 
 
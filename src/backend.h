@@ -8,6 +8,8 @@
 #include "platform/stream-profile.h"
 #include "platform/frame-object.h"
 
+#include <rsutils/json-fwd.h>
+
 #include <memory>
 #include <vector>
 #include <string>
@@ -44,6 +46,10 @@ namespace librealsense
 
             virtual std::shared_ptr<device_watcher> create_device_watcher() const = 0;
 
+            // Applies the context settings that concern the backend; the backend is shared by all contexts, so the
+            // settings of the last context created are the ones in effect
+            virtual void configure(rsutils::json const & settings) {}
+
             virtual std::string get_device_serial(uint16_t device_vid, uint16_t device_pid, const std::string& device_uid) const
             {
                 std::string empty_str;
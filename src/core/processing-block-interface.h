@@ -28,6 +28,7 @@ public:
     virtual void set_output_callback( rs2_frame_callback_sptr callback ) = 0;
     virtual void invoke( frame_holder frame ) = 0;
     virtual synthetic_source_interface & get_source() = 0;
+    virtual void set_frame_allocator( rs2_frame_allocator_sptr allocator ) = 0;
 };
 
 
@@ -352,6 +352,8 @@ namespace librealsense
             virtual void disable_stream(const std::vector<device_serializer::stream_identifier>& stream_ids) = 0;
             virtual const std::string& get_file_name() const = 0;
             virtual std::vector<std::shared_ptr<serialized_data>> fetch_last_frames(const nanoseconds& seek_time) = 0;
+            // Room for this many more frames per stream to be alive at once, e.g. waiting for their callback
+            virtual void reserve_frames(uint32_t frames) = 0;
         };
     }
 }
@@ -30,6 +30,9 @@ struct stream_profile
 
     static void same_resolution( uint32_t & w, uint32_t & h ) {}
     static void rotate_resolution( uint32_t & w, uint32_t & h ) { std::swap( w, h ); }
+    // Decoded at 1/2 or 1/4 of the size (e.g., MJPEG), rounded up
+    static void half_resolution( uint32_t & w, uint32_t & h ) { w = ( w + 1 ) / 2; h = ( h + 1 ) / 2; }
+    static void quarter_resolution( uint32_t & w, uint32_t & h ) { w = ( w + 3 ) / 4; h = ( h + 3 ) / 4; }
 
     // Transformation function, to adjust width/height when a profile is cloned as part of a sensor's defined
     // processing block. The formats_converter uses this when doing its thing.
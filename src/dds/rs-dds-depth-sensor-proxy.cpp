@@ -5,6 +5,7 @@
 #include "rs-dds-option.h"
 
 #include <realdds/topics/dds-topic-names.h>
+#include <realdds/topics/metadata-msg.h>
 
 #include <src/librealsense-exception.h>
 #include <rsutils/json.h>
@@ -58,4 +59,17 @@ void dds_depth_sensor_proxy::add_frame_metadata( frame * const f, rsutils::json
 }
 
 
+void dds_depth_sensor_proxy::add_frame_metadata( frame * const f,
+                                                 realdds::topics::metadata_msg const & dds_md,
+                                                 streaming_impl & streaming )
+{
+    if( dds_md.flags & realdds::topics::metadata_msg::has_depth_units )
+        f->additional_data.depth_units = dds_md.depth_units;
+    else
+        f->additional_data.depth_units = get_depth_scale();
+
+    super::add_frame_metadata( f, dds_md, streaming );
+}
+
+
 }  // namespace librealsense
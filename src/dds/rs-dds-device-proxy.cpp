@@ -13,6 +13,7 @@
 
 #include <realdds/topics/device-info-msg.h>
 #include <realdds/topics/flexible-msg.h>
+#include <realdds/topics/metadata-msg.h>
 #include <realdds/topics/dds-topic-names.h>
 
 #include <src/stream.h>
@@ -22,6 +23,8 @@
 #include <rsutils/string/hexarray.h>
 #include <rsutils/string/from.h>
 
+#include <set>
+
 
 namespace librealsense {
 
@@ -293,14 +296,31 @@ dds_device_proxy::dds_device_proxy( std::shared_ptr< const device_info > const &
 
     if( _dds_dev->supports_metadata() )
     {
+        // Streams with metadata keys get all their metadata in binary, even when the server sends it as JSON
+        std::set< std::string > binary_streams;
+        _dds_dev->foreach_stream(
+            [&]( std::shared_ptr< realdds::dds_stream > const & stream )
+            {
+                if( ! stream->metadata_keys().empty() )
+                    binary_streams.insert( stream->name() );
+            } );
         _metadata_subscription = _dds_dev->on_metadata_available(
-            [this]( std::shared_ptr< const rsutils::json > const & dds_md )
+            [this, binary_streams]( std::shared_ptr< const rsutils::json > const & dds_md )
             {
                 auto & stream_name = dds_md->nested( realdds::topics::metadata::key::stream_name ).string_ref();
+                if( binary_streams.count( stream_name ) )
+                    return;
                 auto it = _stream_name_to_owning_sensor.find( stream_name );
                 if( it != _stream_name_to_owning_sensor.end() )
                     it->second->handle_new_metadata( stream_name, dds_md );
             } );
+        _binary_metadata_subscription = _dds_dev->on_binary_metadata_available(
+            [this]( std::shared_ptr< const realdds::topics::metadata_msg > const & dds_md )
+            {
+                auto it = _stream_name_to_owning_sensor.find( dds_md->stream_name );
+                if( it != _stream_name_to_owning_sensor.end() )
+                    it->second->handle_new_metadata( dds_md );
+            } );
     }
 
     // According to extrinsics_graph (in environment.h) we need 3 steps:
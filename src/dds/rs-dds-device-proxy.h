@@ -45,6 +45,7 @@ class dds_device_proxy
     std::map< std::string, std::shared_ptr< dds_sensor_proxy > > _stream_name_to_owning_sensor;
 
     rsutils::subscription _metadata_subscription;
+    rsutils::subscription _binary_metadata_subscription;
 
     int get_index_from_stream_name( const std::string & name ) const;
     void set_profile_intrinsics( std::shared_ptr< stream_profile_interface > & profile,
@@ -12,6 +12,7 @@
 #include <realdds/topics/device-info-msg.h>
 #include <realdds/topics/image-msg.h>
 #include <realdds/topics/imu-msg.h>
+#include <realdds/topics/metadata-msg.h>
 #include <realdds/topics/dds-topic-names.h>
 
 #include <src/core/options-registry.h>
@@ -362,29 +363,25 @@ void dds_sensor_proxy::handle_new_metadata( std::string const & stream_name,
 }
 
 
-void dds_sensor_proxy::add_no_metadata( frame * const f, streaming_impl & streaming )
+void dds_sensor_proxy::handle_new_metadata( std::shared_ptr< const realdds::topics::metadata_msg > const & dds_md )
 {
-    // Without MD, we have no way of knowing the frame-number - we assume it's one higher than the last
-    f->additional_data.last_frame_number = streaming.last_frame_number.fetch_add( 1 );
-    f->additional_data.frame_number = f->additional_data.last_frame_number + 1;
+    if( ! _md_enabled )
+        return;
 
-    // the frame should already have empty metadata, so no need to do anything else
+    auto it = _streaming_by_name.find( dds_md->stream_name );
+    if( it != _streaming_by_name.end() )
+        it->second.syncer.enqueue_metadata( dds_md->timestamp, dds_md );
+    // else we're not streaming -- must be another client that's subscribed
 }
 
 
-void dds_sensor_proxy::add_frame_metadata( frame * const f,
-                                           json const & dds_md,
-                                           streaming_impl & streaming )
+void dds_sensor_proxy::update_frame_number( frame * const f, streaming_impl & streaming, bool const from_metadata )
 {
-    auto md_header = dds_md.nested( realdds::topics::metadata::key::header );
-    auto md = dds_md.nested( realdds::topics::metadata::key::metadata );
-
     // A frame number is "optional". If the server supplies it, we try to use it for the simple fact that,
     // otherwise, we have no way of detecting drops without some advanced heuristic tracking the FPS and
     // timestamps. If not supplied, we use an increasing counter.
     // Note that if we have no metadata, we have no frame-numbers! So we need a way of generating them
-    if( md_header.nested( realdds::topics::metadata::header::key::frame_number )
-            .get_ex( f->additional_data.frame_number ) )
+    if( from_metadata )
     {
         f->additional_data.last_frame_number = streaming.last_frame_number.exchange( f->additional_data.frame_number );
         if( f->additional_data.frame_number != f->additional_data.last_frame_number + 1
@@ -399,6 +396,30 @@ void dds_sensor_proxy::add_frame_metadata( frame * const f,
         f->additional_data.last_frame_number = streaming.last_frame_number.fetch_add( 1 );
         f->additional_data.frame_number = f->additional_data.last_frame_number + 1;
     }
+}
+
+
+void dds_sensor_proxy::add_no_metadata( frame * const f, streaming_impl & streaming )
+{
+    // Without MD, we have no way of knowing the frame-number - we assume it's one higher than the last
+    f->additional_data.last_frame_number = streaming.last_frame_number.fetch_add( 1 );
+    f->additional_data.frame_number = f->additional_data.last_frame_number + 1;
+
+    // the frame should already have empty metadata, so no need to do anything else
+}
+
+
+void dds_sensor_proxy::add_frame_metadata( frame * const f,
+                                           json const & dds_md,
+                                           streaming_impl & streaming )
+{
+    auto md_header = dds_md.nested( realdds::topics::metadata::key::header );
+    auto md = dds_md.nested( realdds::topics::metadata::key::metadata );
+
+    update_frame_number( f,
+                         streaming,
+                         md_header.nested( realdds::topics::metadata::header::key::frame_number )
+                             .get_ex( f->additional_data.frame_number ) );
 
     // Timestamp is already set in the frame - must be communicated in the metadata, but only for syncing
     // purposes, so we ignore here. The domain is optional, and really only rs-dds-adapter communicates it
@@ -430,6 +451,33 @@ void dds_sensor_proxy::add_frame_metadata( frame * const f,
 }
 
 
+void dds_sensor_proxy::add_frame_metadata( frame * const f,
+                                           realdds::topics::metadata_msg const & dds_md,
+                                           streaming_impl & streaming )
+{
+    using realdds::topics::metadata_msg;
+
+    if( dds_md.flags & metadata_msg::has_frame_number )
+        f->additional_data.frame_number = dds_md.frame_number;
+    update_frame_number( f, streaming, dds_md.flags & metadata_msg::has_frame_number );
+
+    // As with JSON, the timestamp is already set in the frame
+    if( dds_md.flags & metadata_msg::has_timestamp_domain )
+        f->additional_data.timestamp_domain = static_cast< rs2_timestamp_domain >( dds_md.timestamp_domain );
+
+    // Items come keyed by index, so no names are looked up; those unknown to librealsense are ignored
+    auto & metadata = reinterpret_cast< metadata_array & >( f->additional_data.metadata_blob );
+    for( auto const & item : dds_md.items )
+    {
+        if( item.key >= streaming.metadata_keys.size() )
+            continue;
+        auto const key = streaming.metadata_keys[item.key];
+        if( key != RS2_FRAME_METADATA_COUNT )
+            metadata[key] = { true, item.value };
+    }
+}
+
+
 void dds_sensor_proxy::start( rs2_frame_callback_sptr callback )
 {
     for( auto & profile : sensor_base::get_active_streams() )
@@ -444,16 +492,24 @@ void dds_sensor_proxy::start( rs2_frame_callback_sptr callback )
         // Opening it will start streaming on the server side automatically
         dds_stream->open( "rt/" + _dev->device_info().topic_root() + '_' + dds_stream->name(), _dev->subscriber() );
         auto & streaming = _streaming_by_name[dds_stream->name()];
+        streaming.metadata_keys.clear();
+        for( auto & key : dds_stream->metadata_keys() )
+        {
+            rs2_frame_metadata_value value;
+            streaming.metadata_keys.push_back( try_parse( key, value ) ? value : RS2_FRAME_METADATA_COUNT );
+        }
         streaming.syncer.on_frame_release( frame_releaser );
         streaming.syncer.on_frame_ready(
-            [this, &streaming]( syncer_type::frame_holder && fh, std::shared_ptr< const json > const & md )
+            [this, &streaming]( syncer_type::frame_holder && fh, syncer_type::metadata_type const & md )
             {
                 if( _is_streaming ) // stop was not called
                 {
                     if( ! md )
                         add_no_metadata( static_cast< frame * >( fh.get() ), streaming );
+                    else if( md.binary )
+                        add_frame_metadata( static_cast< frame * >( fh.get() ), *md.binary, streaming );
                     else
-                        add_frame_metadata( static_cast< frame * >( fh.get() ), *md, streaming );
+                        add_frame_metadata( static_cast< frame * >( fh.get() ), *md.json, streaming );
                     invoke_new_frame( static_cast< frame * >( fh.release() ), nullptr, nullptr );
                 }
             } );
@@ -24,6 +24,7 @@ class dds_motion_stream_profile;
 namespace topics {
 class image_msg;
 class imu_msg;
+class metadata_msg;
 }  // namespace topics
 }  // namespace realdds
 
@@ -51,6 +52,8 @@ protected:
     {
         syncer_type syncer;
         std::atomic< unsigned long long > last_frame_number{ 0 };
+        // For binary metadata, the metadata value of each of the stream's keys, or RS2_FRAME_METADATA_COUNT if unknown
+        std::vector< rs2_frame_metadata_value > metadata_keys;
     };
 
 private:
@@ -102,9 +105,13 @@ protected:
                              streaming_impl & );
     void handle_new_metadata( std::string const & stream_name,
                               std::shared_ptr< const rsutils::json > const & metadata );
+    void handle_new_metadata( std::shared_ptr< const realdds::topics::metadata_msg > const & metadata );
+
+    void update_frame_number( frame *, streaming_impl &, bool from_metadata );
 
     virtual void add_no_metadata( frame *, streaming_impl & );
     virtual void add_frame_metadata( frame *, rsutils::json const & metadata, streaming_impl & );
+    virtual void add_frame_metadata( frame *, realdds::topics::metadata_msg const & metadata, streaming_impl & );
 
     friend class dds_device_proxy;  // Currently calls handle_new_metadata
 };
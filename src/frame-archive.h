@@ -3,14 +3,17 @@
 #pragma once
 
 #include "archive.h"
+#include "frame-buffer-pool.h"
 #include <src/core/frame-interface.h>
 
 #include <atomic>
+#include <limits>
 #include <vector>
 
 namespace librealsense
 {
-    constexpr static int RS2_USER_QUEUE_SIZE = 128;
+    // Most frame objects a stream's pool grows to; past that, each published frame is allocated on its own
+    constexpr static int RS2_MAX_FRAME_POOL_SIZE = 1024;
 
     // Defines general frames storage model
     template<class T>
@@ -18,11 +21,12 @@ namespace librealsense
     {
         std::atomic<uint32_t>* max_frame_queue_size;
         std::atomic<uint32_t> published_frames_count;
-        small_heap<T, RS2_USER_QUEUE_SIZE> published_frames;
+        slab_heap<T> published_frames;
         std::shared_ptr<metadata_parser_map> _metadata_parsers = nullptr;
         callbacks_heap callback_inflight;
 
-        std::vector<T> freelist; // return frames here
+        frame_buffer_pool buffers; // return frame data here
+        rs2_frame_allocator_sptr _allocator; // user-supplied, takes precedence over the pool; accessed atomically
         std::atomic<bool> recycle_frames;
         int pending_frames = 0;
         std::recursive_mutex mutex;
@@ -34,40 +38,39 @@ namespace librealsense
         T alloc_frame(const size_t size, frame_additional_data && additional_data, bool requires_memory)
         {
             T backbuffer;
-            //const size_t size = modes[stream].get_image_size(stream);
+            if (requires_memory && !alloc_external(size, backbuffer))
             {
-                std::lock_guard<std::recursive_mutex> guard(mutex);
-
-                if (requires_memory)
-                {
-                    // Attempt to obtain a buffer of the appropriate size from the freelist
-                    for (auto it = begin(freelist); it != end(freelist); ++it)
-                    {
-                        if (it->data.size() == size)
-                        {
-                            backbuffer = std::move(*it);
-                            freelist.erase(it);
-                            break;
-                        }
-                    }
-                }
-
-                // Discard buffers that have been in the freelist for longer than 1s
-                for (auto it = begin(freelist); it != end(freelist);)
-                {
-                    if (additional_data.timestamp > it->additional_data.timestamp + 1000) it = freelist.erase(it);
-                    else ++it;
-                }
+                // Attempt to obtain a buffer of the appropriate size from the pool; only new buffers get zero-filled
+                if (!buffers.acquire(size, backbuffer.data))
+                    backbuffer.data.resize(size, 0);
             }
 
-            if (requires_memory)
-            {
-                backbuffer.data.resize(size, 0); // TODO: Allow users to provide a custom allocator for frame buffers
-            }
+            // Discard buffers that have been in the pool for longer than 1s
+            buffers.evict_stale(additional_data.timestamp);
+
             backbuffer.additional_data = std::move( additional_data );
             return backbuffer;
         }
 
+        // Returns false if there is no user allocator, or if it declined the request
+        bool alloc_external(const size_t size, T& f)
+        {
+            auto allocator = std::atomic_load(&_allocator);
+            if (!allocator || !size || size > size_t(std::numeric_limits<int>::max()))
+                return false;
+
+            auto ptr = static_cast<uint8_t*>(allocator->allocate(int(size)));
+            if (!ptr)
+                return false;
+
+            // The allocator is kept alive for as long as any of its buffers are in use
+            f.attach_external_data(std::shared_ptr<uint8_t>(ptr, [allocator, size](uint8_t* p)
+            {
+                allocator->deallocate(p, int(size));
+            }), size);
+            return true;
+        }
+
         frame_interface* track_frame(T& f)
         {
             std::unique_lock<std::recursive_mutex> lock(mutex);
@@ -88,15 +91,14 @@ namespace librealsense
             if( fi )
             {
                 auto f = (T *)fi;
-                std::unique_lock<std::recursive_mutex> lock(mutex);
 
                 fi->keep();
 
                 if (recycle_frames)
                 {
-                    freelist.push_back(std::move(*f));
+                    buffers.recycle(std::move(f->data), f->additional_data.timestamp);
                 }
-                lock.unlock();
+                f->release_external_data();
 
                 if (f->is_fixed())
                     published_frames.deallocate(f);
@@ -122,12 +124,11 @@ namespace librealsense
                 LOG_DEBUG("User didn't release frame resource.");
                 return nullptr;
             }
-            auto new_frame = (max_frames ? published_frames.allocate() : new T());
+            auto new_frame = published_frames.allocate();
 
             if (new_frame)
             {
-                if (max_frames)
-                    new_frame->mark_fixed();
+                new_frame->mark_fixed();
             }
             else
             {
@@ -142,12 +143,19 @@ namespace librealsense
 
         std::shared_ptr<metadata_parser_map> get_md_parsers() const override { return _metadata_parsers; };
 
+        frame_buffer_pool_stats get_buffer_pool_stats() const override { return buffers.get_stats(); }
+
+        void set_frame_allocator(rs2_frame_allocator_sptr allocator) override { std::atomic_store(&_allocator, allocator); }
+
         friend class frame;
 
     public:
-        explicit frame_archive( std::atomic< uint32_t > * in_max_frame_queue_size,
-                                std::shared_ptr< metadata_parser_map > const & parsers )
+        // The pool of published frames starts with pool_slab_size frames, and grows by as many when they're all taken
+        frame_archive( std::atomic< uint32_t > * in_max_frame_queue_size,
+                       uint32_t pool_slab_size,
+                       std::shared_ptr< metadata_parser_map > const & parsers )
             : max_frame_queue_size( in_max_frame_queue_size )
+            , published_frames( int( pool_slab_size ), RS2_MAX_FRAME_POOL_SIZE )
             , recycle_frames( true )
             , _metadata_parsers( parsers )
         {
@@ -184,10 +192,7 @@ namespace librealsense
             // wait until user is done with all the stuff he chose to borrow
             callback_inflight.wait_until_empty();
 
-            {
-                std::lock_guard<std::recursive_mutex> guard(mutex);
-                freelist.clear();
-            }
+            buffers.clear();
 
             pending_frames = published_frames.get_size();
             if (pending_frames > 0)
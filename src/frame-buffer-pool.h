@@ -0,0 +1,208 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include <atomic>
+#include <vector>
+#include <cstdint>
+
+
+namespace librealsense {
+
+
+struct frame_buffer_pool_stats
+{
+    uint64_t hits = 0;       // allocations served by a recycled buffer
+    uint64_t misses = 0;     // allocations that needed a new buffer
+    uint64_t evictions = 0;  // recycled buffers that were released instead of reused
+};
+
+
+// Recycles frame data buffers so that steady-state streaming does not allocate (or zero-fill) memory per frame.
+//
+// Buffers are kept in buckets according to their size class (the position of the highest bit of their size), and each
+// bucket is a fixed set of slots, each guarded by its own atomic state: producers (frame allocation) and consumers
+// (frame release) never take a lock or wait on each other. A buffer that is not reused within MAX_IDLE_TIME of the
+// latest frame, or that finds no free slot when it is returned, is released. Idle buffers are looked for at most once
+// every MAX_IDLE_TIME, so a buffer may stay idle for up to twice as long before it is released.
+//
+class frame_buffer_pool
+{
+public:
+    using buffer = std::vector< uint8_t >;
+
+    static constexpr int SLOTS_PER_BUCKET = 8;
+    static constexpr int N_BUCKETS = 8 * sizeof( size_t ) + 1;
+    static constexpr double MAX_IDLE_TIME = 1000.;  // in frame timestamp units (msec)
+
+    frame_buffer_pool()
+    {
+        for( auto & b : _buckets )
+            b.store( nullptr );
+    }
+    frame_buffer_pool( frame_buffer_pool const & ) = delete;
+    frame_buffer_pool & operator=( frame_buffer_pool const & ) = delete;
+
+    ~frame_buffer_pool()
+    {
+        for( auto & b : _buckets )
+            delete b.load();
+    }
+
+    // Move a recycled buffer of the requested size into 'out', if one is available. Recycled buffers are returned with
+    // their previous contents. Returns false on a miss, in which case 'out' is untouched.
+    bool acquire( size_t size, buffer & out )
+    {
+        if( auto b = _buckets[bucket_index( size )].load( std::memory_order_acquire ) )
+        {
+            for( auto & s : b->slots )
+            {
+                if( ! try_lock( s, FULL ) )
+                    continue;
+                if( s.buf.size() >= size )
+                {
+                    out.swap( s.buf );
+                    buffer().swap( s.buf );
+                    s.state.store( EMPTY, std::memory_order_release );
+                    out.resize( size );  // never grows, so nothing is filled
+                    ++_hits;
+                    return true;
+                }
+                s.state.store( FULL, std::memory_order_release );
+            }
+        }
+        ++_misses;
+        return false;
+    }
+
+    // Return a buffer to the pool; 'buf' is left empty if it was taken, or as-is if there was no room for it
+    void recycle( buffer && buf, double timestamp )
+    {
+        if( buf.empty() )
+            return;
+
+        auto & b = get_or_create_bucket( bucket_index( buf.size() ) );
+        for( auto & s : b.slots )
+        {
+            if( ! try_lock( s, EMPTY ) )
+                continue;
+            s.buf.swap( buf );
+            s.timestamp.store( timestamp, std::memory_order_relaxed );
+            s.state.store( FULL, std::memory_order_release );
+            return;
+        }
+        ++_evictions;
+    }
+
+    // Release buffers that were last used more than MAX_IDLE_TIME before 'timestamp'. This is called for every frame, so
+    // the slots are only scanned if MAX_IDLE_TIME has passed since the last scan (or time went backwards).
+    void evict_stale( double timestamp )
+    {
+        auto last = _last_eviction.load( std::memory_order_relaxed );
+        if( timestamp >= last && timestamp < last + MAX_IDLE_TIME )
+            return;
+        if( ! _last_eviction.compare_exchange_strong( last, timestamp, std::memory_order_relaxed ) )
+            return;  // another thread got to it first
+        evict_if( [&]( slot & s ) {
+            return timestamp > s.timestamp.load( std::memory_order_relaxed ) + MAX_IDLE_TIME;
+        } );
+    }
+
+    // Release all buffers held by the pool
+    void clear()
+    {
+        evict_if( []( slot & ) { return true; } );
+    }
+
+    frame_buffer_pool_stats get_stats() const
+    {
+        frame_buffer_pool_stats stats;
+        stats.hits = _hits.load();
+        stats.misses = _misses.load();
+        stats.evictions = _evictions.load();
+        return stats;
+    }
+
+private:
+    enum : int { EMPTY, BUSY, FULL };
+
+    struct slot
+    {
+        std::atomic< int > state{ EMPTY };
+        std::atomic< double > timestamp{ 0. };
+        buffer buf;
+    };
+
+    struct bucket
+    {
+        slot slots[SLOTS_PER_BUCKET];
+    };
+
+    static int bucket_index( size_t size )
+    {
+        int i = 0;
+        while( size )
+        {
+            size >>= 1;
+            ++i;
+        }
+        return i;
+    }
+
+    static bool try_lock( slot & s, int from )
+    {
+        int expected = from;
+        return s.state.load( std::memory_order_relaxed ) == from
+            && s.state.compare_exchange_strong( expected, BUSY, std::memory_order_acquire );
+    }
+
+    bucket & get_or_create_bucket( int index )
+    {
+        auto & p = _buckets[index];
+        auto b = p.load( std::memory_order_acquire );
+        if( ! b )
+        {
+            // Buckets are only created once per size class, and never released while the pool lives
+            auto new_bucket = new bucket();
+            if( p.compare_exchange_strong( b, new_bucket, std::memory_order_acq_rel ) )
+                b = new_bucket;
+            else
+                delete new_bucket;
+        }
+        return *b;
+    }
+
+    template< class Pred >
+    void evict_if( Pred && should_evict )
+    {
+        for( auto & p : _buckets )
+        {
+            auto b = p.load( std::memory_order_acquire );
+            if( ! b )
+                continue;
+            for( auto & s : b->slots )
+            {
+                if( ! should_evict( s ) || ! try_lock( s, FULL ) )
+                    continue;
+                if( ! should_evict( s ) )  // it may have been reused and returned in the meantime
+                {
+                    s.state.store( FULL, std::memory_order_release );
+                    continue;
+                }
+                buffer().swap( s.buf );
+                s.state.store( EMPTY, std::memory_order_release );
+                ++_evictions;
+            }
+        }
+    }
+
+    std::atomic< bucket * > _buckets[N_BUCKETS];
+    std::atomic< double > _last_eviction{ 0. };
+    std::atomic< uint64_t > _hits{ 0 };
+    std::atomic< uint64_t > _misses{ 0 };
+    std::atomic< uint64_t > _evictions{ 0 };
+};
+
+
+}  // namespace librealsense
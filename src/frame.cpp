@@ -73,6 +73,11 @@ frame::frame( frame && r )
 frame & frame::operator=( frame && r )
 {
     data = std::move( r.data );
+    external_data = std::move( r.external_data );
+    external_data_size = r.external_data_size;
+    r.external_data_size = 0;
+    export_external_data = std::move( r.export_external_data );
+    r.export_external_data = nullptr;
     owner = r.owner;
     ref_count = r.ref_count.exchange( 0 );
     _kept = r._kept.exchange( false );
@@ -148,12 +153,14 @@ bool frame::find_metadata( rs2_frame_metadata_value frame_metadata, rs2_metadata
 
 int frame::get_frame_data_size() const
 {
+    if( external_data )
+        return (int)external_data_size;
     return (int)data.size();
 }
 
 const uint8_t * frame::get_frame_data() const
 {
-    const uint8_t * frame_data = data.data();
+    const uint8_t * frame_data = external_data ? external_data.get() : data.data();
 
     if( on_release.get_data() )
     {
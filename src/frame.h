@@ -10,6 +10,7 @@
 #include <atomic>
 #include <vector>
 #include <memory>
+#include <functional>
 
 
 namespace librealsense {
@@ -20,6 +21,11 @@ class LRS_EXTENSION_API frame : public frame_interface
 {
 public:
     std::vector< uint8_t > data;
+    // Frame data that lives outside of 'data' (e.g., from a user-supplied allocator); takes precedence over 'data'
+    // and is released through its deleter when the frame is returned to its archive
+    std::shared_ptr< uint8_t > external_data;
+    size_t external_data_size = 0;
+    std::function< int() > export_external_data;  // returns a DMABUF file descriptor of the external data, or -1
     frame_additional_data additional_data;
     std::shared_ptr< metadata_parser_map > metadata_parsers = nullptr;
     
@@ -37,6 +43,17 @@ public:
     frame & operator=( frame && r );
 
     virtual ~frame() { on_release.reset(); }
+
+    void attach_external_data( std::shared_ptr< uint8_t > buffer,
+                               size_t size,
+                               std::function< int() > export_fd = nullptr )
+    {
+        external_data = std::move( buffer );
+        external_data_size = external_data ? size : 0;
+        export_external_data = external_data ? std::move( export_fd ) : nullptr;
+    }
+    void release_external_data() { attach_external_data( nullptr, 0 ); }
+
     frame_header const & get_header() const override { return additional_data; }
     bool find_metadata( rs2_frame_metadata_value, rs2_metadata_type * p_output_value ) const override;
     int get_frame_data_size() const override;
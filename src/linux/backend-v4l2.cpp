@@ -2,6 +2,7 @@
 // Copyright(c) 2015 Intel Corporation. All Rights Reserved.
 
 #include "backend-v4l2.h"
+#include "private-mapping.h"
 #include <src/platform/command-transfer.h>
 #include <src/platform/hid-data.h>
 #include <src/core/time-service.h>
@@ -18,6 +19,7 @@
 #include "usb/usb-device.h"
 
 #include <rsutils/string/from.h>
+#include <rsutils/json.h>
 
 #include <cassert>
 #include <cstdlib>
@@ -323,6 +325,10 @@ namespace librealsense
                                                     fd, _offset));
                 if(_start == MAP_FAILED)
                     throw linux_backend_exception("mmap failed");
+
+                // Video buffers can be exported as DMABUF, so frames referencing them in-place can be shared
+                if (type == V4L2_BUF_TYPE_VIDEO_CAPTURE || type == V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE)
+                    _device_fd = fd;
             }
             else
             {
@@ -359,6 +365,8 @@ namespace librealsense
         {
             if (_use_memory_map)
             {
+               if (_dmabuf_fd >= 0)
+                   ::close(_dmabuf_fd);
                if(munmap(_start, _original_length) < 0)
                    linux_backend_exception("munmap");
             }
@@ -379,6 +387,47 @@ namespace librealsense
         {
             std::lock_guard<std::mutex> lock(_mutex);
             _must_enqueue = false;
+            _device_fd = -1;
+        }
+
+        int buffer::export_dmabuf()
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_dmabuf_fd < 0 && _device_fd >= 0)
+            {
+                v4l2_exportbuffer expbuf = {};
+                expbuf.type = _type;
+                expbuf.index = _index;
+                expbuf.plane = 0;
+                expbuf.flags = O_RDONLY | O_CLOEXEC;
+                if (xioctl(_device_fd, VIDIOC_EXPBUF, &expbuf) < 0)
+                {
+                    LOG_DEBUG_V4L("xioctl(VIDIOC_EXPBUF) failed for buf " << std::dec << _index << ": " << strerror(errno));
+                    _device_fd = -1;  // no point trying again
+                }
+                else
+                    _dmabuf_fd = expbuf.fd;
+            }
+            return _dmabuf_fd;
+        }
+
+        void buffer::release_mapping()
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            // Frames released later must not queue it (or export it) on a descriptor that may be closed (or reused)
+            // by then
+            _must_enqueue = false;
+            _device_fd = -1;
+            if (!_use_memory_map)
+                return;  // user pointers are ours already
+
+            // Frames may still reference the buffer in-place (see 'zero-copy-frames'), and the driver cannot release
+            // its buffers while they are mapped: give those frames a copy at the same address instead
+            if (!replace_with_private_copy(_start, _original_length))
+                LOG_WARNING("Failed to copy out V4L2 buffer " << std::dec << _index << " still referenced by frames: "
+                            << strerror(errno));
+            else if (_dmabuf_fd >= 0)
+                LOG_DEBUG_V4L("V4L2 buffer " << std::dec << _index << " stays allocated until its exported DMABUF is closed");
         }
 
         void buffer::request_next_frame(int fd, bool force)
@@ -1252,7 +1301,29 @@ namespace librealsense
                 streamon();
 
                 _is_capturing = true;
-                _thread = std::unique_ptr<std::thread>(new std::thread([this](){ capture_loop(); }));
+                _reactor = v4l_capture_reactor::get();
+                if (_reactor)
+                {
+                    _reactor_id = _reactor->add(_fds, std::chrono::seconds(5), [this](fd_set & fds, int val)
+                    {
+                        try
+                        {
+                            handle_poll_result(fds, val);
+                        }
+                        catch (const std::exception& ex)
+                        {
+                            LOG_ERROR(ex.what());
+
+                            librealsense::notification n = {RS2_NOTIFICATION_CATEGORY_UNKNOWN_ERROR, 0, RS2_LOG_SEVERITY_ERROR, ex.what()};
+
+                            _error_handler(n);
+                            return false;
+                        }
+                        return _is_capturing.load();
+                    });
+                }
+                else
+                    _thread = std::unique_ptr<std::thread>(new std::thread([this](){ capture_loop(); }));
 
                 // Starting the video/metadata syncer
                 _video_md_syncer.start();
@@ -1272,8 +1343,16 @@ namespace librealsense
             // Stop nn-demand frames polling
             signal_stop();
 
-            _thread->join();
-            _thread.reset();
+            if (_reactor)
+            {
+                _reactor->remove(_reactor_id);
+                _reactor.reset();
+            }
+            else
+            {
+                _thread->join();
+                _thread.reset();
+            }
 
             // Notify kernel
             streamoff();
@@ -1393,6 +1472,11 @@ namespace librealsense
             } while (val < 0 && errno == EINTR);
 
             LOG_DEBUG_V4L("Select done, val = " << val << " at " << time_in_HH_MM_SS_MMM());
+            handle_poll_result(fds, val);
+        }
+
+        void v4l_uvc_device::handle_poll_result(fd_set & fds, int val)
+        {
             if(val < 0)
             {
                 _is_capturing = false;
@@ -1547,7 +1631,8 @@ namespace librealsense
                                             auto frame_sz = buf_mgr.md_node_present() ? buf.bytesused :
                                                                 std::min(buf.bytesused - buf_mgr.metadata_size(), buffer->get_length_frame_only());
                                             frame_object fo{ frame_sz, buf_mgr.metadata_size(),
-                                                             buffer->get_frame_start(), buf_mgr.metadata_start(), timestamp };
+                                                             buffer->get_frame_start(), buf_mgr.metadata_start(), timestamp,
+                                                             true, buffer };
 
                                             buffer->attach_buffer(buf);
                                             buf_mgr.handle_buffer(e_video_buf,-1); // transfer new buffer request to the frame callback
@@ -1592,7 +1677,8 @@ namespace librealsense
                                                 }
 
                                                 frame_object fo{ frame_sz, md_size,
-                                                            buffer->get_frame_start(), md_start, timestamp };
+                                                            buffer->get_frame_start(), md_start, timestamp,
+                                                            true, buffer };
 
                                                 //Invoke user callback and enqueue next frame
                                                 _callback(_profile, fo, [buf_mgr]() mutable {
@@ -1697,7 +1783,8 @@ namespace librealsense
                     // D457 work - to work with "normal camera", use frame_sz as the first input to the following frame_object:
                     //frame_object fo{ buf.bytesused - MAX_META_DATA_SIZE, buf_mgr.metadata_size(),
                     frame_object fo{ frame_sz, buf_mgr.metadata_size(),
-                                     video_buffer->get_frame_start(), buf_mgr.metadata_start(), timestamp };
+                                     video_buffer->get_frame_start(), buf_mgr.metadata_start(), timestamp,
+                                     true, video_buffer };
 
                     //Invoke user callback and enqueue next frame
                     _callback(_profile, fo, [buf_mgr]() mutable {
@@ -2115,7 +2202,11 @@ namespace librealsense
             {
                 for(size_t i = 0; i < _buffers.size(); i++)
                 {
-                    _buffers[i]->detach_buffer();
+                    // Still referenced by frames?
+                    if (_buffers[i].use_count() > 1)
+                        _buffers[i]->release_mapping();
+                    else
+                        _buffers[i]->detach_buffer();
                 }
                 _buffers.resize(0);
             }
@@ -2352,7 +2443,10 @@ namespace librealsense
             {
                 for(size_t i = 0; i < _md_buffers.size(); i++)
                 {
-                    _md_buffers[i]->detach_buffer();
+                    if (_md_buffers[i].use_count() > 1)
+                        _md_buffers[i]->release_mapping();
+                    else
+                        _md_buffers[i]->detach_buffer();
                 }
                 _md_buffers.resize(0);
             }
@@ -2741,6 +2835,11 @@ namespace librealsense
                 throw linux_backend_exception(rsutils::string::from() << "MIPI Controls mapping is for Depth XU only, requested for subdevice " << xu.subdevice);
         }
 
+        void v4l_backend::configure(rsutils::json const & settings)
+        {
+            v4l_capture_reactor::configure(v4l_capture_reactor::settings::from_json(settings.nested(std::string("v4l-capture", 11))));
+        }
+
         std::shared_ptr<uvc_device> v4l_backend::create_uvc_device(uvc_device_info info) const
         {
             bool mipi_device = 0xABCD == info.pid; // D457 development. Not for upstream
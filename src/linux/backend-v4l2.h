@@ -7,6 +7,7 @@
 #include <src/platform/uvc-device.h>
 #include <src/metadata.h>
 #include "types.h"
+#include "v4l-capture-reactor.h"
 
 #include <cassert>
 #include <cstdlib>
@@ -119,7 +120,7 @@ namespace librealsense
         };
         static int xioctl(int fh, unsigned long request, void *arg);
 
-        class buffer
+        class buffer : public dmabuf_exporter
         {
         public:
             buffer(int fd, v4l2_buf_type type, bool use_memory_map, uint32_t index);
@@ -132,6 +133,10 @@ namespace librealsense
 
             void detach_buffer();
 
+            // Like detach_buffer(), but for a buffer that may outlive the stream: the device mapping is replaced by a
+            // copy, at the same address, so the driver can release its buffers
+            void release_mapping();
+
             void request_next_frame(int fd, bool force=false);
 
             uint32_t get_full_length() const { return _length; }
@@ -139,6 +144,9 @@ namespace librealsense
 
             uint8_t* get_frame_start() const { return _start; }
 
+            // Video buffers are only exported when a frame asks, as each export holds a file descriptor
+            int export_dmabuf() override;
+
             bool use_memory_map() const { return _use_memory_map; }
 
         private:
@@ -152,6 +160,8 @@ namespace librealsense
             v4l2_buffer _buf;
             std::mutex _mutex;
             bool _must_enqueue = false;
+            int _device_fd = -1;  // to export with; -1 once the buffer is detached, or cannot be exported
+            int _dmabuf_fd = -1;
         };
 
         enum supported_kernel_buf_types : uint8_t
@@ -350,6 +360,7 @@ namespace librealsense
             void signal_stop();
 
             void poll();
+            void handle_poll_result(fd_set & fds, int val);
 
             void set_power_state(power_state state) override;
             power_state get_power_state() const override { return _state; }
@@ -417,6 +428,8 @@ namespace librealsense
             std::atomic<bool> _is_alive;
             std::atomic<bool> _is_started;
             std::unique_ptr<std::thread> _thread;
+            std::shared_ptr<v4l_capture_reactor> _reactor;  // services the capture instead of _thread, when enabled
+            int _reactor_id = -1;
             std::unique_ptr<named_mutex> _named_mtx;
             struct device {
                 enum v4l2_buf_type buf_type;
@@ -502,6 +515,8 @@ namespace librealsense
             std::vector<hid_device_info> query_hid_devices() const override;
 
             std::shared_ptr<device_watcher> create_device_watcher() const override;
+
+            void configure(rsutils::json const & settings) override;
         };
     }
 }
@@ -0,0 +1,39 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include <sys/mman.h>
+#include <cstring>
+#include <cstddef>
+
+
+namespace librealsense {
+namespace platform {
+
+
+// Replaces the memory mapped at 'start' (as returned by mmap) with a private copy of its first 'length' bytes, at the
+// same address. Pointers into it stay valid and see the same data, but the original mapping (e.g., of a V4L2 capture
+// buffer) is released, and any later writes to it are no longer seen.
+//
+// Returns false, with the original mapping left in place, on failure (see errno).
+//
+inline bool replace_with_private_copy( void * start, size_t length )
+{
+    auto copy = mmap( nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+    if( copy == MAP_FAILED )
+        return false;
+    std::memcpy( copy, start, length );
+
+    // Moves the copy over the original in one step, so 'start' is never left unmapped
+    if( mremap( copy, length, length, MREMAP_MAYMOVE | MREMAP_FIXED, start ) == MAP_FAILED )
+    {
+        munmap( copy, length );
+        return false;
+    }
+    return true;
+}
+
+
+}  // namespace platform
+}  // namespace librealsense
@@ -0,0 +1,307 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include "v4l-capture-reactor.h"
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+#include <src/librealsense-exception.h>
+#include <src/log.h>
+
+#include <rsutils/json.h>
+#include <rsutils/shared-ptr-singleton.h>
+#include <rsutils/string/from.h>
+
+
+namespace librealsense {
+namespace platform {
+
+
+v4l_capture_reactor::settings v4l_capture_reactor::settings::from_json( rsutils::json const & j )
+{
+    settings s;
+    if( j.is_null() || j.is_discarded() )
+        return s;
+    if( ! j.is_object() )
+        throw invalid_value_exception( rsutils::string::from() << "invalid 'v4l-capture' settings: " << j );
+
+    auto get_int = [&]( char const * name, int min_value, int max_value )
+    {
+        auto value_j = j.nested( std::string( name ) );
+        if( ! value_j )
+            return 0;
+        if( ! value_j.is_number_integer() || value_j.get< int64_t >() < min_value
+            || value_j.get< int64_t >() > max_value )
+            throw invalid_value_exception( rsutils::string::from() << "invalid 'v4l-capture/" << name << "' value "
+                                                                   << value_j << "; expecting [" << min_value << "-"
+                                                                   << max_value << "]" );
+        return value_j.get< int >();
+    };
+    s.threads = get_int( "threads", 0, 64 );
+    s.priority = get_int( "priority", 0, 99 );
+
+    if( auto cpus_j = j.nested( std::string( "cpus", 4 ) ) )
+    {
+        if( ! cpus_j.is_array() )
+            throw invalid_value_exception( rsutils::string::from()
+                                           << "invalid 'v4l-capture/cpus' value " << cpus_j << "; expecting an array" );
+        for( auto & cpu : cpus_j )
+        {
+            if( ! cpu.is_number_integer() || cpu.get< int64_t >() < 0 || cpu.get< int64_t >() >= CPU_SETSIZE )
+                throw invalid_value_exception( rsutils::string::from() << "invalid 'v4l-capture/cpus' CPU " << cpu );
+            s.cpus.push_back( cpu.get< int >() );
+        }
+    }
+    return s;
+}
+
+
+static std::mutex the_settings_mutex;
+static v4l_capture_reactor::settings the_settings;
+static rsutils::shared_ptr_singleton< v4l_capture_reactor > the_reactor;
+
+
+void v4l_capture_reactor::configure( settings const & s )
+{
+    std::lock_guard< std::mutex > lock( the_settings_mutex );
+    the_settings = s;
+}
+
+
+std::shared_ptr< v4l_capture_reactor > v4l_capture_reactor::get()
+{
+    settings s;
+    {
+        std::lock_guard< std::mutex > lock( the_settings_mutex );
+        s = the_settings;
+    }
+    if( s.threads <= 0 )
+        return nullptr;
+    return the_reactor.instance( s );
+}
+
+
+v4l_capture_reactor::registration::~registration()
+{
+    if( timerfd >= 0 )
+        ::close( timerfd );
+    if( epfd >= 0 )
+        ::close( epfd );
+}
+
+
+v4l_capture_reactor::v4l_capture_reactor( settings const & s )
+    : _settings( s )
+{
+    _epfd = epoll_create1( EPOLL_CLOEXEC );
+    if( _epfd < 0 )
+        throw linux_backend_exception( "epoll_create1 failed" );
+
+    _wakeup_fd = eventfd( 0, EFD_NONBLOCK | EFD_CLOEXEC );
+    if( _wakeup_fd < 0 )
+    {
+        ::close( _epfd );
+        throw linux_backend_exception( "eventfd failed" );
+    }
+
+    // Level-triggered and never disarmed, so it wakes up all the workers
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.u64 = uint64_t( -1 );
+    epoll_ctl( _epfd, EPOLL_CTL_ADD, _wakeup_fd, &ev );
+
+    for( size_t i = 0; i < size_t( _settings.threads ); ++i )
+        _workers.emplace_back( [this, i]() { worker( i ); } );
+
+    LOG_INFO( "V4L capture reactor started with " << _settings.threads << " threads" );
+}
+
+
+v4l_capture_reactor::~v4l_capture_reactor()
+{
+    uint64_t one = 1;
+    if( write( _wakeup_fd, &one, sizeof( one ) ) < 0 )
+        LOG_ERROR( "Failed to signal the V4L capture reactor to stop: " << strerror( errno ) );
+    for( auto & t : _workers )
+        t.join();
+
+    ::close( _wakeup_fd );
+    ::close( _epfd );
+}
+
+
+int v4l_capture_reactor::add( std::vector< int > const & fds, std::chrono::milliseconds timeout, handler on_ready )
+{
+    auto r = std::make_shared< registration >();
+    r->timeout = timeout;
+    r->on_ready = std::move( on_ready );
+
+    r->epfd = epoll_create1( EPOLL_CLOEXEC );
+    if( r->epfd < 0 )
+        throw linux_backend_exception( "epoll_create1 failed" );
+    r->timerfd = timerfd_create( CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC );
+    if( r->timerfd < 0 )
+        throw linux_backend_exception( "timerfd_create failed" );
+
+    std::vector< int > watched( fds );
+    watched.push_back( r->timerfd );
+    for( auto fd : watched )
+    {
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.fd = fd;
+        if( epoll_ctl( r->epfd, EPOLL_CTL_ADD, fd, &ev ) < 0 )
+            throw linux_backend_exception( rsutils::string::from() << "epoll_ctl(ADD) failed for fd " << fd );
+    }
+    arm_timer( *r );
+
+    std::lock_guard< std::mutex > lock( _mutex );
+    r->id = _next_id++;
+    _registrations[r->id] = r;
+
+    // One-shot: only one worker at a time services a device, until it re-arms it
+    epoll_event ev{};
+    ev.events = EPOLLIN | EPOLLONESHOT;
+    ev.data.u64 = uint64_t( r->id );
+    if( epoll_ctl( _epfd, EPOLL_CTL_ADD, r->epfd, &ev ) < 0 )
+    {
+        _registrations.erase( r->id );
+        throw linux_backend_exception( "epoll_ctl(ADD) failed for device" );
+    }
+    return r->id;
+}
+
+
+void v4l_capture_reactor::remove( int id )
+{
+    std::shared_ptr< registration > r;
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        auto it = _registrations.find( id );
+        if( it == _registrations.end() )
+            return;
+        r = it->second;
+        _registrations.erase( it );
+    }
+    epoll_ctl( _epfd, EPOLL_CTL_DEL, r->epfd, nullptr );
+
+    std::lock_guard< std::mutex > lock( r->running );
+    r->removed = true;
+}
+
+
+void v4l_capture_reactor::arm_timer( registration const & r ) const
+{
+    itimerspec spec{};
+    spec.it_value.tv_sec = r.timeout.count() / 1000;
+    spec.it_value.tv_nsec = ( r.timeout.count() % 1000 ) * 1000000;
+    timerfd_settime( r.timerfd, 0, &spec, nullptr );
+}
+
+
+void v4l_capture_reactor::worker( size_t index )
+{
+    auto self = pthread_self();
+    if( ! _settings.cpus.empty() )
+    {
+        cpu_set_t cpus;
+        CPU_ZERO( &cpus );
+        for( auto cpu : _settings.cpus )
+            CPU_SET( cpu, &cpus );
+        if( auto err = pthread_setaffinity_np( self, sizeof( cpus ), &cpus ) )
+            LOG_WARNING( "Failed to set V4L capture thread " << index << " CPU affinity: " << strerror( err ) );
+    }
+    if( _settings.priority > 0 )
+    {
+        sched_param param{};
+        param.sched_priority = _settings.priority;
+        if( auto err = pthread_setschedparam( self, SCHED_FIFO, &param ) )
+            LOG_WARNING( "Failed to set V4L capture thread " << index << " to SCHED_FIFO: " << strerror( err ) );
+    }
+
+    epoll_event events[8];
+    while( true )
+    {
+        int n = epoll_wait( _epfd, events, 8, -1 );
+        if( n < 0 )
+        {
+            if( errno == EINTR )
+                continue;
+            LOG_ERROR( "V4L capture reactor epoll_wait failed: " << strerror( errno ) );
+            return;
+        }
+
+        for( int i = 0; i < n; ++i )
+        {
+            if( events[i].data.u64 == uint64_t( -1 ) )
+                return;
+
+            std::shared_ptr< registration > r;
+            {
+                std::lock_guard< std::mutex > lock( _mutex );
+                auto it = _registrations.find( int( events[i].data.u64 ) );
+                if( it == _registrations.end() )
+                    continue;  // removed while we were waiting
+                r = it->second;
+            }
+            service( *r );
+        }
+    }
+}
+
+
+void v4l_capture_reactor::service( registration & r )
+{
+    std::lock_guard< std::mutex > lock( r.running );
+    if( r.removed )
+        return;
+
+    // Collect everything that is ready, like select() would
+    epoll_event events[8];
+    int n = epoll_wait( r.epfd, events, 8, 0 );
+
+    fd_set fds;
+    FD_ZERO( &fds );
+    int n_ready = 0;
+    bool timed_out = false;
+    for( int i = 0; i < n; ++i )
+    {
+        if( events[i].data.fd == r.timerfd )
+        {
+            uint64_t expirations;
+            if( read( r.timerfd, &expirations, sizeof( expirations ) ) > 0 )
+                timed_out = true;
+            continue;
+        }
+        FD_SET( events[i].data.fd, &fds );
+        ++n_ready;
+    }
+
+    bool keep_servicing = true;
+    if( n_ready || timed_out )
+    {
+        arm_timer( r );
+        keep_servicing = r.on_ready( fds, n_ready );
+    }
+
+    if( keep_servicing )
+    {
+        epoll_event ev{};
+        ev.events = EPOLLIN | EPOLLONESHOT;
+        ev.data.u64 = uint64_t( r.id );
+        if( epoll_ctl( _epfd, EPOLL_CTL_MOD, r.epfd, &ev ) < 0 && errno != ENOENT )  // ENOENT: being removed
+            LOG_ERROR( "V4L capture reactor failed to re-arm device: " << strerror( errno ) );
+    }
+}
+
+
+}  // namespace platform
+}  // namespace librealsense
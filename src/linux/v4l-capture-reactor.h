@@ -0,0 +1,101 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include <sys/select.h>
+
+#include <rsutils/json-fwd.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace librealsense {
+namespace platform {
+
+
+// Services the capture of all V4L devices on a small pool of shared threads, instead of a select() thread per device.
+//
+// Each device registers the fds it would otherwise select() on. A single epoll instance watches all of them, and a
+// worker calls the device handler with the subset that is ready, exactly as select() would have reported it (or with
+// none, after the device timeout expires). Handlers of the same device never run concurrently, but different devices
+// are serviced in parallel by different workers.
+//
+// The reactor is off by default, and is configured through the 'v4l-capture' context setting:
+//     threads   - number of worker threads; 0 (or missing) keeps a capture thread per device
+//     cpus      - array of CPUs the workers are restricted to, e.g. [2,3]
+//     priority  - SCHED_FIFO priority [1-99] for the workers; 0 (or missing) keeps the default policy
+// The reactor is shared by all contexts: the settings of the last context created apply from the next time it starts.
+//
+class v4l_capture_reactor
+{
+public:
+    struct settings
+    {
+        int threads = 0;
+        std::vector< int > cpus;
+        int priority = 0;
+
+        // Throws invalid_value_exception if malformed
+        static settings from_json( rsutils::json const & );
+    };
+
+    // Called with the ready fds and their count, or an empty set and 0 on timeout; returns whether to keep servicing
+    using handler = std::function< bool( fd_set & fds, int n_ready ) >;
+
+    // Sets what the shared reactor will use the next time it is created
+    static void configure( settings const & );
+
+    // The shared reactor, or null if it is not enabled
+    static std::shared_ptr< v4l_capture_reactor > get();
+
+    explicit v4l_capture_reactor( settings const & );
+    ~v4l_capture_reactor();
+
+    v4l_capture_reactor( v4l_capture_reactor const & ) = delete;
+    v4l_capture_reactor & operator=( v4l_capture_reactor const & ) = delete;
+
+    // Start servicing the given fds; returns an id for remove()
+    int add( std::vector< int > const & fds, std::chrono::milliseconds timeout, handler );
+
+    // Stop servicing, waiting for a handler that may be running to return; must not be called from the handler
+    void remove( int id );
+
+private:
+    struct registration
+    {
+        int id;
+        int epfd = -1;     // the device fds, so all that are ready can be collected at once
+        int timerfd = -1;  // expires if none of the fds becomes ready in time
+        std::chrono::milliseconds timeout;
+        handler on_ready;
+        std::mutex running;
+        bool removed = false;
+
+        ~registration();
+    };
+
+    void worker( size_t index );
+    void service( registration & );
+    void arm_timer( registration const & ) const;
+
+    settings _settings;
+    int _epfd = -1;
+    int _wakeup_fd = -1;  // eventfd to stop the workers
+    std::vector< std::thread > _workers;
+
+    std::mutex _mutex;
+    std::map< int, std::shared_ptr< registration > > _registrations;
+    int _next_id = 0;
+};
+
+
+}  // namespace platform
+}  // namespace librealsense
@@ -38,6 +38,8 @@ playback_device::playback_device( std::shared_ptr< const device_info > const & d
     , m_is_paused( false )
     , m_sample_rate( 1 )
     , m_real_time( true )
+    , m_range_start( 0 )
+    , m_range_end( 0 )
     , m_prev_timestamp( 0 )
     , m_last_published_timestamp( 0 )
 {
@@ -382,8 +384,15 @@ void playback_device::resume()
         if (m_last_published_timestamp >= total_duration)
             m_last_published_timestamp = device_serializer::nanoseconds(0);
         m_reader->reset();
-        m_reader->seek_to_time(m_last_published_timestamp);
-        while (m_last_published_timestamp != device_serializer::nanoseconds(0) && !m_reader->read_next_data()->is<serialized_frame>());
+        if (m_last_published_timestamp < m_range_start)
+        {
+            m_reader->seek_to_time(m_range_start);
+        }
+        else
+        {
+            m_reader->seek_to_time(m_last_published_timestamp);
+            while (m_last_published_timestamp != device_serializer::nanoseconds(0) && !m_reader->read_next_data()->is<serialized_frame>());
+        }
 
         m_is_paused = false;
         catch_up();
@@ -409,6 +418,49 @@ bool playback_device::is_real_time() const
     return m_real_time;
 }
 
+void playback_device::set_read_ahead(uint32_t frames)
+{
+    LOG_INFO("Set read-ahead to " << frames << " frames");
+    for (auto&& sensor : m_sensors)
+        sensor.second->set_read_ahead(frames);
+    // Frames read ahead are allocated from the reader's pool, which must not run out before the queues fill up
+    (*m_read_thread)->invoke([this, frames](dispatcher::cancellable_timer t)
+    {
+        m_reader->reserve_frames(frames);
+    });
+    if ((*m_read_thread)->flush() == false)
+    {
+        LOG_ERROR("Error - timeout waiting for set_read_ahead, possible deadlock detected");
+        assert(0); //Detect this immediately in debug
+    }
+}
+
+void playback_device::set_range(std::chrono::nanoseconds start, std::chrono::nanoseconds end)
+{
+    LOG_INFO("Request to set playback range to [" << start.count() << ", " << end.count() << ")");
+    if (start.count() < 0 || end.count() < 0 || (end.count() > 0 && end <= start))
+    {
+        throw invalid_value_exception( rsutils::string::from() << "Invalid playback range [" << start.count() << ", "
+                                                               << end.count() << ")" );
+    }
+    if (start > m_reader->query_duration())
+    {
+        throw invalid_value_exception( rsutils::string::from() << "Playback range starts at " << start.count()
+                                                               << ", after the end of the file ("
+                                                               << m_reader->query_duration().count() << ")" );
+    }
+    (*m_read_thread)->invoke([this, start, end](dispatcher::cancellable_timer t)
+    {
+        m_range_start = start;
+        m_range_end = end;
+    });
+    if ((*m_read_thread)->flush() == false)
+    {
+        LOG_ERROR("Error - timeout waiting for set_range, possible deadlock detected");
+        assert(0); //Detect this immediately in debug
+    }
+}
+
 std::shared_ptr< const device_info > playback_device::get_device_info() const
 {
     return m_device_info;
@@ -479,6 +531,11 @@ void playback_device::start()
         return; //nothing to do
 
     m_is_started = true;
+    if (m_range_start.count() > 0)
+    {
+        m_reader->seek_to_time(m_range_start);
+        m_prev_timestamp = m_range_start;
+    }
     catch_up();
     try_looping();
     LOG_INFO("Playback started");
@@ -613,6 +670,11 @@ void playback_device::try_looping()
         }
 
         auto timestamp = data->get_timestamp();
+        if (m_range_end.count() > 0 && timestamp >= m_range_end)
+        {
+            LOG_INFO("End of playback range reached");
+            return false;
+        }
         m_prev_timestamp = timestamp;
         //Objects with timestamp of 0 are non streams.
         if (m_base_timestamp.count() == 0)
@@ -44,6 +44,8 @@ namespace librealsense
         void stop();
         void set_real_time(bool real_time);
         bool is_real_time() const;
+        void set_read_ahead(uint32_t frames);
+        void set_range(std::chrono::nanoseconds start, std::chrono::nanoseconds end);
         const std::string& get_file_name() const;
         uint64_t get_position() const;
         rsutils::public_signal< playback_device, rs2_playback_status > playback_status_changed;
@@ -91,6 +93,8 @@ namespace librealsense
         std::map<uint32_t, std::shared_ptr<playback_sensor>> m_active_sensors;
         std::atomic<double> m_sample_rate;
         std::atomic_bool m_real_time;
+        device_serializer::nanoseconds m_range_start; // !< Where playback starts reading; 0 for the start of the file
+        device_serializer::nanoseconds m_range_end;   // !< Where playback ends as if the file ended; 0 for the end of the file
         device_serializer::nanoseconds m_prev_timestamp;
         std::vector< std::shared_ptr< rsutils::lazy< rs2_extrinsics > > > m_extrinsics_fetchers;
         std::map<int, std::pair<uint32_t, rs2_extrinsics>> m_extrinsics_map;
@@ -33,7 +33,9 @@ playback_sensor::playback_sensor(device_interface& parent_device, const device_s
     m_sensor_description(sensor_description),
     m_sensor_id(sensor_description.get_sensor_index()),
     m_parent_device(parent_device),
-    _default_queue_size(1)
+    _default_queue_size(1),
+    m_read_ahead(0),
+    m_streams_read_ahead(0)
 {
     register_sensor_streams(m_sensor_description.get_stream_profiles());
     register_sensor_infos(m_sensor_description);
@@ -86,6 +88,8 @@ void playback_sensor::open(const stream_profiles& requests)
         }
     }
     std::vector<device_serializer::stream_identifier> opened_streams;
+    m_streams_read_ahead = m_read_ahead;
+    auto queue_size = std::max( _default_queue_size, m_streams_read_ahead );
     //For each stream, create a dedicated dispatching thread
     for (auto&& profile : requests)
     {
@@ -93,9 +97,10 @@ void playback_sensor::open(const stream_profiles& requests)
             LOG_DEBUG( "Dropping frame from dispatcher " << profile_to_string( profile ) );
         };
 
+        // A read-ahead queue is passed every frame of the stream: don't take a lock for it
         m_dispatchers.emplace( std::make_pair(
             profile->get_unique_id(),
-            std::make_shared< dispatcher >( _default_queue_size, on_drop_callback ) ) );
+            std::make_shared< dispatcher >( queue_size, on_drop_callback, queue_size > 1 ) ) );
 
         m_dispatchers[profile->get_unique_id()]->start();
 
@@ -222,6 +227,11 @@ void playback_sensor::flush_pending_frames()
     }
 }
 
+void playback_sensor::set_read_ahead(unsigned int frames)
+{
+    m_read_ahead = frames;
+}
+
 void playback_sensor::register_sensor_streams(const stream_profiles& profiles)
 {
     for (auto profile : profiles)
@@ -62,6 +62,9 @@ namespace librealsense
         void unregister_before_start_callback(int token) override;
         void raise_notification(const notification& n);
         bool streams_contains_one_frame_or_more();
+        // Frames each stream may queue ahead of the callbacks, when not playing in real time (0 to wait for each callback).
+        // Takes effect when the streams are next opened.
+        void set_read_ahead(unsigned int frames);
         virtual processing_blocks get_recommended_processing_blocks() const override
         {
             auto processing_blocks_snapshot = m_sensor_description.get_sensor_extensions_snapshots().find(RS2_EXTENSION_RECOMMENDED_FILTERS);
@@ -106,6 +109,8 @@ namespace librealsense
         stream_profiles m_active_streams;
         mutable std::mutex m_active_profile_mutex;
         const unsigned int _default_queue_size;
+        std::atomic<unsigned int> m_read_ahead;
+        unsigned int m_streams_read_ahead; // the read-ahead the open streams' dispatchers were made for
 
     public:
         //handle frame use 3 lambda functions that determines if and when a frame should be published.
@@ -164,7 +169,9 @@ namespace librealsense
                 // On non-real-time, we want the playback to run in synchronous mode:
                 // The playback will dispatch each frame and wait for it callback to finish before
                 // moving on to the next one.
-                if( ! is_real_time )
+                // With a read-ahead, the blocking invoke above already waits for room in the stream's
+                // queue, so reading runs that many frames ahead of the callbacks without dropping any.
+                if( ! is_real_time && m_streams_read_ahead == 0 )
                     m_dispatchers.at( stream_id )->flush();
             }
         }
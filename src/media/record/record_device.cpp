@@ -12,6 +12,8 @@ using namespace librealsense;
 librealsense::record_device::record_device(std::shared_ptr<librealsense::device_interface> device,
                                       std::shared_ptr<librealsense::device_serializer::writer> serializer):
     m_write_thread([](){return std::make_shared<dispatcher>(std::numeric_limits<unsigned int>::max());}),
+    m_queue(MAX_CACHED_DATA_SIZE, RS2_RECORD_DROP_POLICY_DROP_NEWEST),
+    m_write_scheduled(false),
     m_is_recording(true),
     m_record_total_pause_duration(0)
 {
@@ -65,6 +67,7 @@ librealsense::record_device::~record_device()
     {
         s->disable_recording();
     }
+    m_queue.stop();
     if ((*m_write_thread)->flush() == false)
     {
         LOG_ERROR("Error - timeout waiting for flush, possible deadlock detected");
@@ -138,24 +141,38 @@ void librealsense::record_device::write_data(size_t sensor_index, librealsense::
         initialize_recording();
     });
 
-    //TODO: restore: uint64_t data_size = frame.frame->get_frame_data_size();
-    uint64_t cached_data_size = m_cached_data_size; //TODO: restore: (+ data_size)
-    if (cached_data_size > MAX_CACHED_DATA_SIZE)
-    {
-        LOG_WARNING("Recorder reached maximum cache size, frame dropped");
-        on_error("Recorder reached maximum cache size, frame dropped");
+    if (!frame)
         return;
+
+    record_queue::item item;
+    item.frame = std::move(frame);
+    item.sensor_index = sensor_index;
+    item.capture_time = get_capture_time();
+    item.on_error = on_error;
+    if (!m_queue.push(std::move(item)))
+    {
+        return; //Counted, and logged once per stream, by the queue
     }
 
-    m_cached_data_size = cached_data_size;
-    auto capture_time = get_capture_time();
-    //TODO: remove usage of shared pointer when frame_holder is copyable
-    auto frame_holder_ptr = std::make_shared<frame_holder>();
-    *frame_holder_ptr = std::move(frame);
-    (*m_write_thread)->invoke([this, frame_holder_ptr, sensor_index, capture_time/*, data_size*/, on_error](dispatcher::cancellable_timer t) {
+    //A single write is scheduled at a time, and writes every queued frame, so the dispatcher holds no more than the
+    //queue does, whatever the drop policy
+    if (!m_write_scheduled.exchange(true))
+    {
+        (*m_write_thread)->invoke([this](dispatcher::cancellable_timer t) { write_queued_frames(); });
+    }
+}
+
+void librealsense::record_device::write_queued_frames()
+{
+    //Frames pushed from now on schedule another write, so none is left behind
+    m_write_scheduled = false;
+
+    record_queue::item item;
+    while (m_queue.pop(item))
+    {
         if (m_is_recording == false)
         {
-            return; //Recording is paused
+            continue; //Recording is paused
         }
         std::call_once(m_first_frame_flag, [&]()
         {
@@ -166,23 +183,23 @@ void librealsense::record_device::write_data(size_t sensor_index, librealsense::
             catch (const std::exception& e)
             {
                 LOG_ERROR("Failed to write header. " << e.what());
-                on_error( std::string( "Failed to write header. " ) + e.what() );
+                item.on_error( std::string( "Failed to write header. " ) + e.what() );
             }
         });
 
         try
         {
             const uint32_t device_index = 0;
-            auto stream_type = frame_holder_ptr->frame->get_stream()->get_stream_type();
-            auto stream_index = static_cast<uint32_t>(frame_holder_ptr->frame->get_stream()->get_stream_index());
-            m_ros_writer->write_frame({ device_index, static_cast<uint32_t>(sensor_index), stream_type, stream_index }, capture_time, std::move(*frame_holder_ptr));
-            //TODO: restore: std::lock_guard<std::mutex> locker(m_mutex);  m_cached_data_size -= data_size;
+            auto stream_type = item.frame->get_stream()->get_stream_type();
+            auto stream_index = static_cast<uint32_t>(item.frame->get_stream()->get_stream_index());
+            m_ros_writer->write_frame({ device_index, static_cast<uint32_t>(item.sensor_index), stream_type, stream_index }, item.capture_time, std::move(item.frame));
+            m_queue.on_written(item);
         }
         catch(std::exception& e)
         {
-            on_error( std::string( "Failed to write frame. " ) + e.what() );
+            item.on_error( std::string( "Failed to write frame. " ) + e.what() );
         }
-    });
+    }
 }
 
 const std::string& librealsense::record_device::get_info(rs2_camera_info info) const
@@ -446,11 +463,31 @@ void record_device::initialize_recording()
 {
     //Expected to be called once when recording to file actually starts
     m_capture_time_base = std::chrono::high_resolution_clock::now();
-    m_cached_data_size = 0;
     LOG_DEBUG( "Recording capture time base set to: " << m_capture_time_base.time_since_epoch().count() );
 
 }
 
+void record_device::set_queue_limit(uint64_t max_queued_bytes, rs2_record_drop_policy policy)
+{
+    LOG_INFO("Recorder queue limited to " << max_queued_bytes << " bytes, policy: " << get_string(policy));
+    m_queue.set_limit(max_queued_bytes, policy);
+}
+
+void record_device::set_stream_priority(rs2_stream stream, int priority)
+{
+    m_queue.set_stream_priority(stream, priority);
+}
+
+rs2_record_queue_stats record_device::get_queue_stats() const
+{
+    return m_queue.get_stats();
+}
+
+uint64_t record_device::get_dropped_frames(rs2_stream stream, int index) const
+{
+    return m_queue.get_dropped_frames(stream, index);
+}
+
 std::pair<uint32_t, rs2_extrinsics> record_device::get_extrinsics(const stream_interface& stream) const
 {
     return m_device->get_extrinsics(stream);
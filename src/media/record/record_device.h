@@ -9,9 +9,12 @@
 #include "archive.h"
 #include "sensor.h"
 #include "record_sensor.h"
+#include "record_queue.h"
 #include <rsutils/concurrency/concurrency.h>
 #include <rsutils/lazy.h>
 
+#include <atomic>
+
 
 namespace librealsense
 {
@@ -20,7 +23,7 @@ namespace librealsense
                           public info_container
     {
     public:
-        static const uint64_t MAX_CACHED_DATA_SIZE = 1920 * 1080 * 4 * 30; // ~1 sec of HD video @ 30 FPS
+        static const uint64_t MAX_CACHED_DATA_SIZE = 1920 * 1080 * 4 * 30; // ~1 sec of HD video @ 30 FPS, the default queue limit
 
         record_device(std::shared_ptr<device_interface> device, std::shared_ptr<device_serializer::writer> serializer);
         virtual ~record_device();
@@ -41,6 +44,10 @@ namespace librealsense
         void pause_recording();
         void resume_recording();
         const std::string& get_filename() const;
+        void set_queue_limit(uint64_t max_queued_bytes, rs2_record_drop_policy policy);
+        void set_stream_priority(rs2_stream stream, int priority);
+        rs2_record_queue_stats get_queue_stats() const;
+        uint64_t get_dropped_frames(rs2_stream stream, int index) const;
         std::shared_ptr< const device_info > get_device_info() const override;
         std::pair<uint32_t, rs2_extrinsics> get_extrinsics(const stream_interface& stream) const override;
         bool is_valid() const override;
@@ -57,6 +64,7 @@ namespace librealsense
         void write_header();
         std::chrono::nanoseconds get_capture_time() const;
         void write_data(size_t sensor_index, frame_holder f, std::function<void(std::string const&)> on_error);
+        void write_queued_frames();
         void write_sensor_extension_snapshot(size_t sensor_index, rs2_extension ext, std::shared_ptr<extension_snapshot> snapshot, std::function<void(std::string const&)> on_error);
         void write_notification(size_t sensor_index, const notification& n);
         std::vector<std::shared_ptr<record_sensor>> create_record_sensors(std::shared_ptr<device_interface> m_device);
@@ -66,6 +74,8 @@ namespace librealsense
         std::vector<std::shared_ptr<record_sensor>> m_sensors;
 
         rsutils::lazy< std::shared_ptr< dispatcher > > m_write_thread;
+        record_queue m_queue; // frames waiting for m_write_thread
+        std::atomic<bool> m_write_scheduled; // m_write_thread has write_queued_frames() to run
         std::shared_ptr<device_serializer::writer> m_ros_writer;
 
         std::chrono::high_resolution_clock::time_point m_capture_time_base;
@@ -75,7 +85,6 @@ namespace librealsense
         std::mutex m_mutex;
         bool m_is_recording;
         std::once_flag m_first_frame_flag;
-        uint64_t m_cached_data_size;
         std::once_flag m_first_call_flag;
         void initialize_recording();
     };
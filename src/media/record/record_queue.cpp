@@ -0,0 +1,172 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include "record_queue.h"
+#include <core/stream-profile-interface.h>
+#include <core/enum-helpers.h>
+
+#include <rsutils/easylogging/easyloggingpp.h>
+
+#include <algorithm>
+
+using namespace librealsense;
+
+record_queue::record_queue( uint64_t max_bytes, rs2_record_drop_policy policy )
+    : _max_bytes( max_bytes )
+    , _policy( policy )
+{
+}
+
+bool record_queue::push( item && x )
+{
+    x.size = static_cast< uint64_t >( x.frame->get_frame_data_size() );
+    auto profile = x.frame->get_stream();
+    x.stream = { profile->get_stream_type(), profile->get_stream_index() };
+    x.arrival = std::chrono::steady_clock::now();
+
+    std::unique_lock< std::mutex > lock( _mutex );
+    if( ! make_room( x, lock ) )
+    {
+        count_drop( x.stream );
+        return false;
+    }
+
+    _queued_bytes += x.size;
+    _peak_queued_bytes = std::max( _peak_queued_bytes, _queued_bytes );
+    _items.push_back( std::move( x ) );
+    return true;
+}
+
+bool record_queue::make_room( item const & arriving, std::unique_lock< std::mutex > & lock )
+{
+    auto fits = [&]()
+    {
+        return _items.empty() || _queued_bytes + arriving.size <= _max_bytes;
+    };
+
+    switch( _policy )
+    {
+    case RS2_RECORD_DROP_POLICY_BLOCK:
+        _room.wait( lock, [&]() { return _stopped || fits(); } );
+        return fits();
+
+    case RS2_RECORD_DROP_POLICY_DROP_OLDEST:
+        while( ! fits() )
+            drop( _items.begin() );
+        return true;
+
+    case RS2_RECORD_DROP_POLICY_DROP_LOWEST_PRIORITY:
+        while( ! fits() )
+        {
+            // The oldest frame of the lowest-priority stream, unless the arriving one is lower still
+            auto victim = _items.begin();
+            for( auto it = _items.begin(); it != _items.end(); ++it )
+                if( priority_of( it->stream.first ) < priority_of( victim->stream.first ) )
+                    victim = it;
+            if( priority_of( arriving.stream.first ) < priority_of( victim->stream.first ) )
+                return false;
+            drop( victim );
+        }
+        return true;
+
+    case RS2_RECORD_DROP_POLICY_DROP_NEWEST:
+    default:
+        return fits();
+    }
+}
+
+void record_queue::drop( std::deque< item >::iterator it )
+{
+    _queued_bytes -= it->size;
+    count_drop( it->stream );
+    _items.erase( it );
+}
+
+void record_queue::count_drop( std::pair< rs2_stream, int > const & stream )
+{
+    ++_dropped_frames;
+    // Once per stream, so a recording that cannot keep up is noticed without flooding the log
+    if( ++_dropped_per_stream[stream] == 1 )
+        LOG_WARNING( "Recorder queue is full (" << _max_bytes << " bytes, " << get_string( _policy ) << "): dropping "
+                                                << get_string( stream.first ) << " " << stream.second
+                                                << " frames; see rs2_record_device_get_dropped_frames" );
+}
+
+int record_queue::priority_of( rs2_stream stream ) const
+{
+    auto it = _priorities.find( stream );
+    return it == _priorities.end() ? 0 : it->second;
+}
+
+bool record_queue::pop( item & x )
+{
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        if( _items.empty() )
+            return false;
+
+        x = std::move( _items.front() );
+        _items.pop_front();
+        _queued_bytes -= x.size;
+    }
+    _room.notify_all();
+    return true;
+}
+
+void record_queue::on_written( item const & x )
+{
+    auto latency = std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::steady_clock::now() - x.arrival );
+
+    std::lock_guard< std::mutex > lock( _mutex );
+    ++_written_frames;
+    _total_latency += latency;
+    _max_latency = std::max( _max_latency, latency );
+}
+
+void record_queue::stop()
+{
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        _stopped = true;
+    }
+    _room.notify_all();
+}
+
+void record_queue::set_limit( uint64_t max_bytes, rs2_record_drop_policy policy )
+{
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        _max_bytes = max_bytes;
+        _policy = policy;
+    }
+    _room.notify_all();
+}
+
+void record_queue::set_stream_priority( rs2_stream stream, int priority )
+{
+    std::lock_guard< std::mutex > lock( _mutex );
+    _priorities[stream] = priority;
+}
+
+rs2_record_queue_stats record_queue::get_stats() const
+{
+    using ms = std::chrono::duration< double, std::milli >;
+
+    std::lock_guard< std::mutex > lock( _mutex );
+    rs2_record_queue_stats stats;
+    stats.queued_bytes = _queued_bytes;
+    stats.peak_queued_bytes = _peak_queued_bytes;
+    stats.queued_frames = _items.size();
+    stats.written_frames = _written_frames;
+    stats.dropped_frames = _dropped_frames;
+    stats.average_latency = _written_frames ? ms( _total_latency ).count() / _written_frames : 0.;
+    stats.max_latency = ms( _max_latency ).count();
+    return stats;
+}
+
+uint64_t record_queue::get_dropped_frames( rs2_stream stream, int index ) const
+{
+    std::lock_guard< std::mutex > lock( _mutex );
+    auto it = _dropped_per_stream.find( { stream, index } );
+    return it == _dropped_per_stream.end() ? 0 : it->second;
+}
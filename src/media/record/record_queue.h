@@ -0,0 +1,82 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+#pragma once
+
+#include <core/frame-holder.h>
+#include <librealsense2/h/rs_record_playback.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+
+
+namespace librealsense
+{
+    // Frames waiting for the recording thread, accounted in bytes.
+    //
+    // Frames come out in the order they went in. Once the queued bytes would pass the limit,
+    // the drop policy decides what gives: the arriving frame, the oldest queued ones, the oldest
+    // of the lowest-priority streams, or the sensor thread, which then waits for room. A frame
+    // is always let into an empty queue, however large, so a small limit never stalls recording.
+    class record_queue
+    {
+    public:
+        struct item
+        {
+            frame_holder frame;
+            size_t sensor_index = 0;
+            std::chrono::nanoseconds capture_time{ 0 };
+            std::function< void( std::string const & ) > on_error;
+
+            // Filled in by push()
+            uint64_t size = 0;
+            std::pair< rs2_stream, int > stream{ RS2_STREAM_ANY, 0 };
+            std::chrono::steady_clock::time_point arrival;
+        };
+
+        record_queue( uint64_t max_bytes, rs2_record_drop_policy policy );
+
+        // False when the arriving frame was the one dropped
+        bool push( item && );
+        // The oldest frame; false when there is none
+        bool pop( item & );
+        // Accounts for the latency of a popped frame once it is written
+        void on_written( item const & );
+        // Releases sensors waiting for room; from now on frames that do not fit are dropped
+        void stop();
+
+        void set_limit( uint64_t max_bytes, rs2_record_drop_policy policy );
+        void set_stream_priority( rs2_stream stream, int priority );
+
+        rs2_record_queue_stats get_stats() const;
+        uint64_t get_dropped_frames( rs2_stream stream, int index ) const;
+
+    private:
+        bool make_room( item const & arriving, std::unique_lock< std::mutex > & lock );
+        void drop( std::deque< item >::iterator it );
+        void count_drop( std::pair< rs2_stream, int > const & stream );
+        int priority_of( rs2_stream stream ) const;
+
+        mutable std::mutex _mutex;
+        std::condition_variable _room;
+        std::deque< item > _items;
+
+        uint64_t _max_bytes;
+        rs2_record_drop_policy _policy;
+        std::map< rs2_stream, int > _priorities;
+        bool _stopped = false;
+
+        uint64_t _queued_bytes = 0;
+        uint64_t _peak_queued_bytes = 0;
+        uint64_t _written_frames = 0;
+        uint64_t _dropped_frames = 0;
+        std::map< std::pair< rs2_stream, int >, uint64_t > _dropped_per_stream;
+        std::chrono::nanoseconds _total_latency{ 0 };
+        std::chrono::nanoseconds _max_latency{ 0 };
+    };
+}
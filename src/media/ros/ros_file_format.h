@@ -543,6 +543,22 @@ namespace librealsense
         }
     };
 
+    class FrameMetadataQuery : public MultipleRegexTopicQuery
+    {
+    public:
+        //The metadata of all frames, and the accel and twist recorded with each pose transform
+        FrameMetadataQuery()
+            : MultipleRegexTopicQuery( { rsutils::string::from()
+                                             << R"RRR(/device_\d+/sensor_\d+/.*_\d+/()RRR" << ros_topic::ros_image_type_str()
+                                             << "|" << ros_topic::ros_imu_type_str() << "|" << ros_topic::ros_pose_type_str()
+                                             << ")/metadata",
+                                         rsutils::string::from()
+                                             << R"RRR(/device_\d+/sensor_\d+/.*_\d+/)RRR" << ros_topic::ros_pose_type_str()
+                                             << "/(accel|twist)/data" } )
+        {
+        }
+    };
+
     class ExtrinsicsQuery : public RegexTopicQuery
     {
     public:
@@ -854,14 +870,29 @@ namespace librealsense
             }
         };
 
+        inline std::string frame_info_ext_topic( const device_serializer::stream_identifier & stream_id )
+        {
+            return rsutils::string::from()
+                << ( is_camera( stream_id.stream_type ) ? "/camera/" : "/imu/" )
+                << stream_type_to_string( { stream_id.stream_type, (int)stream_id.stream_index } )
+                << "/rs_frame_info_ext/" << stream_id.sensor_index;
+        }
+
         class FrameInfoExt : public RegexTopicQuery
         {
         public:
             FrameInfoExt( const device_serializer::stream_identifier & stream_id )
-                : RegexTopicQuery( rsutils::string::from()
-                                   << ( is_camera( stream_id.stream_type ) ? "/camera/" : "/imu/" )
-                                   << stream_type_to_string( { stream_id.stream_type, (int)stream_id.stream_index } )
-                                   << "/rs_frame_info_ext/" << stream_id.sensor_index )
+                : RegexTopicQuery( frame_info_ext_topic( stream_id ) )
+            {
+            }
+        };
+
+        class FrameInfoExtQuery : public RegexTopicQuery
+        {
+        public:
+            //The frame info of all streams
+            FrameInfoExtQuery()
+                : RegexTopicQuery( R"RRR(/(camera|imu)/.*/rs_frame_info_ext/\d+)RRR" )
             {
             }
         };
@@ -12,6 +12,7 @@
 #include <src/color-sensor.h>
 
 #include <rsutils/string/from.h>
+#include <algorithm>
 #include <cstring>
 
 
@@ -19,13 +20,58 @@ namespace librealsense
 {
     using namespace device_serializer;
 
+    frame_metadata_index::frame_metadata_index( const rosbag::Bag & file, std::function< bool( rosbag::ConnectionInfo const * ) > query )
+        : m_file( file )
+        , m_query( std::move( query ) )
+    {
+    }
+
+    std::vector< rosbag::MessageInstance > frame_metadata_index::at( const std::string & topic, const rs2rosinternal::Time & time )
+    {
+        if( ! m_view || time < m_time )
+        {
+            seek( time );
+        }
+        else if( time > m_time )
+        {
+            while( m_iterator != m_view->end() && ( *m_iterator ).getTime() < time )
+                ++m_iterator;
+            m_time = time;
+            read_current();
+        }
+
+        std::vector< rosbag::MessageInstance > result;
+        for( auto && msg : m_current )
+        {
+            if( msg.getTopic() == topic )
+                result.push_back( msg );
+        }
+        return result;
+    }
+
+    void frame_metadata_index::seek( const rs2rosinternal::Time & time )
+    {
+        m_view.reset( new rosbag::View( m_file, m_query, time ) );
+        m_iterator = m_view->begin();
+        m_time = time;
+        read_current();
+    }
+
+    void frame_metadata_index::read_current()
+    {
+        m_current.clear();
+        for( ; m_iterator != m_view->end() && ( *m_iterator ).getTime() == m_time; ++m_iterator )
+            m_current.push_back( *m_iterator );
+    }
+
     ros_reader::ros_reader(const std::string& file, const std::shared_ptr<context>& ctx) :
         m_metadata_parser_map(md_constant_parser::create_metadata_parser_map()),
         m_total_duration(0),
         m_file_path(file),
         m_context(ctx),
         m_version(0),
-        m_legacy_depth_units(0)
+        m_legacy_depth_units(0),
+        m_reserved_frames(0)
     {
         try
         {
@@ -117,30 +163,26 @@ namespace librealsense
     std::vector<std::shared_ptr<serialized_data>> ros_reader::fetch_last_frames(const nanoseconds& seek_time)
     {
         std::vector<std::shared_ptr<serialized_data>> result;
-        rosbag::View view(m_file, FalseQuery());
         auto as_rostime = to_rostime(seek_time);
         auto start_time = to_rostime(get_static_file_info_timestamp());
 
+        //Look up each stream's last frame in the topic index, rather than reading every message up to the seek time
+        std::vector<std::pair<rs2rosinternal::Time, std::string>> last_frames;
         for (auto topic : m_enabled_streams_topics)
         {
-            view.addQuery(m_file, rosbag::TopicQuery(topic), start_time, as_rostime);
-        }
-        std::map<device_serializer::stream_identifier, rs2rosinternal::Time> last_frames;
-        for (auto&& m : view)
-        {
-            if (m.isType<sensor_msgs::Image>() || m.isType<sensor_msgs::Imu>())
-            {
-                auto id = ros_topic::get_stream_identifier(m.getTopic());
-                last_frames[id] = m.getTime();
-            }
+            rs2rosinternal::Time last;
+            if (m_file.findLastMessageTime(topic, as_rostime, last) && last >= start_time)
+                last_frames.emplace_back(last, topic);
         }
-        for (auto&& kvp : last_frames)
+        //Create the frames in time order, so their metadata is read in a single pass
+        std::sort(last_frames.begin(), last_frames.end());
+        for (auto&& last_frame : last_frames)
         {
-            auto topic = ros_topic::frame_data_topic(kvp.first);
-            rosbag::View view(m_file, rosbag::TopicQuery(topic), kvp.second, kvp.second);
+            rosbag::View view(m_file, rosbag::TopicQuery(last_frame.second), last_frame.first, last_frame.first);
             auto msg = view.begin();
-            auto new_frame = create_frame(*msg);
-            result.push_back(new_frame);
+            if (msg == view.end() || !((*msg).isType<sensor_msgs::Image>() || (*msg).isType<sensor_msgs::Imu>()))
+                continue;
+            result.push_back(create_frame(*msg));
         }
         return result;
     }
@@ -153,9 +195,14 @@ namespace librealsense
     {
         m_file.close();
         m_file.open(m_file_path, rosbag::BagMode::Read);
+        m_file.setPrefetch(PREFETCH_CHUNKS);
         m_version = read_file_version(m_file);
         m_samples_view = nullptr;
-        m_frame_source = std::make_shared<frame_source>(m_version == 1 ? 128 : 32);
+        if (m_version == legacy_file_format::file_version())
+            m_frame_metadata.reset(new frame_metadata_index(m_file, legacy_file_format::FrameInfoExtQuery()));
+        else
+            m_frame_metadata.reset(new frame_metadata_index(m_file, FrameMetadataQuery()));
+        m_frame_source = std::make_shared<frame_source>(frame_pool_size());
         m_frame_source->init(m_metadata_parser_map);
         m_initial_device_description = read_device_description(get_static_file_info_timestamp(), true);
     }
@@ -244,6 +291,12 @@ namespace librealsense
         return m_file_path;
     }
 
+    void ros_reader::reserve_frames(uint32_t frames)
+    {
+        m_reserved_frames = frames;
+        m_frame_source->set_max_publish_list_size(frame_pool_size());
+    }
+
     std::shared_ptr<serialized_frame> ros_reader::create_frame(const rosbag::MessageInstance& msg)
     {
         auto next_msg_topic = msg.getTopic();
@@ -299,15 +352,12 @@ namespace librealsense
         return nanoseconds(streaming_duration.toNSec());
     }
 
-    void ros_reader::get_legacy_frame_metadata(const rosbag::Bag& bag,
-        const device_serializer::stream_identifier& stream_id,
-        const rosbag::MessageInstance &msg,
+    void ros_reader::get_legacy_frame_metadata(const std::vector<rosbag::MessageInstance>& frame_info_msgs,
         frame_additional_data& additional_data)
     {
         uint32_t total_md_size = 0;
-        rosbag::View frame_metadata_view(bag, legacy_file_format::FrameInfoExt(stream_id), msg.getTime(), msg.getTime());
-        assert(frame_metadata_view.size() <= 1);
-        for (auto message_instance : frame_metadata_view)
+        assert(frame_info_msgs.size() <= 1);
+        for (auto&& message_instance : frame_info_msgs)
         {
             auto info = instantiate_msg<realsense_legacy_msgs::frame_info>(message_instance);
             for (auto&& fmd : info->frame_metadata)
@@ -348,17 +398,13 @@ namespace librealsense
         }
     }
 
-    std::map<std::string, std::string> ros_reader::get_frame_metadata(const rosbag::Bag& bag,
-        const std::string& topic,
-        const device_serializer::stream_identifier& stream_id,
-        const rosbag::MessageInstance &msg,
+    std::map<std::string, std::string> ros_reader::get_frame_metadata(const std::vector<rosbag::MessageInstance>& metadata_msgs,
         frame_additional_data& additional_data)
     {
         uint32_t total_md_size = 0;
         std::map<std::string, std::string> remaining;
-        rosbag::View frame_metadata_view(bag, rosbag::TopicQuery(topic), msg.getTime(), msg.getTime());
 
-        for (auto message_instance : frame_metadata_view)
+        for (auto&& message_instance : metadata_msgs)
         {
             auto key_val_msg = instantiate_msg<diagnostic_msgs::KeyValue>(message_instance);
             if (key_val_msg->key == TIMESTAMP_DOMAIN_MD_STR)
@@ -424,14 +470,14 @@ namespace librealsense
         {
             //Version 1 legacy
             stream_id = legacy_file_format::get_stream_identifier(image_data.getTopic());
-            get_legacy_frame_metadata(m_file, stream_id, image_data, additional_data);
+            get_legacy_frame_metadata(m_frame_metadata->at(legacy_file_format::frame_info_ext_topic(stream_id), image_data.getTime()), additional_data);
         }
         else
         {
             //Version 2 and above
             stream_id = ros_topic::get_stream_identifier(image_data.getTopic());
             auto info_topic = ros_topic::frame_metadata_topic(stream_id);
-            get_frame_metadata(m_file, info_topic, stream_id, image_data, additional_data);
+            get_frame_metadata(m_frame_metadata->at(info_topic, image_data.getTime()), additional_data);
         }
 
         frame_interface * frame = m_frame_source->alloc_frame(
@@ -478,14 +524,14 @@ namespace librealsense
         {
             //Version 1 legacy
             stream_id = legacy_file_format::get_stream_identifier(motion_data.getTopic());
-            get_legacy_frame_metadata(m_file, stream_id, motion_data, additional_data);
+            get_legacy_frame_metadata(m_frame_metadata->at(legacy_file_format::frame_info_ext_topic(stream_id), motion_data.getTime()), additional_data);
         }
         else
         {
             //Version 2 and above
             stream_id = ros_topic::get_stream_identifier(motion_data.getTopic());
             auto info_topic = ros_topic::frame_metadata_topic(stream_id);
-            get_frame_metadata(m_file, info_topic, stream_id, motion_data, additional_data);
+            get_frame_metadata(m_frame_metadata->at(info_topic, motion_data.getTime()), additional_data);
         }
 
         frame_interface * frame = m_frame_source->alloc_frame(
@@ -582,15 +628,15 @@ namespace librealsense
             auto transform_msg = instantiate_msg<geometry_msgs::Transform>(msg);
 
             auto stream_id = ros_topic::get_stream_identifier(msg.getTopic());
-            std::string accel_topic = ros_topic::pose_accel_topic(stream_id);
-            rosbag::View accel_view(m_file, rosbag::TopicQuery(accel_topic), msg.getTime(), msg.getTime());
-            assert(accel_view.size() == 1);
-            auto accel_msg = instantiate_msg<geometry_msgs::Accel>(*accel_view.begin());
-
-            std::string twist_topic = ros_topic::pose_twist_topic(stream_id);
-            rosbag::View twist_view(m_file, rosbag::TopicQuery(twist_topic), msg.getTime(), msg.getTime());
-            assert(twist_view.size() == 1);
-            auto twist_msg = instantiate_msg<geometry_msgs::Twist>(*twist_view.begin());
+            auto accel_msgs = m_frame_metadata->at(ros_topic::pose_accel_topic(stream_id), msg.getTime());
+            auto twist_msgs = m_frame_metadata->at(ros_topic::pose_twist_topic(stream_id), msg.getTime());
+            if (accel_msgs.empty() || twist_msgs.empty())
+            {
+                throw io_exception( rsutils::string::from() << "Missing pose accel or twist at " << msg.getTime().toNSec() << "ns (Topic: " << msg.getTopic() << ")" );
+            }
+            assert(accel_msgs.size() == 1 && twist_msgs.size() == 1);
+            auto accel_msg = instantiate_msg<geometry_msgs::Accel>(accel_msgs.front());
+            auto twist_msg = instantiate_msg<geometry_msgs::Twist>(twist_msgs.front());
 
             pose.rotation = to_float4(transform_msg->rotation);
             pose.translation = to_float3(transform_msg->translation);
@@ -605,14 +651,14 @@ namespace librealsense
         {
             //Version 1 legacy
             stream_id = legacy_file_format::get_stream_identifier(msg.getTopic());
-            get_legacy_frame_metadata(m_file, stream_id, msg, additional_data);
+            get_legacy_frame_metadata(m_frame_metadata->at(legacy_file_format::frame_info_ext_topic(stream_id), msg.getTime()), additional_data);
         }
         else
         {
             //Version 2 and above
             stream_id = ros_topic::get_stream_identifier(msg.getTopic());
             auto info_topic = ros_topic::frame_metadata_topic(stream_id);
-            auto remaining = get_frame_metadata(m_file, info_topic, stream_id, msg, additional_data);
+            auto remaining = get_frame_metadata(m_frame_metadata->at(info_topic, msg.getTime()), additional_data);
             for (auto&& kvp : remaining)
             {
                 if (kvp.first == MAPPER_CONFIDENCE_MD_STR)
@@ -21,6 +21,31 @@ namespace librealsense
     class processing_block_interface;
     class recommended_proccesing_blocks_snapshot;
 
+    // The messages recorded alongside frames (their metadata, and the accel and twist of poses), by topic and time.
+    //
+    // Frames are read in time order, so rather than querying the bag for each frame, a single time-ordered view of all
+    // these messages is opened with the file and walked forward together with the frames, holding only the messages of
+    // the current time. Asking for an earlier time (e.g., after seeking back) reopens the view at that time.
+    class frame_metadata_index
+    {
+    public:
+        frame_metadata_index( const rosbag::Bag & file, std::function< bool( rosbag::ConnectionInfo const * ) > query );
+
+        // The messages of the topic at exactly the given time
+        std::vector< rosbag::MessageInstance > at( const std::string & topic, const rs2rosinternal::Time & time );
+
+    private:
+        void seek( const rs2rosinternal::Time & time );
+        void read_current();
+
+        const rosbag::Bag & m_file;
+        std::function< bool( rosbag::ConnectionInfo const * ) > m_query;
+        std::unique_ptr< rosbag::View > m_view;
+        rosbag::View::iterator m_iterator;
+        rs2rosinternal::Time m_time;
+        std::vector< rosbag::MessageInstance > m_current;  // the messages at m_time
+    };
+
     class ros_reader: public device_serializer::reader
     {
     public:
@@ -34,8 +59,12 @@ namespace librealsense
         virtual void enable_stream(const std::vector<device_serializer::stream_identifier>& stream_ids) override;
         virtual void disable_stream(const std::vector<device_serializer::stream_identifier>& stream_ids) override;
         const std::string& get_file_name() const override;
+        void reserve_frames(uint32_t frames) override;
 
     private:
+        static const uint32_t PREFETCH_CHUNKS = 4; // chunks decompressed ahead of playback
+
+        uint32_t frame_pool_size() const { return (m_version == 1 ? 128 : 32) + m_reserved_frames; }
 
         template <typename ROS_TYPE>
         static typename ROS_TYPE::ConstPtr instantiate_msg(const rosbag::MessageInstance& msg)
@@ -53,9 +82,7 @@ namespace librealsense
 
         std::shared_ptr<serialized_frame> create_frame(const rosbag::MessageInstance& msg);
         static nanoseconds get_file_duration(const rosbag::Bag& file, uint32_t version);
-        static void get_legacy_frame_metadata(const rosbag::Bag& bag,
-            const device_serializer::stream_identifier& stream_id,
-            const rosbag::MessageInstance &msg,
+        static void get_legacy_frame_metadata(const std::vector<rosbag::MessageInstance>& frame_info_msgs,
             frame_additional_data& additional_data);
 
         template <typename T>
@@ -73,10 +100,7 @@ namespace librealsense
             return ret;
         }
 
-        static std::map<std::string, std::string> get_frame_metadata(const rosbag::Bag& bag,
-            const std::string& topic,
-            const device_serializer::stream_identifier& stream_id,
-            const rosbag::MessageInstance &msg,
+        static std::map<std::string, std::string> get_frame_metadata(const std::vector<rosbag::MessageInstance>& metadata_msgs,
             frame_additional_data& additional_data);
         frame_holder create_image_from_message(const rosbag::MessageInstance &image_data) const;
         frame_holder create_motion_sample(const rosbag::MessageInstance &motion_data) const;
@@ -133,9 +157,11 @@ namespace librealsense
         rosbag::Bag                             m_file;
         std::unique_ptr<rosbag::View>           m_samples_view;
         rosbag::View::iterator                  m_samples_itrator;
+        std::unique_ptr<frame_metadata_index>   m_frame_metadata;
         std::vector<std::string>                m_enabled_streams_topics;
         std::shared_ptr<context>                m_context;
         uint32_t                                m_version;
         float                                   m_legacy_depth_units;
+        uint32_t                                m_reserved_frames;
     };
 }
@@ -17,21 +17,43 @@
 
 #include <rsutils/string/from.h>
 
+#include <algorithm>
+#include <thread>
+
 namespace librealsense
 {
     using namespace device_serializer;
 
-    ros_writer::ros_writer(const std::string& file, bool compress_while_record) : m_file_path(file)
+    ros_writer::ros_writer(const std::string& file, bool compress_while_record, int compression_level, uint32_t compression_threads)
+        : m_file_path(file)
     {
         LOG_INFO("Compression while record is set to " << (compress_while_record ? "ON" : "OFF"));
         m_bag.open(file, rosbag::BagMode::Write);
         if (compress_while_record)
         {
-            m_bag.setCompression(rosbag::CompressionType::LZ4);
+            // Compress closed chunks off the writing thread, leaving a core for the device
+            if (compression_threads == 0)
+                compression_threads = std::max(1u, std::min(4u, std::thread::hardware_concurrency() - 1));
+            LOG_DEBUG("Compressing recorded chunks on " << compression_threads << " threads, level " << compression_level);
+            m_bag.setParallelCompression(compression_threads, compression_level);
         }
         write_file_version();
     }
 
+    ros_writer::~ros_writer()
+    {
+        // Closing writes whatever chunks are still queued, then the index: a full disk shows up
+        // here, at the end of the recording, and the file is left without an index
+        try
+        {
+            m_bag.close();
+        }
+        catch (std::exception const& e)
+        {
+            LOG_ERROR("Failed to finish recording \"" << m_file_path << "\": " << e.what());
+        }
+    }
+
     void ros_writer::write_device_description(const librealsense::device_snapshot& device_description)
     {
         for (auto&& device_extension_snapshot : device_description.get_device_extensions_snapshots().get_snapshots())
@@ -175,7 +197,8 @@ namespace librealsense
 
     void ros_writer::write_video_frame(const stream_identifier& stream_id, const nanoseconds& timestamp, frame_holder&& frame)
     {
-        sensor_msgs::Image image;
+        image_view_msg view;
+        auto & image = view.image;
         auto vid_frame = dynamic_cast<librealsense::video_frame*>(frame.frame);
         if (!vid_frame)
             throw std::runtime_error("Frame is not video frame");
@@ -185,9 +208,8 @@ namespace librealsense
         image.step = static_cast<uint32_t>(vid_frame->get_stride());
         convert(vid_frame->get_stream()->get_format(), image.encoding);
         image.is_bigendian = is_big_endian();
-        auto size = vid_frame->get_stride() * vid_frame->get_height();
-        auto p_data = vid_frame->get_frame_data();
-        image.data.assign(p_data, p_data + size);
+        view.data = vid_frame->get_frame_data();
+        view.size = static_cast<uint32_t>(vid_frame->get_stride() * vid_frame->get_height());
         image.header.seq = static_cast<uint32_t>(vid_frame->get_frame_number());
         std::chrono::duration<double, std::milli> timestamp_ms(vid_frame->get_frame_timestamp());
         image.header.stamp = rs2rosinternal::Time(std::chrono::duration<double>(timestamp_ms).count());
@@ -196,8 +218,9 @@ namespace librealsense
         if(df)
             image.depth_units = df->get_units();
         auto image_topic = ros_topic::frame_data_topic(stream_id);
-        write_message(image_topic, timestamp, image);
+        write_message(image_topic, timestamp, view);
         write_additional_frame_messages(stream_id, timestamp, frame);
+        frame.reset();  // the data is in the chunk: release the frame back to its source now
     }
 
     void ros_writer::write_motion_frame(const stream_identifier& stream_id, const nanoseconds& timestamp, frame_holder&& frame)
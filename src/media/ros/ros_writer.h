@@ -7,17 +7,94 @@
 
 #include <rsutils/string/from.h>
 
+#include <cstring>
+
+
+namespace librealsense
+{
+    // A sensor_msgs::Image whose data stays in the frame: it serializes to the same bytes as the image would, copying
+    // the frame data straight into the bag chunk instead of into the message first
+    struct image_view_msg
+    {
+        sensor_msgs::Image image;  // all but the data, which is left empty
+        const uint8_t * data;
+        uint32_t size;
+    };
+}
+
+namespace rs2rosinternal
+{
+    namespace message_traits
+    {
+        template<> struct IsMessage< librealsense::image_view_msg > : std::true_type {};
+        template<> struct IsFixedSize< librealsense::image_view_msg > : std::false_type {};
+        template<> struct HasHeader< librealsense::image_view_msg > : std::true_type {};
+
+        template<> struct MD5Sum< librealsense::image_view_msg >
+        {
+            static const char * value() { return MD5Sum< sensor_msgs::Image >::value(); }
+            static const char * value( const librealsense::image_view_msg & ) { return value(); }
+        };
+
+        template<> struct DataType< librealsense::image_view_msg >
+        {
+            static const char * value() { return DataType< sensor_msgs::Image >::value(); }
+            static const char * value( const librealsense::image_view_msg & ) { return value(); }
+        };
+
+        template<> struct Definition< librealsense::image_view_msg >
+        {
+            static const char * value() { return Definition< sensor_msgs::Image >::value(); }
+            static const char * value( const librealsense::image_view_msg & ) { return value(); }
+        };
+    }
+
+    namespace serialization
+    {
+        // Same layout as Serializer< sensor_msgs::Image >, with the data taken from the view
+        template<> struct Serializer< librealsense::image_view_msg >
+        {
+            template< typename Stream >
+            inline static void write( Stream & stream, const librealsense::image_view_msg & m )
+            {
+                stream.next( m.image.header );
+                stream.next( m.image.height );
+                stream.next( m.image.width );
+                stream.next( m.image.encoding );
+                stream.next( m.image.is_bigendian );
+                stream.next( m.image.step );
+                stream.next( m.size );
+                if( m.size )
+                    memcpy( stream.advance( m.size ), m.data, m.size );
+                if( ! m.image.header.version.compare( "1" ) )
+                    stream.next( m.image.depth_units );
+            }
+
+            inline static uint32_t serializedLength( const librealsense::image_view_msg & m )
+            {
+                // The empty image already accounts for the data length
+                return serializationLength( m.image ) + m.size;
+            }
+        };
+    }
+}
+
 
 namespace librealsense
 {
     using namespace device_serializer;
 
+    class info_interface;
+    class options_interface;
     class recommended_proccesing_blocks_interface;
 
     class ros_writer: public writer
     {
     public:
-        explicit ros_writer(const std::string& file, bool compress_while_record);
+        // With compression, chunks are LZ4-compressed (LZ4-HC when compression_level > 0) on
+        // compression_threads background threads, 0 picking a number from the available cores
+        explicit ros_writer(const std::string& file, bool compress_while_record, int compression_level = 0, uint32_t compression_threads = 0);
+        ~ros_writer() override;
         void write_device_description(const librealsense::device_snapshot& device_description) override;
         void write_frame(const stream_identifier& stream_id, const nanoseconds& timestamp, frame_holder&& frame) override;
         void write_snapshot(uint32_t device_index, const nanoseconds& timestamp, rs2_extension type, const std::shared_ptr<extension_snapshot>& snapshot) override;
@@ -7,12 +7,24 @@
 
 #include <cstddef>  // size_t
 #include <cstdint>  // uint8_t
+#include <memory>
 
 
 namespace librealsense {
 namespace platform {
 
 
+// Pixels that can be exported as a DMABUF, on demand, to share them with other devices or processes
+class dmabuf_exporter
+{
+public:
+    virtual ~dmabuf_exporter() = default;
+
+    // Returns a DMABUF file descriptor for the pixels, owned by the exporter, or -1 if they cannot be exported
+    virtual int export_dmabuf() = 0;
+};
+
+
 struct frame_object
 {
     size_t frame_size;
@@ -20,6 +32,8 @@ struct frame_object
     const void * pixels;
     const void * metadata;
     rs2_time_t backend_time;
+    bool retainable = false;  // pixels remain valid until the continuation is called, and may be used in-place
+    std::shared_ptr< dmabuf_exporter > dmabuf;  // for retainable pixels that can be exported
 };
 
 
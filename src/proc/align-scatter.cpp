@@ -0,0 +1,68 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include "align-scatter.h"
+
+#include <algorithm>
+#include <vector>
+
+
+namespace librealsense
+{
+    void scatter_min_depth( parallel_pool & pool, depth_pixel_map const & map, uint16_t * dest, int dest_width, int dest_height )
+    {
+        // The target rows that each depth row reaches, as [x, y]; on a single thread, there is a single band
+        std::vector< int2 > row_span( map.height, int2{ 0, dest_height - 1 } );
+        if( pool.concurrency() > 1 )
+        {
+            pool.parallel_for( map.height, 16, [&]( size_t begin, size_t end )
+            {
+                for( size_t y = begin; y < end; ++y )
+                {
+                    int first = dest_height, last = -1;
+                    auto i = y * map.width;
+                    for( int x = 0; x < map.width; ++x, ++i )
+                    {
+                        // Without branches, as depth holes are hard to predict
+                        bool valid = ( map.z_pixels[i] != 0 ) & ( map.top_left[i].x <= map.bottom_right[i].x )
+                                   & ( map.top_left[i].y <= map.bottom_right[i].y );
+                        first = std::min( first, valid ? map.top_left[i].y : first );
+                        last = std::max( last, valid ? map.bottom_right[i].y : last );
+                    }
+                    row_span[y] = { std::max( first, 0 ), std::min( last, dest_height - 1 ) };
+                }
+            } );
+        }
+
+        pool.parallel_for( dest_height, 16, [&]( size_t begin, size_t end )
+        {
+            const int band_first = int( begin );
+            const int band_last = int( end ) - 1;
+            for( int y = 0; y < map.height; ++y )
+            {
+                if( row_span[y].y < band_first || row_span[y].x > band_last )
+                    continue;
+
+                auto i = size_t( y ) * map.width;
+                for( int x = 0; x < map.width; ++x, ++i )
+                {
+                    const uint16_t z = map.z_pixels[i];
+                    if( ! z )
+                        continue;
+
+                    // Only the part of the rectangle that is in this band (and in the image)
+                    const int x0 = std::max( map.top_left[i].x, 0 );
+                    const int x1 = std::min( map.bottom_right[i].x, dest_width - 1 );
+                    const int y0 = std::max( map.top_left[i].y, band_first );
+                    const int y1 = std::min( map.bottom_right[i].y, band_last );
+                    for( int other_y = y0; other_y <= y1; ++other_y )
+                    {
+                        auto out = dest + size_t( other_y ) * dest_width;
+                        for( int other_x = x0; other_x <= x1; ++other_x )
+                            out[other_x] = out[other_x] ? std::min( out[other_x], z ) : z;
+                    }
+                }
+            }
+        } );
+    }
+}
@@ -0,0 +1,29 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "types.h"
+#include "parallel-pool.h"
+
+
+namespace librealsense
+{
+    // The pixels of a depth image, mapped to rectangles [top_left, bottom_right] of pixels in another image (empty where
+    // bottom_right is above or left of top_left); the rectangles may extend beyond the other image.
+    struct depth_pixel_map
+    {
+        const uint16_t * z_pixels;
+        int width, height;
+        const int2 * top_left;
+        const int2 * bottom_right;
+    };
+
+    // Write the depth of each valid (non-zero) depth pixel into the rectangle it is mapped to, keeping the nearest depth
+    // where rectangles overlap; pixels nothing is mapped to are left untouched (zero, usually).
+    //
+    // The target image is split into horizontal bands that are each written by a single task, and each band visits only
+    // the depth rows that reach it, so the writes are race-free. And since the nearest depth does not depend on the
+    // order of the writes, the result is the same as a serial pass.
+    void scatter_min_depth( parallel_pool & pool, depth_pixel_map const & map, uint16_t * dest, int dest_width, int dest_height );
+}
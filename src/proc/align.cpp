@@ -9,6 +9,7 @@
 #include "proc/synthetic-stream.h"
 #include "environment.h"
 #include "align.h"
+#include "align-scatter.h"
 #include "stream.h"
 
 #if defined(RS2_USE_CUDA)
@@ -32,13 +33,37 @@ namespace librealsense
         #endif
     }
 
+    // Map a depth pixel to the rectangle of pixels it covers in the other image; false if it is not all inside it
+    static bool map_depth_pixel(const rs2_intrinsics& depth_intrin, const rs2_extrinsics& depth_to_other,
+        const rs2_intrinsics& other_intrin, int depth_x, int depth_y, float depth, int2& top_left, int2& bottom_right)
+    {
+        // Map the top-left corner of the depth pixel onto the other image
+        float depth_pixel[2] = { depth_x - 0.5f, depth_y - 0.5f }, depth_point[3], other_point[3], other_pixel[2];
+        rs2_deproject_pixel_to_point(depth_point, &depth_intrin, depth_pixel, depth);
+        rs2_transform_point_to_point(other_point, &depth_to_other, depth_point);
+        rs2_project_point_to_pixel(other_pixel, &other_intrin, other_point);
+        top_left.x = static_cast<int>(other_pixel[0] + 0.5f);
+        top_left.y = static_cast<int>(other_pixel[1] + 0.5f);
+
+        // Map the bottom-right corner of the depth pixel onto the other image
+        depth_pixel[0] = depth_x + 0.5f; depth_pixel[1] = depth_y + 0.5f;
+        rs2_deproject_pixel_to_point(depth_point, &depth_intrin, depth_pixel, depth);
+        rs2_transform_point_to_point(other_point, &depth_to_other, depth_point);
+        rs2_project_point_to_pixel(other_pixel, &other_intrin, other_point);
+        bottom_right.x = static_cast<int>(other_pixel[0] + 0.5f);
+        bottom_right.y = static_cast<int>(other_pixel[1] + 0.5f);
+
+        return top_left.x >= 0 && top_left.y >= 0 && bottom_right.x < other_intrin.width && bottom_right.y < other_intrin.height;
+    }
+
+    // Transfer pixels between the depth rows [first_row, last_row) and the other image; the transfer may only write to
+    // the depth pixel, as several bands of rows are aligned in parallel
     template<class GET_DEPTH, class TRANSFER_PIXEL>
     void align_images(const rs2_intrinsics& depth_intrin, const rs2_extrinsics& depth_to_other,
-        const rs2_intrinsics& other_intrin, GET_DEPTH get_depth, TRANSFER_PIXEL transfer_pixel)
+        const rs2_intrinsics& other_intrin, int first_row, int last_row, GET_DEPTH get_depth, TRANSFER_PIXEL transfer_pixel)
     {
         // Iterate over the pixels of the depth image
-#pragma omp parallel for schedule(dynamic)
-        for (int depth_y = 0; depth_y < depth_intrin.height; ++depth_y)
+        for (int depth_y = first_row; depth_y < last_row; ++depth_y)
         {
             int depth_pixel_index = depth_y * depth_intrin.width;
             for (int depth_x = 0; depth_x < depth_intrin.width; ++depth_x, ++depth_pixel_index)
@@ -46,29 +71,14 @@ namespace librealsense
                 // Skip over depth pixels with the value of zero, we have no depth data so we will not write anything into our aligned images
                 if (float depth = get_depth(depth_pixel_index))
                 {
-                    // Map the top-left corner of the depth pixel onto the other image
-                    float depth_pixel[2] = { depth_x - 0.5f, depth_y - 0.5f }, depth_point[3], other_point[3], other_pixel[2];
-                    rs2_deproject_pixel_to_point(depth_point, &depth_intrin, depth_pixel, depth);
-                    rs2_transform_point_to_point(other_point, &depth_to_other, depth_point);
-                    rs2_project_point_to_pixel(other_pixel, &other_intrin, other_point);
-                    const int other_x0 = static_cast<int>(other_pixel[0] + 0.5f);
-                    const int other_y0 = static_cast<int>(other_pixel[1] + 0.5f);
-
-                    // Map the bottom-right corner of the depth pixel onto the other image
-                    depth_pixel[0] = depth_x + 0.5f; depth_pixel[1] = depth_y + 0.5f;
-                    rs2_deproject_pixel_to_point(depth_point, &depth_intrin, depth_pixel, depth);
-                    rs2_transform_point_to_point(other_point, &depth_to_other, depth_point);
-                    rs2_project_point_to_pixel(other_pixel, &other_intrin, other_point);
-                    const int other_x1 = static_cast<int>(other_pixel[0] + 0.5f);
-                    const int other_y1 = static_cast<int>(other_pixel[1] + 0.5f);
-
-                    if (other_x0 < 0 || other_y0 < 0 || other_x1 >= other_intrin.width || other_y1 >= other_intrin.height)
+                    int2 top_left, bottom_right;
+                    if (!map_depth_pixel(depth_intrin, depth_to_other, other_intrin, depth_x, depth_y, depth, top_left, bottom_right))
                         continue;
 
                     // Transfer between the depth pixels and the pixels inside the rectangle on the other image
-                    for (int y = other_y0; y <= other_y1; ++y)
+                    for (int y = top_left.y; y <= bottom_right.y; ++y)
                     {
-                        for (int x = other_x0; x <= other_x1; ++x)
+                        for (int x = top_left.x; x <= bottom_right.x; ++x)
                         {
                             transfer_pixel(depth_pixel_index, y * other_intrin.width + x);
                         }
@@ -97,44 +107,60 @@ namespace librealsense
         auto z_pixels = reinterpret_cast<const uint16_t*>(depth.get_data());
         auto out_z = (uint16_t *)(aligned_data);
 
-        align_images(z_intrin, z_to_other, other_intrin,
-            [z_pixels, z_scale](int z_pixel_index) { return z_scale * z_pixels[z_pixel_index]; },
-            [out_z, z_pixels](int z_pixel_index, int other_pixel_index)
+        // Several depth pixels may map to the same pixel: map them all first, then write the nearest of them
+        _pixel_top_left.resize(z_intrin.width * z_intrin.height);
+        _pixel_bottom_right.resize(z_intrin.width * z_intrin.height);
+        auto top_left = _pixel_top_left.data();
+        auto bottom_right = _pixel_bottom_right.data();
+        _pool->parallel_for(z_intrin.height, 16, [&](size_t begin, size_t end)
         {
-            out_z[other_pixel_index] = out_z[other_pixel_index] ?
-                std::min((int)out_z[other_pixel_index], (int)z_pixels[z_pixel_index]) :
-                z_pixels[z_pixel_index];
+            for (int y = int(begin); y < int(end); ++y)
+            {
+                for (int x = 0, i = y * z_intrin.width; x < z_intrin.width; ++x, ++i)
+                {
+                    if (!z_pixels[i] || !map_depth_pixel(z_intrin, z_to_other, other_intrin, x, y, z_scale * z_pixels[i], top_left[i], bottom_right[i]))
+                    {
+                        top_left[i] = { 0, 0 };
+                        bottom_right[i] = { -1, -1 };
+                    }
+                }
+            }
         });
+        scatter_min_depth(*_pool, { z_pixels, z_intrin.width, z_intrin.height, top_left, bottom_right },
+            out_z, other_intrin.width, other_intrin.height);
     }
 
     template<int N, class GET_DEPTH>
-    void align_other_to_depth_bytes( uint8_t * other_aligned_to_depth, GET_DEPTH get_depth, const rs2_intrinsics& depth_intrin, const rs2_extrinsics& depth_to_other, const rs2_intrinsics& other_intrin, const uint8_t * other_pixels)
+    void align_other_to_depth_bytes( parallel_pool& pool, uint8_t * other_aligned_to_depth, GET_DEPTH get_depth, const rs2_intrinsics& depth_intrin, const rs2_extrinsics& depth_to_other, const rs2_intrinsics& other_intrin, const uint8_t * other_pixels)
     {
         auto in_other = (const bytes<N> *)(other_pixels);
         auto out_other = (bytes<N> *)(other_aligned_to_depth);
-        align_images(depth_intrin, depth_to_other, other_intrin, get_depth,
-            [out_other, in_other](int depth_pixel_index, int other_pixel_index) { out_other[depth_pixel_index] = in_other[other_pixel_index]; });
+        pool.parallel_for(depth_intrin.height, 16, [&](size_t begin, size_t end)
+        {
+            align_images(depth_intrin, depth_to_other, other_intrin, int(begin), int(end), get_depth,
+                [out_other, in_other](int depth_pixel_index, int other_pixel_index) { out_other[depth_pixel_index] = in_other[other_pixel_index]; });
+        });
     }
 
     template<class GET_DEPTH>
-    void align_other_to_depth( uint8_t * other_aligned_to_depth, GET_DEPTH get_depth, const rs2_intrinsics& depth_intrin, const rs2_extrinsics & depth_to_other, const rs2_intrinsics& other_intrin, const uint8_t * other_pixels, rs2_format other_format)
+    void align_other_to_depth( parallel_pool& pool, uint8_t * other_aligned_to_depth, GET_DEPTH get_depth, const rs2_intrinsics& depth_intrin, const rs2_extrinsics & depth_to_other, const rs2_intrinsics& other_intrin, const uint8_t * other_pixels, rs2_format other_format)
     {
         switch (other_format)
         {
         case RS2_FORMAT_Y8:
-            align_other_to_depth_bytes<1>(other_aligned_to_depth, get_depth, depth_intrin, depth_to_other, other_intrin, other_pixels);
+            align_other_to_depth_bytes<1>(pool, other_aligned_to_depth, get_depth, depth_intrin, depth_to_other, other_intrin, other_pixels);
             break;
         case RS2_FORMAT_Y16:
         case RS2_FORMAT_Z16:
-            align_other_to_depth_bytes<2>(other_aligned_to_depth, get_depth, depth_intrin, depth_to_other, other_intrin, other_pixels);
+            align_other_to_depth_bytes<2>(pool, other_aligned_to_depth, get_depth, depth_intrin, depth_to_other, other_intrin, other_pixels);
             break;
         case RS2_FORMAT_RGB8:
         case RS2_FORMAT_BGR8:
-            align_other_to_depth_bytes<3>(other_aligned_to_depth, get_depth, depth_intrin, depth_to_other, other_intrin, other_pixels);
+            align_other_to_depth_bytes<3>(pool, other_aligned_to_depth, get_depth, depth_intrin, depth_to_other, other_intrin, other_pixels);
             break;
         case RS2_FORMAT_RGBA8:
         case RS2_FORMAT_BGRA8:
-            align_other_to_depth_bytes<4>(other_aligned_to_depth, get_depth, depth_intrin, depth_to_other, other_intrin, other_pixels);
+            align_other_to_depth_bytes<4>(pool, other_aligned_to_depth, get_depth, depth_intrin, depth_to_other, other_intrin, other_pixels);
             break;
         default:
             assert(false); // NOTE: rs2_align_other_to_depth_bytes<2>(...) is not appropriate for RS2_FORMAT_YUYV/RS2_FORMAT_RAW10 images, no logic prevents U/V channels from being written to one another
@@ -157,7 +183,7 @@ namespace librealsense
         auto z_pixels = reinterpret_cast<const uint16_t*>(depth.get_data());
         auto other_pixels = reinterpret_cast<const uint8_t *>(other.get_data());
 
-        align_other_to_depth(aligned_data, [z_pixels, z_scale](int z_pixel_index) { return z_scale * z_pixels[z_pixel_index]; },
+        align_other_to_depth(*_pool, aligned_data, [z_pixels, z_scale](int z_pixel_index) { return z_scale * z_pixels[z_pixel_index]; },
             z_intrin, z_to_other, other_intrin, other_pixels, other_profile.format());
     }
 
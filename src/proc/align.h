@@ -3,6 +3,7 @@
 #pragma once
 
 #include "synthetic-stream.h"
+#include "parallel-pool.h"
 
 #include <src/basics.h>
 #include <map>
@@ -20,7 +21,8 @@ namespace librealsense
     protected:
         align(rs2_stream to_stream, const char* name)
             : generic_processing_block(name),
-              _to_stream_type(to_stream), _depth_scale(0)
+              _to_stream_type(to_stream), _depth_scale(0),
+              _pool(parallel_pool::get())
         {}
 
         bool should_process(const rs2::frame& frame) override;
@@ -48,9 +50,12 @@ namespace librealsense
         std::map<std::pair<stream_profile_interface*, stream_profile_interface*>, std::shared_ptr<rs2::video_stream_profile>> _align_stream_unique_ids;
         rs2::stream_profile _source_stream_profile;
         float _depth_scale;
+        std::shared_ptr<parallel_pool> _pool;  // the images are aligned in bands of rows
 
     private:
         rs2::video_frame allocate_aligned_frame(const rs2::frame_source& source, const rs2::video_frame& from, const rs2::video_frame& to);
         void align_frames(rs2::video_frame& aligned, const rs2::video_frame& from, const rs2::video_frame& to);
+
+        std::vector<int2> _pixel_top_left, _pixel_bottom_right;  // depth pixels mapped to the other image
     };
 }
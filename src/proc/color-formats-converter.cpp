@@ -7,9 +7,7 @@
 #include "image-avx.h"
 #include "image.h"
 
-#define STB_IMAGE_STATIC
-#define STB_IMAGE_IMPLEMENTATION
-#include "../third-party/stb_image.h"
+#include <rsutils/string/from.h>
 
 #ifdef RS2_USE_CUDA
 #include "cuda/cuda-conversion.cuh"
@@ -1071,17 +1069,11 @@ namespace librealsense
     /////////////////////////////
     // MJPEG unpacking routines //
     /////////////////////////////
-    void unpack_mjpeg( uint8_t * const dest[], const uint8_t * source, int width, int height, int actual_size, int input_size)
+    void unpack_mjpeg( jpeg_decoder & decoder, rs2_format dst_format, int scale, uint8_t * const dest[], const uint8_t * source, int width, int height, int source_size, int input_size)
     {
-        int w, h, bpp;
-        auto uncompressed_rgb = stbi_load_from_memory(source, actual_size, &w, &h, &bpp, false);
-        if (uncompressed_rgb)
-        {
-            auto uncompressed_size = w * h * bpp;
-            std::memcpy( dest[0], uncompressed_rgb, uncompressed_size );
-            stbi_image_free(uncompressed_rgb);
-        }
-        else
+        // The raw frame size is the compressed size, when the backend reports it; otherwise the decoder stops at the end-of-image marker
+        size_t size = input_size > 0 ? input_size : source_size;
+        if (!decoder.decode(source, size, dst_format, scale, dest[0], width, height))
             LOG_ERROR("jpeg decode failed");
     }
 
@@ -1111,9 +1103,28 @@ namespace librealsense
         unpack_uyvyc(_target_format, _target_stream, dest, source, width, height, actual_size);
     }
 
+    mjpeg_converter::mjpeg_converter(const char* name, rs2_format target_format, int scale) :
+        color_converter(name, target_format),
+        _decoder(jpeg_decoder::create()),
+        _scale(scale)
+    {
+        if (!jpeg_decoder::is_supported(target_format))
+            throw invalid_value_exception(rsutils::string::from() << "MJPEG cannot be decoded to " << rs2_format_to_string(target_format));
+        if (!jpeg_decoder::is_supported_scale(scale))
+            throw invalid_value_exception(rsutils::string::from() << "Unsupported MJPEG scale 1/" << scale);
+        LOG_DEBUG("MJPEG decoding with " << _decoder->get_name());
+    }
+
+    rs2::frame mjpeg_converter::process_frame(const rs2::frame_source& source, const rs2::frame& f)
+    {
+        // The buffer the compressed image is in: once scaled, the decoded image can be smaller than that
+        _source_size = f.get_data_size();
+        return color_converter::process_frame(source, f);
+    }
+
     void mjpeg_converter::process_function( uint8_t * const dest[], const uint8_t * source, int width, int height, int actual_size, int input_size)
     {
-        unpack_mjpeg(dest, source, width, height, actual_size, input_size);
+        unpack_mjpeg(*_decoder, _target_format, _scale, dest, source, width, height, _source_size, input_size);
     }
 
     void bgr_to_rgb::process_function( uint8_t * const dest[], const uint8_t * source, int width, int height, int actual_size, int input_size)
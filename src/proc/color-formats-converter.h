@@ -4,6 +4,7 @@
 #pragma once
 
 #include "synthetic-stream.h"
+#include "jpeg-decoder.h"
 
 namespace librealsense
 {
@@ -38,16 +39,24 @@ namespace librealsense
         void process_function( uint8_t * const dest[], const uint8_t * source, int width, int height, int actual_size, int input_size) override;
     };
 
+    // Decodes into RGB8, BGR8 or Y8, optionally scaled down by 2 or 4 while decoding (see jpeg_decoder). A scaled
+    // converter is registered with a target profile of the scaled resolution, which the formats converter gives the
+    // raw frames, too; the frames it outputs are allocated at that size.
     class LRS_EXTENSION_API mjpeg_converter : public color_converter
     {
     public:
-        mjpeg_converter(rs2_format target_format) :
-            mjpeg_converter("MJPEG Converter", target_format) {};
+        mjpeg_converter(rs2_format target_format, int scale = 1) :
+            mjpeg_converter("MJPEG Converter", target_format, scale) {};
 
     protected:
-        mjpeg_converter(const char* name, rs2_format target_format) :
-            color_converter(name, target_format) {};
+        mjpeg_converter(const char* name, rs2_format target_format, int scale);
+        rs2::frame process_frame(const rs2::frame_source& source, const rs2::frame& f) override;
         void process_function( uint8_t * const dest[], const uint8_t * source, int width, int height, int actual_size, int input_size) override;
+
+    private:
+        std::unique_ptr<jpeg_decoder> _decoder;  // one per stream, reused for every frame
+        int _scale;
+        int _source_size = 0;  // of the frame being processed
     };
 
     class LRS_EXTENSION_API bgr_to_rgb : public color_converter
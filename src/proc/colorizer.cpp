@@ -11,6 +11,10 @@
 #include "colorizer.h"
 #include "disparity-transform.h"
 
+#ifdef __SSSE3__
+#include <tmmintrin.h>
+#endif
+
 namespace librealsense
 {
     static color_map hue{ {
@@ -286,8 +290,8 @@ namespace librealsense
             else if (depth_format == RS2_FORMAT_Z16)
             {
                 auto depth_data = reinterpret_cast<const uint16_t*>(depth.get_data());
-                update_histogram(_hist_data, depth_data, w, h);
-                make_rgb_data<uint16_t>(depth_data, rgb_data, w, h, coloring_function);
+                update_z16_lut(depth_data, w, h);
+                colorize_z16(depth_data, rgb_data, size_t(w) * h, _z16_lut.data());
             }
         };
 
@@ -314,13 +318,8 @@ namespace librealsense
             else if (depth_format == RS2_FORMAT_Z16)
             {
                 auto depth_data = reinterpret_cast<const uint16_t*>(depth.get_data());
-                auto min = _min;
-                auto max = _max;
-                auto coloring_function = [&, this](float data) {
-                    if (min >= max) return 0.f;
-                    return (data * _depth_units - min) / (max - min);
-                };
-                make_rgb_data<uint16_t>(depth_data, rgb_data, w, h, coloring_function);
+                update_z16_lut(depth_data, w, h);
+                colorize_z16(depth_data, rgb_data, size_t(w) * h, _z16_lut.data());
             }
         };
 
@@ -336,4 +335,80 @@ namespace librealsense
 
         return ret;
     }
+
+    static uint32_t pack_color(const float3& c)
+    {
+        return uint32_t((uint8_t)c.x) | (uint32_t((uint8_t)c.y) << 8) | (uint32_t((uint8_t)c.z) << 16);
+    }
+
+    void colorizer::update_z16_lut(const uint16_t* depth_data, int w, int h)
+    {
+        auto cm = _maps[_map_index];
+        if (_z16_lut.empty())
+        {
+            _z16_lut.resize(MAX_DEPTH);
+            _z16_lut[0] = 0;  // no depth is black
+        }
+
+        if (_equalize)
+        {
+            // Build the cumulative histogram and the colors in one pass; only values that are present are needed
+            memset(_hist_data, 0, MAX_DEPTH * sizeof(int));
+            const size_t n = size_t(w) * h;
+            for (size_t i = 0; i < n; ++i)
+                ++_hist_data[depth_data[i]];
+
+            const auto pixels = (float)(n - _hist_data[0]);
+            int cumulative = 0;
+            for (int i = 1; i < MAX_DEPTH; ++i)
+            {
+                bool present = _hist_data[i] != 0;
+                cumulative += _hist_data[i];
+                _hist_data[i] = cumulative;
+                if (present)
+                    _z16_lut[i] = pack_color(cm->get(cumulative / pixels));
+            }
+            _z16_lut_key.map_index = -1;
+            return;
+        }
+
+        // Otherwise the colors depend only on the range, map and units
+        if (_z16_lut_key.map_index == _map_index && _z16_lut_key.min == _min && _z16_lut_key.max == _max
+            && _z16_lut_key.depth_units == _depth_units)
+            return;
+
+        const auto min = _min;
+        const auto max = _max;
+        for (int i = 1; i < MAX_DEPTH; ++i)
+        {
+            float f = (min >= max) ? 0.f : ((float)i * _depth_units - min) / (max - min);
+            _z16_lut[i] = pack_color(cm->get(f));
+        }
+        _z16_lut_key.map_index = _map_index;
+        _z16_lut_key.min = min;
+        _z16_lut_key.max = max;
+        _z16_lut_key.depth_units = _depth_units;
+    }
+
+    void colorizer::colorize_z16(const uint16_t* depth_data, uint8_t* rgb_data, size_t n, const uint32_t* lut)
+    {
+        size_t i = 0;
+#ifdef __SSSE3__
+        // Gather 4 colors and drop their 4th bytes; each 16-byte store overlaps the next by 4, so stop short of the end
+        const __m128i rgbx_to_rgb = _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+        for (; i + 8 <= n; i += 4)
+        {
+            __m128i colors = _mm_setr_epi32((int)lut[depth_data[i]], (int)lut[depth_data[i + 1]],
+                                            (int)lut[depth_data[i + 2]], (int)lut[depth_data[i + 3]]);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(rgb_data + i * 3), _mm_shuffle_epi8(colors, rgbx_to_rgb));
+        }
+#endif
+        for (; i < n; ++i)
+        {
+            auto c = lut[depth_data[i]];
+            rgb_data[i * 3 + 0] = uint8_t(c);
+            rgb_data[i * 3 + 1] = uint8_t(c >> 8);
+            rgb_data[i * 3 + 2] = uint8_t(c >> 16);
+        }
+    }
 }
@@ -152,6 +152,10 @@ namespace librealsense {
             }
         }
 
+        // Z16 frames are colorized through a table of the color of each depth value, instead of per pixel
+        void update_z16_lut(const uint16_t* depth_data, int w, int h);
+        static void colorize_z16(const uint16_t* depth_data, uint8_t* rgb_data, size_t n, const uint32_t* lut);
+
         float _min, _max;
         bool _equalize;
 
@@ -167,5 +171,12 @@ namespace librealsense {
 
         float   _depth_units = 0.f;
         float   _d2d_convert_factor = 0.f;
+
+        std::vector<uint32_t> _z16_lut;     // 0x00BBGGRR for each Z16 value
+        struct
+        {
+            int map_index = -1;             // none; the table is built from the histogram of every frame when equalizing
+            float min, max, depth_units;
+        } _z16_lut_key;
     };
 }
@@ -6,6 +6,10 @@
 #include "../include/librealsense2/hpp/rs_frame.hpp"
 #include "../include/librealsense2/hpp/rs_processing.hpp"
 #include "proc/synthetic-stream.h"
+#include "proc/decimation-kernels.h"
+#include "proc/parallel-pool.h"
+
+#include <algorithm>
 
 namespace librealsense
 {
@@ -15,6 +19,17 @@ namespace librealsense
     public:
         decimation_filter();
 
+        // What a depth frame is decimated to, for blocks that decimate it themselves (fused_depth_filter)
+        struct output_geometry
+        {
+            rs2::stream_profile profile;
+            size_t              patch_size;
+            size_t              real_height;
+            size_t              padded_width;
+            size_t              padded_height;
+        };
+        output_geometry get_output_geometry(const rs2::frame& f);
+
     protected:
         rs2::frame prepare_target_frame(const rs2::frame& f, const rs2::frame_source& source, rs2_extension tgt_type);
 
@@ -23,6 +38,21 @@ namespace librealsense
 
         void decimate_others(rs2_format format, const void * frame_data_in, void * frame_data_out,
             size_t width_in, size_t height_in, size_t scale);
+
+        // Block means of each of the interleaved channels of a pixel, with rows split across the pool
+        template<class T>
+        void decimate_channels(const T * frame_data_in, T * frame_data_out, size_t width_in, size_t channels, size_t scale)
+        {
+            _pool->parallel_for(_real_height, 8, [&](size_t first_row, size_t last_row)
+            {
+                decimate_mean(frame_data_in, width_in, channels, frame_data_out, _padded_width, scale, first_row, last_row);
+            });
+
+            // Fill-in the padded rows with zeros
+            std::fill(frame_data_out + size_t(_real_height) * _padded_width * channels,
+                      frame_data_out + size_t(_padded_height) * _padded_width * channels, T(0));
+        }
+
         rs2::frame process_frame(const rs2::frame_source& source, const rs2::frame& f) override;
 
     private:
@@ -41,6 +71,7 @@ namespace librealsense
         uint16_t                _padded_height;
         bool                    _recalc_profile;
         bool                    _options_changed;   // Tracking changes imposed by user
+        std::shared_ptr<parallel_pool> _pool;
     };
     MAP_EXTENSION(RS2_EXTENSION_DECIMATION_FILTER, librealsense::decimation_filter);
 }
@@ -0,0 +1,391 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include "decimation-kernels.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#define DECIMATION_SIMD
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define DECIMATION_SIMD
+#endif
+
+
+namespace librealsense
+{
+    namespace
+    {
+        inline uint16_t min_of( uint16_t a, uint16_t b ) { return a < b ? a : b; }
+        inline uint16_t max_of( uint16_t a, uint16_t b ) { return a < b ? b : a; }
+
+#ifdef DECIMATION_SIMD
+#if defined(__SSSE3__)
+        typedef __m128i u16x8;
+        inline u16x8 load( uint16_t const * p ) { return _mm_loadu_si128( reinterpret_cast< __m128i const * >( p ) ); }
+        inline void store( uint16_t * p, u16x8 v ) { _mm_storeu_si128( reinterpret_cast< __m128i * >( p ), v ); }
+        inline u16x8 dup_u16( uint16_t x ) { return _mm_set1_epi16( short( x ) ); }
+        inline u16x8 is_zero( u16x8 v ) { return _mm_cmpeq_epi16( v, _mm_setzero_si128() ); }
+        inline u16x8 equals( u16x8 a, u16x8 b ) { return _mm_cmpeq_epi16( a, b ); }
+        inline u16x8 select( u16x8 mask, u16x8 a, u16x8 b ) { return _mm_or_si128( _mm_and_si128( mask, a ), _mm_andnot_si128( mask, b ) ); }
+        // SSE2 has no unsigned 16-bit min/max
+        inline u16x8 max_of( u16x8 a, u16x8 b ) { return _mm_adds_epu16( _mm_subs_epu16( a, b ), b ); }
+        inline u16x8 min_of( u16x8 a, u16x8 b ) { return _mm_subs_epu16( a, _mm_subs_epu16( a, b ) ); }
+        inline u16x8 add_u16( u16x8 a, u16x8 b ) { return _mm_add_epi16( a, b ); }
+        inline u16x8 sub_u16( u16x8 a, u16x8 b ) { return _mm_sub_epi16( a, b ); }
+        inline u16x8 half( u16x8 v ) { return _mm_srli_epi16( v, 1 ); }
+
+        // Pixels 2i and 2i+1 of 16, into lane i of 'even' and 'odd'. Sign-extending each half keeps packs_epi32 from
+        // saturating.
+        inline void load_pairs( uint16_t const * p, u16x8 & even, u16x8 & odd )
+        {
+            __m128i a = load( p ), b = load( p + 8 );
+            even = _mm_packs_epi32( _mm_srai_epi32( _mm_slli_epi32( a, 16 ), 16 ),
+                                    _mm_srai_epi32( _mm_slli_epi32( b, 16 ), 16 ) );
+            odd = _mm_packs_epi32( _mm_srai_epi32( a, 16 ), _mm_srai_epi32( b, 16 ) );
+        }
+
+        // Shuffles that take pixel 3i+c of 24 (in three registers) into lane i
+        struct triple_shuffles
+        {
+            __m128i mask[3][3];  // [c][register]
+
+            triple_shuffles()
+            {
+                for( int c = 0; c < 3; ++c )
+                    for( int r = 0; r < 3; ++r )
+                    {
+                        alignas( 16 ) int8_t bytes[16];
+                        for( int i = 0; i < 8; ++i )
+                        {
+                            int const pixel = 3 * i + c;
+                            bool const here = pixel / 8 == r;
+                            bytes[2 * i] = here ? int8_t( 2 * ( pixel % 8 ) ) : int8_t( -128 );
+                            bytes[2 * i + 1] = here ? int8_t( 2 * ( pixel % 8 ) + 1 ) : int8_t( -128 );
+                        }
+                        mask[c][r] = _mm_load_si128( reinterpret_cast< __m128i const * >( bytes ) );
+                    }
+            }
+        };
+        const triple_shuffles shuffles_3;
+
+        inline void load_triples( uint16_t const * p, u16x8 * c )
+        {
+            __m128i const v[3] = { load( p ), load( p + 8 ), load( p + 16 ) };
+            for( int k = 0; k < 3; ++k )
+                c[k] = _mm_or_si128( _mm_or_si128( _mm_shuffle_epi8( v[0], shuffles_3.mask[k][0] ),
+                                                   _mm_shuffle_epi8( v[1], shuffles_3.mask[k][1] ) ),
+                                     _mm_shuffle_epi8( v[2], shuffles_3.mask[k][2] ) );
+        }
+#else
+        typedef uint16x8_t u16x8;
+        inline u16x8 load( uint16_t const * p ) { return vld1q_u16( p ); }
+        inline void store( uint16_t * p, u16x8 v ) { vst1q_u16( p, v ); }
+        inline u16x8 dup_u16( uint16_t x ) { return vdupq_n_u16( x ); }
+        inline u16x8 is_zero( u16x8 v ) { return vceqq_u16( v, vdupq_n_u16( 0 ) ); }
+        inline u16x8 equals( u16x8 a, u16x8 b ) { return vceqq_u16( a, b ); }
+        inline u16x8 select( u16x8 mask, u16x8 a, u16x8 b ) { return vbslq_u16( mask, a, b ); }
+        inline u16x8 max_of( u16x8 a, u16x8 b ) { return vmaxq_u16( a, b ); }
+        inline u16x8 min_of( u16x8 a, u16x8 b ) { return vminq_u16( a, b ); }
+        inline u16x8 add_u16( u16x8 a, u16x8 b ) { return vaddq_u16( a, b ); }
+        inline u16x8 sub_u16( u16x8 a, u16x8 b ) { return vsubq_u16( a, b ); }
+        inline u16x8 half( u16x8 v ) { return vshrq_n_u16( v, 1 ); }
+
+        inline void load_pairs( uint16_t const * p, u16x8 & even, u16x8 & odd )
+        {
+            uint16x8x2_t v = vld2q_u16( p );
+            even = v.val[0];
+            odd = v.val[1];
+        }
+
+        inline void load_triples( uint16_t const * p, u16x8 * c )
+        {
+            uint16x8x3_t v = vld3q_u16( p );
+            c[0] = v.val[0];
+            c[1] = v.val[1];
+            c[2] = v.val[2];
+        }
+#endif
+#endif
+
+        // Sorting networks, for a pixel (uint16_t) or for 8 of them (u16x8)
+        template< class V >
+        inline void sort_pair( V & a, V & b )
+        {
+            V const lo = min_of( a, b );
+            b = max_of( a, b );
+            a = lo;
+        }
+
+        template< size_t K >
+        struct network;
+
+        template<>
+        struct network< 4 >
+        {
+            template< class V >
+            static void sort( V * p )
+            {
+                sort_pair( p[0], p[1] ); sort_pair( p[2], p[3] );
+                sort_pair( p[0], p[2] ); sort_pair( p[1], p[3] );
+                sort_pair( p[1], p[2] );
+            }
+        };
+
+        // Sorts the rows of 3, then the columns, then the diagonals that are left
+        template<>
+        struct network< 9 >
+        {
+            template< class V >
+            static void sort( V * p )
+            {
+                sort_pair( p[0], p[1] ); sort_pair( p[3], p[4] ); sort_pair( p[6], p[7] );
+                sort_pair( p[1], p[2] ); sort_pair( p[4], p[5] ); sort_pair( p[7], p[8] );
+                sort_pair( p[0], p[1] ); sort_pair( p[3], p[4] ); sort_pair( p[6], p[7] );
+                sort_pair( p[0], p[3] ); sort_pair( p[3], p[6] ); sort_pair( p[0], p[3] );
+                sort_pair( p[1], p[4] ); sort_pair( p[4], p[7] ); sort_pair( p[1], p[4] );
+                sort_pair( p[2], p[5] ); sort_pair( p[5], p[8] ); sort_pair( p[2], p[5] );
+                sort_pair( p[1], p[3] ); sort_pair( p[5], p[7] ); sort_pair( p[2], p[6] );
+                sort_pair( p[4], p[6] ); sort_pair( p[2], p[4] ); sort_pair( p[2], p[3] );
+                sort_pair( p[5], p[6] );
+            }
+        };
+
+        // With the n invalid (0) pixels sorted to the front, the median of the valid ones is at K - 1 - n_valid / 2:
+        // the lower middle one for an even count, and the last (0) if none are valid.
+        template< size_t K >
+        uint16_t median_of_valid( uint16_t * p )
+        {
+            size_t n_valid = 0;
+            for( size_t i = 0; i < K; ++i )
+                n_valid += p[i] != 0;
+            network< K >::sort( p );
+            return p[K - 1 - n_valid / 2];
+        }
+
+#ifdef DECIMATION_SIMD
+        template< size_t K >
+        u16x8 median_of_valid( u16x8 * p )
+        {
+            u16x8 n_valid = dup_u16( K );
+            for( size_t i = 0; i < K; ++i )
+                n_valid = add_u16( n_valid, is_zero( p[i] ) );  // -1 for each invalid
+            network< K >::sort( p );
+
+            u16x8 const index = sub_u16( dup_u16( K - 1 ), half( n_valid ) );
+            u16x8 median = p[K - 1];
+            for( size_t i = K - 1 - K / 2; i < K - 1; ++i )
+                median = select( equals( index, dup_u16( uint16_t( i ) ) ), p[i], median );
+            return median;
+        }
+#endif
+
+        template< class T >
+        void zero_padding( T * row, size_t width, size_t stride )
+        {
+            if( stride > width )
+                std::memset( row + width, 0, ( stride - width ) * sizeof( T ) );
+        }
+
+        // Runs f with the scale as a compile-time constant, so the loops over a block unroll
+        template< class F >
+        void with_scale( size_t scale, F f )
+        {
+            switch( scale )
+            {
+            case 1: f( std::integral_constant< size_t, 1 >() ); break;
+            case 2: f( std::integral_constant< size_t, 2 >() ); break;
+            case 3: f( std::integral_constant< size_t, 3 >() ); break;
+            case 4: f( std::integral_constant< size_t, 4 >() ); break;
+            case 5: f( std::integral_constant< size_t, 5 >() ); break;
+            case 6: f( std::integral_constant< size_t, 6 >() ); break;
+            case 7: f( std::integral_constant< size_t, 7 >() ); break;
+            case 8: f( std::integral_constant< size_t, 8 >() ); break;
+            default: throw std::invalid_argument( "decimation scale must be 1 to 8" );
+            }
+        }
+
+        // Division by a multiplication: (n * reciprocal(d)) >> 32 is n / d as long as n * d < 2^32, which holds for
+        // the sums of 16-bit pixels over blocks of up to 8x8
+        inline uint64_t reciprocal( uint32_t d ) { return ( uint64_t( 1 ) << 32 ) / d + 1; }
+        inline uint32_t divide( uint32_t n, uint64_t r ) { return uint32_t( ( n * r ) >> 32 ); }
+
+        // Both means add up each column of the block's rows first, in loops the compiler vectorizes, then the columns
+        // of each block
+
+        // 16 bits hold the column sums of 8-bit pixels over 8 rows, so twice as many fit in a register
+        template< class T >
+        struct column_sum
+        {
+            typedef uint32_t type;
+        };
+
+        template<>
+        struct column_sum< uint8_t >
+        {
+            typedef uint16_t type;
+        };
+
+        template< size_t S >
+        void depth_mean_rows( uint16_t const * in, size_t width_in, uint16_t * out, size_t out_stride,
+                              size_t first_row, size_t last_row )
+        {
+            size_t const width_out = width_in / S;
+            size_t const columns = width_out * S;
+            std::vector< uint32_t > sums( columns ), counts( columns );
+            uint64_t by_count[S * S + 1];
+            for( size_t n = 1; n <= S * S; ++n )
+                by_count[n] = reciprocal( uint32_t( n ) );
+            by_count[0] = 0;  // and the sum is 0
+
+            for( size_t j = first_row; j < last_row; ++j )
+            {
+                std::fill( sums.begin(), sums.end(), 0 );
+                std::fill( counts.begin(), counts.end(), 0 );
+                for( size_t n = 0; n < S; ++n )
+                {
+                    uint16_t const * row = in + ( j * S + n ) * width_in;
+                    for( size_t u = 0; u < columns; ++u )
+                    {
+                        sums[u] += row[u];
+                        counts[u] += row[u] != 0;
+                    }
+                }
+
+                uint16_t * o = out + j * out_stride;
+                for( size_t x = 0; x < width_out; ++x )
+                {
+                    uint32_t sum = 0, count = 0;
+                    for( size_t m = 0; m < S; ++m )
+                    {
+                        sum += sums[x * S + m];
+                        count += counts[x * S + m];
+                    }
+                    o[x] = uint16_t( divide( sum, by_count[count] ) );
+                }
+                zero_padding( o, width_out, out_stride );
+            }
+        }
+
+        template< size_t S, class T >
+        void mean_rows( T const * in, size_t width_in, size_t channels, T * out, size_t out_stride,
+                        size_t first_row, size_t last_row )
+        {
+            size_t const width_out = width_in / S;
+            size_t const columns = width_out * S * channels;
+            uint64_t const by_patch = reciprocal( S * S );
+            std::vector< typename column_sum< T >::type > sums( columns );
+            for( size_t j = first_row; j < last_row; ++j )
+            {
+                std::fill( sums.begin(), sums.end(), 0 );
+                for( size_t n = 0; n < S; ++n )
+                {
+                    T const * row = in + ( j * S + n ) * width_in * channels;
+                    for( size_t u = 0; u < columns; ++u )
+                        sums[u] += row[u];
+                }
+
+                // A channel at a time, so the stride between a block's pixels is the only one left at run time
+                T * o = out + j * out_stride * channels;
+                for( size_t k = 0; k < channels; ++k )
+                {
+                    auto const * s = sums.data() + k;
+                    for( size_t x = 0; x < width_out; ++x )
+                    {
+                        uint32_t sum = 0;
+                        for( size_t m = 0; m < S; ++m )
+                            sum += s[( x * S + m ) * channels];
+                        o[x * channels + k] = T( divide( sum, by_patch ) );
+                    }
+                }
+                zero_padding( o, width_out * channels, out_stride * channels );
+            }
+        }
+    }
+
+
+    void decimate_depth_median( uint16_t const * in, size_t width_in, uint16_t * out, size_t out_stride, size_t scale,
+                                size_t first_row, size_t last_row )
+    {
+        size_t const width_out = width_in / scale;
+        for( size_t j = first_row; j < last_row; ++j )
+        {
+            uint16_t const * r0 = in + j * scale * width_in;
+            uint16_t const * r1 = r0 + width_in;
+            uint16_t * o = out + j * out_stride;
+            size_t x = 0;
+            if( scale == 2 )
+            {
+#ifdef DECIMATION_SIMD
+                for( ; x + 8 <= width_out; x += 8 )
+                {
+                    u16x8 p[4];
+                    load_pairs( r0 + 2 * x, p[0], p[1] );
+                    load_pairs( r1 + 2 * x, p[2], p[3] );
+                    store( o + x, median_of_valid< 4 >( p ) );
+                }
+#endif
+                for( ; x < width_out; ++x )
+                {
+                    uint16_t p[4] = { r0[2 * x], r0[2 * x + 1], r1[2 * x], r1[2 * x + 1] };
+                    o[x] = median_of_valid< 4 >( p );
+                }
+            }
+            else
+            {
+                uint16_t const * r2 = r1 + width_in;
+#ifdef DECIMATION_SIMD
+                for( ; x + 8 <= width_out; x += 8 )
+                {
+                    u16x8 p[9];
+                    load_triples( r0 + 3 * x, p );
+                    load_triples( r1 + 3 * x, p + 3 );
+                    load_triples( r2 + 3 * x, p + 6 );
+                    store( o + x, median_of_valid< 9 >( p ) );
+                }
+#endif
+                for( ; x < width_out; ++x )
+                {
+                    uint16_t p[9];
+                    for( size_t m = 0; m < 3; ++m )
+                    {
+                        p[m] = r0[3 * x + m];
+                        p[3 + m] = r1[3 * x + m];
+                        p[6 + m] = r2[3 * x + m];
+                    }
+                    o[x] = median_of_valid< 9 >( p );
+                }
+            }
+            zero_padding( o, width_out, out_stride );
+        }
+    }
+
+
+    void decimate_depth_mean( uint16_t const * in, size_t width_in, uint16_t * out, size_t out_stride, size_t scale,
+                              size_t first_row, size_t last_row )
+    {
+        with_scale( scale, [&]( auto s ) {
+            depth_mean_rows< decltype( s )::value >( in, width_in, out, out_stride, first_row, last_row );
+        } );
+    }
+
+
+    template< class T >
+    void decimate_mean( T const * in, size_t width_in, size_t channels, T * out, size_t out_stride, size_t scale,
+                        size_t first_row, size_t last_row )
+    {
+        with_scale( scale, [&]( auto s ) {
+            mean_rows< decltype( s )::value >( in, width_in, channels, out, out_stride, first_row, last_row );
+        } );
+    }
+
+
+    template void decimate_mean< uint8_t >( uint8_t const *, size_t, size_t, uint8_t *, size_t, size_t, size_t, size_t );
+    template void decimate_mean< uint16_t >( uint16_t const *, size_t, size_t, uint16_t *, size_t, size_t, size_t, size_t );
+}
@@ -0,0 +1,30 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace librealsense
+{
+    // The kernels of decimation_filter. Each output pixel summarizes a scale x scale block of input pixels, and only
+    // the first width_in / scale columns have blocks: the rest of the output row, up to out_stride pixels, is zeroed.
+    // They work on a range of output rows, so rows may be split across threads. Scales run from 1 to 8.
+
+    // Z16, scale 2 or 3: the median of the valid (non-zero) pixels in the block, the lower of the two middle ones for an
+    // even count, and 0 if none are valid. Where SSSE3 or NEON are available, a sorting network runs over 8 output
+    // pixels at a time: invalid pixels are sorted in as 0, and the median is picked past them.
+    void decimate_depth_median( uint16_t const * in, size_t width_in, uint16_t * out, size_t out_stride, size_t scale,
+                                size_t first_row, size_t last_row );
+
+    // Z16, other scales: the mean of the valid pixels in the block, or 0
+    void decimate_depth_mean( uint16_t const * in, size_t width_in, uint16_t * out, size_t out_stride, size_t scale,
+                              size_t first_row, size_t last_row );
+
+    // The mean of each of the interleaved channels of a pixel (Y8, Y16, RGB8, RGBA8...), over all the block
+    template< class T >
+    void decimate_mean( T const * in, size_t width_in, size_t channels, T * out, size_t out_stride, size_t scale,
+                        size_t first_row, size_t last_row );
+}
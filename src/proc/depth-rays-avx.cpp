@@ -0,0 +1,32 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+// Built with AVX2 enabled (see RS2_USE_AVX2_KERNELS), and only called when the CPU supports it
+
+#include "depth-rays.h"
+#include "depth-rays-simd.h"
+
+
+namespace librealsense
+{
+#if defined(__AVX2__)
+    size_t depth_rays::deproject_avx2( uint16_t const * depth, float depth_scale, float * out, size_t first, size_t last ) const
+    {
+        auto xs = _x.data();
+        auto ys = _y.data();
+        size_t i = first;
+        const __m256 scale = _mm256_set1_ps( depth_scale );
+        for( ; i + 8 <= last; i += 8, out += 24 )
+        {
+            __m128i d = _mm_loadu_si128( reinterpret_cast< __m128i const * >( depth + i ) );
+            __m256 z = _mm256_mul_ps( _mm256_cvtepi32_ps( _mm256_cvtepu16_epi32( d ) ), scale );
+            __m256 x = _mm256_mul_ps( z, _mm256_loadu_ps( xs + i ) );
+            __m256 y = _mm256_mul_ps( z, _mm256_loadu_ps( ys + i ) );
+            store_xyz( out, _mm256_castps256_ps128( x ), _mm256_castps256_ps128( y ), _mm256_castps256_ps128( z ) );
+            store_xyz( out + 12, _mm256_extractf128_ps( x, 1 ), _mm256_extractf128_ps( y, 1 ), _mm256_extractf128_ps( z, 1 ) );
+        }
+        _mm256_zeroupper();  // the caller goes on with SSE
+        return i;
+    }
+#endif
+}
@@ -0,0 +1,25 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#if defined(__SSSE3__) || defined(__AVX2__)
+#include <immintrin.h>
+
+
+namespace librealsense
+{
+    // Store 4 points, from their coordinates
+    static inline void store_xyz( float * out, __m128 x, __m128 y, __m128 z )
+    {
+        auto x_y = _mm_shuffle_ps( x, y, _MM_SHUFFLE( 2, 0, 2, 0 ) );  // x0 x2 y0 y2
+        auto z_x = _mm_shuffle_ps( z, x, _MM_SHUFFLE( 3, 1, 2, 0 ) );  // z0 z2 x1 x3
+        auto y_z = _mm_shuffle_ps( y, z, _MM_SHUFFLE( 3, 1, 3, 1 ) );  // y1 y3 z1 z3
+
+        _mm_storeu_ps( out, _mm_shuffle_ps( x_y, z_x, _MM_SHUFFLE( 2, 0, 2, 0 ) ) );      // x0 y0 z0 x1
+        _mm_storeu_ps( out + 4, _mm_shuffle_ps( y_z, x_y, _MM_SHUFFLE( 3, 1, 2, 0 ) ) );  // y1 z1 x2 y2
+        _mm_storeu_ps( out + 8, _mm_shuffle_ps( z_x, y_z, _MM_SHUFFLE( 3, 1, 3, 1 ) ) );  // z2 x3 y3 z3
+    }
+}
+
+#endif
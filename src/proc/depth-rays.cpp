@@ -0,0 +1,121 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include "depth-rays.h"
+#include "depth-rays-simd.h"
+
+#include <librealsense2/rsutil.h>
+
+#include <cstring>
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#if defined(RS2_USE_AVX2_KERNELS) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+
+namespace librealsense
+{
+#if defined(RS2_USE_AVX2_KERNELS)
+    static bool cpu_has_avx2()
+    {
+#if defined(_MSC_VER)
+        int info[4];
+        __cpuid( info, 0 );
+        if( info[0] < 7 )
+            return false;
+        __cpuid( info, 1 );
+        bool const os_saves_ymm = ( info[2] & ( 1 << 27 ) ) && ( _xgetbv( 0 ) & 6 ) == 6;  // OSXSAVE, XMM and YMM state
+        __cpuidex( info, 7, 0 );
+        return os_saves_ymm && ( info[1] & ( 1 << 5 ) );
+#else
+        return __builtin_cpu_supports( "avx2" );
+#endif
+    }
+#endif
+
+    bool depth_rays::update( rs2_intrinsics const & intrin, parallel_pool & pool )
+    {
+        if( _valid && ! std::memcmp( &_intrinsics, &intrin, sizeof( intrin ) ) )
+            return false;
+
+        _intrinsics = intrin;
+        _x.resize( size_t( intrin.width ) * intrin.height );
+        _y.resize( _x.size() );
+        pool.parallel_for( intrin.height, 16, [&]( size_t begin, size_t end )
+        {
+            for( int y = int( begin ); y < int( end ); ++y )
+            {
+                size_t i = size_t( y ) * intrin.width;
+                for( int x = 0; x < intrin.width; ++x, ++i )
+                {
+                    const float pixel[] = { (float)x, (float)y };
+                    float point[3];
+                    rs2_deproject_pixel_to_point( point, &intrin, pixel, 1.f );
+                    _x[i] = point[0];
+                    _y[i] = point[1];
+                }
+            }
+        } );
+        _valid = true;
+        return true;
+    }
+
+    void depth_rays::deproject( uint16_t const * depth, float depth_scale, float3 * points, size_t first, size_t last ) const
+    {
+        auto xs = _x.data();
+        auto ys = _y.data();
+        auto out = reinterpret_cast< float * >( points + first );
+        size_t i = first;
+
+#if defined(RS2_USE_AVX2_KERNELS)
+        static bool const use_avx2 = cpu_has_avx2();
+        if( use_avx2 )
+        {
+            auto next = deproject_avx2( depth, depth_scale, out, first, last );
+            out += ( next - i ) * 3;
+            i = next;
+        }
+#endif
+#if defined(__SSSE3__)
+        const __m128 scale = _mm_set1_ps( depth_scale );
+        const __m128i zero = _mm_setzero_si128();
+        for( ; i + 4 <= last; i += 4, out += 12 )
+        {
+            __m128i d = _mm_loadl_epi64( reinterpret_cast< __m128i const * >( depth + i ) );
+            __m128 z = _mm_mul_ps( _mm_cvtepi32_ps( _mm_unpacklo_epi16( d, zero ) ), scale );
+            store_xyz( out, _mm_mul_ps( z, _mm_loadu_ps( xs + i ) ), _mm_mul_ps( z, _mm_loadu_ps( ys + i ) ), z );
+        }
+#elif defined(__ARM_NEON)
+        const float32x4_t scale = vdupq_n_f32( depth_scale );
+        for( ; i + 4 <= last; i += 4, out += 12 )
+        {
+            float32x4x3_t p;
+            p.val[2] = vmulq_f32( vcvtq_f32_u32( vmovl_u16( vld1_u16( depth + i ) ) ), scale );
+            p.val[0] = vmulq_f32( p.val[2], vld1q_f32( xs + i ) );
+            p.val[1] = vmulq_f32( p.val[2], vld1q_f32( ys + i ) );
+            vst3q_f32( out, p );
+        }
+#endif
+
+        for( ; i < last; ++i, out += 3 )
+        {
+            float z = depth_scale * depth[i];
+            out[0] = z * xs[i];
+            out[1] = z * ys[i];
+            out[2] = z;
+        }
+    }
+
+    void depth_rays::deproject( uint16_t const * depth, float depth_scale, float3 * points, parallel_pool & pool ) const
+    {
+        const size_t width = _intrinsics.width;
+        pool.parallel_for( _intrinsics.height, 16, [&]( size_t begin, size_t end )
+        {
+            deproject( depth, depth_scale, points, begin * width, end * width );
+        } );
+    }
+}
@@ -0,0 +1,40 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "types.h"
+#include "parallel-pool.h"
+
+#include <vector>
+
+
+namespace librealsense
+{
+    // The rays of the pixels of a depth image, for deprojecting it into points.
+    //
+    // Every distortion model rs2_deproject_pixel_to_point() supports deprojects a pixel at depth z to z * (x, y, 1), so
+    // the (x, y) of each pixel is computed once, for the current intrinsics, and deprojecting a frame is a multiply per
+    // coordinate. Where SSE or NEON are available, several pixels are deprojected at a time, and 8 at a time on CPUs with
+    // AVX2 (if the library was built with RS2_USE_AVX2_KERNELS).
+    class depth_rays
+    {
+    public:
+        // Rebuild the rays if the intrinsics changed (or were never set); true if they were rebuilt
+        bool update( rs2_intrinsics const & intrin, parallel_pool & pool );
+
+        // Deproject the pixels [first, last) of a Z16 image, into the same points
+        void deproject( uint16_t const * depth, float depth_scale, float3 * points, size_t first, size_t last ) const;
+
+        // Deproject a whole Z16 image, in parallel bands of rows
+        void deproject( uint16_t const * depth, float depth_scale, float3 * points, parallel_pool & pool ) const;
+
+    private:
+        // Deprojects 8 pixels at a time, as far as it can into [first, last); returns the first pixel it did not reach
+        size_t deproject_avx2( uint16_t const * depth, float depth_scale, float * out, size_t first, size_t last ) const;
+
+        rs2_intrinsics _intrinsics = {};
+        bool _valid = false;
+        std::vector< float > _x, _y;
+    };
+}
@@ -10,6 +10,7 @@
 #include <src/core/depth-frame.h>
 #include <src/core/sensor-interface.h>
 #include <src/depth-sensor.h>
+#include <src/software-sensor.h>
 #include "synthetic-stream.h"
 
 namespace librealsense
@@ -75,7 +76,8 @@ namespace librealsense
             float d2d_convert_factor = 0;
         };
 
-        static info update_info_from_frame(const rs2::frame& f)
+        // The focal length is the frame's, unless given for another resolution (decimated) of the same sensor
+        static info update_info_from_frame(const rs2::frame& f, float focal_lenght_mm = 0.f)
         {
             // Check if the new frame originated from stereo-based depth sensor
             // and retrieve the stereo baseline parameter that will be used in transformations
@@ -104,10 +106,21 @@ namespace librealsense
                 }
             }
 
+            // Software device can obtain the baseline via Options interface, also without depth units
+            if (!info.stereoscopic_depth)
+            {
+                auto depth_emul = As<librealsense::software_sensor>(snr);
+                if (depth_emul && depth_emul->supports_option(RS2_OPTION_STEREO_BASELINE))
+                {
+                    stereo_baseline_meter = depth_emul->get_option(RS2_OPTION_STEREO_BASELINE).query() * 0.001f;
+                    info.stereoscopic_depth = true;
+                }
+            }
+
             if (info.stereoscopic_depth)
             {
-                auto vp = f.get_profile().as<rs2::video_stream_profile>();
-                auto focal_lenght_mm = vp.get_intrinsics().fx;
+                if (focal_lenght_mm == 0.f)
+                    focal_lenght_mm = f.get_profile().as<rs2::video_stream_profile>().get_intrinsics().fx;
                 const uint8_t fractional_bits = 5;
                 const uint8_t fractions = 1 << fractional_bits;
                 float depth_units = 0.001f;
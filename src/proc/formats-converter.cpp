@@ -95,6 +95,15 @@ stream_profiles formats_converter::get_all_possible_profiles( const stream_profi
     // Note - User profile type is stream_profile_interface, factories profile type is stream_profile.
     stream_profiles to_profiles;
 
+    // Targets of another resolution than their raw profile, added once all the others are known
+    struct resized_target
+    {
+        processing_block_factory * pbf;
+        std::shared_ptr< stream_profile_interface > raw_profile;
+        std::shared_ptr< stream_profile_interface > profile;
+    };
+    std::vector< resized_target > resized_targets;
+
     for( auto & raw_profile : raw_profiles )
     {
         LOG_DEBUG( "Raw profile: " << raw_profile );
@@ -123,11 +132,16 @@ stream_profiles formats_converter::get_all_possible_profiles( const stream_profi
                         auto cloned_vsp = As< video_stream_profile, stream_profile_interface >( cloned_profile );
                         if( cloned_vsp )
                         {
-                            // Conversion may involve changing the resolution (rotation, expansion, etc.)
+                            // Conversion may involve changing the resolution (rotation, expansion, scaling, etc.)
                             auto width = cloned_vsp->get_width();
                             auto height = cloned_vsp->get_height();
                             target.resolution_transform( width, height );
-                            cloned_vsp->set_dims( width, height );
+                            if( width != cloned_vsp->get_width() || height != cloned_vsp->get_height() )
+                            {
+                                cloned_vsp->set_dims( width, height );
+                                resized_targets.push_back( { pbf.get(), raw_profile, cloned_profile } );
+                                continue;
+                            }
                         }
                         LOG_DEBUG( "          -> " << cloned_profile );
 
@@ -159,6 +173,19 @@ stream_profiles formats_converter::get_all_possible_profiles( const stream_profi
         }
     }
 
+    // A resized target is only added when no other raw profile already converts to it (e.g., MJPEG 640x480 decoded
+    // at half size, when the camera also streams 320x240): the request for it must resolve to a single raw profile
+    for( auto & resized : resized_targets )
+    {
+        auto key = to_profile( resized.profile.get() );
+        if( _target_profiles_to_raw_profiles.count( key ) )
+            continue;
+        LOG_DEBUG( "Raw profile: " << resized.raw_profile << "\n          -> " << resized.profile );
+        _pbf_supported_profiles[resized.pbf].push_back( resized.profile );
+        _target_profiles_to_raw_profiles[key].push_back( resized.raw_profile );
+        to_profiles.push_back( resized.profile );
+    }
+
     return to_profiles;
 }
 
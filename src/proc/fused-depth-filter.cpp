@@ -0,0 +1,187 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include <librealsense2/hpp/rs_sensor.hpp>
+#include <librealsense2/hpp/rs_processing.hpp>
+#include "core/video.h"
+#include "stream.h"
+#include "proc/synthetic-stream.h"
+#include "proc/decimation-filter.h"
+#include "proc/decimation-kernels.h"
+#include "proc/threshold.h"
+#include "proc/disparity-transform.h"
+#include "proc/spatial-filter.h"
+#include "proc/temporal-filter.h"
+#include "proc/hole-filling-filter.h"
+#include "proc/fused-depth-filter.h"
+
+#include <algorithm>
+#include <cmath>
+
+
+namespace librealsense
+{
+    fused_depth_filter::fused_depth_filter()
+        : composite_processing_block("Fused Depth Filter"),
+        _decimation(std::make_shared<decimation_filter>()),
+        _threshold(std::make_shared<threshold>()),
+        _spatial(std::make_shared<spatial_filter>()),
+        _temporal(std::make_shared<temporal_filter>()),
+        _hole_filling(std::make_shared<hole_filling_filter>()),
+        _stereoscopic_depth(false),
+        _d2d_convert_factor(0.f),
+        _width(0), _height(0),
+        _pool(parallel_pool::get())
+    {
+        // The chain, for its options and for the frames that are not fused
+        add(_decimation);
+        add(_threshold);
+        add(std::make_shared<disparity_transform>(true));
+        add(_spatial);
+        add(_temporal);
+        add(_hole_filling);
+        add(std::make_shared<disparity_transform>(false));
+        update_info(RS2_CAMERA_INFO_NAME, "Fused Depth Filter");
+
+        auto on_frame = [this](rs2::frame f, const rs2::frame_source& source)
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+
+            if (should_fuse(f))
+            {
+                if (auto out = process_frame(source, f))
+                    source.frame_ready(out);
+                return;
+            }
+            lock.unlock();
+
+            auto fi = (frame_interface*)f.get();
+            fi->acquire();
+            _processing_blocks.front()->invoke(frame_holder(fi));
+        };
+
+        auto callback = new rs2::frame_processor_callback<decltype(on_frame)>(on_frame);
+        processing_block::set_processing_callback(std::shared_ptr<rs2_frame_processor_callback>(callback));
+    }
+
+    void fused_depth_filter::set_output_callback(rs2_frame_callback_sptr callback)
+    {
+        // Fused frames are output by this block, the others by the last block of the chain
+        composite_processing_block::set_output_callback(callback);
+        processing_block::set_output_callback(callback);
+    }
+
+    void fused_depth_filter::invoke(frame_holder frames)
+    {
+        // Through the processing callback, which hands to the chain whatever it does not fuse
+        processing_block::invoke(std::move(frames));
+    }
+
+    bool fused_depth_filter::should_fuse(const rs2::frame& f)
+    {
+        if (!f || !f.is<rs2::depth_frame>() || f.is<rs2::disparity_frame>())
+            return false;
+
+        auto profile = f.get_profile();
+        if (profile.stream_type() != RS2_STREAM_DEPTH || profile.format() != RS2_FORMAT_Z16)
+            return false;
+
+        // The chain passes depth it cannot transform to disparity on unfiltered
+        if (profile.get() != _source_stream_profile.get())
+        {
+            _source_stream_profile = profile;
+            _stereoscopic_depth = disparity_info::update_info_from_frame(f).stereoscopic_depth;
+            _decimated_stream_profile = rs2::stream_profile();
+        }
+        return _stereoscopic_depth;
+    }
+
+    void fused_depth_filter::update_configuration(const rs2::frame& f, const decimation_filter::output_geometry& decimated)
+    {
+        if (decimated.profile.get() == _decimated_stream_profile.get())
+            return;
+
+        // The disparity is that of the decimated frame, and the output has its intrinsics, as in the chain
+        _decimated_stream_profile = decimated.profile;
+        auto intrinsics = _decimated_stream_profile.as<rs2::video_stream_profile>().get_intrinsics();
+        _d2d_convert_factor = disparity_info::update_info_from_frame(f, intrinsics.fx).d2d_convert_factor;
+
+        _target_stream_profile = _decimated_stream_profile.clone(RS2_STREAM_DEPTH, 0, RS2_FORMAT_Z16);
+        auto tgt_vspi = dynamic_cast<video_stream_profile_interface*>(_target_stream_profile.get()->profile);
+        if (!tgt_vspi)
+            throw std::runtime_error("Stream profile is not video stream profile");
+        tgt_vspi->set_intrinsics([intrinsics]() { return intrinsics; });
+        tgt_vspi->set_dims(intrinsics.width, intrinsics.height);
+
+        _width = decimated.padded_width;
+        _height = decimated.padded_height;
+        _disparity.resize(_width * _height);
+    }
+
+    rs2::frame fused_depth_filter::process_frame(const rs2::frame_source& source, const rs2::frame& f)
+    {
+        auto src = f.as<rs2::video_frame>();
+        auto depth = static_cast<const uint16_t*>(src.get_data());
+        size_t const width_in = src.get_width();
+        float const units = ((depth_frame*)f.get())->get_units();
+
+        auto decimated = _decimation->get_output_geometry(f);
+        auto range = _threshold->get_range();
+        update_configuration(f, decimated);
+
+        size_t const scale = decimated.patch_size;
+        size_t const real_height = decimated.real_height;
+        size_t const width = _width;
+        float const min = range.first, max = range.second;
+        float const factor = _d2d_convert_factor;
+        float * disparity = _disparity.data();
+
+        // Decimation, threshold and the transform to disparity, an output row at a time
+        _pool->parallel_for(real_height, 8, [&](size_t first_row, size_t last_row)
+        {
+            std::vector<uint16_t> row(width);
+            for (size_t v = first_row; v < last_row; ++v)
+            {
+                auto block = depth + v * scale * width_in;
+                if (scale == 2 || scale == 3)
+                    decimate_depth_median(block, width_in, row.data(), width, scale, 0, 1);
+                else
+                    decimate_depth_mean(block, width_in, row.data(), width, scale, 0, 1);
+
+                float * out = disparity + v * width;
+                for (size_t u = 0; u < width; ++u)
+                {
+                    auto dist = units * row[u];
+                    out[u] = (row[u] && dist >= min && dist <= max) ? factor / float(row[u]) : 0.f;
+                }
+            }
+        });
+
+        // The padded rows
+        std::fill(disparity + real_height * width, disparity + _height * width, 0.f);
+
+        // The filters of the chain, with their state and options, in place; each is set to the disparity frame, and
+        // set back by the chain on its next frame
+        _spatial->filter_disparity(disparity, _width, _height);
+        _temporal->filter_disparity(disparity, _width, _height);
+        _hole_filling->filter_disparity(disparity, _width, _height);
+
+        // Back to depth, into the only frame allocated
+        auto tgt = source.allocate_video_frame(_target_stream_profile, f, int(sizeof(uint16_t)), int(_width), int(_height),
+            int(_width * sizeof(uint16_t)), RS2_EXTENSION_DEPTH_FRAME);
+        if (!tgt)
+            return f;
+
+        auto out = static_cast<uint16_t*>(const_cast<void*>(tgt.get_data()));
+        _pool->parallel_for(_width * _height, 4096, [&](size_t first, size_t last)
+        {
+            for (size_t i = first; i < last; ++i)
+            {
+                float const input = disparity[i];
+                out[i] = std::isnormal(input) ? static_cast<uint16_t>((factor / input) + 0.5f) : 0;
+            }
+        });
+
+        return tgt;
+    }
+}
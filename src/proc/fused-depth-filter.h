@@ -0,0 +1,55 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "synthetic-stream.h"
+#include "decimation-filter.h"
+#include "parallel-pool.h"
+
+#include <vector>
+
+namespace librealsense
+{
+    class threshold;
+    class spatial_filter;
+    class temporal_filter;
+    class hole_filling_filter;
+
+    // The recommended depth chain - decimation, threshold, depth to disparity, spatial, temporal, hole filling and back
+    // to depth - as a single block, with the options of the chain's blocks.
+    //
+    // Z16 depth from a stereo sensor is filtered in one disparity buffer that is kept across frames, and only the
+    // output frame is allocated. Decimation, threshold and the transform to disparity are done an output row at a
+    // time, while the input rows are in cache; the spatial, temporal and hole-filling filters, which need whole rows,
+    // columns or neighbourhoods, then run in place on the buffer; and the transform back to depth writes the output.
+    // The results are those of the chain. Anything else (framesets, other streams) goes through the chain.
+    class fused_depth_filter : public composite_processing_block
+    {
+    public:
+        fused_depth_filter();
+
+        void set_output_callback(rs2_frame_callback_sptr callback) override;
+        void invoke(frame_holder frames) override;
+
+    private:
+        bool should_fuse(const rs2::frame& f);
+        void update_configuration(const rs2::frame& f, const decimation_filter::output_geometry& decimated);
+        rs2::frame process_frame(const rs2::frame_source& source, const rs2::frame& f);
+
+        std::shared_ptr<decimation_filter>      _decimation;
+        std::shared_ptr<threshold>              _threshold;
+        std::shared_ptr<spatial_filter>         _spatial;
+        std::shared_ptr<temporal_filter>        _temporal;
+        std::shared_ptr<hole_filling_filter>    _hole_filling;
+
+        rs2::stream_profile     _source_stream_profile;
+        rs2::stream_profile     _decimated_stream_profile;
+        rs2::stream_profile     _target_stream_profile;
+        bool                    _stereoscopic_depth;
+        float                   _d2d_convert_factor;
+        size_t                  _width, _height;    // Of the decimated (padded) frame
+        std::vector<float>      _disparity;         // The frame being filtered, reused across frames
+        std::shared_ptr<parallel_pool> _pool;
+    };
+}
@@ -26,7 +26,8 @@ namespace librealsense
         _width(0), _height(0), _stride(0), _bpp(0),
         _extension_type(RS2_EXTENSION_DEPTH_FRAME),
         _current_frm_size_pixels(0),
-        _hole_filling_mode(hole_fill_def)
+        _hole_filling_mode(hole_fill_def),
+        _pool(parallel_pool::get())
     {
         _stream_filter.stream = RS2_STREAM_DEPTH;
         _stream_filter.format = RS2_FORMAT_Z16;
@@ -65,15 +66,33 @@ namespace librealsense
         update_configuration(f);
         auto tgt = prepare_target_frame(f, source);
 
-        // Hole filling pass
+        // Hole filling pass, from the input into the target
         if (_extension_type == RS2_EXTENSION_DISPARITY_FRAME)
-            apply_hole_filling<float>(const_cast<void*>(tgt.get_data()));
+            apply_hole_filling<float>(f.get_data(), const_cast<void*>(tgt.get_data()));
         else
-            apply_hole_filling<uint16_t>(const_cast<void*>(tgt.get_data()));
+            apply_hole_filling<uint16_t>(f.get_data(), const_cast<void*>(tgt.get_data()));
 
         return tgt;
     }
 
+    void hole_filling_filter::filter_disparity(float * disparity, size_t width, size_t height)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        if (_width != width || _height != height || _extension_type != RS2_EXTENSION_DISPARITY_FRAME)
+        {
+            _source_stream_profile = rs2::stream_profile();
+            _extension_type = RS2_EXTENSION_DISPARITY_FRAME;
+            _bpp = sizeof(float);
+            _width = width;
+            _height = height;
+            _stride = _width * _bpp;
+            _current_frm_size_pixels = _width * _height;
+        }
+
+        apply_hole_filling<float>(disparity, disparity);
+    }
+
     void  hole_filling_filter::update_configuration(const rs2::frame& f)
     {
         if (f.get_profile().get() != _source_stream_profile.get())
@@ -94,11 +113,8 @@ namespace librealsense
 
     rs2::frame hole_filling_filter::prepare_target_frame(const rs2::frame& f, const rs2::frame_source& source)
     {
-        // Allocate and copy the content of the input data to the target
-        rs2::frame tgt = source.allocate_video_frame(_target_stream_profile, f, int(_bpp), int(_width), int(_height), int(_stride), _extension_type);
-
-        memmove(const_cast<void*>(tgt.get_data()), f.get_data(), _current_frm_size_pixels * _bpp);
-        return tgt;
+        // Allocate the target; the hole filling writes all of it
+        return source.allocate_video_frame(_target_stream_profile, f, int(_bpp), int(_width), int(_height), int(_stride), _extension_type);
     }
 
 }
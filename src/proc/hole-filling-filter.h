@@ -3,23 +3,21 @@
 // Enhancing the input video frame by filling missing data.
 #pragma once
 
+#include "hole-filling-kernels.h"
+#include "parallel-pool.h"
+
 #include <rsutils/string/from.h>
 
 namespace librealsense
 {
-    enum holes_filling_types : uint8_t
-    {
-        hf_fill_from_left,
-        hf_farest_from_around,
-        hf_nearest_from_around,
-        hf_max_value
-    };
-
     class hole_filling_filter : public depth_processing_block
     {
     public:
         hole_filling_filter();
 
+        // Fills the holes of a disparity frame in place
+        void filter_disparity(float * disparity, size_t width, size_t height);
+
     protected:
         void update_configuration(const rs2::frame& f);
         rs2::frame process_frame(const rs2::frame_source& source, const rs2::frame& f) override;
@@ -27,22 +25,22 @@ namespace librealsense
         rs2::frame prepare_target_frame(const rs2::frame& f, const rs2::frame_source& source);
 
         template<typename T>
-        void apply_hole_filling(void * image_data)
+        void apply_hole_filling(const void * source_data, void * image_data)
         {
-            bool fp = (std::is_floating_point<T>::value);
+            const T* in = reinterpret_cast<const T*>(source_data);
             T* data = reinterpret_cast<T*>(image_data);
 
             // Select and apply the appropriate hole filling method
             switch (_hole_filling_mode)
             {
             case hf_fill_from_left:
-                holes_fill_left(data, _width, _height, _stride);
+                hole_fill<hf_fill_from_left>(in, data, _width, _height, _pool.get());
                 break;
             case hf_farest_from_around:
-                holes_fill_farest(data, _width, _height, _stride);
+                hole_fill<hf_farest_from_around>(in, data, _width, _height, _pool.get());
                 break;
             case hf_nearest_from_around:
-                holes_fill_nearest(data, _width, _height, _stride);
+                hole_fill<hf_nearest_from_around>(in, data, _width, _height, _pool.get());
                 break;
             default:
                 throw invalid_value_exception( rsutils::string::from() << "Unsupported hole filling mode: "
@@ -50,114 +48,6 @@ namespace librealsense
             }
         }
 
-        // Implementations of the hole-filling methods
-        template<typename T>
-        inline void holes_fill_left(T* image_data, size_t width, size_t height, size_t stride)
-        {
-            std::function<bool(T*)> fp_oper = [](T* ptr) { return !*((int *)ptr); };
-            std::function<bool(T*)> uint_oper = [](T* ptr) { return !(*ptr); };
-            auto empty = (std::is_floating_point<T>::value) ? fp_oper : uint_oper;
-
-            T* p = image_data;
-
-            for (size_t j = 0; j < height; ++j)
-            {
-                ++p;
-                for (size_t i = 1; i < width; ++i)
-                {
-                    if (empty(p))
-                        *p = *(p - 1);
-                    ++p;
-                }
-            }
-        }
-
-        template<typename T>
-        inline void holes_fill_farest(T* image_data, size_t width, size_t height, size_t stride)
-        {
-            std::function<bool(T*)> fp_oper = [](T* ptr) { return !*((int *)ptr); };
-            std::function<bool(T*)> uint_oper = [](T* ptr) { return !(*ptr); };
-            auto empty = (std::is_floating_point<T>::value) ? fp_oper : uint_oper;
-
-            T tmp = 0;
-            T * p = image_data + width;
-            T * q = nullptr;
-            for (int j = 1; j < height - 1; ++j)
-            {
-                ++p;
-                for (size_t i = 1; i < width; ++i)
-                {
-                    if (empty(p))
-                    {
-                        tmp = *(p - width);
-
-                        q = p - width - 1;
-                        if (*q > tmp)
-                            tmp = *q;
-
-                        q = p - 1;
-                        if (*q > tmp)
-                            tmp = *q;
-
-                        q = p + width - 1;
-                        if (*q > tmp)
-                            tmp = *q;
-
-                        q = p + width;
-                        if (*q > tmp)
-                            tmp = *q;
-
-                        *p = tmp;
-                    }
-
-                    p++;
-                }
-            }
-        }
-
-        template<typename T>
-        inline void holes_fill_nearest(T* image_data, size_t width, size_t height, size_t stride)
-        {
-            std::function<bool(T*)> fp_oper = [](T* ptr) { return !*((int *)ptr); };
-            std::function<bool(T*)> uint_oper = [](T* ptr) { return !(*ptr); };
-            auto empty = (std::is_floating_point<T>::value) ? fp_oper : uint_oper;
-
-            T tmp = 0;
-            T * p = image_data + width;
-            T * q = nullptr;
-            for (int j = 1; j < height - 1; ++j)
-            {
-                ++p;
-                for (size_t i = 1; i < width; ++i)
-                {
-                    if (empty(p))
-                    {
-                        tmp = *(p - width);
-
-                        q = p - width - 1;
-                        if (!empty(q) && (*q < tmp))
-                            tmp = *q;
-
-                        q = p - 1;
-                        if (!empty(q) && (*q < tmp))
-                            tmp = *q;
-
-                        q = p + width - 1;
-                        if (!empty(q) && (*q < tmp))
-                            tmp = *q;
-
-                        q = p + width;
-                        if (!empty(q) && (*q < tmp))
-                            tmp = *q;
-
-                        *p = tmp;
-                    }
-
-                    p++;
-                }
-            }
-        }
-
     private:
 
         size_t                  _width, _height, _stride;
@@ -167,6 +57,7 @@ namespace librealsense
         rs2::stream_profile     _source_stream_profile;
         rs2::stream_profile     _target_stream_profile;
         uint8_t                 _hole_filling_mode;
+        std::shared_ptr<parallel_pool> _pool;
     };
     MAP_EXTENSION(RS2_EXTENSION_HOLE_FILLING_FILTER, librealsense::hole_filling_filter);
 }
@@ -0,0 +1,318 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include "hole-filling-kernels.h"
+#include "parallel-pool.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#if defined(__SSSE3__)
+#include <emmintrin.h>
+#define HOLE_FILL_SIMD
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define HOLE_FILL_SIMD
+#endif
+
+
+namespace librealsense
+{
+    namespace
+    {
+        // Bands smaller than this are not worth refilling their first rows for
+        const size_t min_band_rows = 16;
+
+        template< class T >
+        bool is_hole( T v ) { return v == T( 0 ); }
+
+        // The value of a hole at column i, given the rows around it and its left neighbour (already filled)
+        template< holes_filling_types Mode, class T >
+        struct fill_rule;
+
+        template< class T >
+        struct fill_rule< hf_fill_from_left, T >
+        {
+            static T fill( T const *, T left, T const *, size_t ) { return left; }
+        };
+
+        // The farthest of the neighbours above, to the left and below
+        template< class T >
+        struct fill_rule< hf_farest_from_around, T >
+        {
+            static T fill( T const * above, T left, T const * below, size_t i )
+            {
+                T tmp = above[i];
+                if( above[i - 1] > tmp )
+                    tmp = above[i - 1];
+                if( left > tmp )
+                    tmp = left;
+                if( below[i - 1] > tmp )
+                    tmp = below[i - 1];
+                if( below[i] > tmp )
+                    tmp = below[i];
+                return tmp;
+            }
+        };
+
+        // The nearest valid neighbour, if the one above is valid
+        template< class T >
+        struct fill_rule< hf_nearest_from_around, T >
+        {
+            static T fill( T const * above, T left, T const * below, size_t i )
+            {
+                T tmp = above[i];
+                if( ! is_hole( above[i - 1] ) && above[i - 1] < tmp )
+                    tmp = above[i - 1];
+                if( ! is_hole( left ) && left < tmp )
+                    tmp = left;
+                if( ! is_hole( below[i - 1] ) && below[i - 1] < tmp )
+                    tmp = below[i - 1];
+                if( ! is_hole( below[i] ) && below[i] < tmp )
+                    tmp = below[i];
+                return tmp;
+            }
+        };
+
+#ifdef HOLE_FILL_SIMD
+#if defined(__SSSE3__)
+        typedef __m128i u16x8;
+        inline u16x8 load( uint16_t const * p ) { return _mm_loadu_si128( reinterpret_cast< __m128i const * >( p ) ); }
+        inline void store( uint16_t * p, u16x8 v ) { _mm_storeu_si128( reinterpret_cast< __m128i * >( p ), v ); }
+        inline u16x8 zeros() { return _mm_setzero_si128(); }
+        inline u16x8 dup_u16( uint16_t x ) { return _mm_set1_epi16( short( x ) ); }
+        inline u16x8 first_lane( uint16_t x ) { return _mm_cvtsi32_si128( x ); }  // the others are 0
+        inline u16x8 is_zero( u16x8 v ) { return _mm_cmpeq_epi16( v, _mm_setzero_si128() ); }
+        inline u16x8 is_not_zero( u16x8 v ) { return _mm_xor_si128( is_zero( v ), _mm_set1_epi8( -1 ) ); }
+        inline bool any( u16x8 mask ) { return _mm_movemask_epi8( mask ) != 0; }
+        inline u16x8 and_( u16x8 a, u16x8 b ) { return _mm_and_si128( a, b ); }
+        inline u16x8 and_not( u16x8 a, u16x8 b ) { return _mm_andnot_si128( b, a ); }  // a & ~b
+        inline u16x8 select( u16x8 mask, u16x8 a, u16x8 b ) { return _mm_or_si128( _mm_and_si128( mask, a ), _mm_andnot_si128( mask, b ) ); }
+        // SSE2 has no unsigned 16-bit min/max
+        inline u16x8 max_u16( u16x8 a, u16x8 b ) { return _mm_adds_epu16( _mm_subs_epu16( a, b ), b ); }
+        inline u16x8 min_u16( u16x8 a, u16x8 b ) { return _mm_subs_epu16( a, _mm_subs_epu16( a, b ) ); }
+        inline u16x8 add_u16( u16x8 a, u16x8 b ) { return _mm_add_epi16( a, b ); }
+        // Lane k gets lane k - N, and the first N lanes get 0
+        template< int N > u16x8 shift_up( u16x8 v ) { return _mm_slli_si128( v, 2 * N ); }
+#else
+        typedef uint16x8_t u16x8;
+        inline u16x8 load( uint16_t const * p ) { return vld1q_u16( p ); }
+        inline void store( uint16_t * p, u16x8 v ) { vst1q_u16( p, v ); }
+        inline u16x8 zeros() { return vdupq_n_u16( 0 ); }
+        inline u16x8 dup_u16( uint16_t x ) { return vdupq_n_u16( x ); }
+        inline u16x8 first_lane( uint16_t x ) { return vsetq_lane_u16( x, vdupq_n_u16( 0 ), 0 ); }
+        inline u16x8 is_zero( u16x8 v ) { return vceqq_u16( v, vdupq_n_u16( 0 ) ); }
+        inline u16x8 is_not_zero( u16x8 v ) { return vtstq_u16( v, v ); }
+        inline bool any( u16x8 mask )
+        {
+            uint64x2_t m = vreinterpretq_u64_u16( mask );
+            return ( vgetq_lane_u64( m, 0 ) | vgetq_lane_u64( m, 1 ) ) != 0;
+        }
+        inline u16x8 and_( u16x8 a, u16x8 b ) { return vandq_u16( a, b ); }
+        inline u16x8 and_not( u16x8 a, u16x8 b ) { return vbicq_u16( a, b ); }
+        inline u16x8 select( u16x8 mask, u16x8 a, u16x8 b ) { return vbslq_u16( mask, a, b ); }
+        inline u16x8 max_u16( u16x8 a, u16x8 b ) { return vmaxq_u16( a, b ); }
+        inline u16x8 min_u16( u16x8 a, u16x8 b ) { return vminq_u16( a, b ); }
+        inline u16x8 add_u16( u16x8 a, u16x8 b ) { return vaddq_u16( a, b ); }
+        template< int N > u16x8 shift_up( u16x8 v ) { return vextq_u16( vdupq_n_u16( 0 ), v, 8 - N ); }
+#endif
+
+        // The rules for 8 depth pixels at a time: what a hole takes from the rows above and below ('partial'), and how
+        // it combines with its left neighbour. Combining is associative, with 0 as identity, so a run of holes is a
+        // (segmented) scan.
+        template< holes_filling_types Mode >
+        struct simd_rule;
+
+        template<>
+        struct simd_rule< hf_fill_from_left >
+        {
+            static u16x8 gather( uint16_t const *, uint16_t const *, size_t ) { return zeros(); }
+            static u16x8 combine( u16x8 a, u16x8 b ) { return max_u16( a, b ); }
+            static u16x8 takes_left( u16x8 holes, u16x8 ) { return holes; }
+        };
+
+        template<>
+        struct simd_rule< hf_farest_from_around >
+        {
+            static u16x8 gather( uint16_t const * above, uint16_t const * below, size_t i )
+            {
+                return max_u16( max_u16( load( above + i - 1 ), load( above + i ) ),
+                                max_u16( load( below + i - 1 ), load( below + i ) ) );
+            }
+            static u16x8 combine( u16x8 a, u16x8 b ) { return max_u16( a, b ); }
+            static u16x8 takes_left( u16x8 holes, u16x8 ) { return holes; }
+        };
+
+        template<>
+        struct simd_rule< hf_nearest_from_around >
+        {
+            // The smallest non-zero: 0 wraps around to the largest when 1 is subtracted, and back after
+            static u16x8 min_valid( u16x8 a, u16x8 b )
+            {
+                u16x8 const minus_one = dup_u16( 0xffff );
+                return add_u16( min_u16( add_u16( a, minus_one ), add_u16( b, minus_one ) ), dup_u16( 1 ) );
+            }
+            // 0 when the one above is a hole
+            static u16x8 gather( uint16_t const * above, uint16_t const * below, size_t i )
+            {
+                u16x8 const up = load( above + i );
+                u16x8 m = min_valid( min_valid( up, load( above + i - 1 ) ), min_valid( load( below + i - 1 ), load( below + i ) ) );
+                return and_( is_not_zero( up ), m );
+            }
+            static u16x8 combine( u16x8 a, u16x8 b ) { return min_valid( a, b ); }
+            // ... and then the left neighbour doesn't matter
+            static u16x8 takes_left( u16x8 holes, u16x8 partial ) { return and_( holes, is_not_zero( partial ) ); }
+        };
+
+        // Fills from column 'i' in blocks of 8, leaving 'i' at the first column not done
+        template< holes_filling_types Mode >
+        void fill_row_simd( uint16_t const * above, uint16_t const * in, uint16_t const * below, uint16_t * out,
+                            size_t width, size_t & i )
+        {
+            typedef simd_rule< Mode > rule;
+            u16x8 const lane_0 = first_lane( 0xffff );
+            for( ; i + 8 <= width; i += 8 )
+            {
+                u16x8 const cur = load( in + i );
+                u16x8 const holes = is_zero( cur );
+                if( ! any( holes ) )
+                {
+                    store( out + i, cur );
+                    continue;
+                }
+                u16x8 const partial = rule::gather( above, below, i );
+                u16x8 v = select( holes, partial, cur );
+                u16x8 chained = rule::takes_left( holes, partial );
+
+                // The left neighbour is already filled: the first pixel takes it
+                v = select( and_( chained, lane_0 ), rule::combine( v, first_lane( out[i - 1] ) ), v );
+                chained = and_not( chained, lane_0 );
+
+                // Then each hole takes its left neighbour's value along runs of holes, 1, 2 and 4 pixels back
+                v = select( chained, rule::combine( v, shift_up< 1 >( v ) ), v );
+                chained = and_( chained, shift_up< 1 >( chained ) );
+                v = select( chained, rule::combine( v, shift_up< 2 >( v ) ), v );
+                chained = and_( chained, shift_up< 2 >( chained ) );
+                v = select( chained, rule::combine( v, shift_up< 4 >( v ) ), v );
+
+                store( out + i, v );
+            }
+        }
+#endif
+
+        template< holes_filling_types Mode, class T >
+        struct row_filler
+        {
+            static void fill( T const * above, T const * in, T const * below, T * out, size_t width )
+            {
+                if( ! width )
+                    return;
+                out[0] = in[0];
+                for( size_t i = 1; i < width; ++i )
+                    out[i] = is_hole( in[i] ) ? fill_rule< Mode, T >::fill( above, out[i - 1], below, i ) : in[i];
+            }
+        };
+
+#ifdef HOLE_FILL_SIMD
+        template< holes_filling_types Mode >
+        struct row_filler< Mode, uint16_t >
+        {
+            static void fill( uint16_t const * above, uint16_t const * in, uint16_t const * below, uint16_t * out,
+                              size_t width )
+            {
+                if( ! width )
+                    return;
+                out[0] = in[0];
+                size_t i = 1;
+                fill_row_simd< Mode >( above, in, below, out, width, i );
+                for( ; i < width; ++i )
+                    out[i] = is_hole( in[i] ) ? fill_rule< Mode, uint16_t >::fill( above, out[i - 1], below, i ) : in[i];
+            }
+        };
+#endif
+
+        template< holes_filling_types Mode, class T >
+        void fill_row( T const * above, T const * in, T const * below, T * out, size_t width )
+        {
+            row_filler< Mode, T >::fill( above, in, below, out, width );
+        }
+    }
+
+    template< holes_filling_types Mode, class T >
+    void hole_fill( T const * in, T * out, size_t width, size_t height, parallel_pool * pool )
+    {
+        if( ! width || ! height )
+            return;
+
+        if( Mode == hf_fill_from_left )
+        {
+            auto fill_rows = [&]( size_t first_row, size_t last_row ) {
+                for( size_t j = first_row; j < last_row; ++j )
+                    fill_row< Mode >( (T const *)nullptr, in + j * width, (T const *)nullptr, out + j * width, width );
+            };
+            if( pool )
+                pool->parallel_for( height, min_band_rows, fill_rows );
+            else
+                fill_rows( 0, height );
+            return;
+        }
+
+        if( in != out )
+        {
+            memcpy( out, in, width * sizeof( T ) );
+            if( height > 1 )
+                memcpy( out + ( height - 1 ) * width, in + ( height - 1 ) * width, width * sizeof( T ) );
+        }
+        if( height < 3 )
+            return;
+
+        // Rows [first_row, last_row), each against the row above it, then against the row it filled
+        auto fill_rows = [&]( size_t first_row, size_t last_row, T const * above ) {
+            for( size_t j = first_row; j < last_row; ++j )
+            {
+                fill_row< Mode >( above, in + j * width, in + ( j + 1 ) * width, out + j * width, width );
+                above = out + j * width;
+            }
+        };
+
+        size_t const rows = height - 2;
+        size_t const n_bands = ( pool && in != out ) ? std::min( pool->concurrency(), rows / min_band_rows ) : 1;
+        if( n_bands <= 1 )
+        {
+            fill_rows( 1, height - 1, out );
+            return;
+        }
+
+        auto band_start = [&]( size_t band ) { return 1 + rows * band / n_bands; };
+        pool->parallel_for( n_bands, 1, [&]( size_t first_band, size_t last_band ) {
+            for( size_t band = first_band; band < last_band; ++band )
+            {
+                // The other bands don't know what the row above them will be filled with: take it as it is for now
+                size_t const first_row = band_start( band );
+                fill_rows( first_row, band_start( band + 1 ), ( band ? in : out ) + ( first_row - 1 ) * width );
+            }
+        } );
+
+        // The row above each band is now final: refill its rows until one comes out as it was, and the rest with it
+        std::vector< T > row( width );
+        for( size_t band = 1; band < n_bands; ++band )
+        {
+            for( size_t j = band_start( band ); j < height - 1; ++j )
+            {
+                T * target = out + j * width;
+                fill_row< Mode >( target - width, in + j * width, in + ( j + 1 ) * width, row.data(), width );
+                if( ! memcmp( row.data(), target, width * sizeof( T ) ) )
+                    break;
+                memcpy( target, row.data(), width * sizeof( T ) );
+            }
+        }
+    }
+
+    template void hole_fill< hf_fill_from_left, uint16_t >( uint16_t const *, uint16_t *, size_t, size_t, parallel_pool * );
+    template void hole_fill< hf_farest_from_around, uint16_t >( uint16_t const *, uint16_t *, size_t, size_t, parallel_pool * );
+    template void hole_fill< hf_nearest_from_around, uint16_t >( uint16_t const *, uint16_t *, size_t, size_t, parallel_pool * );
+    template void hole_fill< hf_fill_from_left, float >( float const *, float *, size_t, size_t, parallel_pool * );
+    template void hole_fill< hf_farest_from_around, float >( float const *, float *, size_t, size_t, parallel_pool * );
+    template void hole_fill< hf_nearest_from_around, float >( float const *, float *, size_t, size_t, parallel_pool * );
+}
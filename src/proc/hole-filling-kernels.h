@@ -0,0 +1,35 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace librealsense
+{
+    class parallel_pool;
+
+    enum holes_filling_types : uint8_t
+    {
+        hf_fill_from_left,
+        hf_farest_from_around,
+        hf_nearest_from_around,
+        hf_max_value
+    };
+
+    // The hole-filling modes of hole_filling_filter, for depth (uint16_t) and disparity (float) frames. A hole is a
+    // pixel that is 0; the first column is kept as is, and so are the first and last rows in the farest/nearest modes.
+    //
+    // A hole is filled from its neighbours after the holes before it were filled: the one to its left, and for
+    // farest/nearest the row above. The results are those of filling the whole image in place, in order.
+    //
+    // 'in' and 'out' may be the same buffer. Rows are split across the pool, if given:
+    // - From the left, rows are independent.
+    // - Farest/nearest (out of place only) fill bands of rows against the unfilled row above them, then refill the
+    //   first rows of each band, in order, until they come out the same.
+    // Where SSE2 or NEON are available, the neighbours of 8 depth pixels are gathered at a time.
+    template< holes_filling_types Mode, class T >
+    void hole_fill( T const * in, T * out, size_t width, size_t height, parallel_pool * pool );
+}
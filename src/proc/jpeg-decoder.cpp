@@ -0,0 +1,177 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include "jpeg-decoder.h"
+
+#include <rsutils/easylogging/easyloggingpp.h>
+
+#include <algorithm>
+#include <cstring>
+
+#ifdef RS2_USE_TURBOJPEG
+#include <turbojpeg.h>
+#endif
+
+#define STB_IMAGE_STATIC
+#define STB_IMAGE_IMPLEMENTATION
+#include "../third-party/stb_image.h"
+
+
+namespace librealsense
+{
+    static int bytes_per_pixel( rs2_format format )
+    {
+        return format == RS2_FORMAT_Y8 ? 1 : 3;
+    }
+
+    bool jpeg_decoder::is_supported( rs2_format format )
+    {
+        return format == RS2_FORMAT_RGB8 || format == RS2_FORMAT_BGR8 || format == RS2_FORMAT_Y8;
+    }
+
+    // Decodes the full image into a temporary buffer, then copies (or averages scale x scale blocks of) it into the
+    // destination
+    class stb_jpeg_decoder : public jpeg_decoder
+    {
+    public:
+        const char * get_name() const override { return "stb_image"; }
+
+        bool decode( uint8_t const * jpeg, size_t size, rs2_format format, int scale,
+                     uint8_t * dest, int width, int height ) override
+        {
+            int const bpp = bytes_per_pixel( format );
+            int w, h, components;
+            if( ! stbi_info_from_memory( jpeg, int( size ), &w, &h, &components ) )
+                return false;
+
+            int const cols = ( w + scale - 1 ) / scale;
+            int const rows = ( h + scale - 1 ) / scale;
+            if( cols > width || rows > height )
+            {
+                LOG_DEBUG( "jpeg of " << w << "x" << h << " does not fit in " << width << "x" << height << " at 1/" << scale );
+                return false;
+            }
+
+            auto image = stbi_load_from_memory( jpeg, int( size ), &w, &h, &components, bpp );
+            if( ! image )
+                return false;
+
+            bool const swap_rb = format == RS2_FORMAT_BGR8;
+            for( int y = 0; y < rows; ++y )
+            {
+                auto out = dest + size_t( y ) * width * bpp;
+                if( scale == 1 )
+                {
+                    auto in = image + size_t( y ) * w * bpp;
+                    if( ! swap_rb )
+                    {
+                        std::memcpy( out, in, size_t( cols ) * bpp );
+                        continue;
+                    }
+                    for( int x = 0; x < cols; ++x, in += bpp, out += bpp )
+                    {
+                        out[0] = in[2];
+                        out[1] = in[1];
+                        out[2] = in[0];
+                    }
+                    continue;
+                }
+
+                // The blocks at the right and bottom edges may be partial
+                int const y0 = y * scale, y1 = std::min( h, y0 + scale );
+                for( int x = 0; x < cols; ++x, out += bpp )
+                {
+                    int const x0 = x * scale, x1 = std::min( w, x0 + scale );
+                    int const count = ( y1 - y0 ) * ( x1 - x0 );
+                    for( int c = 0; c < bpp; ++c )
+                    {
+                        int sum = 0;
+                        for( int yy = y0; yy < y1; ++yy )
+                            for( int xx = x0; xx < x1; ++xx )
+                                sum += image[( size_t( yy ) * w + xx ) * bpp + c];
+                        out[swap_rb ? 2 - c : c] = uint8_t( ( sum + count / 2 ) / count );
+                    }
+                }
+            }
+
+            stbi_image_free( image );
+            return true;
+        }
+    };
+
+#ifdef RS2_USE_TURBOJPEG
+    // Decodes straight into the destination, scaling in the DCT domain; the decompressor is kept between frames
+    class turbo_jpeg_decoder : public jpeg_decoder
+    {
+        tjhandle _handle;
+
+    public:
+        turbo_jpeg_decoder()
+            : _handle( tjInitDecompress() )
+        {
+        }
+
+        ~turbo_jpeg_decoder() override
+        {
+            if( _handle )
+                tjDestroy( _handle );
+        }
+
+        bool valid() const { return _handle != nullptr; }
+
+        const char * get_name() const override { return "libjpeg-turbo"; }
+
+        bool decode( uint8_t const * jpeg, size_t size, rs2_format format, int scale,
+                     uint8_t * dest, int width, int height ) override
+        {
+            int w, h, subsampling, colorspace;
+            auto src = const_cast< unsigned char * >( jpeg );  // older versions of the API are not const-correct
+            if( tjDecompressHeader3( _handle, src, static_cast< unsigned long >( size ), &w, &h, &subsampling, &colorspace ) )
+            {
+                LOG_DEBUG( "jpeg header: " << tjGetErrorStr2( _handle ) );
+                return false;
+            }
+
+            // The decompressor picks the largest scaling factor that fits in the width and height it is given
+            tjscalingfactor factor = { 1, scale };
+            int scaled_w = TJSCALED( w, factor );
+            int scaled_h = TJSCALED( h, factor );
+            if( scaled_w > width || scaled_h > height )
+            {
+                LOG_DEBUG( "jpeg of " << w << "x" << h << " does not fit in " << width << "x" << height << " at 1/" << scale );
+                return false;
+            }
+
+            int pixel_format = format == RS2_FORMAT_Y8 ? TJPF_GRAY : format == RS2_FORMAT_BGR8 ? TJPF_BGR : TJPF_RGB;
+            int pitch = width * bytes_per_pixel( format );
+            if( tjDecompress2( _handle, src, static_cast< unsigned long >( size ), dest, scaled_w, pitch, scaled_h,
+                               pixel_format, 0 ) )
+            {
+                // Warnings (e.g., a truncated image) still leave a usable frame
+                if( tjGetErrorCode( _handle ) != TJERR_WARNING )
+                {
+                    LOG_DEBUG( "jpeg decompress: " << tjGetErrorStr2( _handle ) );
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+#endif
+
+    std::unique_ptr< jpeg_decoder > jpeg_decoder::create()
+    {
+#ifdef RS2_USE_TURBOJPEG
+        std::unique_ptr< turbo_jpeg_decoder > turbo( new turbo_jpeg_decoder() );
+        if( turbo->valid() )
+            return std::move( turbo );
+        LOG_WARNING( "Failed to initialize libjpeg-turbo; falling back to stb_image" );
+#endif
+        return create_stb();
+    }
+
+    std::unique_ptr< jpeg_decoder > jpeg_decoder::create_stb()
+    {
+        return std::unique_ptr< jpeg_decoder >( new stb_jpeg_decoder() );
+    }
+}
@@ -0,0 +1,45 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include <src/basics.h>
+#include <librealsense2/h/rs_sensor.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+
+namespace librealsense
+{
+    // Decompresses (M)JPEG images straight into a frame buffer.
+    //
+    // A decoder is meant to be created once per stream and reused for every frame: the libjpeg-turbo implementation
+    // (used when the library was found at configure time, see RS2_USE_TURBOJPEG) keeps its decompressor state between
+    // frames, and stb_image is the fallback.
+    class LRS_EXTENSION_API jpeg_decoder
+    {
+    public:
+        static std::unique_ptr< jpeg_decoder > create();
+
+        // The stb_image decoder, regardless of what create() would return
+        static std::unique_ptr< jpeg_decoder > create_stb();
+
+        // RGB8, BGR8 and Y8 (luminance only)
+        static bool is_supported( rs2_format format );
+
+        // The DCT scaling factors the decoders support: the image is decoded at 1/scale of its size
+        static bool is_supported_scale( int scale ) { return scale == 1 || scale == 2 || scale == 4; }
+
+        virtual ~jpeg_decoder() = default;
+
+        virtual const char * get_name() const = 0;
+
+        // Decode 'size' bytes of JPEG at 1/scale of its size into 'dest', a width x height image of the given format and
+        // a packed stride. Returns false if the image could not be decoded, or if at that scale (rounded up) it is larger
+        // than width x height; rows or columns a smaller image does not cover are left untouched.
+        virtual bool decode( uint8_t const * jpeg, size_t size, rs2_format format, int scale,
+                             uint8_t * dest, int width, int height ) = 0;
+    };
+}
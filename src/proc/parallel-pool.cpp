@@ -0,0 +1,163 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include "parallel-pool.h"
+
+#include <rsutils/shared-ptr-singleton.h>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+
+
+namespace librealsense {
+
+
+struct parallel_pool::job
+{
+    std::function< void( size_t, size_t ) > const * body;
+    size_t n;
+    size_t chunk;
+    size_t n_chunks;
+
+    std::atomic< size_t > next{ 0 };
+    std::atomic< size_t > done{ 0 };
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::exception_ptr error;
+
+    // Run the next chunk; false if all were already taken
+    bool run_one()
+    {
+        auto i = next.fetch_add( 1 );
+        if( i >= n_chunks )
+            return false;
+
+        auto begin = i * chunk;
+        try
+        {
+            ( *body )( begin, std::min( n, begin + chunk ) );
+        }
+        catch( ... )
+        {
+            std::lock_guard< std::mutex > lock( mutex );
+            if( ! error )
+                error = std::current_exception();
+        }
+
+        if( done.fetch_add( 1 ) + 1 == n_chunks )
+        {
+            std::lock_guard< std::mutex > lock( mutex );
+            cv.notify_all();
+        }
+        return true;
+    }
+
+    bool exhausted() const { return next.load() >= n_chunks; }
+};
+
+
+static rsutils::shared_ptr_singleton< parallel_pool > the_pool;
+
+
+std::shared_ptr< parallel_pool > parallel_pool::get()
+{
+    size_t n_threads = std::thread::hardware_concurrency();
+    return the_pool.instance( n_threads > 1 ? n_threads - 1 : 0 );
+}
+
+
+parallel_pool::parallel_pool( size_t n_workers )
+{
+    for( size_t i = 0; i < n_workers; ++i )
+        _workers.emplace_back( [this]() { worker(); } );
+}
+
+
+parallel_pool::~parallel_pool()
+{
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        _stopping = true;
+    }
+    _cv.notify_all();
+    for( auto & t : _workers )
+        t.join();
+}
+
+
+void parallel_pool::parallel_for( size_t n, size_t grain, std::function< void( size_t, size_t ) > const & body )
+{
+    if( ! n )
+        return;
+
+    // Enough chunks to balance the load, but none smaller than the grain
+    size_t chunk = std::max( grain, ( n + concurrency() * 4 - 1 ) / ( concurrency() * 4 ) );
+    if( ! chunk )
+        chunk = 1;
+    size_t n_chunks = ( n + chunk - 1 ) / chunk;
+    if( n_chunks == 1 || _workers.empty() )
+    {
+        body( 0, n );
+        return;
+    }
+
+    auto j = std::make_shared< job >();
+    j->body = &body;
+    j->n = n;
+    j->chunk = chunk;
+    j->n_chunks = n_chunks;
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        _jobs.push_back( j );
+    }
+    if( n_chunks - 1 < _workers.size() )
+        for( size_t i = 1; i < n_chunks; ++i )
+            _cv.notify_one();
+    else
+        _cv.notify_all();
+
+    while( j->run_one() )
+        ;
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        auto it = std::find( _jobs.begin(), _jobs.end(), j );
+        if( it != _jobs.end() )
+            _jobs.erase( it );
+    }
+
+    // Chunks may still be running in the workers; the body must outlive them
+    std::unique_lock< std::mutex > lock( j->mutex );
+    j->cv.wait( lock, [&]() { return j->done.load() == j->n_chunks; } );
+    if( j->error )
+        std::rethrow_exception( j->error );
+}
+
+
+void parallel_pool::worker()
+{
+    std::unique_lock< std::mutex > lock( _mutex );
+    while( true )
+    {
+        _cv.wait( lock, [this]() { return _stopping || ! _jobs.empty(); } );
+        if( _stopping )
+            return;
+
+        auto j = _jobs.front();
+        if( j->exhausted() )
+        {
+            // Its remaining chunks are already running; the caller is waiting for them, not for us
+            _jobs.pop_front();
+            continue;
+        }
+
+        lock.unlock();
+        while( j->run_one() )
+            ;
+        lock.lock();
+    }
+}
+
+
+}  // namespace librealsense
@@ -0,0 +1,56 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace librealsense {
+
+
+// A pool of worker threads for splitting the processing of a single frame, e.g. into row bands.
+//
+// The pool is shared by all the processing blocks that hold it (see get()), and lives while any of them does. Several
+// blocks may call parallel_for() at the same time from their own threads: jobs are served in order, and the calling
+// thread always participates in its own job so it makes progress even when the workers are busy elsewhere.
+//
+class parallel_pool
+{
+    struct job;
+
+public:
+    // The shared pool, with a worker per hardware thread (minus the caller)
+    static std::shared_ptr< parallel_pool > get();
+
+    explicit parallel_pool( size_t n_workers );
+    ~parallel_pool();
+
+    parallel_pool( parallel_pool const & ) = delete;
+    parallel_pool & operator=( parallel_pool const & ) = delete;
+
+    // How many threads may run chunks of a job, including the caller
+    size_t concurrency() const { return _workers.size() + 1; }
+
+    // Split [0, n) into chunks of at least 'grain' items (the last may be smaller) and call body( begin, end ) for each,
+    // in parallel; returns when all chunks are done. The first exception thrown by the body is rethrown here.
+    void parallel_for( size_t n, size_t grain, std::function< void( size_t begin, size_t end ) > const & body );
+
+private:
+    void worker();
+
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    std::deque< std::shared_ptr< job > > _jobs;
+    bool _stopping = false;
+    std::vector< std::thread > _workers;
+};
+
+
+}  // namespace librealsense
@@ -25,26 +25,13 @@
 
 namespace librealsense
 {
-    template<class MAP_DEPTH> void deproject_depth(float * points, const rs2_intrinsics & intrin, const uint16_t * depth, MAP_DEPTH map_depth)
-    {
-        for (int y = 0; y < intrin.height; ++y)
-        {
-            for (int x = 0; x < intrin.width; ++x)
-            {
-                const float pixel[] = { (float)x, (float)y };
-                rs2_deproject_pixel_to_point(points, &intrin, pixel, map_depth(*depth++));
-                points += 3;
-            }
-        }
-    }
-
     const float3 * pointcloud::depth_to_points(rs2::points output, 
         const rs2_intrinsics &depth_intrinsics, const rs2::depth_frame& depth_frame)
     {
-        auto image = output.get_vertices();
-        auto depth_scale = depth_frame.get_units();
-        deproject_depth((float*)image, depth_intrinsics, (const uint16_t*)depth_frame.get_data(), [depth_scale](uint16_t z) { return depth_scale * z; });
-        return (float3*)image;
+        auto image = (float3*)output.get_vertices();
+        _depth_rays.update(depth_intrinsics, *_pool);
+        _depth_rays.deproject((const uint16_t*)depth_frame.get_data(), depth_frame.get_units(), image, *_pool);
+        return image;
     }
 
     float3 transform(const rs2_extrinsics *extrin, const float3 &point) { float3 p = {}; rs2_transform_point_to_point(&p.x, extrin, &point.x); return p; }
@@ -293,6 +280,7 @@ namespace librealsense
 
     pointcloud::pointcloud(const char* name)
         : stream_filter_processing_block(name)
+        , _pool(parallel_pool::get())
     {
         _occlusion_filter = std::make_shared<occlusion_filter>();
 
@@ -3,6 +3,7 @@
 
 #pragma once
 #include "synthetic-stream.h"
+#include "depth-rays.h"
 
 namespace librealsense
 {
@@ -46,6 +47,9 @@ namespace librealsense
         // Intermediate translation table of (depth_x*depth_y) with actual texel coordinates per depth pixel
         std::vector<float2>                    _pixels_map;
 
+        depth_rays                             _depth_rays;  // rebuilt when the depth intrinsics change
+        std::shared_ptr<parallel_pool>         _pool;
+
         rs2::stream_profile _output_stream;
         rs2::frame _other_stream;
         rs2::frame _depth_stream;
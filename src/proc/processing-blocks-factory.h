@@ -59,6 +59,23 @@ namespace librealsense
                 } );
         }
 
+        // Targets of another resolution than the source (see stream_profile::resolution_transform), each converted by
+        // a T constructed with the target format and the given arguments
+        template< typename T, typename... Args >
+        static std::vector< processing_block_factory > create_pbf_vector( rs2_format src,
+                                                                          const std::vector< rs2_format > & dst,
+                                                                          rs2_stream stream,
+                                                                          stream_profile::resolution_transform_fn transform,
+                                                                          Args... args )
+        {
+            std::vector< processing_block_factory > factories;
+            for( auto d : dst )
+                factories.push_back( { { { src } },
+                                       { { d, stream, 0, 0, 0, 0, transform } },
+                                       [=]() { return std::make_shared< T >( d, args... ); } } );
+            return factories;
+        }
+
         stream_profiles find_satisfied_requests(const stream_profiles& sp, const stream_profiles& supported_profiles) const;
         bool has_source(const std::shared_ptr<stream_profile_interface>& source) const;
 
@@ -0,0 +1,261 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include "spatial-filter-fp.h"
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSSE3__)
+#include <emmintrin.h>
+#define FP_FILTER_SIMD
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define FP_FILTER_SIMD
+#endif
+
+
+namespace librealsense
+{
+    namespace
+    {
+        inline bool is_valid_fp(float x)
+        {
+            int32_t bits;
+            memcpy(&bits, &x, sizeof(bits));
+            return bits > 0;
+        }
+
+        // Filter a line of n pixels, 'step' apart, in both directions
+        void filter_line_fp(float * line, size_t n, ptrdiff_t step, fp_filter_params const & p)
+        {
+            if (n < 2)
+                return;
+
+            float * im = line;
+            for (int pass = 0; pass < 2; ++pass)
+            {
+                float state = *im;
+                float previous = state;
+                for (size_t i = 1; i < n; ++i)
+                {
+                    im += step;
+                    float innovation = *im;
+                    if (is_valid_fp(innovation))
+                    {
+                        float delta = previous - innovation;
+                        if (is_valid_fp(previous) && delta < p.delta_z && delta > -p.delta_z)
+                            *im = state = innovation * p.alpha + state * (1.0f - p.alpha);
+                        else
+                            state = innovation;
+                    }
+                    previous = innovation;
+                }
+                step = -step;
+            }
+        }
+
+#ifdef FP_FILTER_SIMD
+#if defined(__SSSE3__)
+        typedef __m128 f32x4;
+        typedef __m128 m32x4;
+
+        inline f32x4 load(float const * p) { return _mm_loadu_ps(p); }
+        inline void store(float * p, f32x4 v) { _mm_storeu_ps(p, v); }
+        inline f32x4 splat(float x) { return _mm_set1_ps(x); }
+        inline f32x4 sub(f32x4 a, f32x4 b) { return _mm_sub_ps(a, b); }
+        inline f32x4 blend(f32x4 x, f32x4 state, f32x4 alpha, f32x4 one_minus_alpha)
+        {
+            return _mm_add_ps(_mm_mul_ps(x, alpha), _mm_mul_ps(state, one_minus_alpha));
+        }
+        inline m32x4 is_valid(f32x4 x)
+        {
+            return _mm_castsi128_ps(_mm_cmpgt_epi32(_mm_castps_si128(x), _mm_setzero_si128()));
+        }
+        inline m32x4 is_within(f32x4 d, f32x4 limit, f32x4 neg_limit)
+        {
+            return _mm_and_ps(_mm_cmplt_ps(d, limit), _mm_cmpgt_ps(d, neg_limit));
+        }
+        inline m32x4 both(m32x4 a, m32x4 b) { return _mm_and_ps(a, b); }
+        inline f32x4 select(m32x4 m, f32x4 a, f32x4 b) { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+        inline void transpose(f32x4 & a, f32x4 & b, f32x4 & c, f32x4 & d) { _MM_TRANSPOSE4_PS(a, b, c, d); }
+#else
+        typedef float32x4_t f32x4;
+        typedef uint32x4_t m32x4;
+
+        inline f32x4 load(float const * p) { return vld1q_f32(p); }
+        inline void store(float * p, f32x4 v) { vst1q_f32(p, v); }
+        inline f32x4 splat(float x) { return vdupq_n_f32(x); }
+        inline f32x4 sub(f32x4 a, f32x4 b) { return vsubq_f32(a, b); }
+        inline f32x4 blend(f32x4 x, f32x4 state, f32x4 alpha, f32x4 one_minus_alpha)
+        {
+            return vaddq_f32(vmulq_f32(x, alpha), vmulq_f32(state, one_minus_alpha));
+        }
+        inline m32x4 is_valid(f32x4 x) { return vcgtq_s32(vreinterpretq_s32_f32(x), vdupq_n_s32(0)); }
+        inline m32x4 is_within(f32x4 d, f32x4 limit, f32x4 neg_limit)
+        {
+            return vandq_u32(vcltq_f32(d, limit), vcgtq_f32(d, neg_limit));
+        }
+        inline m32x4 both(m32x4 a, m32x4 b) { return vandq_u32(a, b); }
+        inline f32x4 select(m32x4 m, f32x4 a, f32x4 b) { return vbslq_f32(m, a, b); }
+        inline void transpose(f32x4 & a, f32x4 & b, f32x4 & c, f32x4 & d)
+        {
+            float32x4x2_t ab = vtrnq_f32(a, b);  // a0 b0 a2 b2, a1 b1 a3 b3
+            float32x4x2_t cd = vtrnq_f32(c, d);  // c0 d0 c2 d2, c1 d1 c3 d3
+            a = vcombine_f32(vget_low_f32(ab.val[0]), vget_low_f32(cd.val[0]));
+            b = vcombine_f32(vget_low_f32(ab.val[1]), vget_low_f32(cd.val[1]));
+            c = vcombine_f32(vget_high_f32(ab.val[0]), vget_high_f32(cd.val[0]));
+            d = vcombine_f32(vget_high_f32(ab.val[1]), vget_high_f32(cd.val[1]));
+        }
+#endif
+
+        struct simd_params
+        {
+            f32x4 alpha, one_minus_alpha, delta_z, neg_delta_z;
+
+            explicit simd_params(fp_filter_params const & p)
+                : alpha(splat(p.alpha)), one_minus_alpha(splat(1.0f - p.alpha))
+                , delta_z(splat(p.delta_z)), neg_delta_z(splat(-p.delta_z))
+            {}
+        };
+
+        // The filter state of 4 independent lines; same as filter_line_fp(), without branches
+        struct fp_filter_lanes
+        {
+            f32x4 state, previous;
+            m32x4 previous_valid;
+
+            void start(f32x4 x)
+            {
+                state = previous = x;
+                previous_valid = is_valid(x);
+            }
+
+            f32x4 step(f32x4 innovation, simd_params const & p)
+            {
+                m32x4 valid = is_valid(innovation);
+                m32x4 smooth = both(both(valid, previous_valid), is_within(sub(previous, innovation), p.delta_z, p.neg_delta_z));
+                f32x4 out = select(smooth, blend(innovation, state, p.alpha, p.one_minus_alpha), innovation);
+                state = select(valid, out, state);
+                previous = innovation;
+                previous_valid = valid;
+                return out;
+            }
+        };
+
+        inline f32x4 gather(float * const rows[4], size_t u)
+        {
+            float lanes[4] = { rows[0][u], rows[1][u], rows[2][u], rows[3][u] };
+            return load(lanes);
+        }
+
+        inline void scatter(float * const rows[4], size_t u, f32x4 v)
+        {
+            float lanes[4];
+            store(lanes, v);
+            for (int i = 0; i < 4; ++i)
+                rows[i][u] = lanes[i];
+        }
+
+        // Filter 4 consecutive rows together, transposing 4x4 blocks so each lane follows its own row
+        void filter_4_rows_simd(float * row, size_t width, simd_params const & p)
+        {
+            float * const rows[4] = { row, row + width, row + 2 * width, row + 3 * width };
+            fp_filter_lanes lanes;
+
+            // left to right
+            lanes.start(gather(rows, 0));
+            size_t u = 1;
+            for (; u + 4 <= width; u += 4)
+            {
+                f32x4 a = load(rows[0] + u), b = load(rows[1] + u), c = load(rows[2] + u), d = load(rows[3] + u);
+                transpose(a, b, c, d);
+                a = lanes.step(a, p);
+                b = lanes.step(b, p);
+                c = lanes.step(c, p);
+                d = lanes.step(d, p);
+                transpose(a, b, c, d);
+                store(rows[0] + u, a); store(rows[1] + u, b); store(rows[2] + u, c); store(rows[3] + u, d);
+            }
+            for (; u < width; ++u)
+                scatter(rows, u, lanes.step(gather(rows, u), p));
+
+            // right to left; u is one past the next pixel
+            lanes.start(gather(rows, width - 1));
+            for (u = width - 1; u >= 4; u -= 4)
+            {
+                f32x4 a = load(rows[0] + u - 4), b = load(rows[1] + u - 4), c = load(rows[2] + u - 4), d = load(rows[3] + u - 4);
+                transpose(a, b, c, d);
+                d = lanes.step(d, p);
+                c = lanes.step(c, p);
+                b = lanes.step(b, p);
+                a = lanes.step(a, p);
+                transpose(a, b, c, d);
+                store(rows[0] + u - 4, a); store(rows[1] + u - 4, b); store(rows[2] + u - 4, c); store(rows[3] + u - 4, d);
+            }
+            while (u-- > 0)
+                scatter(rows, u, lanes.step(gather(rows, u), p));
+        }
+
+        // Filter N*4 consecutive columns together, a row at a time
+        template<int N>
+        void filter_columns_simd(float * image, size_t width, size_t height, size_t col, simd_params const & p)
+        {
+            fp_filter_lanes lanes[N];
+            float * im = image + col;
+
+            // top to bottom
+            for (int k = 0; k < N; ++k)
+                lanes[k].start(load(im + 4 * k));
+            for (size_t v = 1; v < height; ++v)
+            {
+                im += width;
+                for (int k = 0; k < N; ++k)
+                    store(im + 4 * k, lanes[k].step(load(im + 4 * k), p));
+            }
+
+            // bottom to top
+            for (int k = 0; k < N; ++k)
+                lanes[k].start(load(im + 4 * k));
+            for (size_t v = 1; v < height; ++v)
+            {
+                im -= width;
+                for (int k = 0; k < N; ++k)
+                    store(im + 4 * k, lanes[k].step(load(im + 4 * k), p));
+            }
+        }
+#endif
+    }
+
+    void filter_rows_fp(float * image, size_t width, size_t first_row, size_t last_row, fp_filter_params const & p)
+    {
+        size_t v = first_row;
+#ifdef FP_FILTER_SIMD
+        if (width >= 2)
+        {
+            simd_params sp(p);
+            for (; v + 4 <= last_row; v += 4)
+                filter_4_rows_simd(image + v * width, width, sp);
+        }
+#endif
+        for (; v < last_row; ++v)
+            filter_line_fp(image + v * width, width, 1, p);
+    }
+
+    void filter_columns_fp(float * image, size_t width, size_t height, size_t first_col, size_t last_col, fp_filter_params const & p)
+    {
+        size_t u = first_col;
+#ifdef FP_FILTER_SIMD
+        if (height >= 2)
+        {
+            simd_params sp(p);
+            for (; u + 16 <= last_col; u += 16)
+                filter_columns_simd<4>(image, width, height, u, sp);
+            for (; u + 4 <= last_col; u += 4)
+                filter_columns_simd<1>(image, width, height, u, sp);
+        }
+#endif
+        for (; u < last_col; ++u)
+            filter_line_fp(image + u, height, ptrdiff_t(width), p);
+    }
+}
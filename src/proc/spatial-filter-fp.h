@@ -0,0 +1,30 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include <cstddef>
+
+
+namespace librealsense
+{
+    // The recursive (domain transform) filter of the spatial filter, for floating-point (disparity) frames.
+    //
+    // Along a line, a valid pixel that follows a valid pixel of similar value is blended into the running state and
+    // replaced by it; any other valid pixel restarts the state. Pixels are valid when their bits, as an int, are
+    // positive (so zeros, negatives and NaNs are all invalid). Each line is filtered forward, then backward.
+    //
+    // Lines are independent, so ranges of rows or columns may be filtered in parallel. Where SSE or NEON are available
+    // 4 lines are filtered at a time, one per lane.
+    struct fp_filter_params
+    {
+        float alpha;    // weight of the current pixel
+        float delta_z;  // the difference from the previous pixel above which no smoothing is done
+    };
+
+    // Filter rows [first_row, last_row) of the image horizontally
+    void filter_rows_fp(float * image, size_t width, size_t first_row, size_t last_row, fp_filter_params const & p);
+
+    // Filter columns [first_col, last_col) of the image vertically
+    void filter_columns_fp(float * image, size_t width, size_t height, size_t first_col, size_t last_col, fp_filter_params const & p);
+}
@@ -8,12 +8,15 @@
 #include "proc/synthetic-stream.h"
 #include "proc/hole-filling-filter.h"
 #include "proc/spatial-filter.h"
+#include "proc/spatial-filter-fp.h"
 
 #include <librealsense2/hpp/rs_sensor.hpp>
 #include <librealsense2/hpp/rs_processing.hpp>
 
 #include <rsutils/string/from.h>
 
+#include <algorithm>
+
 
 namespace librealsense
 {
@@ -57,6 +60,7 @@ namespace librealsense
         _spatial_alpha_param(alpha_default_val),
         _spatial_delta_param(delta_default_val),
         _spatial_iterations(filter_iter_def),
+        _spatial_edge_threshold(delta_default_val),
         _width(0), _height(0), _stride(0), _bpp(0),
         _extension_type(RS2_EXTENSION_DEPTH_FRAME),
         _current_frm_size_pixels(0),
@@ -64,7 +68,8 @@ namespace librealsense
         _focal_lenght_mm(0.f),
         _stereo_baseline_mm(0.f),
         _holes_filling_mode(holes_fill_def),
-        _holes_filling_radius(0)
+        _holes_filling_radius(0),
+        _pool(parallel_pool::get())
     {
         _stream_filter.stream = RS2_STREAM_DEPTH;
         _stream_filter.format = RS2_FORMAT_Z16;
@@ -83,7 +88,7 @@ namespace librealsense
             delta_default_val,
             &_spatial_delta_param, "Edge-preserving Threshold");
 
-        auto weak_spatial_filter_delta = std::weak_ptr<ptr_option<uint8_t>>();
+        auto weak_spatial_filter_delta = std::weak_ptr<ptr_option<uint8_t>>(spatial_filter_delta);
         spatial_filter_delta->on_set([this, weak_spatial_filter_delta](float val)
         {
             auto strong_spatial_filter_delta = weak_spatial_filter_delta.lock();
@@ -175,6 +180,25 @@ namespace librealsense
         return tgt;
     }
 
+    void spatial_filter::filter_disparity(float * disparity, size_t width, size_t height)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        // Set to the disparity frame; a frame of the chain then reconfigures the filter for its own profile
+        if (_width != width || _height != height || _extension_type != RS2_EXTENSION_DISPARITY_FRAME)
+        {
+            _source_stream_profile = rs2::stream_profile();
+            _extension_type = RS2_EXTENSION_DISPARITY_FRAME;
+            _bpp = sizeof(float);
+            _width = width;
+            _height = height;
+            _stride = _width * _bpp;
+            _current_frm_size_pixels = _width * _height;
+        }
+
+        dxf_smooth<float>(disparity, _spatial_alpha_param, _spatial_edge_threshold, _spatial_iterations);
+    }
+
     void  spatial_filter::update_configuration(const rs2::frame& f)
     {
         if (f.get_profile().get() != _source_stream_profile.get())
@@ -241,259 +265,26 @@ namespace librealsense
     void spatial_filter::recursive_filter_horizontal_fp(void * image_data, float alpha, float deltaZ)
     {
         float *image = reinterpret_cast<float*>(image_data);
+        const fp_filter_params params{ alpha, deltaZ };
+        const size_t width = _width, height = _height;
 
-        int v, u;
-
-        for (v = 0; v < _height;) {
-            // left to right
-            float *im = image + v * _width;
-            float state = *im;
-            float previousInnovation = state;
-
-            im++;
-            float innovation = *im;
-            u = int(_width) - 1;
-            if (!(*(int*)&previousInnovation > 0))
-                goto CurrentlyInvalidLR;
-            // else fall through
-
-        CurrentlyValidLR:
-            for (;;) {
-                if (*(int*)&innovation > 0) {
-                    float delta = previousInnovation - innovation;
-                    bool smallDifference = delta < deltaZ && delta > -deltaZ;
-
-                    if (smallDifference) {
-                        float filtered = innovation * alpha + state * (1.0f - alpha);
-                        *im = state = filtered;
-                    }
-                    else {
-                        state = innovation;
-                    }
-                    u--;
-                    if (u <= 0)
-                        goto DoneLR;
-                    previousInnovation = innovation;
-                    im += 1;
-                    innovation = *im;
-                }
-                else {  // switch to CurrentlyInvalid state
-                    u--;
-                    if (u <= 0)
-                        goto DoneLR;
-                    previousInnovation = innovation;
-                    im += 1;
-                    innovation = *im;
-                    goto CurrentlyInvalidLR;
-                }
-            }
-
-        CurrentlyInvalidLR:
-            for (;;) {
-                u--;
-                if (u <= 0)
-                    goto DoneLR;
-                if (*(int*)&innovation > 0) { // switch to CurrentlyValid state
-                    previousInnovation = state = innovation;
-                    im += 1;
-                    innovation = *im;
-                    goto CurrentlyValidLR;
-                }
-                else {
-                    im += 1;
-                    innovation = *im;
-                }
-            }
-        DoneLR:
-
-            // right to left
-            im = image + (v + 1) * _width - 2;  // end of row - two pixels
-            previousInnovation = state = im[1];
-            u = int(_width) - 1;
-            innovation = *im;
-            if (!(*(int*)&previousInnovation > 0))
-                goto CurrentlyInvalidRL;
-            // else fall through
-        CurrentlyValidRL:
-            for (;;) {
-                if (*(int*)&innovation > 0) {
-                    float delta = previousInnovation - innovation;
-                    bool smallDifference = delta < deltaZ && delta > -deltaZ;
-
-                    if (smallDifference) {
-                        float filtered = innovation * alpha + state * (1.0f - alpha);
-                        *im = state = filtered;
-                    }
-                    else {
-                        state = innovation;
-                    }
-                    u--;
-                    if (u <= 0)
-                        goto DoneRL;
-                    previousInnovation = innovation;
-                    im -= 1;
-                    innovation = *im;
-                }
-                else {  // switch to CurrentlyInvalid state
-                    u--;
-                    if (u <= 0)
-                        goto DoneRL;
-                    previousInnovation = innovation;
-                    im -= 1;
-                    innovation = *im;
-                    goto CurrentlyInvalidRL;
-                }
-            }
-
-        CurrentlyInvalidRL:
-            for (;;) {
-                u--;
-                if (u <= 0)
-                    goto DoneRL;
-                if (*(int*)&innovation > 0) { // switch to CurrentlyValid state
-                    previousInnovation = state = innovation;
-                    im -= 1;
-                    innovation = *im;
-                    goto CurrentlyValidRL;
-                }
-                else {
-                    im -= 1;
-                    innovation = *im;
-                }
-            }
-        DoneRL:
-            v++;
-        }
+        // Rows are handed out in groups of 4, so each can be filtered with SIMD
+        _pool->parallel_for((height + 3) / 4, 4, [&](size_t first_group, size_t last_group)
+        {
+            filter_rows_fp(image, width, first_group * 4, std::min(height, last_group * 4), params);
+        });
     }
 
     void spatial_filter::recursive_filter_vertical_fp(void * image_data, float alpha, float deltaZ)
     {
         float *image = reinterpret_cast<float*>(image_data);
+        const fp_filter_params params{ alpha, deltaZ };
+        const size_t width = _width, height = _height;
 
-        int v, u;
-
-        // we'll do one column at a time, top to bottom, bottom to top, left to right,
-
-        for (u = 0; u < _width;) {
-
-            float *im = image + u;
-            float state = im[0];
-            float previousInnovation = state;
-
-            v = int(_height) - 1;
-            im += _width;
-            float innovation = *im;
-
-            if (!(*(int*)&previousInnovation > 0))
-                goto CurrentlyInvalidTB;
-            // else fall through
-
-        CurrentlyValidTB:
-            for (;;) {
-                if (*(int*)&innovation > 0) {
-                    float delta = previousInnovation - innovation;
-                    bool smallDifference = delta < deltaZ && delta > -deltaZ;
-
-                    if (smallDifference) {
-                        float filtered = innovation * alpha + state * (1.0f - alpha);
-                        *im = state = filtered;
-                    }
-                    else {
-                        state = innovation;
-                    }
-                    v--;
-                    if (v <= 0)
-                        goto DoneTB;
-                    previousInnovation = innovation;
-                    im += _width;
-                    innovation = *im;
-                }
-                else {  // switch to CurrentlyInvalid state
-                    v--;
-                    if (v <= 0)
-                        goto DoneTB;
-                    previousInnovation = innovation;
-                    im += _width;
-                    innovation = *im;
-                    goto CurrentlyInvalidTB;
-                }
-            }
-
-        CurrentlyInvalidTB:
-            for (;;) {
-                v--;
-                if (v <= 0)
-                    goto DoneTB;
-                if (*(int*)&innovation > 0) { // switch to CurrentlyValid state
-                    previousInnovation = state = innovation;
-                    im += _width;
-                    innovation = *im;
-                    goto CurrentlyValidTB;
-                }
-                else {
-                    im += _width;
-                    innovation = *im;
-                }
-            }
-        DoneTB:
-
-            im = image + u + (_height - 2) * _width;
-            state = im[_width];
-            previousInnovation = state;
-            innovation = *im;
-            v = int(_height) - 1;
-            if (!(*(int*)&previousInnovation > 0))
-                goto CurrentlyInvalidBT;
-            // else fall through
-        CurrentlyValidBT:
-            for (;;) {
-                if (*(int*)&innovation > 0) {
-                    float delta = previousInnovation - innovation;
-                    bool smallDifference = delta < deltaZ && delta > -deltaZ;
-
-                    if (smallDifference) {
-                        float filtered = innovation * alpha + state * (1.0f - alpha);
-                        *im = state = filtered;
-                    }
-                    else {
-                        state = innovation;
-                    }
-                    v--;
-                    if (v <= 0)
-                        goto DoneBT;
-                    previousInnovation = innovation;
-                    im -= _width;
-                    innovation = *im;
-                }
-                else {  // switch to CurrentlyInvalid state
-                    v--;
-                    if (v <= 0)
-                        goto DoneBT;
-                    previousInnovation = innovation;
-                    im -= _width;
-                    innovation = *im;
-                    goto CurrentlyInvalidBT;
-                }
-            }
-
-        CurrentlyInvalidBT:
-            for (;;) {
-                v--;
-                if (v <= 0)
-                    goto DoneBT;
-                if (*(int*)&innovation > 0) { // switch to CurrentlyValid state
-                    previousInnovation = state = innovation;
-                    im -= _width;
-                    innovation = *im;
-                    goto CurrentlyValidBT;
-                }
-                else {
-                    im -= _width;
-                    innovation = *im;
-                }
-            }
-        DoneBT:
-            u++;
-        }
+        // Strips of whole cache lines (16 pixels), so threads do not write to the same lines
+        _pool->parallel_for((width + 15) / 16, 2, [&](size_t first_strip, size_t last_strip)
+        {
+            filter_columns_fp(image, width, height, first_strip * 16, std::min(width, last_strip * 16), params);
+        });
     }
 }
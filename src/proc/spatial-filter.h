@@ -12,6 +12,7 @@
 
 #include "../include/librealsense2/hpp/rs_frame.hpp"
 #include "../include/librealsense2/hpp/rs_processing.hpp"
+#include "parallel-pool.h"
 
 namespace librealsense
 {
@@ -20,6 +21,9 @@ namespace librealsense
     public:
         spatial_filter();
 
+        // Smooths a disparity frame in place, for blocks that keep it in a buffer of their own (fused_depth_filter)
+        void filter_disparity(float * disparity, size_t width, size_t height);
+
     protected:
         void    update_configuration(const rs2::frame& f);
 
@@ -52,14 +56,13 @@ namespace librealsense
                 intertial_holes_fill<T>(static_cast<T*>(frame_data));
         }
 
+        // Rows (horizontal) and column strips (vertical) are filtered in parallel, several at a time with SIMD
         void recursive_filter_horizontal_fp(void * image_data, float alpha, float deltaZ);
         void recursive_filter_vertical_fp(void * image_data, float alpha, float deltaZ);
 
         template <typename T>
         void  recursive_filter_horizontal(void * image_data, float alpha, float deltaZ)
         {
-            size_t v{}, u{};
-
             // Handle conversions for invalid input data
             const bool fp = (std::is_floating_point<T>::value);
 
@@ -70,91 +73,95 @@ namespace librealsense
             const T delta_z = static_cast<T>(deltaZ);
 
             auto image = reinterpret_cast<T*>(image_data);
-            size_t cur_fill = 0;
 
-            for (v = 0; v < _height; v++)
+            // Rows are independent of each other
+            _pool->parallel_for(_height, 16, [&](size_t first_row, size_t last_row)
             {
-                // left to right
-                T *im = image + v * _width;
-                T val0 = im[0];
-                cur_fill = 0;
+                size_t v{}, u{};
+                size_t cur_fill = 0;
 
-                for (u = 1; u < _width - 1; u++)
+                for (v = first_row; v < last_row; v++)
                 {
-                    T val1 = im[1];
+                    // left to right
+                    T *im = image + v * _width;
+                    T val0 = im[0];
+                    cur_fill = 0;
 
-                    if (fabs(val0) >= valid_threshold)
+                    for (u = 1; u < _width - 1; u++)
                     {
-                        if (fabs(val1) >= valid_threshold)
-                        {
-                            cur_fill = 0;
-                            T diff = static_cast<T>(fabs(val1 - val0));
+                        T val1 = im[1];
 
-                            if (diff >= valid_threshold && diff <= delta_z)
+                        if (fabs(val0) >= valid_threshold)
+                        {
+                            if (fabs(val1) >= valid_threshold)
                             {
-                                float filtered = val1 * alpha + val0 * (1.0f - alpha);
-                                val1 = static_cast<T>(filtered + round);
-                                im[1] = val1;
+                                cur_fill = 0;
+                                T diff = static_cast<T>(fabs(val1 - val0));
+
+                                if (diff >= valid_threshold && diff <= delta_z)
+                                {
+                                    float filtered = val1 * alpha + val0 * (1.0f - alpha);
+                                    val1 = static_cast<T>(filtered + round);
+                                    im[1] = val1;
+                                }
                             }
-                        }
-                        else // Only the old value is valid - appy holes filling
-                        {
-                            if (_holes_filling_radius)
+                            else // Only the old value is valid - appy holes filling
                             {
-                                if (++cur_fill <_holes_filling_radius)
-                                    im[1] = val1 = val0;
+                                if (_holes_filling_radius)
+                                {
+                                    if (++cur_fill <_holes_filling_radius)
+                                        im[1] = val1 = val0;
+                                }
                             }
                         }
-                    }
-
-                    val0 = val1;
-                    im += 1;
-                }
 
-                // right to left
-                im = image + (v + 1) * _width - 2;  // end of row - two pixels
-                T val1 = im[1];
-                cur_fill = 0;
+                        val0 = val1;
+                        im += 1;
+                    }
 
-                for (u = _width - 1; u > 0; u--)
-                {
-                    T val0 = im[0];
+                    // right to left
+                    im = image + (v + 1) * _width - 2;  // end of row - two pixels
+                    T val1 = im[1];
+                    cur_fill = 0;
 
-                    if (val1 >= valid_threshold)
+                    for (u = _width - 1; u > 0; u--)
                     {
-                        if (val0 > valid_threshold)
-                        {
-                            cur_fill = 0;
-                            T diff = static_cast<T>(fabs(val1 - val0));
+                        T val0 = im[0];
 
-                            if (diff <= delta_z)
+                        if (val1 >= valid_threshold)
+                        {
+                            if (val0 > valid_threshold)
                             {
-                                float filtered = val0 * alpha + val1 * (1.0f - alpha);
-                                val0 = static_cast<T>(filtered + round);
-                                im[0] = val0;
+                                cur_fill = 0;
+                                T diff = static_cast<T>(fabs(val1 - val0));
+
+                                if (diff <= delta_z)
+                                {
+                                    float filtered = val0 * alpha + val1 * (1.0f - alpha);
+                                    val0 = static_cast<T>(filtered + round);
+                                    im[0] = val0;
+                                }
                             }
-                        }
-                        else // 'inertial' hole filling
-                        {
-                            if (_holes_filling_radius)
+                            else // 'inertial' hole filling
                             {
-                                if (++cur_fill <_holes_filling_radius)
-                                    im[0] = val0 = val1;
+                                if (_holes_filling_radius)
+                                {
+                                    if (++cur_fill <_holes_filling_radius)
+                                        im[0] = val0 = val1;
+                                }
                             }
                         }
-                    }
 
-                    val1 = val0;
-                    im -= 1;
+                        val1 = val0;
+                        im -= 1;
+                    }
                 }
-            }
+            });
         }
 
         template <typename T>
         void recursive_filter_vertical(void * image_data, float alpha, float deltaZ)
         {
-            size_t v{}, u{};
-
             // Handle conversions for invalid input data
             const bool fp = (std::is_floating_point<T>::value);
 
@@ -166,54 +173,57 @@ namespace librealsense
 
             auto image = reinterpret_cast<T*>(image_data);
 
-            // we'll do one row at a time, top to bottom, then bottom to top
-
-            // top to bottom
+            // we'll do one row at a time, top to bottom, then bottom to top; columns are independent of each other,
+            // so they are split into strips that are filtered in parallel
 
-            T *im = image;
-            T im0{};
-            T imw{};
-            for (v = 1; v < _height; v++)
+            _pool->parallel_for(_width, 64, [&](size_t first_col, size_t last_col)
             {
-                for (u = 0; u < _width; u++)
-                {
-                    im0 = im[0];
-                    imw = im[_width];
+                size_t v{}, u{};
+                T im0{};
+                T imw{};
 
-                    //if ((fabs(im0) >= valid_threshold) && (fabs(imw) >= valid_threshold))
+                // top to bottom
+                for (v = 1; v < _height; v++)
+                {
+                    T *im = image + (v - 1) * _width;
+                    for (u = first_col; u < last_col; u++)
                     {
-                        T diff = static_cast<T>(fabs(im0 - imw));
-                        if (diff < delta_z)
+                        im0 = im[u];
+                        imw = im[u + _width];
+
+                        //if ((fabs(im0) >= valid_threshold) && (fabs(imw) >= valid_threshold))
                         {
-                            float filtered = imw * alpha + im0 * (1.f - alpha);
-                            im[_width] = static_cast<T>(filtered + round);
+                            T diff = static_cast<T>(fabs(im0 - imw));
+                            if (diff < delta_z)
+                            {
+                                float filtered = imw * alpha + im0 * (1.f - alpha);
+                                im[u + _width] = static_cast<T>(filtered + round);
+                            }
                         }
                     }
-                    im += 1;
                 }
-            }
 
-            // bottom to top
-            im = image + (_height - 2) * _width;
-            for (v = 1; v < _height; v++, im -= (_width * 2))
-            {
-                for (u = 0; u < _width; u++)
+                // bottom to top
+                for (v = 1; v < _height; v++)
                 {
-                    im0 = im[0];
-                    imw = im[_width];
-
-                    if ((fabs(im0) >= valid_threshold) && (fabs(imw) >= valid_threshold))
+                    T *im = image + (_height - 1 - v) * _width;
+                    for (u = first_col; u < last_col; u++)
                     {
-                        T diff = static_cast<T>(fabs(im0 - imw));
-                        if (diff < delta_z)
+                        im0 = im[u];
+                        imw = im[u + _width];
+
+                        if ((fabs(im0) >= valid_threshold) && (fabs(imw) >= valid_threshold))
                         {
-                            float filtered = im0 * alpha + imw * (1.f - alpha);
-                            im[0] = static_cast<T>(filtered + round);
+                            T diff = static_cast<T>(fabs(im0 - imw));
+                            if (diff < delta_z)
+                            {
+                                float filtered = im0 * alpha + imw * (1.f - alpha);
+                                im[u] = static_cast<T>(filtered + round);
+                            }
                         }
                     }
-                    im += 1;
                 }
-            }
+            });
         }
 
         template<typename T>
@@ -280,6 +290,7 @@ namespace librealsense
         float                   _stereo_baseline_mm;
         uint8_t                 _holes_filling_mode;
         uint8_t                 _holes_filling_radius;
+        std::shared_ptr<parallel_pool> _pool;
     };
     MAP_EXTENSION(RS2_EXTENSION_SPATIAL_FILTER, librealsense::spatial_filter);
 }
@@ -9,6 +9,7 @@
 
 #include "core/video.h"
 #include "proc/synthetic-stream.h"
+#include "proc/align-scatter.h"
 #include "environment.h"
 #include "stream.h"
 
@@ -191,11 +192,15 @@ inline void get_texture_map_sse(const uint16_t * depth,
         _mm_stream_si128(&res[1], res2_int1);
         res += 2;
     }
+
+    // The streaming stores are weakly ordered: make them visible before the map is used (from other threads, too)
+    _mm_sfence();
 }
 
-image_transform::image_transform(const rs2_intrinsics& from, float depth_scale)
+image_transform::image_transform(const rs2_intrinsics& from, float depth_scale, std::shared_ptr<parallel_pool> pool)
     :_depth(from),
     _depth_scale(depth_scale),
+    _pool(std::move(pool)),
     _pixel_top_left_int(from.width*from.height),
     _pixel_bottom_right_int(from.width*from.height)
 {
@@ -253,32 +258,22 @@ void image_transform::align_depth_to_other(const uint16_t* z_pixels, uint16_t* d
     }
 }
 
-inline void image_transform::move_depth_to_other(const uint16_t* z_pixels, uint16_t* dest, const rs2_intrinsics& to,
-    const std::vector<librealsense::int2>& pixel_top_left_int,
-    const std::vector<librealsense::int2>& pixel_bottom_right_int)
+template<rs2_distortion dist>
+inline void image_transform::get_texture_map(const uint16_t* z_pixels,
+    const std::vector<float>& pre_compute_map_x,
+    const std::vector<float>& pre_compute_map_y,
+    std::vector<int2>& pixels,
+    const rs2_intrinsics& to,
+    const rs2_extrinsics& from_to_other)
 {
-    for (int y = 0; y < _depth.height; ++y)
+    // In blocks of 8 pixels, which keeps each band aligned for the SSE loads and stores
+    const size_t n_blocks = (_depth.height*_depth.width + 7) / 8;
+    _pool->parallel_for(n_blocks, 1024, [&](size_t begin, size_t end)
     {
-        for (int x = 0; x < _depth.width; ++x)
-        {
-            auto depth_pixel_index = y * _depth.width + x;
-            // Skip over depth pixels with the value of zero, we have no depth data so we will not write anything into our aligned images
-            if (z_pixels[depth_pixel_index])
-            {
-                for (int other_y = pixel_top_left_int[depth_pixel_index].y; other_y <= pixel_bottom_right_int[depth_pixel_index].y; ++other_y)
-                {
-                    for (int other_x = pixel_top_left_int[depth_pixel_index].x; other_x <= pixel_bottom_right_int[depth_pixel_index].x; ++other_x)
-                    {
-                        if (other_x < 0 || other_y < 0 || other_x >= to.width || other_y >= to.height)
-                            continue;
-                        auto other_ind = other_y * to.width + other_x;
-
-                        dest[other_ind] = dest[other_ind] ? std::min(dest[other_ind], z_pixels[depth_pixel_index]) : z_pixels[depth_pixel_index];
-                    }
-                }
-            }
-        }
-    }
+        const size_t first = begin * 8;
+        get_texture_map_sse<dist>(z_pixels + first, _depth_scale, static_cast<unsigned int>((end - begin) * 8),
+            pre_compute_map_x.data() + first, pre_compute_map_y.data() + first, (uint8_t *)(pixels.data() + first), to, from_to_other);
+    });
 }
 
 void image_transform::align_other_to_depth(const uint16_t* z_pixels, const uint8_t * source, uint8_t * dest, int bpp, const rs2_intrinsics& to,
@@ -301,8 +296,7 @@ template<rs2_distortion dist>
 inline void image_transform::align_depth_to_other_sse(const uint16_t * z_pixels, uint16_t * dest, const rs2_intrinsics& depth, const rs2_intrinsics& to,
     const rs2_extrinsics& from_to_other)
 {
-    get_texture_map_sse<dist>(z_pixels, _depth_scale, _depth.height*_depth.width, _pre_compute_map_x_top_left.data(),
-        _pre_compute_map_y_top_left.data(), (uint8_t *)_pixel_top_left_int.data(), to, from_to_other);
+    get_texture_map<dist>(z_pixels, _pre_compute_map_x_top_left, _pre_compute_map_y_top_left, _pixel_top_left_int, to, from_to_other);
 
     float fov[2];
     rs2_fov(&depth, fov);
@@ -311,32 +305,27 @@ inline void image_transform::align_depth_to_other_sse(const uint16_t * z_pixels,
     rs2_fov(&to, fov);
     float2 pixels_per_angle_target = { (float)to.width / fov[0], (float)to.height / fov[1] };
 
+    const int2 * bottom_right = _pixel_top_left_int.data();
     if (pixels_per_angle_depth.x < pixels_per_angle_target.x || pixels_per_angle_depth.y < pixels_per_angle_target.y || is_special_resolution(depth, to))
     {
-        get_texture_map_sse<dist>(z_pixels, _depth_scale, _depth.height*_depth.width, _pre_compute_map_x_bottom_right.data(),
-            _pre_compute_map_y_bottom_right.data(), (uint8_t *)_pixel_bottom_right_int.data(), to, from_to_other);
-
-        move_depth_to_other(z_pixels, dest, to, _pixel_top_left_int, _pixel_bottom_right_int);
-    }
-    else
-    {
-        move_depth_to_other(z_pixels, dest, to, _pixel_top_left_int, _pixel_top_left_int);
+        get_texture_map<dist>(z_pixels, _pre_compute_map_x_bottom_right, _pre_compute_map_y_bottom_right, _pixel_bottom_right_int, to, from_to_other);
+        bottom_right = _pixel_bottom_right_int.data();
     }
 
+    scatter_min_depth(*_pool, { z_pixels, _depth.width, _depth.height, _pixel_top_left_int.data(), bottom_right }, dest, to.width, to.height);
+
 }
 
 template<rs2_distortion dist>
 inline void image_transform::align_other_to_depth_sse(const uint16_t * z_pixels, const uint8_t * source, uint8_t * dest, int bpp, const rs2_intrinsics& to,
     const rs2_extrinsics& from_to_other)
 {
-    get_texture_map_sse<dist>(z_pixels, _depth_scale, _depth.height*_depth.width, _pre_compute_map_x_top_left.data(),
-        _pre_compute_map_y_top_left.data(), (uint8_t *)_pixel_top_left_int.data(), to, from_to_other);
+    get_texture_map<dist>(z_pixels, _pre_compute_map_x_top_left, _pre_compute_map_y_top_left, _pixel_top_left_int, to, from_to_other);
 
     std::vector<int2>& bottom_right = _pixel_top_left_int;
     if (to.height < _depth.height && to.width < _depth.width)
     {
-        get_texture_map_sse<dist>(z_pixels, _depth_scale, _depth.height*_depth.width, _pre_compute_map_x_bottom_right.data(),
-            _pre_compute_map_y_bottom_right.data(), (uint8_t *)_pixel_bottom_right_int.data(), to, from_to_other);
+        get_texture_map<dist>(z_pixels, _pre_compute_map_x_bottom_right, _pre_compute_map_y_bottom_right, _pixel_bottom_right_int, to, from_to_other);
 
         bottom_right = _pixel_bottom_right_int;
     }
@@ -371,29 +360,32 @@ void image_transform::move_other_to_depth(const uint16_t* z_pixels,
     const std::vector<librealsense::int2>& pixel_top_left_int,
     const std::vector<librealsense::int2>& pixel_bottom_right_int)
 {
-    // Iterate over the pixels of the depth image
-    for (int y = 0; y < _depth.height; ++y)
+    // Iterate over the pixels of the depth image, in bands of rows: only the depth pixel is written
+    _pool->parallel_for(_depth.height, 16, [&](size_t begin, size_t end)
     {
-        for (int x = 0; x < _depth.width; ++x)
+        for (int y = int(begin); y < int(end); ++y)
         {
-            auto depth_pixel_index = y * _depth.width + x;
-            // Skip over depth pixels with the value of zero, we have no depth data so we will not write anything into our aligned images
-            if (z_pixels[depth_pixel_index])
+            for (int x = 0; x < _depth.width; ++x)
             {
-                for (int other_y = pixel_top_left_int[depth_pixel_index].y; other_y <= pixel_bottom_right_int[depth_pixel_index].y; ++other_y)
+                auto depth_pixel_index = y * _depth.width + x;
+                // Skip over depth pixels with the value of zero, we have no depth data so we will not write anything into our aligned images
+                if (z_pixels[depth_pixel_index])
                 {
-                    for (int other_x = pixel_top_left_int[depth_pixel_index].x; other_x <= pixel_bottom_right_int[depth_pixel_index].x; ++other_x)
+                    for (int other_y = pixel_top_left_int[depth_pixel_index].y; other_y <= pixel_bottom_right_int[depth_pixel_index].y; ++other_y)
                     {
-                        if (other_x < 0 || other_y < 0 || other_x >= to.width || other_y >= to.height)
-                            continue;
-                        auto other_ind = other_y * to.width + other_x;
-
-                        dest[depth_pixel_index] = source[other_ind];
+                        for (int other_x = pixel_top_left_int[depth_pixel_index].x; other_x <= pixel_bottom_right_int[depth_pixel_index].x; ++other_x)
+                        {
+                            if (other_x < 0 || other_y < 0 || other_x >= to.width || other_y >= to.height)
+                                continue;
+                            auto other_ind = other_y * to.width + other_x;
+
+                            dest[depth_pixel_index] = source[other_ind];
+                        }
                     }
                 }
             }
         }
-    }
+    });
 }
 
 void align_sse::reset_cache(rs2_stream from, rs2_stream to)
@@ -417,7 +409,7 @@ void align_sse::align_z_to_other(rs2::video_frame& aligned, const rs2::video_fra
 
     if (_stream_transform == nullptr)
     {
-        _stream_transform = std::make_shared<image_transform>(z_intrin, z_scale);
+        _stream_transform = std::make_shared<image_transform>(z_intrin, z_scale, _pool);
         _stream_transform->pre_compute_x_y_map_corners();
     }
     _stream_transform->align_depth_to_other(z_pixels, reinterpret_cast<uint16_t*>(aligned_data), 2, z_intrin, other_intrin, z_to_other);
@@ -441,7 +433,7 @@ void align_sse::align_other_to_z(rs2::video_frame& aligned, const rs2::video_fra
 
     if (_stream_transform == nullptr)
     {
-        _stream_transform = std::make_shared<image_transform>(z_intrin, z_scale);
+        _stream_transform = std::make_shared<image_transform>(z_intrin, z_scale, _pool);
         _stream_transform->pre_compute_x_y_map_corners();
     }
 
@@ -12,7 +12,8 @@ namespace librealsense
     public:
 
         image_transform(const rs2_intrinsics& from,
-            float depth_scale);
+            float depth_scale,
+            std::shared_ptr<parallel_pool> pool);
 
         inline void align_depth_to_other(const uint16_t* z_pixels,
             uint16_t* dest, int bpp,
@@ -31,6 +32,7 @@ namespace librealsense
 
         const rs2_intrinsics _depth;
         float _depth_scale;
+        std::shared_ptr<parallel_pool> _pool;
 
         std::vector<float> _pre_compute_map_x_top_left;
         std::vector<float> _pre_compute_map_y_top_left;
@@ -44,6 +46,15 @@ namespace librealsense
             std::vector<float>& pre_compute_map_y,
             float offset = 0);
 
+        // Map the depth pixels to the other image, in parallel bands of pixels
+        template<rs2_distortion dist>
+        inline void get_texture_map(const uint16_t* z_pixels,
+            const std::vector<float>& pre_compute_map_x,
+            const std::vector<float>& pre_compute_map_y,
+            std::vector<int2>& pixels,
+            const rs2_intrinsics& to,
+            const rs2_extrinsics& from_to_other);
+
         template<rs2_distortion dist = RS2_DISTORTION_NONE>
         inline void align_depth_to_other_sse(const uint16_t* z_pixels,
             uint16_t* dest, const rs2_intrinsics& depth,
@@ -56,11 +67,6 @@ namespace librealsense
             uint8_t* dest, int bpp, const rs2_intrinsics& to,
             const rs2_extrinsics& from_to_other);
 
-        inline void move_depth_to_other(const uint16_t* z_pixels,
-            uint16_t* dest, const rs2_intrinsics& to,
-            const std::vector<int2>& pixel_top_left_int,
-            const std::vector<int2>& pixel_bottom_right_int);
-
         template<class T >
         inline void move_other_to_depth(const uint16_t* z_pixels,
             const T* source,
@@ -30,6 +30,11 @@ namespace librealsense
         _source.set_callback(callback);
     }
 
+    void processing_block::set_frame_allocator( rs2_frame_allocator_sptr allocator )
+    {
+        _source.set_frame_allocator(allocator);
+    }
+
     processing_block::processing_block(const char* name) :
         _source_wrapper(_source)
     {
@@ -599,6 +604,14 @@ namespace librealsense
         _processing_blocks.back()->set_output_callback(callback);
     }
 
+    void composite_processing_block::set_frame_allocator( rs2_frame_allocator_sptr allocator )
+    {
+        // Intermediate frames are allocated by the internal blocks, too
+        processing_block::set_frame_allocator(allocator);
+        for (auto&& pb : _processing_blocks)
+            pb->set_frame_allocator(allocator);
+    }
+
     void composite_processing_block::invoke(frame_holder frames)
     {
         // Invoke the first processing block.
@@ -59,6 +59,7 @@ namespace librealsense
         void set_output_callback( rs2_frame_callback_sptr callback) override;
         void invoke(frame_holder frames) override;
         synthetic_source_interface& get_source() override { return _source_wrapper; }
+        void set_frame_allocator( rs2_frame_allocator_sptr allocator ) override;
 
         virtual ~processing_block() { _source.flush(); }
     protected:
@@ -255,6 +256,7 @@ namespace librealsense
         processing_block& get(rs2_option option);
         void add(std::shared_ptr<processing_block> block);
         void set_output_callback(rs2_frame_callback_sptr callback) override;
+        void set_frame_allocator(rs2_frame_allocator_sptr allocator) override;
         void invoke(frame_holder frames) override;
 
     protected:
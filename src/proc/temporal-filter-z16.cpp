@@ -0,0 +1,185 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include "temporal-filter-z16.h"
+
+#include <cstdlib>
+
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+
+namespace librealsense
+{
+    persistence_rule persistence_rule::from_option(uint8_t persistence_param)
+    {
+        // See the option descriptions in temporal_filter
+        static const persistence_rule rules[] = {
+            { 8, 9 },  // 0: disabled
+            { 8, 8 },  // 1: valid in 8/8
+            { 3, 2 },  // 2: valid in 2/last 3
+            { 4, 2 },  // 3: valid in 2/last 4
+            { 8, 2 },  // 4: valid in 2/8
+            { 2, 1 },  // 5: valid in 1/last 2
+            { 5, 1 },  // 6: valid in 1/last 5
+            { 8, 1 },  // 7: valid in 1/8
+            { 8, 0 },  // 8: always on
+        };
+        if (persistence_param < sizeof(rules) / sizeof(rules[0]))
+            return rules[persistence_param];
+        return rules[0];
+    }
+
+    void temporal_filter_z16(uint16_t const * in, uint16_t * out, uint16_t * last, uint8_t * history, size_t n,
+                             uint8_t phase, temporal_filter_params const & p)
+    {
+        const uint8_t mask = uint8_t(1 << phase);
+        const uint8_t window = p.persistence.window_mask(phase);
+        const float one_minus_alpha = 1.f - p.alpha;
+        size_t i = 0;
+
+#if defined(__SSSE3__)
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i ones = _mm_set1_epi8(-1);
+        const __m128i delta_z = _mm_set1_epi16(short(p.delta_z));
+        const __m128i bit = _mm_set1_epi8(char(mask));
+        const __m128i window_bits = _mm_set1_epi8(char(window));
+        const __m128i low_nibble = _mm_set1_epi8(0x0f);
+        const __m128i nibble_bit_counts = _mm_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+        const __m128i not_enough_valid = _mm_set1_epi8(char(p.persistence.min_valid - 1));
+        const __m128i bias32 = _mm_set1_epi32(0x8000);
+        const __m128i bias16 = _mm_set1_epi16(short(0x8000));
+        const __m128 alpha = _mm_set1_ps(p.alpha);
+        const __m128 beta = _mm_set1_ps(one_minus_alpha);
+
+        auto select = [](__m128i m, __m128i a, __m128i b) { return _mm_or_si128(_mm_and_si128(m, a), _mm_andnot_si128(m, b)); };
+        auto non_zero = [&](__m128i x) { return _mm_xor_si128(_mm_cmpeq_epi16(x, zero), ones); };
+        auto blend = [&](__m128i cur, __m128i prev) {  // 32-bit values
+            __m128 filtered = _mm_add_ps(_mm_mul_ps(alpha, _mm_cvtepi32_ps(cur)), _mm_mul_ps(beta, _mm_cvtepi32_ps(prev)));
+            return _mm_sub_epi32(_mm_cvttps_epi32(filtered), bias32);  // biased, for a signed pack
+        };
+
+        for (; i + 16 <= n; i += 16)
+        {
+            __m128i hist = _mm_loadu_si128(reinterpret_cast<__m128i const *>(history + i));
+
+            // Credible if enough of the history bits in the window are set
+            __m128i h = _mm_and_si128(hist, window_bits);
+            __m128i n_valid = _mm_add_epi8(_mm_shuffle_epi8(nibble_bit_counts, _mm_and_si128(h, low_nibble)),
+                                           _mm_shuffle_epi8(nibble_bit_counts, _mm_and_si128(_mm_srli_epi16(h, 4), low_nibble)));
+            __m128i credible8 = _mm_cmpgt_epi8(n_valid, not_enough_valid);
+
+            __m128i agree16[2], cur_valid16[2];
+            for (int k = 0; k < 2; ++k)
+            {
+                __m128i cur = _mm_loadu_si128(reinterpret_cast<__m128i const *>(in + i + 8 * k));
+                __m128i prev = _mm_loadu_si128(reinterpret_cast<__m128i const *>(last + i + 8 * k));
+
+                __m128i cur_valid = non_zero(cur);
+                __m128i prev_valid = non_zero(prev);
+                __m128i diff = _mm_or_si128(_mm_subs_epu16(cur, prev), _mm_subs_epu16(prev, cur));
+                __m128i small_diff = non_zero(_mm_subs_epu16(delta_z, diff));
+                __m128i agree = _mm_and_si128(_mm_and_si128(cur_valid, prev_valid), small_diff);
+
+                __m128i result = _mm_xor_si128(_mm_packs_epi32(blend(_mm_unpacklo_epi16(cur, zero), _mm_unpacklo_epi16(prev, zero)),
+                                                               blend(_mm_unpackhi_epi16(cur, zero), _mm_unpackhi_epi16(prev, zero))),
+                                               bias16);
+                __m128i credible = k ? _mm_unpackhi_epi8(credible8, credible8) : _mm_unpacklo_epi8(credible8, credible8);
+                __m128i fill = _mm_andnot_si128(cur_valid, _mm_and_si128(prev_valid, credible));
+
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i + 8 * k), select(agree, result, select(fill, prev, cur)));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(last + i + 8 * k), select(agree, result, select(cur_valid, cur, prev)));
+
+                agree16[k] = agree;
+                cur_valid16[k] = cur_valid;
+            }
+
+            // Agreeing pixels add this frame to their history, other valid ones restart it, and missing ones clear it
+            __m128i agree8 = _mm_packs_epi16(agree16[0], agree16[1]);
+            __m128i cur_valid8 = _mm_packs_epi16(cur_valid16[0], cur_valid16[1]);
+            hist = select(agree8, _mm_or_si128(hist, bit), select(cur_valid8, bit, _mm_andnot_si128(bit, hist)));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(history + i), hist);
+        }
+#elif defined(__ARM_NEON)
+        const uint16x8_t delta_z = vdupq_n_u16(p.delta_z);
+        const uint8x16_t bit = vdupq_n_u8(mask);
+        const uint8x16_t window_bits = vdupq_n_u8(window);
+        const uint8x16_t min_valid = vdupq_n_u8(p.persistence.min_valid);
+        const float32x4_t alpha = vdupq_n_f32(p.alpha);
+        const float32x4_t beta = vdupq_n_f32(one_minus_alpha);
+
+        auto blend = [&](uint16x4_t cur, uint16x4_t prev) {
+            float32x4_t filtered = vaddq_f32(vmulq_f32(alpha, vcvtq_f32_u32(vmovl_u16(cur))),
+                                             vmulq_f32(beta, vcvtq_f32_u32(vmovl_u16(prev))));
+            return vmovn_u32(vcvtq_u32_f32(filtered));
+        };
+
+        for (; i + 16 <= n; i += 16)
+        {
+            uint8x16_t hist = vld1q_u8(history + i);
+
+            // Credible if enough of the history bits in the window are set
+            uint8x16_t credible8 = vcgeq_u8(vcntq_u8(vandq_u8(hist, window_bits)), min_valid);
+            uint8x16x2_t credible16 = vzipq_u8(credible8, credible8);
+
+            uint16x8_t agree16[2], cur_valid16[2];
+            for (int k = 0; k < 2; ++k)
+            {
+                uint16x8_t cur = vld1q_u16(in + i + 8 * k);
+                uint16x8_t prev = vld1q_u16(last + i + 8 * k);
+
+                uint16x8_t cur_valid = vtstq_u16(cur, cur);
+                uint16x8_t prev_valid = vtstq_u16(prev, prev);
+                uint16x8_t agree = vandq_u16(vandq_u16(cur_valid, prev_valid), vcltq_u16(vabdq_u16(cur, prev), delta_z));
+
+                uint16x8_t result = vcombine_u16(blend(vget_low_u16(cur), vget_low_u16(prev)),
+                                                 blend(vget_high_u16(cur), vget_high_u16(prev)));
+                uint16x8_t credible = vreinterpretq_u16_u8(credible16.val[k]);
+                uint16x8_t fill = vbicq_u16(vandq_u16(prev_valid, credible), cur_valid);
+
+                vst1q_u16(out + i + 8 * k, vbslq_u16(agree, result, vbslq_u16(fill, prev, cur)));
+                vst1q_u16(last + i + 8 * k, vbslq_u16(agree, result, vbslq_u16(cur_valid, cur, prev)));
+
+                agree16[k] = agree;
+                cur_valid16[k] = cur_valid;
+            }
+
+            // Agreeing pixels add this frame to their history, other valid ones restart it, and missing ones clear it
+            uint8x16_t agree8 = vcombine_u8(vmovn_u16(agree16[0]), vmovn_u16(agree16[1]));
+            uint8x16_t cur_valid8 = vcombine_u8(vmovn_u16(cur_valid16[0]), vmovn_u16(cur_valid16[1]));
+            hist = vbslq_u8(agree8, vorrq_u8(hist, bit), vbslq_u8(cur_valid8, bit, vbicq_u8(hist, bit)));
+            vst1q_u8(history + i, hist);
+        }
+#endif
+
+        for (; i < n; ++i)
+        {
+            uint16_t cur = in[i];
+            uint16_t prev = last[i];
+
+            if (cur)
+            {
+                if (prev && uint16_t(std::abs(int(cur) - int(prev))) < p.delta_z)
+                {  // old and new val agree
+                    history[i] |= mask;
+                    cur = uint16_t(p.alpha * cur + one_minus_alpha * prev);
+                }
+                else
+                {
+                    history[i] = mask;
+                }
+                last[i] = cur;
+            }
+            else
+            {
+                if (prev && p.persistence.is_credible(history[i], window))
+                    cur = prev;  // we have had enough samples lately
+                history[i] &= ~mask;
+            }
+            out[i] = cur;
+        }
+    }
+}
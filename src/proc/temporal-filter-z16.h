@@ -0,0 +1,53 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace librealsense
+{
+    // The persistence (holes filling) rule of the temporal filter: a pixel missing in the current frame is filled with
+    // its last value if it was valid in at least 'min_valid' of the last 'window' frames.
+    //
+    // The history of a pixel holds a bit per frame, for the last 8 frames; the current frame is at bit 'phase', which
+    // still holds the frame from 8 frames ago when the rule is evaluated, so the window spans the bits below it.
+    struct persistence_rule
+    {
+        uint8_t window = 8;
+        uint8_t min_valid = 9;  // never credible
+
+        static persistence_rule from_option(uint8_t persistence_param);
+
+        // The history bits that are in the window, for a frame at the given phase
+        uint8_t window_mask(uint8_t phase) const
+        {
+            unsigned bits = (1u << window) - 1;
+            unsigned shift = (phase - window) & 7u;
+            return uint8_t((bits << shift) | (bits >> (8 - shift)));
+        }
+
+        bool is_credible(uint8_t history, uint8_t window_mask) const
+        {
+            uint8_t x = history & window_mask;
+            x = x - ((x >> 1) & 0x55);
+            x = (x & 0x33) + ((x >> 2) & 0x33);
+            return uint8_t((x + (x >> 4)) & 0x0f) >= min_valid;
+        }
+    };
+
+    struct temporal_filter_params
+    {
+        float alpha;
+        uint16_t delta_z;
+        persistence_rule persistence;
+    };
+
+    // Filter n pixels of a Z16 frame from 'in' into 'out' (which may be the same buffer), against the last frame and
+    // the per-pixel history, which are updated; 'phase' is the history bit of this frame.
+    // Where SSSE3 or NEON are available, 16 pixels are processed at a time.
+    void temporal_filter_z16(uint16_t const * in, uint16_t * out, uint16_t * last, uint8_t * history, size_t n,
+                             uint8_t phase, temporal_filter_params const & p);
+}
@@ -3,40 +3,44 @@
 
 #pragma once
 #include "types.h"
+#include "temporal-filter-z16.h"
 
 namespace librealsense
 {
-    const size_t PRESISTENCY_LUT_SIZE = 256;
-
     class temporal_filter : public depth_processing_block
     {
     public:
         temporal_filter();
 
+        // Filters a disparity frame in place, carrying the history across the calls as across frames
+        void filter_disparity(float * disparity, size_t width, size_t height);
+
     protected:
         void    update_configuration(const rs2::frame& f);
         rs2::frame process_frame(const rs2::frame_source& source, const rs2::frame& f) override;
 
         rs2::frame prepare_target_frame(const rs2::frame& f, const rs2::frame_source& source);
 
+        // The input frame is filtered into the output frame, which may be the same buffer
         template<typename T>
-        void temp_jw_smooth(void* frame_data, void * _last_frame_data, uint8_t *history)
+        void temp_jw_smooth(const void* input_data, void* frame_data, void * _last_frame_data, uint8_t *history)
         {
             static_assert((std::is_arithmetic<T>::value), "temporal filter assumes numeric types");
 
-            const bool fp = (std::is_floating_point<T>::value);
-
             T delta_z = static_cast<T>(_delta_param);
 
+            auto input          = reinterpret_cast<const T*>(input_data);
             auto frame          = reinterpret_cast<T*>(frame_data);
             auto _last_frame    = reinterpret_cast<T*>(_last_frame_data);
 
             unsigned char mask = 1 << _cur_frame_index;
+            unsigned char window = _persistence.window_mask(_cur_frame_index);
 
             // pass one -- go through image and update all
             for (size_t i = 0; i < _current_frm_size_pixels; i++)
             {
-                T cur_val = frame[i];
+                T cur_val = input[i];
+                frame[i] = cur_val;
                 T prev_val = _last_frame[i];
 
                 if (cur_val)
@@ -69,9 +73,7 @@ namespace librealsense
                 {  // no cur_val
                     if (prev_val)
                     { // only case we can help
-                        unsigned char hist = history[i];
-                        unsigned char classification = _persistence_map[hist];
-                        if (classification & mask)
+                        if (_persistence.is_credible(history[i], window))
                         { // we have had enough samples lately
                             frame[i] = prev_val;
                         }
@@ -88,7 +90,6 @@ namespace librealsense
         void on_set_alpha(float val);
         void on_set_delta(float val);
 
-        void recalc_persistence_map();
         uint8_t                 _persistence_param;
 
         float                   _alpha_param;               // The normalized weight of the current pixel
@@ -103,8 +104,7 @@ namespace librealsense
         std::vector<uint8_t>    _last_frame;                // Hold the last frame received for the current profile
         std::vector<uint8_t>    _history;                   // represents the history over the last 8 frames, 1 bit per frame
         uint8_t                 _cur_frame_index;
-        // encodes whether a particular 8 bit history is good enough for all 8 phases of storage
-        std::array<uint8_t, PRESISTENCY_LUT_SIZE> _persistence_map;
+        persistence_rule        _persistence;               // whether a particular 8 bit history is good enough to fill a hole
     };
     MAP_EXTENSION(RS2_EXTENSION_TEMPORAL_FILTER, librealsense::temporal_filter);
 }
@@ -34,6 +34,12 @@ namespace librealsense
                 max_opt));
     }
 
+    std::pair<float, float> threshold::get_range()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return { _min, _max };
+    }
+
     rs2::frame threshold::process_frame(const rs2::frame_source& source, const rs2::frame& f)
     {
         if (!f.is<rs2::depth_frame>()) return f;
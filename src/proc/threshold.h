@@ -17,6 +17,9 @@ namespace librealsense
     public:
         threshold();
 
+        // The range of depth kept, in meters
+        std::pair<float, float> get_range();
+
     protected:
         rs2::frame process_frame(const rs2::frame_source& source, const rs2::frame& f) override;
 
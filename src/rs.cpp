@@ -32,6 +32,7 @@
 #include "proc/decimation-filter.h"
 #include "proc/spatial-filter.h"
 #include "proc/hole-filling-filter.h"
+#include "proc/fused-depth-filter.h"
 #include "proc/color-formats-converter.h"
 #include "proc/y411-converter.h"
 #include "proc/rates-printer.h"
@@ -933,6 +934,88 @@ void rs2_set_notifications_callback(const rs2_sensor* sensor, rs2_notification_c
 HANDLE_EXCEPTIONS_AND_RETURN(, sensor, on_notification, user)
 
 
+class user_frame_allocator : public rs2_frame_allocator
+{
+    rs2_frame_allocate_ptr aptr;
+    rs2_frame_deallocate_ptr dptr;
+    void * user;
+
+public:
+    user_frame_allocator( rs2_frame_allocate_ptr allocate, rs2_frame_deallocate_ptr deallocate, void * user )
+        : aptr( allocate )
+        , dptr( deallocate )
+        , user( user )
+    {
+    }
+
+    void * allocate( int size ) override
+    {
+        try
+        {
+            return aptr( size, user );
+        }
+        catch( ... )
+        {
+            LOG_ERROR( "Received an exception from frame allocator!" );
+        }
+        return nullptr;
+    }
+
+    void deallocate( void * data, int size ) override
+    {
+        try
+        {
+            dptr( data, size, user );
+        }
+        catch( ... )
+        {
+            LOG_ERROR( "Received an exception from frame deallocator!" );
+        }
+    }
+
+    void release() override { delete this; }
+};
+
+static librealsense::sensor_base & get_frame_allocator_target( const rs2_sensor * sensor )
+{
+    auto sb = dynamic_cast< librealsense::sensor_base * >( sensor->sensor );
+    if( ! sb )
+        throw not_implemented_exception( "This sensor does not support custom frame allocators" );
+    return *sb;
+}
+
+void rs2_set_frame_allocator( const rs2_sensor * sensor,
+                              rs2_frame_allocate_ptr allocate,
+                              rs2_frame_deallocate_ptr deallocate,
+                              void * user,
+                              rs2_error ** error ) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL( sensor );
+    rs2_frame_allocator_sptr allocator;
+    if( allocate )
+    {
+        VALIDATE_NOT_NULL( deallocate );
+        allocator.reset( new user_frame_allocator( allocate, deallocate, user ),
+                         []( rs2_frame_allocator * p ) { p->release(); } );
+    }
+    get_frame_allocator_target( sensor ).set_frame_allocator( std::move( allocator ) );
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, sensor, allocate, deallocate, user)
+
+void rs2_set_frame_allocator_cpp( const rs2_sensor * sensor, rs2_frame_allocator * allocator, rs2_error ** error ) BEGIN_API_CALL
+{
+    // Take ownership of the allocator ASAP or else memory leaks could result if we throw! (the caller usually does a
+    // 'new' when calling us)
+    rs2_frame_allocator_sptr allocator_ptr;
+    if( allocator )
+        allocator_ptr.reset( allocator, []( rs2_frame_allocator * p ) { p->release(); } );
+
+    VALIDATE_NOT_NULL( sensor );
+    get_frame_allocator_target( sensor ).set_frame_allocator( std::move( allocator_ptr ) );
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, sensor, allocator)
+
+
 class software_device_destruction_callback : public rs2_software_device_destruction_callback
 {
     rs2_software_device_destruction_callback_ptr nptr;
@@ -1260,6 +1343,29 @@ void rs2_keep_frame(rs2_frame* frame) BEGIN_API_CALL
 }
 NOEXCEPT_RETURN(, frame)
 
+void rs2_get_frame_buffer_pool_stats(const rs2_frame* frame, rs2_frame_buffer_pool_stats* stats, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(frame);
+    VALIDATE_NOT_NULL(stats);
+    auto owner = ((frame_interface*)frame)->get_owner();
+    if (!owner)
+        throw invalid_value_exception("frame is not owned by a frame pool");
+
+    auto pool_stats = owner->get_buffer_pool_stats();
+    stats->hits = pool_stats.hits;
+    stats->misses = pool_stats.misses;
+    stats->evictions = pool_stats.evictions;
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, frame, stats)
+
+int rs2_frame_get_dmabuf_fd(const rs2_frame* frame, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(frame);
+    auto f = dynamic_cast< librealsense::frame * >( (frame_interface *)frame );
+    return f && f->export_external_data ? f->export_external_data() : -1;
+}
+HANDLE_EXCEPTIONS_AND_RETURN(-1, frame)
+
 const char* rs2_get_option_description(const rs2_options* options, rs2_option option, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(options);
@@ -1876,6 +1982,24 @@ int rs2_playback_device_is_real_time(const rs2_device* device, rs2_error** error
 }
 HANDLE_EXCEPTIONS_AND_RETURN(0, device)
 
+void rs2_playback_device_set_read_ahead(const rs2_device* device, unsigned int frames, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(device);
+    auto playback = VALIDATE_INTERFACE(device->device, librealsense::playback_device);
+    playback->set_read_ahead(frames);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, device, frames)
+
+void rs2_playback_device_set_range(const rs2_device* device, long long int start, long long int end, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(device);
+    VALIDATE_LE(0, start);
+    VALIDATE_LE(0, end);
+    auto playback = VALIDATE_INTERFACE(device->device, librealsense::playback_device);
+    playback->set_range(std::chrono::nanoseconds(start), std::chrono::nanoseconds(end));
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, device, start, end)
+
 void rs2_playback_device_set_status_changed_callback(const rs2_device* device, rs2_playback_status_changed_callback* callback, rs2_error** error) BEGIN_API_CALL
 {
     // Take ownership of the callback ASAP or else memory leaks could result if we throw! (the caller usually does a
@@ -1942,6 +2066,20 @@ rs2_device* rs2_create_record_device_ex(const rs2_device* device, const char* fi
 }
 HANDLE_EXCEPTIONS_AND_RETURN(nullptr, device, file)
 
+rs2_device* rs2_create_record_device_compressed(const rs2_device* device, const char* file, int compression_level, int compression_threads, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(device);
+    VALIDATE_NOT_NULL(file);
+    VALIDATE_RANGE(compression_level, 0, 12);
+    VALIDATE_RANGE(compression_threads, 0, 64);
+
+    return new rs2_device({
+        std::make_shared<record_device>(device->device,
+            std::make_shared<ros_writer>(file, true, compression_level, static_cast<uint32_t>(compression_threads)))
+        });
+}
+HANDLE_EXCEPTIONS_AND_RETURN(nullptr, device, file, compression_level, compression_threads)
+
 void rs2_record_device_pause(const rs2_device* device, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(device);
@@ -1966,6 +2104,42 @@ const char* rs2_record_device_filename(const rs2_device* device, rs2_error** err
 }
 HANDLE_EXCEPTIONS_AND_RETURN(nullptr, device)
 
+void rs2_record_device_set_queue_limit(const rs2_device* device, unsigned long long max_queued_bytes, rs2_record_drop_policy policy, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(device);
+    VALIDATE_ENUM(policy);
+    auto record_device = VALIDATE_INTERFACE(device->device, librealsense::record_device);
+    record_device->set_queue_limit(max_queued_bytes, policy);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, device, max_queued_bytes, policy)
+
+void rs2_record_device_set_stream_priority(const rs2_device* device, rs2_stream stream, int priority, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(device);
+    VALIDATE_ENUM(stream);
+    auto record_device = VALIDATE_INTERFACE(device->device, librealsense::record_device);
+    record_device->set_stream_priority(stream, priority);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, device, stream, priority)
+
+void rs2_record_device_get_queue_stats(const rs2_device* device, rs2_record_queue_stats* stats, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(device);
+    VALIDATE_NOT_NULL(stats);
+    auto record_device = VALIDATE_INTERFACE(device->device, librealsense::record_device);
+    *stats = record_device->get_queue_stats();
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, device, stats)
+
+unsigned long long rs2_record_device_get_dropped_frames(const rs2_device* device, rs2_stream stream, int index, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(device);
+    VALIDATE_ENUM(stream);
+    auto record_device = VALIDATE_INTERFACE(device->device, librealsense::record_device);
+    return record_device->get_dropped_frames(stream, index);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(0, device, stream, index)
+
 
 rs2_frame* rs2_allocate_synthetic_video_frame(rs2_source* source, const rs2_stream_profile* new_stream, rs2_frame* original,
     int new_bpp, int new_width, int new_height, int new_stride, rs2_extension frame_type, rs2_error** error) BEGIN_API_CALL
@@ -2409,6 +2583,34 @@ void rs2_start_processing_fptr(rs2_processing_block* block, rs2_frame_callback_p
 }
 HANDLE_EXCEPTIONS_AND_RETURN(, block, on_frame, user)
 
+void rs2_set_processing_block_frame_allocator(rs2_processing_block* block, rs2_frame_allocator* allocator, rs2_error** error) BEGIN_API_CALL
+{
+    // Take ownership of the allocator ASAP or else memory leaks could result if we throw!
+    rs2_frame_allocator_sptr allocator_ptr;
+    if( allocator )
+        allocator_ptr.reset( allocator, []( rs2_frame_allocator * p ) { p->release(); } );
+
+    VALIDATE_NOT_NULL(block);
+
+    block->block->set_frame_allocator( std::move( allocator_ptr ) );
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, block, allocator)
+
+void rs2_set_processing_block_frame_allocator_fptr(rs2_processing_block* block, rs2_frame_allocate_ptr allocate, rs2_frame_deallocate_ptr deallocate, void* user, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(block);
+
+    rs2_frame_allocator_sptr allocator;
+    if( allocate )
+    {
+        VALIDATE_NOT_NULL(deallocate);
+        allocator.reset( new user_frame_allocator( allocate, deallocate, user ),
+                         []( rs2_frame_allocator * p ) { p->release(); } );
+    }
+    block->block->set_frame_allocator( std::move( allocator ) );
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, block, allocate, deallocate, user)
+
 void rs2_start_processing_queue(rs2_processing_block* block, rs2_frame_queue* queue, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(block);
@@ -2599,6 +2801,14 @@ rs2_processing_block* rs2_create_hole_filling_filter_block(rs2_error** error) BE
 }
 NOARGS_HANDLE_EXCEPTIONS_AND_RETURN(nullptr)
 
+rs2_processing_block* rs2_create_fused_depth_filter_block(rs2_error** error) BEGIN_API_CALL
+{
+    auto block = std::make_shared<librealsense::fused_depth_filter>();
+
+    return new rs2_processing_block{ block };
+}
+NOARGS_HANDLE_EXCEPTIONS_AND_RETURN(nullptr)
+
 rs2_processing_block* rs2_create_rates_printer_block(rs2_error** error) BEGIN_API_CALL
 {
     auto block = std::make_shared<librealsense::rates_printer>();
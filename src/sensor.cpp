@@ -72,6 +72,7 @@ void log_callback_end( uint32_t fps,
           } )
     {
         register_option(RS2_OPTION_FRAMES_QUEUE_SIZE, _source.get_published_size_option());
+        register_option(RS2_OPTION_FRAMES_POOL_SIZE, _source.get_pool_size_option());
 
         register_metadata(RS2_FRAME_METADATA_TIME_OF_ARRIVAL, std::make_shared<librealsense::md_time_of_arrival_parser>());
 
@@ -131,6 +132,11 @@ void log_callback_end( uint32_t fps,
         return _source.set_callback(callback);
     }
 
+    void sensor_base::set_frame_allocator( rs2_frame_allocator_sptr allocator )
+    {
+        _source.set_frame_allocator( allocator );
+    }
+
     bool sensor_base::is_streaming() const
     {
         return _is_streaming;
@@ -193,6 +199,7 @@ void log_callback_end( uint32_t fps,
     {
         std::lock_guard<std::mutex> lock(_active_profile_mutex);
         _active_profiles = requests;
+        _source.set_stream_profiles(requests);
     }
 
     void sensor_base::register_profile(std::shared_ptr<stream_profile_interface> target) const
@@ -594,7 +601,11 @@ void log_callback_end( uint32_t fps,
         const auto & resolved_req = _formats_converter.get_active_source_profiles();
         std::vector< std::shared_ptr< processing_block > > active_pbs = _formats_converter.get_active_converters();
         for( auto & pb : active_pbs )
+        {
             register_processing_block_options( *pb );
+            if( _frame_allocator )
+                pb->set_frame_allocator( _frame_allocator );
+        }
 
         _raw_sensor->set_source_owner(this);
         try
@@ -686,6 +697,19 @@ void log_callback_end( uint32_t fps,
         _formats_converter.set_frames_callback( callback );
     }
 
+    void synthetic_sensor::set_frame_allocator( rs2_frame_allocator_sptr allocator )
+    {
+        std::lock_guard< std::mutex > lock( _synthetic_configure_lock );
+
+        // Frames reach the user either as-is from the raw sensor or through the format converters, which are only
+        // created when the sensor is opened
+        _frame_allocator = allocator;
+        sensor_base::set_frame_allocator( allocator );
+        _raw_sensor->set_frame_allocator( allocator );
+        for( auto & pb : _formats_converter.get_active_converters() )
+            pb->set_frame_allocator( allocator );
+    }
+
     void synthetic_sensor::register_notifications_callback( rs2_notifications_callback_sptr callback )
     {
         sensor_base::register_notifications_callback(callback);
@@ -71,6 +71,7 @@ namespace librealsense
         virtual std::shared_ptr<notifications_processor> get_notifications_processor() const;
         virtual rs2_frame_callback_sptr get_frames_callback() const override;
         virtual void set_frames_callback( rs2_frame_callback_sptr callback ) override;
+        virtual void set_frame_allocator( rs2_frame_allocator_sptr allocator );
         bool is_streaming() const override;
         virtual bool is_opened() const;
         virtual void register_metadata(rs2_frame_metadata_value metadata, std::shared_ptr<md_attribute_parser_base> metadata_parser) const;
@@ -243,6 +244,7 @@ namespace librealsense
         std::shared_ptr< raw_sensor_base > const & get_raw_sensor() const { return _raw_sensor; }
         rs2_frame_callback_sptr get_frames_callback() const override;
         void set_frames_callback( rs2_frame_callback_sptr callback ) override;
+        void set_frame_allocator( rs2_frame_allocator_sptr allocator ) override;
         void register_notifications_callback( rs2_notifications_callback_sptr callback ) override;
         int register_before_streaming_changes_callback(std::function<void(bool)> callback) override;
         void unregister_before_start_callback(int token) override;
@@ -261,6 +263,7 @@ namespace librealsense
         std::mutex _synthetic_configure_lock;
 
         rs2_frame_callback_sptr _post_process_callback;
+        rs2_frame_allocator_sptr _frame_allocator;
         std::shared_ptr<raw_sensor_base> _raw_sensor;
         formats_converter _formats_converter;
         std::vector<rs2_option> _cached_processing_blocks_options;
@@ -5,50 +5,118 @@
 
 #include "librealsense-exception.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
 #include <mutex>
 #include <condition_variable>
 
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
 
 namespace librealsense {
 
 
+// Index of the lowest set bit; word must not be 0
+inline int lowest_set_bit( uint64_t word )
+{
+#if defined( _MSC_VER ) && defined( _WIN64 )
+    unsigned long index;
+    _BitScanForward64( &index, word );
+    return int( index );
+#elif defined( _MSC_VER )
+    unsigned long index;
+    if( _BitScanForward( &index, static_cast< unsigned long >( word ) ) )
+        return int( index );
+    _BitScanForward( &index, static_cast< unsigned long >( word >> 32 ) );
+    return int( index ) + 32;
+#else
+    return __builtin_ctzll( word );
+#endif
+}
+
+
+// Claims one of the set (free) bits in an array of words with a CAS, and returns its index, or -1 if none are set
+inline int claim_free_bit( std::atomic< uint64_t > * free_bits, int words )
+{
+    for( auto w = 0; w < words; w++ )
+    {
+        uint64_t word = free_bits[w].load( std::memory_order_relaxed );
+        while( word )
+        {
+            auto const bit = lowest_set_bit( word );
+            if( free_bits[w].compare_exchange_weak( word,
+                                                    word & ~( uint64_t( 1 ) << bit ),
+                                                    std::memory_order_acquire,
+                                                    std::memory_order_relaxed ) )
+                return 64 * w + bit;
+        }
+    }
+    return -1;
+}
+
+
+// Sets the first 'count' bits of an array of words, and clears the rest
+inline void set_free_bits( std::atomic< uint64_t > * free_bits, int words, int count )
+{
+    for( auto w = 0; w < words; w++ )
+    {
+        auto const bits = count - 64 * w;
+        free_bits[w] = bits >= 64 ? ~uint64_t( 0 ) : bits > 0 ? ( uint64_t( 1 ) << bits ) - 1 : 0;
+    }
+}
+
+
+// A fixed pool of C objects, handed out without taking a lock.
+//
+// Free slots are bits in an array of 64-bit words: allocate() claims the lowest set bit of a word
+// with a CAS, and deallocate() gives it back with a single atomic OR. Only wait_until_empty()
+// sleeps, and deallocate() takes the mutex only while someone is waiting there.
+//
 template < class T, int C >
 class small_heap
 {
+    static const int WORDS = ( C + 63 ) / 64;
+
     T buffer[C];
-    bool is_free[C];
+    std::atomic< uint64_t > free_bits[WORDS];  // set = free
+    std::atomic< bool > keep_allocating;
+    std::atomic< int > size;
+    std::atomic< int > waiters;
     std::mutex mutex;
-    bool keep_allocating = true;
     std::condition_variable cv;
-    int size = 0;
 
 public:
     static const int CAPACITY = C;
 
     small_heap()
+        : keep_allocating( true )
+        , size( 0 )
+        , waiters( 0 )
     {
         for( auto i = 0; i < C; i++ )
-        {
-            is_free[i] = true;
             buffer[i] = std::move( T() );
-        }
+        set_free_bits( free_bits, WORDS, C );
     }
 
     T * allocate()
     {
-        std::unique_lock< std::mutex > lock( mutex );
+        // Counted before checking keep_allocating, so that once stop_allocation() returns and the
+        // size reaches 0, nothing is allocated any more
+        size++;
         if( ! keep_allocating )
-            return nullptr;
-
-        for( auto i = 0; i < C; i++ )
         {
-            if( is_free[i] )
-            {
-                is_free[i] = false;
-                size++;
-                return &buffer[i];
-            }
+            release_one();
+            return nullptr;
         }
+
+        auto const i = claim_free_bit( free_bits, WORDS );
+        if( i >= 0 )
+            return &buffer[i];
+        release_one();
         return nullptr;
     }
 
@@ -62,37 +130,175 @@ public:
         auto old_value = std::move( buffer[i] );
         buffer[i] = std::move( T() );
 
+        free_bits[i / 64].fetch_or( uint64_t( 1 ) << ( i % 64 ), std::memory_order_release );
+        release_one();
+    }
+
+    void stop_allocation()
+    {
+        keep_allocating = false;
+    }
+
+    void wait_until_empty()
+    {
+        std::unique_lock< std::mutex > lock( mutex );
+        waiters++;
+
+        const auto ready = [this]() {
+            return is_empty();
+        };
+        bool const emptied = ready()
+                          || cv.wait_for( lock,
+                                          std::chrono::hours( 1000 ),
+                                          ready );  // for some reason passing std::chrono::duration::max makes it return instantly
+        waiters--;
+        if( ! emptied )
+        {
+            throw invalid_value_exception( "Could not flush one of the user controlled objects!" );
+        }
+    }
+
+    bool is_empty() const { return size == 0; }
+    int get_size() const { return size; }
+
+private:
+    void release_one()
+    {
+        // Either we see the waiter, or it sees the size we leave
+        if( --size == 0 && waiters )
+        {
+            {
+                std::lock_guard< std::mutex > lock( mutex );
+            }
+            cv.notify_all();
+        }
+    }
+};
+
+
+// A pool of T objects that starts with one slab of 'slab_size' and grows by another slab whenever all
+// are taken, up to 'max_size' objects (rounded up to whole slabs). Allocation within the slabs is
+// lock-free, as in small_heap; only adding a slab takes a lock. Slabs are kept until the heap is
+// destroyed, so an object's address stays valid.
+//
+template < class T >
+class slab_heap
+{
+    struct slab
+    {
+        std::unique_ptr< T[] > items;
+        std::unique_ptr< std::atomic< uint64_t >[] > free_bits;  // set = free
+
+        slab( int size, int words )
+            : items( new T[size] )
+            , free_bits( new std::atomic< uint64_t >[words] )
+        {
+            set_free_bits( free_bits.get(), words, size );
+        }
+    };
+
+    int const _slab_size;
+    int const _words;
+    int const _max_slabs;
+    std::unique_ptr< std::unique_ptr< slab >[] > _slabs;  // never moved, so readers need no lock
+    std::atomic< int > _n_slabs;
+    std::mutex _grow_mutex;
+
+    std::atomic< bool > keep_allocating;
+    std::atomic< int > size;
+    std::atomic< int > waiters;
+    std::mutex mutex;
+    std::condition_variable cv;
+
+public:
+    slab_heap( int slab_size, int max_size )
+        : _slab_size( std::max( slab_size, 1 ) )
+        , _words( ( _slab_size + 63 ) / 64 )
+        , _max_slabs( std::max( ( max_size + _slab_size - 1 ) / _slab_size, 1 ) )
+        , _slabs( new std::unique_ptr< slab >[_max_slabs] )
+        , _n_slabs( 1 )
+        , keep_allocating( true )
+        , size( 0 )
+        , waiters( 0 )
+    {
+        _slabs[0].reset( new slab( _slab_size, _words ) );
+    }
+
+    T * allocate()
+    {
+        // See small_heap::allocate()
+        size++;
+        if( ! keep_allocating )
+        {
+            release_one();
+            return nullptr;
+        }
+
+        int n = _n_slabs.load( std::memory_order_acquire );
+        for( auto s = 0; s < n; s++ )
+            if( auto item = claim( *_slabs[s] ) )
+                return item;
+
         {
-            std::unique_lock< std::mutex > lock( mutex );
+            std::lock_guard< std::mutex > lock( _grow_mutex );
 
-            is_free[i] = true;
-            size--;
+            // Someone else may have added a slab in the meantime
+            int const grown = _n_slabs.load( std::memory_order_relaxed );
+            for( ; n < grown; n++ )
+                if( auto item = claim( *_slabs[n] ) )
+                    return item;
 
-            if( size == 0 )
+            if( n < _max_slabs )
             {
-                lock.unlock();
-                cv.notify_one();
+                _slabs[n].reset( new slab( _slab_size, _words ) );
+                auto item = claim( *_slabs[n] );  // nobody else sees this slab yet
+                _n_slabs.store( n + 1, std::memory_order_release );
+                return item;
             }
         }
+        release_one();
+        return nullptr;
+    }
+
+    void deallocate( T * item )
+    {
+        int const n = _n_slabs.load( std::memory_order_acquire );
+        for( auto s = 0; s < n; s++ )
+        {
+            auto & sl = *_slabs[s];
+            if( item < sl.items.get() || item >= sl.items.get() + _slab_size )
+                continue;
+
+            auto i = item - sl.items.get();
+            auto old_value = std::move( *item );
+            *item = std::move( T() );
+
+            sl.free_bits[i / 64].fetch_or( uint64_t( 1 ) << ( i % 64 ), std::memory_order_release );
+            release_one();
+            return;
+        }
+        throw invalid_value_exception( "Trying to return item to a heap that didn't allocate it!" );
     }
 
     void stop_allocation()
     {
-        std::unique_lock< std::mutex > lock( mutex );
         keep_allocating = false;
     }
 
     void wait_until_empty()
     {
         std::unique_lock< std::mutex > lock( mutex );
+        waiters++;
 
         const auto ready = [this]() {
             return is_empty();
         };
-        if( ! ready()
-            && ! cv.wait_for( lock,
-                              std::chrono::hours( 1000 ),
-                              ready ) )  // for some reason passing std::chrono::duration::max makes it return instantly
+        bool const emptied = ready()
+                          || cv.wait_for( lock,
+                                          std::chrono::hours( 1000 ),
+                                          ready );  // for some reason passing std::chrono::duration::max makes it return instantly
+        waiters--;
+        if( ! emptied )
         {
             throw invalid_value_exception( "Could not flush one of the user controlled objects!" );
         }
@@ -100,6 +306,26 @@ public:
 
     bool is_empty() const { return size == 0; }
     int get_size() const { return size; }
+    int get_capacity() const { return _n_slabs * _slab_size; }
+
+private:
+    T * claim( slab & sl )
+    {
+        auto const i = claim_free_bit( sl.free_bits.get(), _words );
+        return i >= 0 ? &sl.items[i] : nullptr;
+    }
+
+    void release_one()
+    {
+        // Either we see the waiter, or it sees the size we leave
+        if( --size == 0 && waiters )
+        {
+            {
+                std::lock_guard< std::mutex > lock( mutex );
+            }
+            cv.notify_all();
+        }
+    }
 };
 
 
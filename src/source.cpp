@@ -15,9 +15,10 @@ namespace librealsense
     class frame_queue_size : public option_base
     {
     public:
-        frame_queue_size(std::atomic<uint32_t>* ptr, const option_range& opt_range)
+        frame_queue_size(std::atomic<uint32_t>* ptr, const option_range& opt_range, const char* description)
             : option_base(opt_range),
-              _ptr(ptr)
+              _ptr(ptr),
+              _description(description)
         {}
 
         void set(float value) override
@@ -34,24 +35,54 @@ namespace librealsense
 
         bool is_enabled() const override { return true; }
 
-        const char* get_description() const override
-        {
-            return "Max number of frames you can hold at a given time. Increasing this number will reduce frame drops but increase latency, and vice versa";
-        }
+        const char* get_description() const override { return _description; }
     private:
         std::atomic<uint32_t>* _ptr;
+        const char* _description;
     };
 
     std::shared_ptr<option> frame_source::get_published_size_option()
     {
-        return std::make_shared<frame_queue_size>(&_max_publish_list_size, option_range{ 0, 32, 1, 16 });
+        return std::make_shared<frame_queue_size>(&_max_publish_list_size, option_range{ 0, 32, 1, 16 },
+            "Max number of frames you can hold at a given time. Increasing this number will reduce frame drops but increase latency, and vice versa");
+    }
+
+    std::shared_ptr<option> frame_source::get_pool_size_option()
+    {
+        return std::make_shared<frame_queue_size>(&_pool_size, option_range{ 0, RS2_MAX_FRAME_POOL_SIZE, 1, 0 },
+            "Number of frame objects each stream preallocates, and grows by when they are all in use. 0 sizes it by the stream's frame rate");
     }
 
     frame_source::frame_source( uint32_t max_publish_list_size )
         : _callback( nullptr, []( rs2_frame_callback * ) {} )
         , _max_publish_list_size( max_publish_list_size )
+        , _pool_size( 0 )
     {}
 
+    void frame_source::set_stream_profiles( stream_profiles const & profiles )
+    {
+        std::lock_guard< std::recursive_mutex > lock( _mutex );
+
+        _stream_fps.clear();
+        for( auto & p : profiles )
+            _stream_fps[{ p->get_stream_type(), p->get_stream_index() }] = p->get_framerate();
+    }
+
+    uint32_t frame_source::get_pool_slab_size( archive_id const & id ) const
+    {
+        if( auto size = _pool_size.load() )
+            return size;
+
+        // Enough for a quarter of a second of frames, but no more than the user may hold on to
+        uint32_t slab = 16;
+        auto it = _stream_fps.find( { std::get< rs2_stream >( id ), std::get< int >( id ) } );
+        if( it != _stream_fps.end() && it->second )
+            slab = std::min( std::max( it->second / 4, 4u ), 128u );
+        if( auto max_frames = _max_publish_list_size.load() )
+            slab = std::min( slab, max_frames );
+        return slab;
+    }
+
     void frame_source::init(std::shared_ptr<metadata_parser_map> metadata_parsers)
     {
         std::lock_guard< std::recursive_mutex > lock( _mutex );
@@ -77,11 +108,13 @@ namespace librealsense
         if( it == _supported_extensions.end() )
             throw wrong_api_call_sequence_exception( "Requested frame type is not supported!" );
 
-        auto ret = _archive.insert( { id, make_archive( ex, &_max_publish_list_size, _metadata_parsers ) } );
+        auto ret = _archive.insert( { id, make_archive( ex, &_max_publish_list_size, get_pool_slab_size( id ), _metadata_parsers ) } );
         if( ! ret.second || ! ret.first->second ) // Check insertion success and allocation success
             throw std::runtime_error( rsutils::string::from() << "Failed to create archive of type " << get_string( ex ) );
 
         ret.first->second->set_sensor( _sensor );
+        if( _frame_allocator && supports_frame_allocator( ex ) )
+            ret.first->second->set_frame_allocator( _frame_allocator );
 
         return ret.first;
     }
@@ -140,6 +173,39 @@ namespace librealsense
         }
     }
 
+    bool frame_source::supports_frame_allocator( rs2_extension ex )
+    {
+        // Other frame types (points, composite, etc.) access their buffer directly, and extensions (e.g., GPU frames)
+        // manage their own memory
+        switch( ex )
+        {
+        case RS2_EXTENSION_VIDEO_FRAME:
+        case RS2_EXTENSION_DEPTH_FRAME:
+        case RS2_EXTENSION_DISPARITY_FRAME:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    void frame_source::set_frame_allocator( rs2_frame_allocator_sptr allocator )
+    {
+        std::lock_guard< std::recursive_mutex > lock( _mutex );
+
+        _frame_allocator = allocator;
+        for( auto & a : _archive )
+        {
+            if( supports_frame_allocator( std::get< rs2_extension >( a.first ) ) )
+                a.second->set_frame_allocator( _frame_allocator );
+        }
+    }
+
+    rs2_frame_allocator_sptr frame_source::get_frame_allocator() const
+    {
+        std::lock_guard< std::recursive_mutex > lock( _mutex );
+        return _frame_allocator;
+    }
+
     void frame_source::set_callback( rs2_frame_callback_sptr callback )
     {
         std::lock_guard< std::recursive_mutex > lock( _mutex );
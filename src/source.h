@@ -6,7 +6,9 @@
 
 #include <librealsense2/hpp/rs_types.hpp>
 #include <src/frame-archive.h>
+#include <src/core/stream-profile-interface.h>
 
+#include <map>
 #include <tuple>
 
 namespace librealsense
@@ -29,6 +31,10 @@ namespace librealsense
         void reset();
 
         std::shared_ptr< option > get_published_size_option();
+        std::shared_ptr< option > get_pool_size_option();
+
+        // The frame rates of the streams about to start, to size their frame pools by
+        void set_stream_profiles( stream_profiles const & profiles );
 
         frame_interface * alloc_frame( archive_id id,
                                        size_t size,
@@ -46,6 +52,10 @@ namespace librealsense
 
         void set_sensor( const std::weak_ptr< sensor_interface > & s );
 
+        // Use a custom allocator for the data of video frames (including depth and disparity); nullptr restores the default
+        void set_frame_allocator( rs2_frame_allocator_sptr allocator );
+        rs2_frame_allocator_sptr get_frame_allocator() const;
+
         template<class T>
         void add_extension( rs2_extension ex )
         {
@@ -60,7 +70,9 @@ namespace librealsense
             // We use a special index for extensions since we don't know the stream type here.
             // We can't wait with the allocation because we need the type T in the creation.
             archive_id special_index = { RS2_STREAM_COUNT, 0, ex };
-            _archive[special_index] = std::make_shared< frame_archive< T > >( &_max_publish_list_size, _metadata_parsers );
+            _archive[special_index] = std::make_shared< frame_archive< T > >( &_max_publish_list_size,
+                                                                             get_pool_slab_size( special_index ),
+                                                                             _metadata_parsers );
         }
 
         void set_max_publish_list_size( int qsize ) { _max_publish_list_size = qsize; }
@@ -72,14 +84,21 @@ namespace librealsense
 
         std::map< archive_id, std::shared_ptr< archive_interface > >::iterator create_archive( archive_id id );
 
+        static bool supports_frame_allocator( rs2_extension ex );
+
+        uint32_t get_pool_slab_size( archive_id const & id ) const;
+
         mutable std::recursive_mutex _mutex;
 
         std::map< archive_id, std::shared_ptr< archive_interface > > _archive;
         std::vector< rs2_extension > _supported_extensions;
 
         std::atomic< uint32_t > _max_publish_list_size;
+        std::atomic< uint32_t > _pool_size;  // 0 = size by frame rate
+        std::map< std::pair< rs2_stream, int >, uint32_t > _stream_fps;
         rs2_frame_callback_sptr _callback;
         std::shared_ptr< metadata_parser_map > _metadata_parsers;
         std::weak_ptr< sensor_interface > _sensor;
+        rs2_frame_allocator_sptr _frame_allocator;
     };
 }
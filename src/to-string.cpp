@@ -441,6 +441,7 @@ std::string const & get_string_( rs2_option value )
         arr[RS2_OPTION_DEPTH_AUTO_EXPOSURE_MODE] = "Auto Exposure Mode";
         CASE( OHM_TEMPERATURE )
         CASE( SOC_PVT_TEMPERATURE )
+        CASE( FRAMES_POOL_SIZE )
 #undef CASE
         return arr;
     }();
@@ -682,6 +683,22 @@ const char * get_string( rs2_notification_category value )
     }
 #undef CASE
 }
+const char * get_string( rs2_record_drop_policy value )
+{
+#define CASE( X ) STRCASE( RECORD_DROP_POLICY, X )
+    switch( value )
+    {
+    CASE( DROP_NEWEST )
+    CASE( DROP_OLDEST )
+    CASE( DROP_LOWEST_PRIORITY )
+    CASE( BLOCK )
+    default:
+        assert( ! is_valid( value ) );
+        return UNKNOWN_VALUE;
+    }
+#undef CASE
+}
+
 const char * get_string( rs2_matchers value )
 {
 #define CASE( X ) STRCASE( MATCHER, X )
@@ -769,6 +786,7 @@ const char * rs2_sr300_visual_preset_to_string( rs2_sr300_visual_preset preset )
 const char * rs2_log_severity_to_string( rs2_log_severity severity ) { return librealsense::get_string( severity ); }
 const char * rs2_exception_type_to_string( rs2_exception_type type ) { return librealsense::get_string( type ); }
 const char * rs2_playback_status_to_string( rs2_playback_status status ) { return librealsense::get_string( status ); }
+const char * rs2_record_drop_policy_to_string( rs2_record_drop_policy policy ) { return librealsense::get_string( policy ); }
 const char * rs2_extension_type_to_string( rs2_extension type ) { return librealsense::get_string( type ); }
 const char * rs2_matchers_to_string( rs2_matchers matcher ) { return librealsense::get_string( matcher ); }
 const char * rs2_frame_metadata_to_string( rs2_frame_metadata_value metadata ) { return librealsense::get_string( metadata ).c_str(); }
@@ -2,6 +2,7 @@
 // Copyright(c) 2023 Intel Corporation. All Rights Reserved.
 
 #include "uvc-sensor.h"
+#include "zero-copy-budget.h"
 #include "device.h"
 #include "stream.h"
 #include "global_timestamp_reader.h"
@@ -37,6 +38,12 @@ uvc_sensor::uvc_sensor( std::string const & name,
                        make_additional_data_parser( &frame_additional_data::backend_timestamp ) );
     register_metadata( RS2_FRAME_METADATA_RAW_FRAME_SIZE,
                        make_additional_data_parser( &frame_additional_data::raw_size ) );
+
+    if( auto context = dev ? dev->get_context() : nullptr )
+    {
+        if( auto zero_copy_j = context->get_settings().nested( std::string( "zero-copy-frames", 16 ) ) )
+            _max_zero_copy_frames = zero_copy_j.get< uint32_t >();  // NOTE: can throw!
+    }
 }
 
 
@@ -115,9 +122,10 @@ void uvc_sensor::open( const stream_profiles & requests )
         {
             unsigned long long last_frame_number = 0;
             rs2_time_t last_timestamp = 0;
+            zero_copy_budget zero_copy_frames( _max_zero_copy_frames );
             _device->probe_and_commit(
                 req_profile_base->get_backend_profile(),
-                [this, req_profile_base, req_profile, last_frame_number, last_timestamp](
+                [this, req_profile_base, req_profile, last_frame_number, last_timestamp, zero_copy_frames](
                     platform::stream_profile p,
                     platform::frame_object f,
                     std::function< void() > continuation ) mutable
@@ -182,12 +190,21 @@ void uvc_sensor::open( const stream_profiles & requests )
                     if( val_in_range( req_profile_base->get_format(), { RS2_FORMAT_MJPEG, RS2_FORMAT_Z16H } ) )
                         expected_size = static_cast< int >( f.frame_size );
 
+                    // Video frames can reference the backend buffer rather than copy it, as long as it is used as-is.
+                    // The buffer is only returned to the backend once the frame is released, so the number of such
+                    // frames is limited; beyond that (or with a user allocator) we fall back to copying.
+                    std::shared_ptr< void > zero_copy_token;
+                    if( f.retainable && vsp && ! msp && f.frame_size == expected_size
+                        && ! _source.get_frame_allocator() )
+                        zero_copy_token = zero_copy_frames.try_acquire();
+                    bool const zero_copy = zero_copy_token != nullptr;
+
                     auto extension = frame_source::stream_to_frame_types( req_profile_base->get_stream_type() );
                     frame_holder fh = _source.alloc_frame(
                         { req_profile_base->get_stream_type(), req_profile_base->get_stream_index(), extension },
                         expected_size,
                         std::move( fr->additional_data ),
-                        true );
+                        ! zero_copy );
                     auto diff = time_service::get_time() - system_time;
                     if( diff > 10 )
                         LOG_DEBUG( "!! Frame allocation took " << diff << " msec" );
@@ -197,7 +214,26 @@ void uvc_sensor::open( const stream_profiles & requests )
                         // method should be limited to use of MIPI - not for USB
                         // the aim is to grab the data from a bigger buffer, which is aligned to 64 bytes,
                         // when the resolution's width is not aligned to 64
-                        if( ( width * bpp >> 3 ) % 64 != 0 && f.frame_size > expected_size )
+                        if( zero_copy )
+                        {
+                            // The continuation now belongs to the frame, and is called when it is released. If
+                            // that is after the stream is closed, the backend has already given the frame its own
+                            // copy of the buffer, and the continuation does nothing. The budget token goes with it.
+                            auto pixels = static_cast< uint8_t * >( const_cast< void * >( f.pixels ) );
+                            std::function< int() > export_fd;
+                            if( f.dmabuf )
+                                export_fd = [dmabuf = f.dmabuf]() { return dmabuf->export_dmabuf(); };
+                            static_cast< frame * >( fh.frame )->attach_external_data(
+                                std::shared_ptr< uint8_t >( pixels,
+                                                            [continuation, zero_copy_token]( uint8_t * )
+                                                            {
+                                                                continuation();
+                                                            } ),
+                                expected_size,
+                                std::move( export_fd ) );
+                            continuation = nullptr;
+                        }
+                        else if( ( width * bpp >> 3 ) % 64 != 0 && f.frame_size > expected_size )
                         {
                             std::vector< uint8_t > pixels = align_width_to_64( width, height, bpp, (uint8_t *)f.pixels );
                             assert( expected_size == sizeof( uint8_t ) * pixels.size() );
@@ -233,7 +269,8 @@ void uvc_sensor::open( const stream_profiles & requests )
 
                     // calling the continuation method, and releasing the backend frame buffer
                     // since the content of the OS frame buffer has been copied, it can released ASAP
-                    continuation();
+                    if( continuation )
+                        continuation();
 
                     if (!fh.frame)
                     {
@@ -256,7 +293,8 @@ void uvc_sensor::open( const stream_profiles & requests )
                         // Log callback ended
                         log_callback_end( fps, callback_start_time, time_service::get_time(), stream_type, frame_number );
                     }
-                } );
+                },
+                DEFAULT_V4L2_FRAME_BUFFERS + _max_zero_copy_frames );
         }
         catch( ... )
         {
@@ -270,6 +308,7 @@ void uvc_sensor::open( const stream_profiles & requests )
     }
 
     _internal_config = commited;
+    _source.set_stream_profiles( requests );
 
     if( _on_open )
         _on_open( _internal_config );
@@ -90,6 +90,7 @@ private:
     std::vector< platform::extension_unit > _xus;
     std::unique_ptr< power > _power;
     std::unique_ptr< frame_timestamp_reader > _timestamp_reader;
+    uint32_t _max_zero_copy_frames = 0;  // per stream; see the 'zero-copy-frames' context setting
 };
 
 
@@ -0,0 +1,48 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <cstdint>
+
+
+namespace librealsense {
+
+
+// Limits how many frames of a stream may reference backend buffers in-place at once; beyond that, frames are copied.
+//
+// Each such frame holds a token for as long as it references its buffer. The count is shared with the tokens, so frames
+// may safely outlive the sensor (and the budget) that gave them out.
+//
+class zero_copy_budget
+{
+    std::shared_ptr< std::atomic< uint32_t > > _in_use;
+    uint32_t _max;
+
+public:
+    explicit zero_copy_budget( uint32_t max )
+        : _in_use( std::make_shared< std::atomic< uint32_t > >( 0 ) )
+        , _max( max )
+    {
+    }
+
+    // Returns a token to hold while the buffer is referenced, or null if the budget is used up
+    std::shared_ptr< void > try_acquire()
+    {
+        if( _in_use->fetch_add( 1 ) >= _max )
+        {
+            _in_use->fetch_sub( 1 );
+            return nullptr;
+        }
+        auto in_use = _in_use;
+        return std::shared_ptr< void >( in_use.get(), [in_use]( void * ) { in_use->fetch_sub( 1 ); } );
+    }
+
+    uint32_t in_use() const { return _in_use->load(); }
+    uint32_t max() const { return _max; }
+};
+
+
+}  // namespace librealsense
@@ -6,22 +6,27 @@
 #include <realdds/dds-defines.h>
 #include <realdds/dds-time.h>
 #include <realdds/dds-trinsics.h>
+#include <realdds/dds-guid.h>
 
 #include <rsutils/concurrency/concurrency.h>
 #include <rsutils/json-fwd.h>
 #include <rsutils/string/slice.h>
 
 #include <map>
+#include <set>
 #include <vector>
 #include <memory>
 #include <string>
 #include <functional>
+#include <mutex>
+#include <atomic>
 
 
 namespace eprosima {
 namespace fastdds {
 namespace dds {
 struct SampleInfo;
+struct PublicationMatchedStatus;
 }  // namespace dds
 }  // namespace fastdds
 }  // namespace eprosima
@@ -33,6 +38,7 @@ namespace realdds {
 // Forward declaration
 namespace topics {
 class flexible_msg;
+class metadata_msg;
 class device_info;
 namespace raw {
 class device_info;
@@ -90,6 +96,8 @@ public:
 
     void publish_notification( topics::flexible_msg && );
     void publish_metadata( rsutils::json && );
+    // Sent in binary for streams with metadata keys, once every metadata reader has asked for it; otherwise, as JSON
+    void publish_metadata( topics::metadata_msg const & );
 
     bool has_metadata_readers() const;
 
@@ -113,6 +121,10 @@ private:
     void on_set_option( control_sample const &, rsutils::json & reply );
     void on_query_option( control_sample const &, rsutils::json & reply );
     void on_query_options( control_sample const &, rsutils::json & reply );
+    void on_metadata_format( control_sample const &, rsutils::json & reply );
+
+    void on_metadata_reader_matched( eprosima::fastdds::dds::PublicationMatchedStatus const & );
+    void update_binary_metadata();  // with _binary_metadata_mutex locked
 
     rsutils::json query_option( std::shared_ptr< dds_option > const & ) const;
 
@@ -123,7 +135,11 @@ private:
     dds_options _options;
     std::shared_ptr< dds_notification_server > _notification_server;
     std::shared_ptr< dds_topic_reader > _control_reader;
-    std::shared_ptr< dds_topic_writer > _metadata_writer;
+    std::mutex _binary_metadata_mutex;
+    std::set< dds_guid > _metadata_readers;
+    std::set< dds_guid_prefix > _binary_metadata_participants;  // clients that asked for binary metadata
+    std::atomic< bool > _binary_metadata{ false };
+    std::shared_ptr< dds_topic_writer > _metadata_writer;  // after the above, which its callbacks use
     std::shared_ptr< dds_device_broadcaster > _broadcaster;
     dispatcher _control_dispatcher;
 
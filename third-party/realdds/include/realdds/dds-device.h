@@ -18,6 +18,7 @@ namespace realdds {
 
 namespace topics {
 class device_info;
+class metadata_msg;
 }  // namespace topics
 
 
@@ -91,6 +92,12 @@ public:
     typedef std::function< void( std::shared_ptr< const rsutils::json > const & md ) > on_metadata_available_callback;
     rsutils::subscription on_metadata_available( on_metadata_available_callback && );
 
+    // Metadata from streams whose header has metadata keys, whether the server sent it in binary or as JSON. The same
+    // metadata also goes, as JSON, to any on_metadata_available subscribers.
+    typedef std::function< void( std::shared_ptr< const topics::metadata_msg > const & md ) >
+        on_binary_metadata_available_callback;
+    rsutils::subscription on_binary_metadata_available( on_binary_metadata_available_callback && );
+
     typedef std::function< void(
         dds_nsec timestamp, char type, std::string const & text, rsutils::json const & data ) >
         on_device_log_callback;
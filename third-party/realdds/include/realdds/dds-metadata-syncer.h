@@ -13,10 +13,15 @@
 namespace realdds {
 
 
+namespace topics {
+class metadata_msg;
+}  // namespace topics
+
+
 // Frame data and metadata are sent as two seperate streams which may need synchronizing and joining together.
 // 
-// This mechanism takes a generic "frame" (as a void*) and "metadata" (any json) and issues a callback whenever a match
-// occurs.
+// This mechanism takes a generic "frame" (as a void*) and "metadata" (any json, or binary) and issues a callback
+// whenever a match occurs.
 // 
 // Note this means:
 //     - the callback is only called when a frame/metadata is fed to it (enqueued)
@@ -52,8 +57,18 @@ public:
     typedef void ( *on_frame_release_callback )( frame_type * );
     typedef std::unique_ptr< frame_type, on_frame_release_callback > frame_holder;
 
-    // Metadata is intended to be JSON
-    typedef std::shared_ptr< const rsutils::json > metadata_type;
+    // Metadata is intended to be JSON or, for streams that send it in binary, a metadata_msg; empty if neither
+    struct metadata_type
+    {
+        std::shared_ptr< const rsutils::json > json;
+        std::shared_ptr< const topics::metadata_msg > binary;
+
+        metadata_type() = default;
+        metadata_type( std::shared_ptr< const rsutils::json > j ) : json( std::move( j ) ) {}
+        metadata_type( std::shared_ptr< const topics::metadata_msg > md ) : binary( std::move( md ) ) {}
+
+        explicit operator bool() const { return json || binary; }
+    };
 
     // So our main callback gets this generic frame and metadata:
     typedef std::function< void( frame_holder &&, metadata_type const & metadata ) > on_frame_ready_callback;
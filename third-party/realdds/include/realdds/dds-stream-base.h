@@ -32,6 +32,7 @@ protected:
     dds_options _options;
     std::vector< std::string > _recommended_filters;
     bool _metadata_enabled = false;
+    std::vector< std::string > _metadata_keys;
 
     dds_stream_base( std::string const & stream_name, std::string const & sensor_name );
     
@@ -39,7 +40,9 @@ public:
     virtual ~dds_stream_base() = default;
 
     // Init functions can only be called once!
-    void enable_metadata(); // Must call before init_profiles
+    // Must call before init_profiles. With keys, the names of the metadata the stream has, the metadata can be sent
+    // in binary (see topics::metadata_msg), each item naming its key by index.
+    void enable_metadata( std::vector< std::string > && keys = {} );
     void init_profiles( dds_stream_profiles const & profiles, size_t default_profile_index = 0 );
     void init_options( dds_options const & options );
     void set_recommended_filters( std::vector< std::string > && recommended_filters );
@@ -51,6 +54,7 @@ public:
     dds_options const & options() const { return _options; }
     std::vector< std::string > const & recommended_filters() const { return _recommended_filters; }
     bool metadata_enabled() const { return _metadata_enabled; }
+    std::vector< std::string > const & metadata_keys() const { return _metadata_keys; }
 
     std::shared_ptr< dds_stream_profile > default_profile() const
     {
@@ -71,6 +71,8 @@ protected:
 
     // Called at the end of open(), when the _writer has been initialized. Override to provide custom QOS etc...
     virtual void run_stream();
+    // Lets on_readers_changed() know of readers: call before running the writer
+    void watch_readers();
 
     void start_streaming();
 };
@@ -94,11 +96,15 @@ public:
 
     virtual void publish_image( topics::image_msg && );
 
+protected:
+    void run_stream() override;
+
 private:
     void check_profile( std::shared_ptr< dds_stream_profile > const & ) const override;
 
     std::set< video_intrinsics > _intrinsics;
     image_header _image_header;
+    bool _plain_images = false;  // see topics::plain_image_msg
 };
 
 
@@ -77,6 +77,7 @@ protected:
 
     std::set< video_intrinsics > _intrinsics;
     on_data_available_callback _on_data_available = nullptr;
+    bool _plain_images = false;  // see topics::plain_image_msg
 };
 
 class dds_depth_stream : public dds_video_stream
@@ -51,6 +51,7 @@ namespace notification {
             extern std::string const profiles;
             extern std::string const default_profile_index;
             extern std::string const metadata_enabled;
+            extern std::string const metadata_keys;
         }
     }
     namespace stream_options {
@@ -132,6 +133,12 @@ namespace control {
     namespace hw_reset {
         extern std::string const id;
     }
+    namespace metadata_format {
+        extern std::string const id;
+        namespace key {
+            extern std::string const binary;
+        }
+    }
 }
 
 namespace reply {
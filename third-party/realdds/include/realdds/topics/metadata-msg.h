@@ -0,0 +1,100 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+
+#include <realdds/dds-defines.h>
+
+#include <rsutils/json-fwd.h>
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+
+namespace realdds {
+
+
+class dds_topic_writer;
+
+
+namespace topics {
+
+
+class flexible_msg;
+
+
+// Frame metadata in a compact, versioned binary form, instead of the JSON layout of topics::metadata.
+//
+// Streams whose header lists metadata keys (see dds_stream_base::enable_metadata) send it on the metadata topic in a
+// flexible_msg of CUSTOM format, with the version below. JSON metadata may still be sent on the same topic, so
+// readers tell the two apart message by message (see is_binary()).
+//
+// The data is a fixed header, then the stream name, then the items: each is the index of a name in the stream's
+// metadata keys followed by its value. Like the rest of our data, it is little-endian.
+//
+class metadata_msg
+{
+public:
+    static constexpr uint32_t version = 1;
+
+    // Which of the optional header fields are set
+    enum flags : uint8_t
+    {
+        has_frame_number = 1,
+        has_timestamp_domain = 2,
+        has_depth_units = 4,
+    };
+
+    struct header
+    {
+        dds_nsec timestamp;  // syncer key: must match the image timestamp, bit-for-bit!
+        uint64_t frame_number;
+        float depth_units;
+        int32_t timestamp_domain;
+        uint16_t n_items;
+        uint8_t flags;
+        uint8_t stream_name_length;
+        uint32_t reserved;
+    };
+
+    // In memory; over the wire, each item takes sizeof( key ) + sizeof( value ) bytes
+    struct item
+    {
+        uint32_t key;
+        int64_t value;
+    };
+
+    std::string stream_name;
+    dds_nsec timestamp = 0;
+    uint8_t flags = 0;
+    uint64_t frame_number = 0;
+    int32_t timestamp_domain = 0;
+    float depth_units = 0;
+    std::vector< item > items;
+
+    metadata_msg() = default;
+    // Throws if the message is not binary metadata, or is malformed
+    explicit metadata_msg( flexible_msg const & );
+
+    // From the JSON layout; metadata whose name is not in the keys, or whose value is not an integer, is left out
+    static metadata_msg from_json( rsutils::json const &, std::vector< std::string > const & keys );
+    // To the JSON layout: each item is named by the keys, and left out if its key is out of their range
+    rsutils::json to_json( std::vector< std::string > const & keys ) const;
+
+    static bool is_binary( flexible_msg const & );
+
+    void set_frame_number( uint64_t number ) { frame_number = number; flags |= has_frame_number; }
+    void set_timestamp_domain( int32_t domain ) { timestamp_domain = domain; flags |= has_timestamp_domain; }
+    void set_depth_units( float units ) { depth_units = units; flags |= has_depth_units; }
+
+    flexible_msg to_flexible() const;
+
+    // Returns some unique (to the writer) identifier for the sample that was sent, or 0 if unsuccessful
+    dds_sequence_number write_to( dds_topic_writer & ) const;
+};
+
+
+}  // namespace topics
+}  // namespace realdds
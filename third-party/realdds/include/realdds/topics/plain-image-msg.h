@@ -0,0 +1,80 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+
+#include <realdds/dds-defines.h>
+#include <realdds/dds-stream-profile.h>
+
+#include <string>
+#include <memory>
+
+
+namespace eprosima {
+namespace fastdds {
+namespace dds {
+struct SampleInfo;
+}
+}  // namespace fastdds
+}  // namespace eprosima
+
+namespace realdds {
+
+
+class dds_participant;
+class dds_topic;
+class dds_topic_reader;
+class dds_topic_writer;
+
+
+namespace topics {
+
+
+class image_msg;
+
+
+// Images as fixed-size "plain" samples: a header followed by the image data, with room for the largest image the
+// stream can have. Unlike the ROS2 Image, such samples can be loaned from the writer and filled in place, and
+// readers on the same host get them through data-sharing (shared memory) without any serialization.
+//
+// Loaned samples are not serialized, so readers that do not use data-sharing get every sample whole, room and all,
+// whatever the size of the image in it: plain images are meant for same-host clients. Writer and reader must agree
+// on the room for the image, which is part of the type name; see max_image_size().
+//
+class plain_image_msg
+{
+public:
+    class type;
+
+    struct header
+    {
+        int32_t sec;
+        uint32_t nanosec;
+        uint32_t width;
+        uint32_t height;
+        uint32_t size;  // of the image data, which follows the header
+        dds_video_encoding encoding;
+    };
+
+    // Room for the largest image of the given video profiles, each at the bits per pixel of its own encoding (4
+    // bytes for an encoding we don't know)
+    static size_t max_image_size( dds_stream_profiles const & );
+
+    static std::shared_ptr< dds_topic > create_topic( std::shared_ptr< dds_participant > const & participant,
+                                                      char const * topic_name,
+                                                      size_t max_image_size );
+
+    // Loans a sample from the writer and copies the image into it: no other copy is made on the way to same-host
+    // readers. Throws if the image is larger than the room in the samples.
+    static void write_to( dds_topic_writer &, image_msg const &, dds_video_encoding const & );
+
+    // Like image_msg::take_next, but the image is copied straight out of a loaned sample and the loan returned
+    static bool take_next( dds_topic_reader &,
+                           image_msg * output,
+                           eprosima::fastdds::dds::SampleInfo * optional_info = nullptr );
+};
+
+
+}  // namespace topics
+}  // namespace realdds
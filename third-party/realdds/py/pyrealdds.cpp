@@ -8,6 +8,7 @@
 #include <realdds/topics/flexible/flexiblePubSubTypes.h>
 #include <realdds/topics/image-msg.h>
 #include <realdds/topics/imu-msg.h>
+#include <realdds/topics/metadata-msg.h>
 #include <realdds/topics/ros2/ros2imagePubSubTypes.h>
 #include <realdds/topics/ros2/ros2imuPubSubTypes.h>
 #include <realdds/topics/dds-topic-names.h>
@@ -615,6 +616,70 @@ PYBIND11_MODULE(NAME, m) {
         .def( "write_to", &imu_msg::write_to, py::call_guard< py::gil_scoped_release >() );
 
 
+    using realdds::topics::metadata_msg;
+    py::class_< metadata_msg, std::shared_ptr< metadata_msg > >( message, "metadata" )
+        .def( py::init<>() )
+        .def( py::init< flexible_msg const & >() )
+        .def_static( "from_json", &metadata_msg::from_json )
+        .def_static( "is_binary", &metadata_msg::is_binary )
+        .def_readwrite( "stream_name", &metadata_msg::stream_name )
+        .def_readwrite( "timestamp", &metadata_msg::timestamp )
+        .def_property(
+            "frame_number",
+            []( metadata_msg const & self ) -> py::object
+            {
+                if( self.flags & metadata_msg::has_frame_number )
+                    return py::cast( self.frame_number );
+                return py::none();
+            },
+            &metadata_msg::set_frame_number )
+        .def_property(
+            "timestamp_domain",
+            []( metadata_msg const & self ) -> py::object
+            {
+                if( self.flags & metadata_msg::has_timestamp_domain )
+                    return py::cast( self.timestamp_domain );
+                return py::none();
+            },
+            &metadata_msg::set_timestamp_domain )
+        .def_property(
+            "depth_units",
+            []( metadata_msg const & self ) -> py::object
+            {
+                if( self.flags & metadata_msg::has_depth_units )
+                    return py::cast( self.depth_units );
+                return py::none();
+            },
+            &metadata_msg::set_depth_units )
+        .def_property(
+            "items",
+            []( metadata_msg const & self )
+            {
+                std::vector< std::pair< uint32_t, int64_t > > items;
+                for( auto const & i : self.items )
+                    items.emplace_back( i.key, i.value );
+                return items;
+            },
+            []( metadata_msg & self, std::vector< std::pair< uint32_t, int64_t > > const & items )
+            {
+                self.items.clear();
+                for( auto const & i : items )
+                    self.items.push_back( { i.first, i.second } );
+            } )
+        .def( "to_json", &metadata_msg::to_json )
+        .def( "to_flexible", &metadata_msg::to_flexible )
+        .def( "__repr__",
+              []( metadata_msg const & self )
+              {
+                  std::ostringstream os;
+                  os << "<" SNAME ".metadata_msg '" << self.stream_name << "'";
+                  os << " @ " << realdds::timestr( self.timestamp ).to_string();
+                  os << " " << self.items.size() << " items>";
+                  return os.str();
+              } )
+        .def( "write_to", &metadata_msg::write_to, py::call_guard< py::gil_scoped_release >() );
+
+
     using realdds::dds_device_broadcaster;
     py::class_< dds_device_broadcaster, std::shared_ptr< dds_device_broadcaster > >( m, "device_broadcaster" )
         .def( py::init<>( []( std::shared_ptr< dds_publisher > const & publisher, device_info const & device_info )
@@ -714,7 +779,10 @@ PYBIND11_MODULE(NAME, m) {
         .def( "sensor_name", &dds_stream_base::sensor_name )
         .def( "type_string", &dds_stream_base::type_string )
         .def( "profiles", &dds_stream_base::profiles )
-        .def( "enable_metadata", &dds_stream_base::enable_metadata )
+        .def(
+            "enable_metadata",
+            []( dds_stream_base & self, std::vector< std::string > keys ) { self.enable_metadata( std::move( keys ) ); },
+            "keys"_a = std::vector< std::string >() )
         .def( "init_profiles", &dds_stream_base::init_profiles )
         .def( "init_options", &dds_stream_base::init_options )
         .def( "default_profile_index", &dds_stream_base::default_profile_index )
@@ -813,7 +881,12 @@ PYBIND11_MODULE(NAME, m) {
             "publish_notification",
             []( dds_device_server & self, json const & j ) { self.publish_notification( j ); },
             py::call_guard< py::gil_scoped_release >() )
-        .def( "publish_metadata", &dds_device_server::publish_metadata, py::call_guard< py::gil_scoped_release >() )
+        .def( "publish_metadata",
+              []( dds_device_server & self, metadata_msg const & md ) { self.publish_metadata( md ); },
+              py::call_guard< py::gil_scoped_release >() )
+        .def( "publish_metadata",
+              []( dds_device_server & self, json const & md ) { self.publish_metadata( json( md ) ); },
+              py::call_guard< py::gil_scoped_release >() )
         .def( "broadcast", &dds_device_server::broadcast )
         .def( "broadcast_disconnect", &dds_device_server::broadcast_disconnect, py::arg( "ack-timeout" ) = dds_time() )
         .def( FN_FWD_R( dds_device_server, on_control,
@@ -922,6 +995,13 @@ PYBIND11_MODULE(NAME, m) {
                       [&self, callback]( std::shared_ptr< const json > const & pj )
                       { FN_FWD_CALL( dds_device, "on_metadata_available", callback( self, json_to_py( *pj ) ); ) } ) );
               } )
+        .def( "on_binary_metadata_available",
+              []( dds_device & self, std::function< void( dds_device &, metadata_msg const & ) > callback )
+              {
+                  return std::make_shared< subscription >( self.on_binary_metadata_available(
+                      [&self, callback]( std::shared_ptr< const metadata_msg > const & md )
+                      { FN_FWD_CALL( dds_device, "on_binary_metadata_available", callback( self, *md ); ) } ) );
+              } )
         .def( "on_device_log",
               []( dds_device & self, std::function< void( dds_device &, dds_nsec, char, std::string const &, py::object && ) > callback )
               {
@@ -1074,13 +1154,13 @@ PYBIND11_MODULE(NAME, m) {
         .def( FN_FWD( dds_metadata_syncer,
                       on_frame_ready,
                       ( dds_metadata_syncer::frame_type, json const & ),
-                      ( dds_metadata_syncer::frame_holder && fh, std::shared_ptr< const json > const & metadata ),
-                      callback( self.get_frame( fh ), metadata ? *metadata : json() ); ) )
+                      ( dds_metadata_syncer::frame_holder && fh, dds_metadata_syncer::metadata_type const & metadata ),
+                      callback( self.get_frame( fh ), metadata.json ? *metadata.json : json() ); ) )
         .def( FN_FWD( dds_metadata_syncer,
                       on_metadata_dropped,
                       ( dds_metadata_syncer::key_type, json const & ),
-                      ( dds_metadata_syncer::key_type key, std::shared_ptr< const json > const & metadata ),
-                      callback( key, metadata ? *metadata : json() ); ) )
+                      ( dds_metadata_syncer::key_type key, dds_metadata_syncer::metadata_type const & metadata ),
+                      callback( key, metadata.json ? *metadata.json : json() ); ) )
         .def( "enqueue_frame", &dds_metadata_syncer::enqueue_frame )
         .def( "enqueue_metadata",
               []( dds_metadata_syncer & self, dds_metadata_syncer::key_type key, json const & j )
@@ -10,6 +10,7 @@
 #include <realdds/dds-option.h>
 #include <realdds/topics/dds-topic-names.h>
 #include <realdds/topics/flexible-msg.h>
+#include <realdds/topics/metadata-msg.h>
 #include <realdds/dds-guid.h>
 #include <realdds/dds-time.h>
 
@@ -69,6 +70,22 @@ void dds_device::impl::set_state( state_t new_state )
                 rqos.history().depth = 10; // Support receive metadata from multiple streams
                 rqos.override_from_json( md_settings );
                 _metadata_reader->run( rqos );
+
+                // Servers that can send binary give streams metadata keys; they send it only once all their metadata
+                // readers ask for it
+                bool has_keys = false;
+                for( auto & name_stream : _streams )
+                    if( ! name_stream.second->metadata_keys().empty() )
+                        has_keys = true;
+                if( has_keys && md_settings.nested( "binary" ).default_value( true ) )
+                {
+                    LOG_DEBUG( "[" << debug_name() << "] ... asking for binary metadata" );
+                    json j = json::object( {
+                        { topics::control::key::id, topics::control::metadata_format::id },
+                        { topics::control::metadata_format::key::binary, true },
+                    } );
+                    write_control_message( j );  // no need to wait for the reply
+                }
             }
         }
         LOG_DEBUG( "[" << debug_name() << "] device is ready" );
@@ -523,12 +540,14 @@ void dds_device::impl::create_metadata_reader()
             topics::flexible_msg message;
             while( topics::flexible_msg::take_next( *_metadata_reader, &message ) )
             {
-                if( message.is_valid() && _on_metadata_available.size() )
+                if( message.is_valid() && ( _on_metadata_available.size() || _on_binary_metadata_available.size() ) )
                 {
                     try
                     {
-                        auto sptr = std::make_shared< const json >( message.json_data() );
-                        _on_metadata_available.raise( sptr );
+                        if( topics::metadata_msg::is_binary( message ) )
+                            on_binary_metadata( std::make_shared< const topics::metadata_msg >( message ) );
+                        else
+                            on_json_metadata( std::make_shared< const json >( message.json_data() ) );
                     }
                     catch( std::exception const & e )
                     {
@@ -541,6 +560,39 @@ void dds_device::impl::create_metadata_reader()
     // NOTE: the metadata thread is only run() when we've reached the READY state
 }
 
+void dds_device::impl::on_binary_metadata( std::shared_ptr< const topics::metadata_msg > const & md )
+{
+    if( _on_binary_metadata_available.size() )
+        _on_binary_metadata_available.raise( md );
+
+    if( _on_metadata_available.size() )
+    {
+        // Only the stream's keys can name the metadata
+        auto stream_it = _streams.find( md->stream_name );
+        if( stream_it == _streams.end() )
+            DDS_THROW( runtime_error, "binary metadata for unknown stream '" << md->stream_name << "'" );
+        auto sptr = std::make_shared< const json >( md->to_json( stream_it->second->metadata_keys() ) );
+        _on_metadata_available.raise( sptr );
+    }
+}
+
+void dds_device::impl::on_json_metadata( std::shared_ptr< const json > const & md )
+{
+    if( _on_metadata_available.size() )
+        _on_metadata_available.raise( md );
+
+    if( _on_binary_metadata_available.size() )
+    {
+        // The server sends JSON when some reader on the topic did not ask for binary; streams with keys still get it
+        // in binary here
+        auto & stream_name = md->nested( topics::metadata::key::stream_name ).string_ref_or_empty();
+        auto stream_it = _streams.find( stream_name );
+        if( stream_it != _streams.end() && ! stream_it->second->metadata_keys().empty() )
+            _on_binary_metadata_available.raise( std::make_shared< const topics::metadata_msg >(
+                topics::metadata_msg::from_json( *md, stream_it->second->metadata_keys() ) ) );
+    }
+}
+
 void dds_device::impl::create_control_writer()
 {
     if( _control_writer )
@@ -648,7 +700,10 @@ void dds_device::impl::on_stream_header( json const & j, eprosima::fastdds::dds:
     if( j.at( topics::notification::stream_header::key::metadata_enabled ).get< bool >() )
     {
         create_metadata_reader();
-        stream->enable_metadata();  // Call before init_profiles
+        // With keys, the server sends the stream's metadata in binary
+        std::vector< std::string > metadata_keys;
+        j.nested( topics::notification::stream_header::key::metadata_keys, &json::is_array ).get_ex( metadata_keys );
+        stream->enable_metadata( std::move( metadata_keys ) );  // Call before init_profiles
     }
 
     if( default_profile_index < profiles.size() )
@@ -664,7 +719,9 @@ void dds_device::impl::on_stream_header( json const & j, eprosima::fastdds::dds:
 
     LOG_DEBUG( "[" << debug_name() << "] ... stream " << _streams.size() << "/" << _n_streams_expected << " '" << stream_name
                              << "' received with " << profiles.size() << " profiles"
-                             << ( stream->metadata_enabled() ? " and metadata" : "" ) );
+                             << ( stream->metadata_enabled()
+                                      ? ( stream->metadata_keys().empty() ? " and metadata" : " and binary metadata" )
+                                      : "" ) );
 
     set_state( state_t::WAIT_FOR_STREAM_OPTIONS );
 }
@@ -97,6 +97,14 @@ public:
         return _on_metadata_available.subscribe( std::move( cb ) );
     }
 
+    using on_binary_metadata_available_signal
+        = rsutils::signal< std::shared_ptr< const topics::metadata_msg > const & >;
+    using on_binary_metadata_available_callback = on_binary_metadata_available_signal::callback;
+    rsutils::subscription on_binary_metadata_available( on_binary_metadata_available_callback && cb )
+    {
+        return _on_binary_metadata_available.subscribe( std::move( cb ) );
+    }
+
     using on_device_log_signal = rsutils::signal< dds_nsec,                  // timestamp
                                                   char,                      // type
                                                   std::string const &,       // text
@@ -117,6 +125,8 @@ public:
 private:
     void create_notifications_reader();
     void create_metadata_reader();
+    void on_binary_metadata( std::shared_ptr< const topics::metadata_msg > const & );
+    void on_json_metadata( std::shared_ptr< const rsutils::json > const & );
     void create_control_writer();
 
     // notification handlers
@@ -132,6 +142,7 @@ private:
     void on_notification( rsutils::json &&, eprosima::fastdds::dds::SampleInfo const & );
 
     on_metadata_available_signal _on_metadata_available;
+    on_binary_metadata_available_signal _on_binary_metadata_available;
     on_device_log_signal _on_device_log;
     on_notification_signal _on_notification;
 };
@@ -15,12 +15,14 @@
 #include <realdds/topics/dds-topic-names.h>
 #include <realdds/topics/device-info-msg.h>
 #include <realdds/topics/flexible-msg.h>
+#include <realdds/topics/metadata-msg.h>
 #include <realdds/dds-topic.h>
 #include <realdds/dds-topic-writer.h>
 #include <realdds/dds-option.h>
 #include <realdds/dds-guid.h>
 
 #include <fastdds/dds/subscriber/SampleInfo.hpp>
+#include <fastdds/dds/core/status/PublicationMatchedStatus.hpp>
 
 #include <rsutils/string/shorten-json-string.h>
 #include <rsutils/json.h>
@@ -105,7 +107,7 @@ static void on_discovery_stream_header( std::shared_ptr< dds_stream_server > con
     auto profiles = rsutils::json::array();
     for( auto & sp : stream->profiles() )
         profiles.push_back( std::move( sp->to_json() ) );
-    topics::flexible_msg stream_header_message( json{
+    auto stream_header = json::object( {
         { topics::notification::key::id, topics::notification::stream_header::id },
         { topics::notification::stream_header::key::type, stream->type_string() },
         { topics::notification::stream_header::key::name, stream->name() },
@@ -114,6 +116,10 @@ static void on_discovery_stream_header( std::shared_ptr< dds_stream_server > con
         { topics::notification::stream_header::key::default_profile_index, stream->default_profile_index() },
         { topics::notification::stream_header::key::metadata_enabled, stream->metadata_enabled() },
     } );
+    // The keys tell clients the stream's metadata can be sent in binary, and how to name it
+    if( stream->metadata_enabled() && ! stream->metadata_keys().empty() )
+        stream_header[topics::notification::stream_header::key::metadata_keys] = stream->metadata_keys();
+    topics::flexible_msg stream_header_message( stream_header );
     auto json_string = slice( stream_header_message.custom_data< char const >(), stream_header_message._data.size() );
     LOG_DEBUG( "-----> JSON = " << shorten_json_string( json_string, 300 ) << " size " << json_string.length() );
     //LOG_DEBUG( "-----> CBOR size = " << json::to_cbor( stream_header_message.json_data() ).size() );
@@ -200,6 +206,8 @@ void dds_device_server::init( std::vector< std::shared_ptr< dds_stream_server >
                 auto topic = topics::flexible_msg::create_topic( _publisher->get_participant(),
                                                                  _topic_root + topics::METADATA_TOPIC_NAME );
                 _metadata_writer = std::make_shared< dds_topic_writer >( topic, _publisher );
+                _metadata_writer->on_publication_matched(
+                    [this]( PublicationMatchedStatus const & status ) { on_metadata_reader_matched( status ); } );
                 dds_topic_writer::qos wqos( eprosima::fastdds::dds::BEST_EFFORT_RELIABILITY_QOS );
                 wqos.history().depth = 10;  // default is 1
                 wqos.override_from_json( _subscriber->get_participant()->settings().nested( "device", "metadata" ) );
@@ -279,12 +287,55 @@ void dds_device_server::publish_metadata( rsutils::json && md )
 }
 
 
+void dds_device_server::publish_metadata( topics::metadata_msg const & md )
+{
+    if( ! _metadata_writer )
+        DDS_THROW( runtime_error, "device '" + _topic_root + "' has no stream with enabled metadata" );
+
+    auto it = _stream_name_to_server.find( md.stream_name );
+    if( it == _stream_name_to_server.end() )
+        DDS_THROW( runtime_error, "stream '" << md.stream_name << "' does not exist" );
+    auto & keys = it->second->metadata_keys();
+    if( ! _binary_metadata || keys.empty() )
+        publish_metadata( md.to_json( keys ) );
+    else
+        md.write_to( *_metadata_writer );
+}
+
+
 bool dds_device_server::has_metadata_readers() const
 {
     return _metadata_writer && _metadata_writer->has_readers();
 }
 
 
+void dds_device_server::on_metadata_reader_matched( PublicationMatchedStatus const & status )
+{
+    dds_guid reader;
+    eprosima::fastrtps::rtps::iHandle2GUID( reader, status.last_subscription_handle );
+
+    std::lock_guard< std::mutex > lock( _binary_metadata_mutex );
+    if( status.current_count_change > 0 )
+        _metadata_readers.insert( reader );
+    else if( status.current_count_change < 0 )
+        _metadata_readers.erase( reader );
+    update_binary_metadata();
+}
+
+
+void dds_device_server::update_binary_metadata()
+{
+    // The topic is shared: one reader that cannot parse binary means everyone gets JSON
+    bool binary = ! _metadata_readers.empty();
+    for( auto & reader : _metadata_readers )
+        if( ! _binary_metadata_participants.count( reader.guidPrefix ) )
+            binary = false;
+    if( binary != _binary_metadata )
+        LOG_DEBUG( "[" << debug_name() << "] sending metadata " << ( binary ? "in binary" : "as JSON" ) );
+    _binary_metadata = binary;
+}
+
+
 struct dds_device_server::control_sample
 {
     rsutils::json const json;
@@ -302,6 +353,7 @@ void dds_device_server::on_control_message_received()
         { topics::control::set_option::id, &dds_device_server::on_set_option },
         { topics::control::query_option::id, &dds_device_server::on_query_option },
         { topics::control::query_options::id, &dds_device_server::on_query_options },
+        { topics::control::metadata_format::id, &dds_device_server::on_metadata_format },
         // These are the ones handle internally -- our owner may handle application-dependent controls
     };
 
@@ -405,6 +457,21 @@ void dds_device_server::on_query_option( control_sample const & control, rsutils
 }
 
 
+void dds_device_server::on_metadata_format( control_sample const & control, json & reply )
+{
+    // Readers are matched to the client by participant: its control writer and metadata reader share a prefix
+    bool const binary = control.json.at( topics::control::metadata_format::key::binary ).get< bool >();  // throws
+    auto const & participant = control.sample.sample_identity.writer_guid().guidPrefix;
+
+    std::lock_guard< std::mutex > lock( _binary_metadata_mutex );
+    if( binary )
+        _binary_metadata_participants.insert( participant );
+    else
+        _binary_metadata_participants.erase( participant );
+    update_binary_metadata();
+}
+
+
 void dds_device_server::on_query_options( control_sample const & control, json & reply )
 {
     // We return a stream->option->value mapping in the reply "option-values"
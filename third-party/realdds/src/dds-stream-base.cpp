@@ -16,13 +16,14 @@ dds_stream_base::dds_stream_base( std::string const & name,
 }
 
 
-void dds_stream_base::enable_metadata()
+void dds_stream_base::enable_metadata( std::vector< std::string > && keys )
 {
     // Ensure no changes after initialization stage
     if( !_profiles.empty() )
         DDS_THROW( runtime_error, "enable metadata to stream '" + _name + "' before initializing profiles" );
 
     _metadata_enabled = true;
+    _metadata_keys = std::move( keys );
 }
 
 
@@ -9,6 +9,7 @@
 #include <realdds/dds-publisher.h>
 #include <realdds/dds-utilities.h>
 #include <realdds/topics/image-msg.h>
+#include <realdds/topics/plain-image-msg.h>
 #include <realdds/topics/imu-msg.h>
 #include <realdds/topics/flexible-msg.h>
 #include <realdds/topics/ros2/ros2imagePubSubTypes.h>
@@ -18,6 +19,8 @@
 #include <fastdds/dds/topic/Topic.hpp>
 #include <fastdds/dds/publisher/DataWriter.hpp>
 
+#include <rsutils/json.h>
+
 
 namespace realdds {
 
@@ -92,14 +95,39 @@ void dds_video_stream_server::open( std::string const & topic_name, std::shared_
     if( profiles().empty() )
         DDS_THROW( runtime_error, "stream '" + name() + "' has no profiles" );
 
-    auto topic = topics::image_msg::create_topic( publisher->get_participant(), topic_name.c_str() );
+    // Images go out as ROS2 Images unless the device settings ask for plain ones, for zero-copy on the same host
+    auto const & participant = publisher->get_participant();
+    _plain_images = participant->settings()
+                        .nested( "device", "video", "plain-images", &rsutils::json::is_boolean )
+                        .default_value( false );
+    auto topic = _plain_images
+                   ? topics::plain_image_msg::create_topic( participant,
+                                                            topic_name.c_str(),
+                                                            topics::plain_image_msg::max_image_size( profiles() ) )
+                   : topics::image_msg::create_topic( participant, topic_name.c_str() );
     _writer = std::make_shared< dds_topic_writer >( topic, publisher );
 
 
     run_stream();
 }
 
-void dds_stream_server::run_stream()
+void dds_video_stream_server::run_stream()
+{
+    if( ! _plain_images )
+        return super::run_stream();
+
+    watch_readers();
+
+    dds_topic_writer::qos wqos( eprosima::fastdds::dds::BEST_EFFORT_RELIABILITY_QOS );  // no retries
+    // Samples are loaned from a pool allocated at their fixed size, and shared with readers on the same host rather
+    // than sent; as frames keep coming, losing the first to the handshake race (see dds_topic_writer::qos) is fine
+    wqos.endpoint().history_memory_policy = eprosima::fastrtps::rtps::PREALLOCATED_MEMORY_MODE;
+    wqos.data_sharing().automatic();
+    wqos.override_from_json( _writer->topic()->get_participant()->settings().nested( "device", "video" ) );
+    _writer->run( wqos );
+}
+
+void dds_stream_server::watch_readers()
 {
     if( ! _writer )
         DDS_THROW( runtime_error, "open() wasn't called before run_stream()" );
@@ -124,7 +152,11 @@ void dds_stream_server::run_stream()
                     }
             } );
     }
-    
+}
+
+void dds_stream_server::run_stream()
+{
+    watch_readers();
     _writer->run( dds_topic_writer::qos( eprosima::fastdds::dds::BEST_EFFORT_RELIABILITY_QOS ) );  // no retries
 }
 
@@ -211,6 +243,14 @@ void dds_video_stream_server::publish_image( topics::image_msg && image )
                    "image width (" + std::to_string( image.width ) + ") does not match stream header ("
                        + std::to_string( _image_header.width ) + ")" );
 
+    if( _plain_images )
+    {
+        LOG_DEBUG( "publishing '" << name() << "' " << _image_header.encoding.to_string() << " plain frame @ "
+                                  << time_to_string( image.timestamp ) );
+        topics::plain_image_msg::write_to( *_writer, image, _image_header.encoding );
+        return;
+    }
+
     // LOG_DEBUG( "publishing a DDS video frame for topic: " << _writer->topic()->get()->get_name() );
     sensor_msgs::msg::Image raw_image;
     
@@ -6,7 +6,9 @@
 #include <realdds/dds-topic.h>
 #include <realdds/dds-topic-reader-thread.h>
 #include <realdds/dds-subscriber.h>
+#include <realdds/dds-participant.h>
 #include <realdds/topics/image-msg.h>
+#include <realdds/topics/plain-image-msg.h>
 #include <realdds/topics/imu-msg.h>
 #include <realdds/topics/flexible-msg.h>
 #include <realdds/dds-exceptions.h>
@@ -32,14 +34,30 @@ void dds_video_stream::open( std::string const & topic_name, std::shared_ptr< dd
     if( profiles().empty() )
         DDS_THROW( runtime_error, "stream '" + name() + "' has no profiles" );
 
+    // The server must have the same setting: plain images are a different topic type
+    auto const & participant = subscriber->get_participant();
+    auto video_settings = participant->settings().nested( "device", "video" );
+    _plain_images = video_settings.nested( "plain-images", &rsutils::json::is_boolean ).default_value( false );
+
     // Topics with same name and type can be created multiple times (multiple open() calls) without an error.
-    auto topic = topics::image_msg::create_topic( subscriber->get_participant(), topic_name.c_str() );
+    auto topic = _plain_images
+                   ? topics::plain_image_msg::create_topic( participant,
+                                                            topic_name.c_str(),
+                                                            topics::plain_image_msg::max_image_size( profiles() ) )
+                   : topics::image_msg::create_topic( participant, topic_name.c_str() );
 
     // To support automatic streaming (without the need to handle start/stop-streaming commands) the reader is created
     // here and destroyed on close()
     _reader = std::make_shared< dds_topic_reader_thread >( topic, subscriber );
     _reader->on_data_available( [this]() { handle_data(); } );
-    _reader->run( dds_topic_reader::qos( eprosima::fastdds::dds::BEST_EFFORT_RELIABILITY_QOS ) );  // no retries
+    dds_topic_reader::qos rqos( eprosima::fastdds::dds::BEST_EFFORT_RELIABILITY_QOS );  // no retries
+    if( _plain_images )
+    {
+        // Samples from writers on the same host are then read from shared memory
+        rqos.data_sharing().automatic();
+        rqos.override_from_json( video_settings );
+    }
+    _reader->run( rqos );
 }
 
 
@@ -84,7 +102,8 @@ void dds_video_stream::handle_data()
 {
     topics::image_msg frame;
     eprosima::fastdds::dds::SampleInfo info;
-    while( _reader && topics::image_msg::take_next( *_reader, &frame, &info ) )
+    auto take_next = _plain_images ? &topics::plain_image_msg::take_next : &topics::image_msg::take_next;
+    while( _reader && take_next( *_reader, &frame, &info ) )
     {
         if( ! frame.is_valid() )
             continue;
@@ -34,6 +34,7 @@ namespace notification {
             std::string const profiles( "profiles", 8 );
             std::string const default_profile_index( "default-profile-index", 21 );
             std::string const metadata_enabled( "metadata-enabled", 16 );
+            std::string const metadata_keys( "metadata-keys", 13 );
         }
     }
     namespace stream_options {
@@ -116,6 +117,12 @@ namespace control {
     namespace hw_reset {
         std::string const id( "hw-reset", 8 );
     }
+    namespace metadata_format {
+        std::string const id( "metadata-format", 15 );
+        namespace key {
+            std::string const binary( "binary", 6 );
+        }
+    }
 }
 
 namespace reply {
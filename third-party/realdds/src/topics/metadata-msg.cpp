@@ -0,0 +1,154 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include <realdds/topics/metadata-msg.h>
+#include <realdds/topics/flexible-msg.h>
+#include <realdds/topics/dds-topic-names.h>
+#include <realdds/dds-utilities.h>
+
+#include <rsutils/json.h>
+
+#include <cstring>
+#include <limits>
+
+
+namespace realdds {
+namespace topics {
+
+
+static size_t constexpr item_size = sizeof( metadata_msg::item::key ) + sizeof( metadata_msg::item::value );
+
+
+metadata_msg::metadata_msg( flexible_msg const & msg )
+{
+    if( ! is_binary( msg ) )
+        DDS_THROW( runtime_error, "not binary metadata (version " << msg._version << ")" );
+
+    auto const & data = msg._data;
+    if( data.size() < sizeof( header ) )
+        DDS_THROW( runtime_error, "binary metadata is too small (" << data.size() << " bytes)" );
+    header h;
+    std::memcpy( &h, data.data(), sizeof( header ) );
+    if( data.size() != sizeof( header ) + h.stream_name_length + h.n_items * item_size )
+        DDS_THROW( runtime_error,
+                   "binary metadata size (" << data.size() << ") does not match its header (" << h.n_items
+                                            << " items)" );
+
+    timestamp = h.timestamp;
+    flags = h.flags;
+    frame_number = h.frame_number;
+    timestamp_domain = h.timestamp_domain;
+    depth_units = h.depth_units;
+
+    auto p = data.data() + sizeof( header );
+    stream_name.assign( reinterpret_cast< char const * >( p ), h.stream_name_length );
+    p += h.stream_name_length;
+
+    items.resize( h.n_items );
+    for( auto & i : items )
+    {
+        std::memcpy( &i.key, p, sizeof( i.key ) );
+        std::memcpy( &i.value, p + sizeof( i.key ), sizeof( i.value ) );
+        p += item_size;
+    }
+}
+
+
+/*static*/ bool metadata_msg::is_binary( flexible_msg const & msg )
+{
+    return msg._data_format == flexible_msg::data_format::CUSTOM && msg._version == version;
+}
+
+
+flexible_msg metadata_msg::to_flexible() const
+{
+    if( stream_name.length() > std::numeric_limits< uint8_t >::max() )
+        DDS_THROW( runtime_error, "stream name '" << stream_name << "' is too long for binary metadata" );
+    if( items.size() > std::numeric_limits< uint16_t >::max() )
+        DDS_THROW( runtime_error, "too many binary metadata items (" << items.size() << ")" );
+
+    flexible_msg msg;
+    msg._data_format = flexible_msg::data_format::CUSTOM;
+    msg._version = version;
+    msg._data.resize( sizeof( header ) + stream_name.length() + items.size() * item_size );
+
+    header h;
+    h.timestamp = timestamp;
+    h.frame_number = frame_number;
+    h.depth_units = depth_units;
+    h.timestamp_domain = timestamp_domain;
+    h.n_items = uint16_t( items.size() );
+    h.flags = flags;
+    h.stream_name_length = uint8_t( stream_name.length() );
+    h.reserved = 0;
+
+    auto p = msg._data.data();
+    std::memcpy( p, &h, sizeof( header ) );
+    p += sizeof( header );
+    std::memcpy( p, stream_name.data(), stream_name.length() );
+    p += stream_name.length();
+    for( auto const & i : items )
+    {
+        std::memcpy( p, &i.key, sizeof( i.key ) );
+        std::memcpy( p + sizeof( i.key ), &i.value, sizeof( i.value ) );
+        p += item_size;
+    }
+    return msg;
+}
+
+
+dds_sequence_number metadata_msg::write_to( dds_topic_writer & writer ) const
+{
+    return to_flexible().write_to( writer );
+}
+
+
+/*static*/ metadata_msg metadata_msg::from_json( rsutils::json const & j, std::vector< std::string > const & keys )
+{
+    metadata_msg md;
+    md.stream_name = j.at( metadata::key::stream_name ).string_ref();
+
+    auto md_header = j.nested( metadata::key::header );
+    md.timestamp = md_header.nested( metadata::header::key::timestamp ).get< dds_nsec >();
+    if( md_header.nested( metadata::header::key::frame_number ).get_ex( md.frame_number ) )
+        md.flags |= has_frame_number;
+    if( md_header.nested( metadata::header::key::timestamp_domain ).get_ex( md.timestamp_domain ) )
+        md.flags |= has_timestamp_domain;
+    if( md_header.nested( metadata::header::key::depth_units ).get_ex( md.depth_units ) )
+        md.flags |= has_depth_units;
+
+    if( auto values = j.nested( metadata::key::metadata, &rsutils::json::is_object ) )
+    {
+        for( uint32_t key = 0; key < keys.size(); ++key )
+            if( auto value = values.nested( keys[key], &rsutils::json::is_number_integer ) )
+                md.items.push_back( { key, value.get< int64_t >() } );
+    }
+    return md;
+}
+
+
+rsutils::json metadata_msg::to_json( std::vector< std::string > const & keys ) const
+{
+    rsutils::json md_header = rsutils::json::object( { { metadata::header::key::timestamp, timestamp } } );
+    if( flags & has_frame_number )
+        md_header[metadata::header::key::frame_number] = frame_number;
+    if( flags & has_timestamp_domain )
+        md_header[metadata::header::key::timestamp_domain] = timestamp_domain;
+    if( flags & has_depth_units )
+        md_header[metadata::header::key::depth_units] = depth_units;
+
+    rsutils::json values = rsutils::json::object();
+    for( auto const & i : items )
+        if( i.key < keys.size() )
+            values[keys[i.key]] = i.value;
+
+    return rsutils::json::object( {
+        { metadata::key::stream_name, stream_name },
+        { metadata::key::header, std::move( md_header ) },
+        { metadata::key::metadata, std::move( values ) },
+    } );
+}
+
+
+}  // namespace topics
+}  // namespace realdds
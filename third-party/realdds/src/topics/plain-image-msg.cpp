@@ -0,0 +1,209 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include <realdds/topics/plain-image-msg.h>
+#include <realdds/topics/image-msg.h>
+
+#include <realdds/dds-topic.h>
+#include <realdds/dds-topic-reader.h>
+#include <realdds/dds-topic-writer.h>
+#include <realdds/dds-utilities.h>
+
+#include <fastdds/dds/topic/TopicDataType.hpp>
+#include <fastdds/dds/core/LoanableSequence.hpp>
+#include <fastdds/dds/subscriber/DataReader.hpp>
+#include <fastdds/dds/subscriber/SampleInfo.hpp>
+#include <fastdds/dds/publisher/DataWriter.hpp>
+#include <fastdds/dds/topic/Topic.hpp>
+
+#include <cstring>
+#include <algorithm>
+#include <map>
+
+
+namespace realdds {
+namespace topics {
+
+
+// The sample is laid out in memory as it is serialized (after the encapsulation), so FastDDS can share it as is.
+// Like the rest of our data, it is little-endian.
+//
+class plain_image_msg::type : public eprosima::fastdds::dds::TopicDataType
+{
+    using SerializedPayload_t = eprosima::fastrtps::rtps::SerializedPayload_t;
+
+    size_t const _max_image_size;
+
+    static uint32_t serialized_size( header const & h )
+    {
+        return uint32_t( SerializedPayload_t::representation_header_size + sizeof( header ) + h.size );
+    }
+
+public:
+    explicit type( size_t max_image_size )
+        : _max_image_size( max_image_size )
+    {
+        setName( ( "realdds::plain_image_" + std::to_string( max_image_size ) ).c_str() );
+        m_typeSize = uint32_t( SerializedPayload_t::representation_header_size + sizeof( header ) + max_image_size );
+        m_isGetKeyDefined = false;
+    }
+
+    bool serialize( void * data, SerializedPayload_t * payload ) override
+    {
+        // Loaned samples are sent as they are, whole; only a sample that is not loaned gets here, and then only the
+        // image in it is sent
+        auto & h = *static_cast< header const * >( data );
+        if( h.size > _max_image_size )
+            return false;
+        auto const length = serialized_size( h );
+        if( payload->max_size < length )
+            return false;
+        payload->data[0] = 0;
+        payload->data[1] = CDR_LE;
+        payload->data[2] = payload->data[3] = 0;
+        payload->encapsulation = CDR_LE;
+        std::memcpy( payload->data + SerializedPayload_t::representation_header_size, data, sizeof( header ) + h.size );
+        payload->length = length;
+        return true;
+    }
+
+    bool deserialize( SerializedPayload_t * payload, void * data ) override
+    {
+        auto const in = payload->data + SerializedPayload_t::representation_header_size;
+        if( payload->length < SerializedPayload_t::representation_header_size + sizeof( header ) )
+            return false;
+        auto & h = *static_cast< header * >( data );
+        std::memcpy( &h, in, sizeof( header ) );
+        if( h.size > _max_image_size || payload->length < serialized_size( h ) )
+            return false;
+        std::memcpy( &h + 1, in + sizeof( header ), h.size );
+        return true;
+    }
+
+    std::function< uint32_t() > getSerializedSizeProvider( void * data ) override
+    {
+        return [data]() { return serialized_size( *static_cast< header const * >( data ) ); };
+    }
+
+    bool getKey( void *, eprosima::fastrtps::rtps::InstanceHandle_t *, bool ) override { return false; }
+
+    void * createData() override { return new uint8_t[sizeof( header ) + _max_image_size]; }
+    void deleteData( void * data ) override { delete[] static_cast< uint8_t * >( data ); }
+
+#ifdef TOPIC_DATA_TYPE_API_HAS_IS_BOUNDED
+    inline bool is_bounded() const override { return true; }
+#endif
+
+#ifdef TOPIC_DATA_TYPE_API_HAS_IS_PLAIN
+    inline bool is_plain() const override { return true; }
+#endif
+};
+
+
+// The most an image of the encoding can take per pixel
+static size_t bits_per_pixel( dds_video_encoding const & encoding )
+{
+    static std::map< std::string, size_t > const bits{
+        { "mono8", 8 },        { "CNF4", 8 },  { "W10", 10 }, { "R10", 10 },  { "Y10B", 10 },
+        { "yuv422_yuy2", 16 }, { "uyvy", 16 }, { "Y8I", 16 }, { "Y16", 16 },  { "16UC1", 16 },
+        { "BYR2", 16 },        { "Y12I", 24 }, { "rgb8", 24 }, { "RGB2", 24 }, { "RGBA", 32 },
+        { "BGRA", 32 },
+        // Compressed from 16 bits per pixel, and no larger in practice
+        { "Z16H", 16 },        { "MJPG", 16 },
+    };
+    auto it = bits.find( encoding.to_string() );
+    return it == bits.end() ? 32 : it->second;
+}
+
+
+/*static*/ size_t plain_image_msg::max_image_size( dds_stream_profiles const & profiles )
+{
+    size_t max_size = 0;
+    for( auto & profile : profiles )
+        if( auto video = std::dynamic_pointer_cast< dds_video_stream_profile >( profile ) )
+            max_size = std::max( max_size,
+                                 ( size_t( video->width() ) * video->height() * bits_per_pixel( video->encoding() ) + 7 )
+                                     / 8 );
+    return max_size;
+}
+
+
+/*static*/ std::shared_ptr< dds_topic > plain_image_msg::create_topic(
+    std::shared_ptr< dds_participant > const & participant, char const * topic_name, size_t max_image_size )
+{
+    return std::make_shared< dds_topic >( participant,
+                                          eprosima::fastdds::dds::TypeSupport( new plain_image_msg::type( max_image_size ) ),
+                                          topic_name );
+}
+
+
+/*static*/ void
+plain_image_msg::write_to( dds_topic_writer & writer, image_msg const & image, dds_video_encoding const & encoding )
+{
+    auto const room = writer->get_type()->m_typeSize
+                    - eprosima::fastrtps::rtps::SerializedPayload_t::representation_header_size - sizeof( header );
+    if( image.raw_data.size() > room )
+        DDS_THROW( runtime_error,
+                   "image size (" << image.raw_data.size() << ") is larger than the plain samples (" << room << ")" );
+
+    void * sample = nullptr;
+    DDS_API_CALL( writer->loan_sample( sample ) );
+
+    auto & h = *static_cast< header * >( sample );
+    h.sec = image.timestamp.seconds;
+    h.nanosec = image.timestamp.nanosec;
+    h.width = uint32_t( image.width );
+    h.height = uint32_t( image.height );
+    h.size = uint32_t( image.raw_data.size() );
+    h.encoding = encoding;
+    std::memcpy( &h + 1, image.raw_data.data(), image.raw_data.size() );
+
+    if( ! writer->write( sample ) )
+    {
+        // The sample is still ours, and the writer must get it back
+        DDS_API_CALL_NO_THROW( writer->discard_loan( sample ) );
+        DDS_THROW( runtime_error, "failed to write plain image sample" );
+    }
+}
+
+
+/*static*/ bool
+plain_image_msg::take_next( dds_topic_reader & reader, image_msg * output, eprosima::fastdds::dds::SampleInfo * info )
+{
+    // An empty sequence, so the samples are loaned rather than copied into it
+    eprosima::fastdds::dds::LoanableSequence< header > samples;
+    eprosima::fastdds::dds::SampleInfoSeq infos;
+    auto status = reader->take( samples, infos, 1 );
+    if( status == ReturnCode_t::RETCODE_NO_DATA )
+    {
+        // This is an expected return code and is not an error
+        return false;
+    }
+    if( status != ReturnCode_t::RETCODE_OK )
+        DDS_API_CALL_THROW( "plain_image_msg::take_next", status );
+
+    if( info )
+        *info = infos[0];
+    if( output )
+    {
+        // Only samples for which valid_data is true should be accessed
+        if( ! infos[0].valid_data )
+            output->invalidate();
+        else
+        {
+            auto const & h = samples[0];
+            auto const data = reinterpret_cast< uint8_t const * >( &h + 1 );
+            output->raw_data.assign( data, data + h.size );
+            output->width = int( h.width );
+            output->height = int( h.height );
+            output->timestamp = dds_time( h.sec, h.nanosec );
+        }
+    }
+
+    reader->return_loan( samples, infos );
+    return true;
+}
+
+
+}  // namespace topics
+}  // namespace realdds
@@ -39,6 +39,8 @@
 #include "macros.h"
 
 #include "buffer.h"
+#include "chunk_compressor.h"
+#include "chunk_prefetcher.h"
 #include "chunked_file.h"
 #include "constants.h"
 #include "exceptions.h"
@@ -52,6 +54,7 @@
 
 #include <ios>
 #include <map>
+#include <memory>
 #include <queue>
 #include <set>
 #include <stdexcept>
@@ -119,6 +122,37 @@ public:
     void            setChunkThreshold(uint32_t chunk_threshold);  //!< Set the threshold for creating new chunks
     uint32_t        getChunkThreshold() const;                    //!< Get the threshold for creating new chunks
 
+    //! Compress chunks with LZ4 on background threads, and write them to the file from another
+    /*!
+     * \param threads Number of compression threads (at least one)
+     * \param level   0 for LZ4, otherwise the LZ4-HC level (see lz4hc.h)
+     *
+     * Closed chunks are queued instead of written inline, so write() only serializes into memory.
+     * The file is the same as with setCompression(LZ4); it is complete once the bag is closed.
+     * Reading back from a bag while it is being written this way is not supported.
+     * Once a chunk fails to compress or write, the write() that closes the next chunk and close()
+     * throw, and the file is left without an index.
+     */
+    void            setParallelCompression(uint32_t threads, int level = 0);
+
+    //! Read and decompress the chunks that follow the one being read on a background thread
+    /*!
+     * \param chunk_count Number of chunks to keep decompressed ahead of the reader; 0 to stop prefetching
+     *
+     * Only for bags open for reading.
+     */
+    void            setPrefetch(uint32_t chunk_count);
+
+    //! Find the time of the last message on a topic at or before the given time
+    /*!
+     * \param topic The topic name
+     * \param time  The latest time to consider
+     * \param last  Receives the time of that message
+     *
+     * A binary search of the topic's index. Returns false if the topic has no message until then.
+     */
+    bool            findLastMessageTime(std::string const& topic, rs2rosinternal::Time const& time, rs2rosinternal::Time& last) const;
+
     //! Write a message into the bag file
     /*!
      * \param topic The topic name
@@ -196,12 +230,13 @@ private:
     void appendConnectionRecordToBuffer(Buffer& buf, ConnectionInfo const* connection_info);
     template<class T>
     void writeMessageDataRecord(uint32_t conn_id, rs2rosinternal::Time const& time, T const& msg);
-    void writeIndexRecords();
+    void writeIndexRecords(std::map<uint32_t, std::multiset<IndexEntry> > const& connection_indexes);
     void writeConnectionRecords();
     void writeChunkInfoRecords();
     void startWritingChunk(rs2rosinternal::Time time);
     void writeChunkHeader(CompressionType compression, uint32_t compressed_size, uint32_t uncompressed_size);
     void stopWritingChunk();
+    void writeCompressedChunk(OutgoingChunk& chunk);
 
     // Reading
 
@@ -223,6 +258,7 @@ private:
     void readMessageDataIntoStream(IndexEntry const& index_entry, Stream& stream) const;
 
     void     decompressChunk(uint64_t chunk_pos) const;
+    void     prefetchChunksAfter(uint64_t chunk_pos) const;
     void     decompressRawChunk(ChunkHeader const& chunk_header) const;
     void     decompressBz2Chunk(ChunkHeader const& chunk_header) const;
     void     decompressLz4Chunk(ChunkHeader const& chunk_header) const;
@@ -305,6 +341,11 @@ private:
     mutable Buffer*  current_buffer_;
 
     mutable uint64_t decompressed_chunk_;      //!< position of decompressed chunk
+
+    std::unique_ptr<ChunkCompressor>             chunk_compressor_;   //!< set when chunks are compressed and written in the background
+    std::vector<std::pair<uint32_t, uint64_t> > written_chunks_;     //!< (index in chunks_, file position) of each chunk it wrote
+
+    std::unique_ptr<ChunkPrefetcher>             chunk_prefetcher_;   //!< set when chunks are decompressed ahead of the reader
 };
 
 } // namespace rosbag
@@ -470,6 +511,11 @@ void Bag::doWrite(std::string const& topic, rs2rosinternal::Time const& time, T
         throw BagException("Tried to insert a message with time less than rs2rosinternal::TIME_MIN");
     }
 
+    // Once a chunk could not be written in the background, the bag takes no more messages: they
+    // would only pile up in the open chunk and the indexes
+    if (chunk_compressor_)
+        chunk_compressor_->check();
+
     // Whenever we write we increment our revision
     bag_revision_++;
 
@@ -511,9 +557,12 @@ void Bag::doWrite(std::string const& topic, rs2rosinternal::Time const& time, T
     }
 
     {
-        // Seek to the end of the file (needed in case previous operation was a read)
-        seek(0, std::ios::end);
-        file_size_ = file_.getOffset();
+        // Seek to the end of the file (needed in case previous operation was a read); the file
+        // belongs to the compressor's writer thread when there is one
+        if (!chunk_compressor_) {
+            seek(0, std::ios::end);
+            file_size_ = file_.getOffset();
+        }
 
         // Write the chunk header if we're starting a new chunk
         if (!chunk_open_)
@@ -538,7 +587,8 @@ void Bag::doWrite(std::string const& topic, rs2rosinternal::Time const& time, T
             }
             connections_[conn_id] = connection_info;
 
-            writeConnectionRecord(connection_info);
+            if (!chunk_compressor_)
+                writeConnectionRecord(connection_info);
             appendConnectionRecordToBuffer(outgoing_chunk_buffer_, connection_info);
         }
 
@@ -580,36 +630,33 @@ void Bag::writeMessageDataRecord(uint32_t conn_id, rs2rosinternal::Time const& t
     header[CONNECTION_FIELD_NAME] = toHeaderString(&conn_id);
     header[TIME_FIELD_NAME]       = toHeaderString(&time);
 
-    // Assemble message in memory first, because we need to write its length
     uint32_t msg_ser_len = rs2rosinternal::serialization::serializationLength(msg);
 
-    record_buffer_.setSize(msg_ser_len);
-
-    rs2rosinternal::serialization::OStream s(record_buffer_.getData(), msg_ser_len);
-
-    // todo: serialize into the outgoing_chunk_buffer & remove record_buffer_
-    rs2rosinternal::serialization::serialize(s, msg);
-
-    // We do an extra seek here since writing our data record may
-    // have indirectly moved our file-pointer if it was a
-    // MessageInstance for our own bag
-    seek(0, std::ios::end);
-    file_size_ = file_.getOffset();
-
-    CONSOLE_BRIDGE_logDebug("Writing MSG_DATA [%llu:%d]: conn=%d sec=%d nsec=%d data_len=%d",
-              (unsigned long long) file_.getOffset(), getChunkOffset(), conn_id, time.sec, time.nsec, msg_ser_len);
-
-    writeHeader(header);
-    writeDataLength(msg_ser_len);
-    write((char*) record_buffer_.getData(), msg_ser_len);
-
     // todo: use better abstraction than appendHeaderToBuffer
     appendHeaderToBuffer(outgoing_chunk_buffer_, header);
     appendDataLengthToBuffer(outgoing_chunk_buffer_, msg_ser_len);
 
+    // Serialize the message straight into the outgoing chunk, and write it to the file from there
     uint32_t offset = outgoing_chunk_buffer_.getSize();
-    outgoing_chunk_buffer_.setSize(outgoing_chunk_buffer_.getSize() + msg_ser_len);
-    memcpy(outgoing_chunk_buffer_.getData() + offset, record_buffer_.getData(), msg_ser_len);
+    outgoing_chunk_buffer_.setSize(offset + msg_ser_len);
+    rs2rosinternal::serialization::OStream s(outgoing_chunk_buffer_.getData() + offset, msg_ser_len);
+    rs2rosinternal::serialization::serialize(s, msg);
+
+    // The outgoing chunk is all the compressor needs
+    if (!chunk_compressor_) {
+        // We do an extra seek here since writing our data record may
+        // have indirectly moved our file-pointer if it was a
+        // MessageInstance for our own bag
+        seek(0, std::ios::end);
+        file_size_ = file_.getOffset();
+
+        CONSOLE_BRIDGE_logDebug("Writing MSG_DATA [%llu:%d]: conn=%d sec=%d nsec=%d data_len=%d",
+                  (unsigned long long) file_.getOffset(), getChunkOffset(), conn_id, time.sec, time.nsec, msg_ser_len);
+
+        writeHeader(header);
+        writeDataLength(msg_ser_len);
+        write((char*) outgoing_chunk_buffer_.getData() + offset, msg_ser_len);
+    }
 
     // Update the current chunk time range
     if (time > curr_chunk_info_.end_time)
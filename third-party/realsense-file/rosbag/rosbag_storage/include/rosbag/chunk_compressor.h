@@ -0,0 +1,94 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#ifndef ROSBAG_CHUNK_COMPRESSOR_H
+#define ROSBAG_CHUNK_COMPRESSOR_H
+
+#include <stdint.h>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "macros.h"
+#include "buffer.h"
+#include "structures.h"
+
+namespace rosbag {
+
+//! A closed chunk on its way to the file: its uncompressed records, and the index entries that follow it
+struct ROSBAG_DECL OutgoingChunk
+{
+    uint32_t index;                 //!< position of the chunk in Bag::chunks_
+    Buffer   uncompressed;          //!< the chunk's records, as they would be written uncompressed
+    Buffer   compressed;            //!< LZ4 frame of the above, filled in by the compressor threads
+
+    std::map<uint32_t, std::multiset<IndexEntry> > connection_indexes;
+};
+
+//! ChunkCompressor LZ4-compresses closed chunks on a pool of threads, and hands them in order to a single writer thread.
+/*!
+ * The bag keeps filling its next chunk while earlier ones are being compressed and written, so a
+ * recording thread never waits on LZ4 or on the disk. The number of chunks in flight is bounded:
+ * acquire() blocks while 2 * threads + 1 are queued, so with the chunk the bag is filling, the
+ * memory used is capped at 2 * threads + 2 chunks.
+ *
+ * The write callback runs on the writer thread, one chunk at a time and in the order the chunks
+ * were pushed. The first exception it (or compression) throws is rethrown from every acquire(),
+ * flush() and check() that follows; chunks after a failure are not written.
+ */
+class ROSBAG_DECL ChunkCompressor
+{
+public:
+    typedef std::function<void(OutgoingChunk&)> WriteCallback;
+
+    //! \param threads Number of compression threads (at least one)
+    //! \param level   0 for LZ4, otherwise the LZ4-HC level
+    ChunkCompressor(uint32_t threads, int level, WriteCallback write);
+    ~ChunkCompressor();
+
+    std::unique_ptr<OutgoingChunk> acquire();          //!< an empty chunk to fill; blocks while too many are in flight
+    void push(std::unique_ptr<OutgoingChunk> chunk);   //!< queue a filled chunk for compression and writing
+    void flush();                                       //!< wait until every pushed chunk is written
+    void check();                                       //!< rethrow the first failure, if any, without waiting
+
+private:
+    void compressLoop();
+    void writeLoop();
+    void compress(OutgoingChunk& chunk) const;
+    void rethrow();
+
+private:
+    int           level_;
+    WriteCallback write_;
+    size_t        max_in_flight_;
+
+    std::mutex              mutex_;
+    std::condition_variable compress_cv_;   //!< signals compressor threads: work pushed, or stopping
+    std::condition_variable write_cv_;      //!< signals the writer thread: a chunk was compressed, or stopping
+    std::condition_variable done_cv_;       //!< signals producers: a chunk was written
+
+    std::deque<std::pair<uint64_t, std::unique_ptr<OutgoingChunk> > > to_compress_;
+    std::map<uint64_t, std::unique_ptr<OutgoingChunk> >               to_write_;
+    std::vector<std::unique_ptr<OutgoingChunk> >                      free_;
+
+    uint64_t           next_push_;
+    uint64_t           next_write_;
+    size_t             in_flight_;
+    bool               stopping_;
+    bool               failed_;     //!< once set, remaining chunks are dropped instead of written
+    std::exception_ptr error_;      //!< first failure, set along with failed_
+
+    std::vector<std::thread> compressors_;
+    std::thread              writer_;
+};
+
+} // namespace rosbag
+
+#endif
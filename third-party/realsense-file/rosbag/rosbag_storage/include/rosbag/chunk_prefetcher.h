@@ -0,0 +1,71 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#ifndef ROSBAG_CHUNK_PREFETCHER_H
+#define ROSBAG_CHUNK_PREFETCHER_H
+
+#include <stdint.h>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "macros.h"
+#include "buffer.h"
+#include "chunked_file.h"
+
+namespace rosbag {
+
+//! ChunkPrefetcher reads and decompresses chunks of a bag on a background thread, ahead of the reader.
+/*!
+ * It opens the file a second time, so it never moves the bag's own file position. The bag asks for
+ * the chunks that follow the one it is reading, and takes each decompressed chunk when it gets
+ * there, waiting if it is still being decompressed. Chunks that fail to read are simply left for
+ * the bag to read itself.
+ */
+class ROSBAG_DECL ChunkPrefetcher
+{
+public:
+    //! \param depth Most decompressed chunks held at once
+    ChunkPrefetcher(std::string const& filename, uint32_t depth);
+    ~ChunkPrefetcher();
+
+    //! Decompress these chunks next, in order, forgetting any other chunk not yet started or taken
+    void prefetch(std::vector<uint64_t> const& chunk_positions);
+
+    //! Swap the decompressed chunk at chunk_pos into buffer; false if it is not prefetched
+    bool take(uint64_t chunk_pos, Buffer& buffer);
+
+    uint32_t getDepth() const;
+
+private:
+    void run();
+    void readChunk(uint64_t chunk_pos, Buffer& decompressed);
+
+private:
+    ChunkedFile file_;
+    uint32_t    depth_;
+    Buffer      header_buffer_;
+    Buffer      chunk_buffer_;
+
+    std::mutex              mutex_;
+    std::condition_variable work_cv_;    //!< signals the thread: chunks requested, or stopping
+    std::condition_variable ready_cv_;   //!< signals take(): a chunk is ready
+
+    std::deque<uint64_t>                           pending_;
+    uint64_t                                       in_progress_;
+    bool                                           busy_;
+    std::map<uint64_t, std::unique_ptr<Buffer> >   ready_;
+    std::vector<std::unique_ptr<Buffer> >          free_;
+    bool                                           stopping_;
+
+    std::thread thread_;
+};
+
+} // namespace rosbag
+
+#endif
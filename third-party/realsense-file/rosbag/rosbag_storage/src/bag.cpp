@@ -37,6 +37,8 @@
 #endif
 #include <signal.h>
 #include <assert.h>
+#include <algorithm>
+#include <exception>
 #include <iomanip>
 #include <map>
 #include <tuple>
@@ -91,7 +93,13 @@ Bag::Bag(string const& filename, uint32_t mode) :
 }
 
 Bag::~Bag() {
-    close();
+    // A destructor can't report a failed close: call close() first to see the error
+    try {
+        close();
+    }
+    catch (std::exception const& e) {
+        CONSOLE_BRIDGE_logError("Error closing the bag: %s", e.what());
+    }
 }
 
 void Bag::open(string const& filename, uint32_t mode) {
@@ -160,10 +168,27 @@ void Bag::close() {
     if (!file_.isOpen())
         return;
 
-    if (mode_ & bagmode::Write || mode_ & bagmode::Append)
-        closeWrite();
+    // Whether or not the bag could be finished, the file is closed and the bag reset
+    std::exception_ptr error;
+    if (mode_ & bagmode::Write || mode_ & bagmode::Append) {
+        try {
+            closeWrite();
+        }
+        catch (...) {
+            error = std::current_exception();
+        }
+    }
 
-    file_.close();
+    // Stop the compressor's threads before the file goes away
+    chunk_compressor_.reset();
+
+    try {
+        file_.close();
+    }
+    catch (...) {
+        if (!error)
+            error = std::current_exception();
+    }
 
     topic_connection_ids_.clear();
     header_connection_ids_.clear();
@@ -173,6 +198,12 @@ void Bag::close() {
     chunks_.clear();
     connection_indexes_.clear();
     curr_chunk_connection_indexes_.clear();
+    chunk_open_ = false;
+    written_chunks_.clear();
+    chunk_prefetcher_.reset();
+
+    if (error)
+        std::rethrow_exception(error);
 }
 
 void Bag::closeWrite() {
@@ -235,6 +266,9 @@ std::tuple<std::string, uint64_t, uint64_t> Bag::getCompressionInfo() const
     return std::make_tuple(main_compression, compressed, uncompressed);
 }
 void Bag::setCompression(CompressionType compression) {
+    if (chunk_compressor_)
+        throw BagException("Can't change compression while chunks are compressed in the background");
+
     if (file_.isOpen() && chunk_open_)
         stopWritingChunk();
 
@@ -247,6 +281,49 @@ void Bag::setCompression(CompressionType compression) {
     compression_ = compression;
 }
 
+void Bag::setParallelCompression(uint32_t threads, int level) {
+    if (chunk_compressor_)
+        throw BagException("Background chunk compression is already enabled");
+
+    if (file_.isOpen() && chunk_open_)
+        stopWritingChunk();
+    outgoing_chunk_buffer_.setSize(0);
+
+    compression_ = compression::LZ4;
+    chunk_compressor_.reset(new ChunkCompressor(threads, level, [this](OutgoingChunk& chunk) { writeCompressedChunk(chunk); }));
+}
+
+void Bag::setPrefetch(uint32_t chunk_count) {
+    if ((mode_ & bagmode::Read) != bagmode::Read || !file_.isOpen())
+        throw BagException("Bag not opened for reading");
+
+    chunk_prefetcher_.reset();
+    if (chunk_count > 0)
+        chunk_prefetcher_.reset(new ChunkPrefetcher(file_.getFileName(), chunk_count));
+}
+
+bool Bag::findLastMessageTime(string const& topic, Time const& time, Time& last) const {
+    bool found = false;
+    for (map<uint32_t, ConnectionInfo*>::const_iterator i = connections_.begin(); i != connections_.end(); i++) {
+        if (i->second->topic != topic)
+            continue;
+
+        map<uint32_t, multiset<IndexEntry> >::const_iterator j = connection_indexes_.find(i->first);
+        if (j == connection_indexes_.end())
+            continue;
+
+        multiset<IndexEntry>::const_iterator e = j->second.upper_bound({ time, 0, 0 });
+        if (e == j->second.begin())
+            continue;
+        e--;
+
+        if (!found || e->time > last)
+            last = e->time;
+        found = true;
+    }
+    return found;
+}
+
 // Version
 
 void Bag::writeVersion() {
@@ -293,6 +370,19 @@ void Bag::stopWriting() {
     if (chunk_open_)
         stopWritingChunk();
 
+    if (chunk_compressor_) {
+        // Wait for the queued chunks, and take the file back from the writer thread. If a chunk
+        // could not be written, the index would point at chunks that are not there: leave it out
+        std::unique_ptr<ChunkCompressor> chunk_compressor = std::move(chunk_compressor_);
+        chunk_compressor->flush();
+        chunk_compressor.reset();
+
+        // Only now are the chunk positions known
+        for( std::pair<uint32_t, uint64_t> const & written : written_chunks_ )
+            chunks_[written.first].pos = written.second;
+        written_chunks_.clear();
+    }
+
     seek(0, std::ios::end);
 
     index_data_pos_ = file_.getOffset();
@@ -438,7 +528,9 @@ void Bag::readFileHeaderRecord() {
 }
 
 uint32_t Bag::getChunkOffset() const {
-    if (compression_ == compression::Uncompressed)
+    if (chunk_compressor_)
+        return outgoing_chunk_buffer_.getSize();
+    else if (compression_ == compression::Uncompressed)
         return static_cast<uint32_t>(file_.getOffset() - curr_chunk_data_pos_);
     else
         return file_.getCompressedBytesIn();
@@ -446,10 +538,18 @@ uint32_t Bag::getChunkOffset() const {
 
 void Bag::startWritingChunk(Time time) {
     // Initialize chunk info
-    curr_chunk_info_.pos        = file_.getOffset();
     curr_chunk_info_.start_time = time;
     curr_chunk_info_.end_time   = time;
 
+    if (chunk_compressor_) {
+        // The chunk is written later, by the compressor: until then its position is just its index
+        curr_chunk_info_.pos = chunks_.size();
+        chunk_open_ = true;
+        return;
+    }
+
+    curr_chunk_info_.pos = file_.getOffset();
+
     // Write the chunk header, with a place-holder for the data sizes (we'll fill in when the chunk is finished)
     writeChunkHeader(compression_, 0, 0);
 
@@ -463,6 +563,32 @@ void Bag::startWritingChunk(Time time) {
 }
 
 void Bag::stopWritingChunk() {
+    if (chunk_compressor_) {
+        // Hand the chunk's records and indexes over, and carry on with the recycled buffers; the
+        // chunk is only indexed once the compressor has taken it (acquire() throws after a failure)
+        std::unique_ptr<OutgoingChunk> chunk;
+        try {
+            chunk = chunk_compressor_->acquire();
+        }
+        catch (...) {
+            // Nothing more will be written, so the chunk is dropped rather than kept growing
+            outgoing_chunk_buffer_.setSize(0);
+            curr_chunk_connection_indexes_.clear();
+            curr_chunk_info_.connection_counts.clear();
+            chunk_open_ = false;
+            throw;
+        }
+        chunk->index = static_cast<uint32_t>(chunks_.size());
+        chunks_.push_back(curr_chunk_info_);
+        chunk->uncompressed.swap(outgoing_chunk_buffer_);
+        chunk->connection_indexes.swap(curr_chunk_connection_indexes_);
+        chunk_compressor_->push(std::move(chunk));
+
+        curr_chunk_info_.connection_counts.clear();
+        chunk_open_ = false;
+        return;
+    }
+
     // Add this chunk to the index
     chunks_.push_back(curr_chunk_info_);
 
@@ -479,7 +605,7 @@ void Bag::stopWritingChunk() {
 
     // Write out the indexes and clear them
     seek(end_of_chunk_pos);
-    writeIndexRecords();
+    writeIndexRecords(curr_chunk_connection_indexes_);
     curr_chunk_connection_indexes_.clear();
 
     // Clear the connection counts
@@ -489,6 +615,17 @@ void Bag::stopWritingChunk() {
     chunk_open_ = false;
 }
 
+void Bag::writeCompressedChunk(OutgoingChunk& chunk) {
+    // Runs on the compressor's writer thread, which has the file to itself until the bag is closed
+    uint64_t pos = file_.getOffset();
+
+    writeChunkHeader(compression::LZ4, chunk.compressed.getSize(), chunk.uncompressed.getSize());
+    write((char*) chunk.compressed.getData(), chunk.compressed.getSize());
+    writeIndexRecords(chunk.connection_indexes);
+
+    written_chunks_.push_back(std::make_pair(chunk.index, pos));
+}
+
 void Bag::writeChunkHeader(CompressionType compression, uint32_t compressed_size, uint32_t uncompressed_size) {
     ChunkHeader chunk_header;
     switch (compression) {
@@ -530,8 +667,8 @@ void Bag::readChunkHeader(ChunkHeader& chunk_header) const {
 
 // Index records
 
-void Bag::writeIndexRecords() {
-    for (map<uint32_t, multiset<IndexEntry> >::const_iterator i = curr_chunk_connection_indexes_.begin(); i != curr_chunk_connection_indexes_.end(); i++) {
+void Bag::writeIndexRecords(map<uint32_t, multiset<IndexEntry> > const& connection_indexes) {
+    for (map<uint32_t, multiset<IndexEntry> >::const_iterator i = connection_indexes.begin(); i != connection_indexes.end(); i++) {
         uint32_t                    connection_id = i->first;
         multiset<IndexEntry> const& index         = i->second;
 
@@ -793,6 +930,16 @@ void Bag::decompressChunk(uint64_t chunk_pos) const {
     if (decompressed_chunk_ == chunk_pos)
         return;
 
+    if (chunk_prefetcher_) {
+        // Take the chunk before asking for the next ones, which lets go of everything else
+        bool prefetched = chunk_prefetcher_->take(chunk_pos, decompress_buffer_);
+        prefetchChunksAfter(chunk_pos);
+        if (prefetched) {
+            decompressed_chunk_ = chunk_pos;
+            return;
+        }
+    }
+
     // Seek to the start of the chunk
     seek(chunk_pos);
 
@@ -813,6 +960,19 @@ void Bag::decompressChunk(uint64_t chunk_pos) const {
     decompressed_chunk_ = chunk_pos;
 }
 
+void Bag::prefetchChunksAfter(uint64_t chunk_pos) const {
+    // Chunks are listed in file order
+    vector<ChunkInfo>::const_iterator i = std::lower_bound(chunks_.begin(), chunks_.end(), chunk_pos,
+        [](ChunkInfo const& chunk_info, uint64_t pos) { return chunk_info.pos < pos; });
+    if (i == chunks_.end() || i->pos != chunk_pos)
+        return;
+
+    vector<uint64_t> next;
+    for (i++; i != chunks_.end() && next.size() < chunk_prefetcher_->getDepth(); i++)
+        next.push_back(i->pos);
+    chunk_prefetcher_->prefetch(next);
+}
+
 void Bag::readMessageDataRecord102(uint64_t offset, rs2rosinternal::Header& header) const {
     CONSOLE_BRIDGE_logDebug("readMessageDataRecord: offset=%llu", (unsigned long long) offset);
 
@@ -0,0 +1,177 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include "rosbag/chunk_compressor.h"
+#include "rosbag/exceptions.h"
+
+#include "../../roslz4/include/roslz4/lz4s.h"
+
+#include <string>
+
+namespace rosbag {
+
+namespace {
+
+// Same block size as LZ4Stream, so chunks read back exactly as if they were compressed while writing
+const int LZ4_BLOCK_SIZE_ID = 6;
+
+} // namespace
+
+ChunkCompressor::ChunkCompressor(uint32_t threads, int level, WriteCallback write) :
+    level_(level),
+    write_(write),
+    max_in_flight_(2 * (threads ? threads : 1) + 1),
+    next_push_(0),
+    next_write_(0),
+    in_flight_(0),
+    stopping_(false),
+    failed_(false)
+{
+    if (threads == 0)
+        threads = 1;
+    for (uint32_t i = 0; i < threads; i++)
+        compressors_.push_back(std::thread([this] { compressLoop(); }));
+    writer_ = std::thread([this] { writeLoop(); });
+}
+
+ChunkCompressor::~ChunkCompressor() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    compress_cv_.notify_all();
+    write_cv_.notify_all();
+    done_cv_.notify_all();
+
+    for (std::thread& t : compressors_)
+        t.join();
+    writer_.join();
+}
+
+std::unique_ptr<OutgoingChunk> ChunkCompressor::acquire() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_cv_.wait(lock, [this] { return in_flight_ < max_in_flight_ || failed_; });
+    rethrow();
+
+    if (free_.empty())
+        return std::unique_ptr<OutgoingChunk>(new OutgoingChunk());
+
+    std::unique_ptr<OutgoingChunk> chunk = std::move(free_.back());
+    free_.pop_back();
+    return chunk;
+}
+
+void ChunkCompressor::push(std::unique_ptr<OutgoingChunk> chunk) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        to_compress_.push_back(std::make_pair(next_push_++, std::move(chunk)));
+        in_flight_++;
+    }
+    compress_cv_.notify_one();
+}
+
+void ChunkCompressor::flush() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_cv_.wait(lock, [this] { return in_flight_ == 0 || failed_; });
+    rethrow();
+}
+
+void ChunkCompressor::check() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    rethrow();
+}
+
+void ChunkCompressor::rethrow() {
+    // The chunks after a failure were dropped, so the failure sticks: nothing more can be written
+    if (failed_)
+        std::rethrow_exception(error_);
+}
+
+void ChunkCompressor::compress(OutgoingChunk& chunk) const {
+    // The LZ4 frame never grows a block by more than its 4-byte size prefix, plus the frame header and footer
+    uint32_t size        = chunk.uncompressed.getSize();
+    uint32_t block_size  = static_cast<uint32_t>(roslz4_blockSizeFromIndex(LZ4_BLOCK_SIZE_ID));
+    uint32_t output_size = size + 4 * (size / block_size + 1) + 16;
+    chunk.compressed.setSize(output_size);
+
+    int ret = roslz4_buffToBuffCompressLevel((char*) chunk.uncompressed.getData(), size,
+                                             (char*) chunk.compressed.getData(), &output_size,
+                                             LZ4_BLOCK_SIZE_ID, level_);
+    if (ret != ROSLZ4_OK)
+        throw BagException( "Error compressing chunk: " + std::to_string( ret ) );
+    chunk.compressed.setSize(output_size);
+}
+
+void ChunkCompressor::compressLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        compress_cv_.wait(lock, [this] { return stopping_ || ! to_compress_.empty(); });
+        if (stopping_)
+            return;
+
+        uint64_t seq = to_compress_.front().first;
+        std::unique_ptr<OutgoingChunk> chunk = std::move(to_compress_.front().second);
+        to_compress_.pop_front();
+
+        lock.unlock();
+        std::exception_ptr error;
+        try {
+            compress(*chunk);
+        }
+        catch (...) {
+            error = std::current_exception();
+        }
+        lock.lock();
+
+        if (error) {
+            failed_ = true;
+            if (! error_)
+                error_ = error;
+        }
+        to_write_[seq] = std::move(chunk);
+        write_cv_.notify_one();
+    }
+}
+
+void ChunkCompressor::writeLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        write_cv_.wait(lock, [this] { return stopping_ || to_write_.count(next_write_); });
+        if (stopping_)
+            return;
+
+        std::map<uint64_t, std::unique_ptr<OutgoingChunk> >::iterator next = to_write_.find(next_write_);
+        std::unique_ptr<OutgoingChunk> chunk = std::move(next->second);
+        to_write_.erase(next);
+        next_write_++;
+
+        // Once anything failed, the file is no longer consistent: drop the remaining chunks
+        bool skip = failed_;
+
+        lock.unlock();
+        std::exception_ptr error;
+        if (! skip) {
+            try {
+                write_(*chunk);
+            }
+            catch (...) {
+                error = std::current_exception();
+            }
+        }
+        chunk->uncompressed.setSize(0);
+        chunk->compressed.setSize(0);
+        chunk->connection_indexes.clear();
+        lock.lock();
+
+        if (error) {
+            failed_ = true;
+            if (! error_)
+                error_ = error;
+        }
+        free_.push_back(std::move(chunk));
+        in_flight_--;
+        done_cv_.notify_all();
+    }
+}
+
+} // namespace rosbag
@@ -0,0 +1,169 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include "rosbag/chunk_prefetcher.h"
+#include "rosbag/constants.h"
+#include "rosbag/exceptions.h"
+
+#include "ros/header.h"
+
+#include <algorithm>
+#include <string.h>
+
+#include "console_bridge/console.h"
+
+namespace rosbag {
+
+ChunkPrefetcher::ChunkPrefetcher(std::string const& filename, uint32_t depth) :
+    depth_(depth ? depth : 1),
+    in_progress_(0),
+    busy_(false),
+    stopping_(false)
+{
+    file_.openRead(filename);
+    thread_ = std::thread([this] { run(); });
+}
+
+ChunkPrefetcher::~ChunkPrefetcher() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    work_cv_.notify_all();
+    thread_.join();
+}
+
+uint32_t ChunkPrefetcher::getDepth() const { return depth_; }
+
+void ChunkPrefetcher::prefetch(std::vector<uint64_t> const& chunk_positions) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        // Recycle whatever is no longer ahead of the reader
+        for (std::map<uint64_t, std::unique_ptr<Buffer> >::iterator i = ready_.begin(); i != ready_.end(); ) {
+            if (std::find(chunk_positions.begin(), chunk_positions.end(), i->first) == chunk_positions.end()) {
+                free_.push_back(std::move(i->second));
+                i = ready_.erase(i);
+            }
+            else
+                i++;
+        }
+
+        pending_.clear();
+        for( uint64_t chunk_pos : chunk_positions )
+            if (ready_.find(chunk_pos) == ready_.end() && ! (busy_ && in_progress_ == chunk_pos))
+                pending_.push_back(chunk_pos);
+    }
+    work_cv_.notify_one();
+}
+
+bool ChunkPrefetcher::take(uint64_t chunk_pos, Buffer& buffer) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    ready_cv_.wait(lock, [&] { return ! (busy_ && in_progress_ == chunk_pos); });
+
+    std::map<uint64_t, std::unique_ptr<Buffer> >::iterator i = ready_.find(chunk_pos);
+    if (i == ready_.end()) {
+        // The caller reads it itself: don't read it a second time
+        pending_.erase(std::remove(pending_.begin(), pending_.end(), chunk_pos), pending_.end());
+        return false;
+    }
+
+    // The caller's old buffer is recycled for a later chunk
+    buffer.swap(*i->second);
+    free_.push_back(std::move(i->second));
+    ready_.erase(i);
+    lock.unlock();
+
+    work_cv_.notify_one();
+    return true;
+}
+
+void ChunkPrefetcher::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        work_cv_.wait(lock, [this] { return stopping_ || (! pending_.empty() && ready_.size() < depth_); });
+        if (stopping_)
+            return;
+
+        uint64_t chunk_pos = pending_.front();
+        pending_.pop_front();
+        std::unique_ptr<Buffer> buffer;
+        if (free_.empty())
+            buffer.reset(new Buffer());
+        else {
+            buffer = std::move(free_.back());
+            free_.pop_back();
+        }
+        busy_        = true;
+        in_progress_ = chunk_pos;
+
+        lock.unlock();
+        bool read = true;
+        try {
+            readChunk(chunk_pos, *buffer);
+        }
+        catch (std::exception const& e) {
+            CONSOLE_BRIDGE_logWarn("Failed to prefetch chunk at %llu: %s", (unsigned long long) chunk_pos, e.what());
+            read = false;
+        }
+        lock.lock();
+
+        busy_ = false;
+        if (read)
+            ready_[chunk_pos] = std::move(buffer);
+        else
+            free_.push_back(std::move(buffer));
+        ready_cv_.notify_all();
+    }
+}
+
+void ChunkPrefetcher::readChunk(uint64_t chunk_pos, Buffer& decompressed) {
+    file_.seek(chunk_pos);
+
+    // Read the chunk header
+    uint32_t header_len;
+    file_.read((char*) &header_len, 4);
+    header_buffer_.setSize(header_len);
+    file_.read((char*) header_buffer_.getData(), header_len);
+
+    rs2rosinternal::Header header;
+    std::string error_msg;
+    if (!header.parse(header_buffer_.getData(), header_len, error_msg))
+        throw BagFormatException("Error reading CHUNK record: " + error_msg);
+    rs2rosinternal::M_string& fields = *header.getValues();
+
+    rs2rosinternal::M_string::const_iterator op          = fields.find(OP_FIELD_NAME);
+    rs2rosinternal::M_string::const_iterator compression = fields.find(COMPRESSION_FIELD_NAME);
+    rs2rosinternal::M_string::const_iterator size        = fields.find(SIZE_FIELD_NAME);
+    if (op == fields.end() || op->second.size() != 1 || (uint8_t) op->second[0] != OP_CHUNK)
+        throw BagFormatException("Expected CHUNK op not found");
+    if (compression == fields.end() || size == fields.end() || size->second.size() != 4)
+        throw BagFormatException("Error reading CHUNK record");
+
+    uint32_t uncompressed_size;
+    memcpy(&uncompressed_size, size->second.data(), 4);
+    uint32_t compressed_size;
+    file_.read((char*) &compressed_size, 4);
+
+    if (compression->second == COMPRESSION_NONE) {
+        decompressed.setSize(compressed_size);
+        file_.read((char*) decompressed.getData(), compressed_size);
+        return;
+    }
+
+    CompressionType type;
+    if (compression->second == COMPRESSION_LZ4)
+        type = compression::LZ4;
+    else if (compression->second == COMPRESSION_BZ2)
+        type = compression::BZ2;
+    else
+        throw BagFormatException("Unknown compression: " + compression->second);
+
+    chunk_buffer_.setSize(compressed_size);
+    file_.read((char*) chunk_buffer_.getData(), compressed_size);
+
+    decompressed.setSize(uncompressed_size);
+    file_.decompress(type, decompressed.getData(), decompressed.getSize(), chunk_buffer_.getData(), chunk_buffer_.getSize());
+}
+
+} // namespace rosbag
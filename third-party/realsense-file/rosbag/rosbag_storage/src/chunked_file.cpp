@@ -137,15 +137,16 @@ void ChunkedFile::close() {
     // Close any compressed stream by changing to uncompressed mode
     setWriteMode(compression::Uncompressed);
 
-    // Close the file
+    // Close the file; whether or not that succeeds, the FILE is gone
     int success = fclose(file_);
-    if (success != 0)
-        throw BagIOException( "Error closing file: " + filename_ );
-
     file_ = NULL;
-    filename_.clear();
+    string filename;
+    filename.swap(filename_);
     
     clearUnused();
+
+    if (success != 0)
+        throw BagIOException( "Error closing file: " + filename );
 }
 
 // Read/write modes
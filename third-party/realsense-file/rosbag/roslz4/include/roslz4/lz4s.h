@@ -85,6 +85,10 @@ void roslz4_decompressEnd(roslz4_stream *str);
 int roslz4_buffToBuffCompress(char *input, unsigned int input_size,
                               char *output, unsigned int *output_size,
                               int block_size_id);
+// Same, with LZ4-HC at the given level (see lz4hc.h) when level > 0
+int roslz4_buffToBuffCompressLevel(char *input, unsigned int input_size,
+                                   char *output, unsigned int *output_size,
+                                   int block_size_id, int level);
 int roslz4_buffToBuffDecompress(char *input, unsigned int input_size,
                                 char *output, unsigned int *output_size);
 
@@ -33,6 +33,7 @@
 ********************************************************************/
 
 #include "roslz4/lz4s.h"
+#include "../../../lz4/lz4hc.h"
 
 #include "xxhash.h"
 
@@ -91,6 +92,7 @@ typedef struct {
 
   // Compression state
   int wrote_header;
+  int compression_level; // 0 for LZ4; otherwise the LZ4-HC level
 
   // Decompression state
   char header[10];
@@ -181,10 +183,15 @@ int bufferToOutput(roslz4_stream *str) {
         state->buffer_offset, str->output_left);
 
   // Shrink output by 1 to detect if data is not compressible
-  uint32_t comp_size = LZ4_compress_default(state->buffer,
-                                            str->output_next + 4,
-                                            state->buffer_offset,
-                                            uncomp_size - 1);
+  uint32_t comp_size;
+  if (state->compression_level > 0) {
+    comp_size = LZ4_compress_HC(state->buffer, str->output_next + 4,
+                                state->buffer_offset, uncomp_size - 1,
+                                state->compression_level);
+  } else {
+    comp_size = LZ4_compress_default(state->buffer, str->output_next + 4,
+                                     state->buffer_offset, uncomp_size - 1);
+  }
   uint32_t wrote;
   if (comp_size > 0) {
     DEBUG("bufferToOutput() Compressed to %i bytes\n", comp_size);
@@ -251,6 +258,7 @@ int streamStateAlloc(roslz4_stream *str) {
   state->stream_checksum_read = 0;
 
   state->wrote_header = 0;
+  state->compression_level = 0;
 
   state->buffer_offset = 0;
   state->buffer_size = 0;
@@ -565,6 +573,13 @@ void roslz4_decompressEnd(roslz4_stream *str) {
 int roslz4_buffToBuffCompress(char *input, unsigned int input_size,
                               char *output, unsigned int *output_size,
                               int block_size_id) {
+  return roslz4_buffToBuffCompressLevel(input, input_size, output, output_size,
+                                        block_size_id, 0);
+}
+
+int roslz4_buffToBuffCompressLevel(char *input, unsigned int input_size,
+                                   char *output, unsigned int *output_size,
+                                   int block_size_id, int level) {
   roslz4_stream stream;
   stream.input_next = input;
   stream.input_left = input_size;
@@ -574,6 +589,7 @@ int roslz4_buffToBuffCompress(char *input, unsigned int input_size,
   int ret;
   ret = roslz4_compressStart(&stream, block_size_id);
   if (ret != ROSLZ4_OK) { return ret; }
+  ((stream_state*) stream.state)->compression_level = level;
 
   while (stream.input_left > 0 && ret != ROSLZ4_STREAM_END) {
     ret = roslz4_compress(&stream, ROSLZ4_FINISH);
@@ -2,6 +2,7 @@
 // Copyright(c) 2015 Intel Corporation. All Rights Reserved.
 
 #pragma once
+#include "lock-free-queue.h"
 #include <queue>
 #include <mutex>
 #include <condition_variable>
@@ -314,12 +315,16 @@ public:
     // and we're non-blocking. The on_drop_callback allows caputring of these instances, if we
     // want...
     //
+    // A lock-free dispatcher queues its actions in a lock_free_queue, which allocates all
+    // queue_capacity (at least 2) slots up front: use it for small queues on busy paths.
+    //
     dispatcher( unsigned int queue_capacity,
-                std::function< void( action ) > on_drop_callback = nullptr );
+                std::function< void( action ) > on_drop_callback = nullptr,
+                bool lock_free = false );
 
     ~dispatcher();
 
-    bool empty() const { return _queue.empty(); }
+    bool empty() const { return _lock_free_queue ? _lock_free_queue->empty() : _queue.empty(); }
 
     // Main invocation of an action: this will be called from any thread, and basically just queues
     // up the actions for our dispatching thread to handle them.
@@ -333,7 +338,14 @@ public:
     {
         if (!_was_stopped)
         {
-            if(is_blocking)
+            if( _lock_free_queue )
+            {
+                if( is_blocking )
+                    _lock_free_queue->blocking_enqueue( std::move( item ) );
+                else
+                    _lock_free_queue->enqueue( std::move( item ) );
+            }
+            else if(is_blocking)
                 _queue.blocking_enqueue(std::move(item));
             else
                 _queue.enqueue(std::move(item));
@@ -388,6 +400,7 @@ private:
     friend cancellable_timer;
 
     single_consumer_queue<std::function<void(cancellable_timer)>> _queue;
+    std::unique_ptr< lock_free_queue< std::function< void( cancellable_timer ) > > > _lock_free_queue;  // replaces _queue, if set
     std::thread _thread;
 
     std::atomic<bool> _was_stopped;
@@ -0,0 +1,411 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+
+namespace rsutils {
+namespace concurrency {
+
+
+// Lets threads sleep until a condition holds, where the condition is changed without a lock.
+//
+// notify() is nearly free while nobody sleeps: it costs a fence and a load. A waiter registers,
+// then reads the epoch, then checks its condition; notify() bumps the epoch when it finds a
+// waiter, so a waiter either sees the change or sleeps on an epoch that is already stale and
+// wakes right away. On Linux waiters sleep on a futex on the epoch itself, so neither side takes
+// a lock; elsewhere they sleep on a condition variable.
+//
+class event_count
+{
+    std::atomic< uint32_t > _epoch;
+    std::atomic< unsigned > _waiters;
+#ifndef __linux__
+    std::mutex _mutex;
+    std::condition_variable _cv;
+#endif
+
+public:
+    event_count()
+        : _epoch( 0 )
+        , _waiters( 0 )
+    {
+    }
+
+    // Returns false if the timeout expired before the predicate held
+    template< class Pred >
+    bool wait_for( std::chrono::milliseconds timeout, Pred pred )
+    {
+        if( pred() )
+            return true;
+        auto const deadline = std::chrono::steady_clock::now() + timeout;
+        _waiters.fetch_add( 1 );
+        bool ready;
+        while( true )
+        {
+            uint32_t const epoch = _epoch.load();
+            if( ( ready = pred() ) )
+                break;
+            auto const now = std::chrono::steady_clock::now();
+            if( now >= deadline )
+                break;
+            sleep( epoch, std::chrono::duration_cast< std::chrono::nanoseconds >( deadline - now ) );
+        }
+        _waiters.fetch_sub( 1 );
+        return ready;
+    }
+
+    template< class Pred >
+    void wait( Pred pred )
+    {
+        if( pred() )
+            return;
+        _waiters.fetch_add( 1 );
+        while( true )
+        {
+            uint32_t const epoch = _epoch.load();
+            if( pred() )
+                break;
+            sleep( epoch, std::chrono::nanoseconds::max() );
+        }
+        _waiters.fetch_sub( 1 );
+    }
+
+    void notify_one() { notify( false ); }
+    void notify_all() { notify( true ); }
+
+private:
+    void notify( bool all )
+    {
+        // Pairs with the waiter's fetch_add: either we see it, or it sees what we changed
+        std::atomic_thread_fence( std::memory_order_seq_cst );
+        if( ! _waiters.load( std::memory_order_relaxed ) )
+            return;
+        _epoch.fetch_add( 1 );
+        wake( all );
+    }
+
+#ifdef __linux__
+    static_assert( sizeof( std::atomic< uint32_t > ) == sizeof( uint32_t ), "the futex word is the epoch itself" );
+
+    // Returns when woken, on timeout, or right away if the epoch is no longer 'epoch'
+    void sleep( uint32_t epoch, std::chrono::nanoseconds timeout )
+    {
+        struct timespec ts;
+        struct timespec * pts = nullptr;
+        if( timeout != std::chrono::nanoseconds::max() )
+        {
+            ts.tv_sec = time_t( timeout.count() / 1000000000 );
+            ts.tv_nsec = long( timeout.count() % 1000000000 );
+            pts = &ts;
+        }
+        syscall( SYS_futex, reinterpret_cast< uint32_t * >( &_epoch ), FUTEX_WAIT_PRIVATE, epoch, pts, nullptr, 0 );
+    }
+
+    void wake( bool all )
+    {
+        syscall( SYS_futex, reinterpret_cast< uint32_t * >( &_epoch ), FUTEX_WAKE_PRIVATE, all ? INT_MAX : 1, nullptr,
+                 nullptr, 0 );
+    }
+#else
+    void sleep( uint32_t epoch, std::chrono::nanoseconds timeout )
+    {
+        std::unique_lock< std::mutex > lock( _mutex );
+        auto changed = [&]() { return _epoch.load() != epoch; };
+        if( timeout == std::chrono::nanoseconds::max() )
+            _cv.wait( lock, changed );
+        else
+            _cv.wait_for( lock, timeout, changed );
+    }
+
+    void wake( bool all )
+    {
+        {
+            // The waiter is either asleep or has yet to check the epoch
+            std::lock_guard< std::mutex > lock( _mutex );
+        }
+        if( all )
+            _cv.notify_all();
+        else
+            _cv.notify_one();
+    }
+#endif
+};
+
+
+// A bounded ring of cells, each with a sequence number telling whether it is ready to be written
+// or read (D. Vyukov's bounded MPMC queue). Producers and consumers claim cells with a single CAS
+// and never wait on each other's locks.
+//
+template< class T >
+class ring_buffer
+{
+    struct cell
+    {
+        std::atomic< size_t > sequence;
+        T data;
+    };
+
+    // Each index gets a cache line of its own, so producers and consumers don't contend on it.
+    // Padded rather than aligned: over-aligned types are not honored by new before C++17.
+    struct position
+    {
+        char before[64];
+        std::atomic< size_t > value;
+        char after[64 - sizeof( std::atomic< size_t > )];
+    };
+
+    size_t const _size;
+    std::unique_ptr< cell[] > _cells;
+    position _enqueue_pos;
+    position _dequeue_pos;
+
+public:
+    // At least two cells are needed to tell a full cell from an empty one
+    explicit ring_buffer( size_t size )
+        : _size( size < 2 ? 2 : size )
+        , _cells( new cell[_size] )
+    {
+        for( size_t i = 0; i < _size; ++i )
+            _cells[i].sequence.store( i, std::memory_order_relaxed );
+        _enqueue_pos.value.store( 0, std::memory_order_relaxed );
+        _dequeue_pos.value.store( 0, std::memory_order_relaxed );
+    }
+
+    size_t capacity() const { return _size; }
+
+    // Moves from item only when it succeeds; false if the ring is full
+    bool try_push( T & item )
+    {
+        size_t pos = _enqueue_pos.value.load( std::memory_order_relaxed );
+        while( true )
+        {
+            cell & c = _cells[pos % _size];
+            size_t const seq = c.sequence.load( std::memory_order_acquire );
+            intptr_t const diff = (intptr_t)seq - (intptr_t)pos;
+            if( diff == 0 )
+            {
+                if( _enqueue_pos.value.compare_exchange_weak( pos, pos + 1, std::memory_order_relaxed ) )
+                {
+                    c.data = std::move( item );
+                    c.sequence.store( pos + 1, std::memory_order_release );
+                    return true;
+                }
+            }
+            else if( diff < 0 )
+                return false;
+            else
+                pos = _enqueue_pos.value.load( std::memory_order_relaxed );
+        }
+    }
+
+    // False if the ring is empty
+    bool try_pop( T & item )
+    {
+        size_t pos = _dequeue_pos.value.load( std::memory_order_relaxed );
+        while( true )
+        {
+            cell & c = _cells[pos % _size];
+            size_t const seq = c.sequence.load( std::memory_order_acquire );
+            intptr_t const diff = (intptr_t)seq - (intptr_t)( pos + 1 );
+            if( diff == 0 )
+            {
+                if( _dequeue_pos.value.compare_exchange_weak( pos, pos + 1, std::memory_order_relaxed ) )
+                {
+                    item = std::move( c.data );
+                    c.data = T();  // don't hold on to whatever it owns
+                    c.sequence.store( pos + _size, std::memory_order_release );
+                    return true;
+                }
+            }
+            else if( diff < 0 )
+                return false;
+            else
+                pos = _dequeue_pos.value.load( std::memory_order_relaxed );
+        }
+    }
+
+    // Only a snapshot while others push and pop
+    size_t size() const
+    {
+        size_t const tail = _dequeue_pos.value.load( std::memory_order_acquire );
+        size_t const head = _enqueue_pos.value.load( std::memory_order_acquire );
+        return head > tail ? std::min( head - tail, _size ) : 0;
+    }
+};
+
+
+}  // namespace concurrency
+}  // namespace rsutils
+
+
+// A drop-in for single_consumer_queue (see concurrency.h) that does not take a lock to enqueue or
+// dequeue: any number of producers, one consumer, over a fixed ring of 'cap' items (at least 2).
+//
+// When full, enqueue() drops the oldest item through the on-drop callback, same as the locking
+// queue. Waiting (for an item, or for room in blocking_enqueue) sleeps on an event_count, so
+// neither side makes a system call while the other is not asleep.
+//
+// Producers count themselves in while they check _accepting and push, and stop() waits for them
+// to leave before clearing: nothing lands in the queue once stop() returns.
+//
+// There is no peek(): the front item can be taken by the consumer at any time.
+//
+template< class T >
+class lock_free_queue
+{
+    rsutils::concurrency::ring_buffer< T > _ring;
+    rsutils::concurrency::event_count _deq_ec;  // not empty signal
+    rsutils::concurrency::event_count _enq_ec;  // not full signal
+
+    std::atomic< bool > _accepting;
+    std::atomic< unsigned > _producers;  // inside enqueue() or blocking_enqueue()
+
+    std::function< void( T const & ) > const _on_drop_callback;
+
+public:
+    explicit lock_free_queue( unsigned int cap, std::function< void( T const & ) > on_drop_callback = nullptr )
+        : _ring( cap )
+        , _accepting( true )
+        , _producers( 0 )
+        , _on_drop_callback( on_drop_callback )
+    {
+    }
+
+    // Enqueue an item onto the queue.
+    // If the queue is at capacity, the front will be removed, losing whatever was there!
+    bool enqueue( T && item )
+    {
+        producer_scope producer( _producers );
+        if( ! _accepting )
+        {
+            if( _on_drop_callback )
+                _on_drop_callback( item );
+            return false;
+        }
+
+        while( ! _ring.try_push( item ) )
+        {
+            T oldest;
+            if( _ring.try_pop( oldest ) && _on_drop_callback )
+                _on_drop_callback( oldest );
+        }
+
+        _deq_ec.notify_one();
+        return true;
+    }
+
+    // Enqueue an item, but wait for room if there isn't any
+    // Returns true if the enqueue succeeded
+    bool blocking_enqueue( T && item )
+    {
+        producer_scope producer( _producers );
+        bool pushed = false;
+        _enq_ec.wait( [&]() { return ! _accepting || ( pushed = _ring.try_push( item ) ); } );
+        if( ! pushed )
+        {
+            // We shouldn't be adding anything to the queue when we're stopping
+            if( _on_drop_callback )
+                _on_drop_callback( item );
+            return false;
+        }
+
+        _deq_ec.notify_one();
+        return true;
+    }
+
+    // Remove one item; if unavailable, wait for it
+    // Return true if an item was removed -- otherwise, false
+    bool dequeue( T * item, unsigned int timeout_ms )
+    {
+        bool popped = false;
+        _deq_ec.wait_for( std::chrono::milliseconds( timeout_ms ),
+                          [&]() { return ( popped = _ring.try_pop( *item ) ) || ! _accepting; } );
+        if( ! popped )
+            return false;
+
+        // We've made room -- let whoever is waiting for room know about it
+        _enq_ec.notify_one();
+        return true;
+    }
+
+    // Remove one item if available; do not wait for one
+    // Return true if an item was removed -- otherwise, false
+    bool try_dequeue( T * item )
+    {
+        if( ! _ring.try_pop( *item ) )
+            return false;
+
+        _enq_ec.notify_one();
+        return true;
+    }
+
+    void stop()
+    {
+        // We no longer accept any more items!
+        _accepting = false;
+
+        // Producers that got in before we stopped accepting may still push: let them finish (and
+        // any waiting for room find out), then clear what they pushed. Later ones see we stopped.
+        _enq_ec.notify_all();
+        while( _producers.load() )
+            std::this_thread::yield();
+
+        clear();
+    }
+
+    void clear()
+    {
+        T item;
+        while( _ring.try_pop( item ) )
+        {
+        }
+
+        // Wake up anyone who is waiting for room to enqueue, or waiting for something to dequeue -- there's nothing now
+        _enq_ec.notify_all();
+        _deq_ec.notify_all();
+    }
+
+    void start() { _accepting = true; }
+
+    bool started() const { return _accepting; }
+    bool stopped() const { return ! started(); }
+
+    size_t size() const { return _ring.size(); }
+
+    bool empty() const { return ! size(); }
+
+private:
+    // Pairs with stop(): either stop() sees us counted in, or we see _accepting is false
+    class producer_scope
+    {
+        std::atomic< unsigned > & _producers;
+
+    public:
+        explicit producer_scope( std::atomic< unsigned > & producers )
+            : _producers( producers )
+        {
+            _producers.fetch_add( 1 );
+        }
+        ~producer_scope() { _producers.fetch_sub( 1 ); }
+    };
+};
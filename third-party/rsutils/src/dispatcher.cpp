@@ -5,11 +5,14 @@
 #include <rsutils/easylogging/easyloggingpp.h>
 #include <rsutils/time/waiting-on.h>
 
-dispatcher::dispatcher( unsigned int cap, std::function< void( action ) > on_drop_callback )
+dispatcher::dispatcher( unsigned int cap, std::function< void( action ) > on_drop_callback, bool lock_free )
     : _queue( cap, on_drop_callback )
     , _was_stopped( true )
     , _is_alive( true )
 {
+    if( lock_free )
+        _lock_free_queue.reset( new lock_free_queue< std::function< void( cancellable_timer ) > >( cap, on_drop_callback ) );
+
     // We keep a running thread that takes stuff off our queue and dispatches them
     _thread = std::thread([&]()
     {
@@ -19,7 +22,9 @@ dispatcher::dispatcher( unsigned int cap, std::function< void( action ) > on_dro
             if( _wait_for_start( timeout_ms ) )
             {
                 std::function< void(cancellable_timer) > item;
-                if (_queue.dequeue(&item, timeout_ms))
+                bool const dequeued = _lock_free_queue ? _lock_free_queue->dequeue( &item, timeout_ms )
+                                                       : _queue.dequeue( &item, timeout_ms );
+                if( dequeued )
                 {
                     cancellable_timer time(this);
 
@@ -64,7 +69,10 @@ void dispatcher::start()
         std::lock_guard< std::mutex > lock(_was_stopped_mutex);
         _was_stopped = false;
     }
-    _queue.start();
+    if( _lock_free_queue )
+        _lock_free_queue->start();
+    else
+        _queue.start();
     // Wake up all threads that wait for the dispatcher to start
     _was_stopped_cv.notify_all();
 
@@ -83,12 +91,15 @@ void dispatcher::stop()
 
     // First things first: don't accept any more incoming stuff, and get rid of anything
     // pending
-    _queue.stop();
+    if( _lock_free_queue )
+        _lock_free_queue->stop();
+    else
+        _queue.stop();
 
     // Wait until any dispatched is done...
     {
         std::lock_guard< std::mutex > lock(_dispatch_mutex);
-        assert(_queue.empty());
+        assert(empty());
     }
     // Signal we've stopped so any sleeping dispatched will wake up immediately
     {
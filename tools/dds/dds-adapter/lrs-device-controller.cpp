@@ -14,6 +14,7 @@ using rsutils::string::hexarray;
 #include <realdds/topics/imu-msg.h>
 #include <realdds/topics/ros2/ros2vector3.h>
 #include <realdds/topics/flexible-msg.h>
+#include <realdds/topics/metadata-msg.h>
 #include <realdds/topics/dds-topic-names.h>
 #include <realdds/dds-device-server.h>
 #include <realdds/dds-stream-server.h>
@@ -233,7 +234,7 @@ std::vector< std::shared_ptr< realdds::dds_stream_server > > lrs_device_controll
             // Set stream metadata support (currently if the device supports metadata all streams does)
             // Must be done before calling init_profiles()
             if( _md_enabled )
-                server->enable_metadata();
+                server->enable_metadata( metadata_keys() );
         }
 
         server->init_profiles( profiles, default_profile_index );
@@ -255,7 +256,7 @@ std::vector< std::shared_ptr< realdds::dds_stream_server > > lrs_device_controll
                 for( auto option_id : supported_options )
                 {
                     // Certain options are automatically added by librealsense and shouldn't actually be shared
-                    if( option_id == RS2_OPTION_FRAMES_QUEUE_SIZE )
+                    if( option_id == RS2_OPTION_FRAMES_QUEUE_SIZE || option_id == RS2_OPTION_FRAMES_POOL_SIZE )
                         continue;  // Added automatically for every sensor_base
 
                     std::string option_name = sensor.get_option_name( option_id );
@@ -750,33 +751,38 @@ bool lrs_device_controller::on_open_streams( json const & control, json & reply
 }
 
 
+/*static*/ std::vector< std::string > lrs_device_controller::metadata_keys()
+{
+    // The key of each metadata item is then its rs2_frame_metadata_value, as in the frame's metadata_array
+    std::vector< std::string > keys;
+    for( size_t i = 0; i < static_cast< size_t >( RS2_FRAME_METADATA_COUNT ); ++i )
+        keys.push_back( rs2_frame_metadata_to_string( static_cast< rs2_frame_metadata_value >( i ) ) );
+    return keys;
+}
+
+
 void lrs_device_controller::publish_frame_metadata( const rs2::frame & f, realdds::dds_time const & timestamp )
 {
     if( ! _dds_device_server->has_metadata_readers() )
         return;
 
-    json md_header = json::object( {
-        { topics::metadata::header::key::frame_number, f.get_frame_number() },               // communicated; up to client to pick up
-        { topics::metadata::header::key::timestamp, timestamp.to_ns() },                     // syncer key: needs to match the image timestamp, bit-for-bit!
-        { topics::metadata::header::key::timestamp_domain, f.get_frame_timestamp_domain() }  // needed if we're dealing with different domains!
-    } );
+    // Sent in binary if the client was told so in the stream header, otherwise as JSON
+    topics::metadata_msg md;
+    md.stream_name = stream_name_from_rs2( f.get_profile() );
+    md.timestamp = timestamp.to_ns();                           // syncer key: needs to match the image timestamp, bit-for-bit!
+    md.set_frame_number( f.get_frame_number() );                // communicated; up to client to pick up
+    md.set_timestamp_domain( f.get_frame_timestamp_domain() );  // needed if we're dealing with different domains!
     if( f.is< rs2::depth_frame >() )
-        md_header[topics::metadata::header::key::depth_units] = f.as< rs2::depth_frame >().get_units();
+        md.set_depth_units( f.as< rs2::depth_frame >().get_units() );
 
-    json metadata = json::object();
     for( size_t i = 0; i < static_cast< size_t >( RS2_FRAME_METADATA_COUNT ); ++i )
     {
         rs2_frame_metadata_value val = static_cast< rs2_frame_metadata_value >( i );
         if( f.supports_frame_metadata( val ) )
-            metadata[rs2_frame_metadata_to_string( val )] = f.get_frame_metadata( val );
+            md.items.push_back( { static_cast< uint32_t >( i ), f.get_frame_metadata( val ) } );
     }
 
-    json md_msg = json::object( {
-        { topics::metadata::key::stream_name, stream_name_from_rs2( f.get_profile() ) },
-        { topics::metadata::key::header, std::move( md_header ) },
-        { topics::metadata::key::metadata, std::move( metadata ) },
-    } );
-    _dds_device_server->publish_metadata( std::move( md_msg ) );
+    _dds_device_server->publish_metadata( md );
 }
 
 
@@ -38,6 +38,7 @@ public:
 private:
     std::vector< std::shared_ptr< realdds::dds_stream_server > > get_supported_streams();
 
+    static std::vector< std::string > metadata_keys();
     void publish_frame_metadata( const rs2::frame & f, realdds::dds_time const & );
 
     bool on_control( std::string const & id, rsutils::json const & control, rsutils::json & reply );
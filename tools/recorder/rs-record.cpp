@@ -12,6 +12,8 @@
 #include <thread>
 #include <string.h>
 #include <chrono>
+#include <algorithm>
+#include <vector>
 #include "tclap/CmdLine.h"
 
 using namespace TCLAP;
@@ -23,10 +25,17 @@ int main(int argc, char * argv[]) try
     SwitchArg debug_arg( "", "debug", "Turn on LibRS debug logs" );
     ValueArg<double>    time("t", "Time", "Amount of time to record (in seconds)", false, 10., "");
     ValueArg<std::string> out_file("f", "FullFilePath", "the file where the data will be saved to", false, "test.bag", "");
+    ValueArg<unsigned>    queue_mb("q", "QueueMB", "Memory allowed for frames waiting to be written (in MB)", false, 256, "");
+    std::vector<std::string> policies = { "newest", "oldest", "priority", "block" };
+    ValuesConstraint<std::string> allowed_policies(policies);
+    ValueArg<std::string> drop_policy("p", "DropPolicy", "What gives once the queue is full: drop the newest or oldest frames, "
+        "drop other streams before color and color before depth, or block the sensors", false, "newest", &allowed_policies);
 
     cmd.add(debug_arg);
     cmd.add(time);
     cmd.add(out_file);
+    cmd.add(queue_mb);
+    cmd.add(drop_policy);
     cmd.parse(argc, argv);
 
 #ifdef BUILD_EASYLOGGINGPP
@@ -54,6 +63,19 @@ int main(int argc, char * argv[]) try
 
     rs2::pipeline_profile profiles = pipe.start(cfg, callback);
 
+    rs2::recorder recorder = profiles.get_device().as<rs2::recorder>();
+    if (recorder)
+    {
+        auto policy = static_cast<rs2_record_drop_policy>(
+            std::find(policies.begin(), policies.end(), drop_policy.getValue()) - policies.begin());
+        recorder.set_queue_limit(queue_mb.getValue() * 1024ull * 1024, policy);
+        if (policy == RS2_RECORD_DROP_POLICY_DROP_LOWEST_PRIORITY)
+        {
+            recorder.set_stream_priority(RS2_STREAM_DEPTH, 2);
+            recorder.set_stream_priority(RS2_STREAM_COLOR, 1);
+        }
+    }
+
     auto t = std::chrono::system_clock::now();
     auto t0 = t;
     while( t - t0 <= std::chrono::milliseconds( (unsigned)( time.getValue() * 1000 ) ) )
@@ -63,6 +85,21 @@ int main(int argc, char * argv[]) try
     }
     std::cout << "\nFinished" << std::endl;
 
+    if (recorder)
+    {
+        auto stats = recorder.get_queue_stats();
+        std::cout << "Written frames: " << stats.written_frames << ", dropped: " << stats.dropped_frames
+                  << ", still queued: " << stats.queued_frames << " (" << stats.queued_bytes / 1024 << " KB)\n"
+                  << "Peak queue: " << stats.peak_queued_bytes / 1024 << " KB, write latency: "
+                  << std::fixed << std::setprecision(1) << stats.average_latency << " ms average, " << stats.max_latency << " ms max" << std::endl;
+        for (auto&& stream : profiles.get_streams())
+        {
+            auto dropped = recorder.get_dropped_frames(stream.stream_type(), stream.stream_index());
+            if (dropped)
+                std::cout << "  " << stream.stream_name() << ": " << dropped << " frames dropped" << std::endl;
+        }
+    }
+
     pipe.stop();
 
     return EXIT_SUCCESS;
@@ -0,0 +1,133 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+
+#include "../algo-common.h"
+#include <librealsense2/rsutil.h>
+#include <src/proc/depth-rays.h>
+
+#include <random>
+#include <vector>
+
+using namespace librealsense;
+
+
+static rs2_intrinsics make_intrinsics( rs2_distortion model )
+{
+    rs2_intrinsics intrin = { 64, 36, 32.1f, 17.9f, 45.2f, 45.3f, model, { 0.f, 0.f, 0.f, 0.f, 0.f } };
+    switch( model )
+    {
+    case RS2_DISTORTION_INVERSE_BROWN_CONRADY:
+    case RS2_DISTORTION_BROWN_CONRADY:
+        intrin.coeffs[0] = 0.18f; intrin.coeffs[1] = -0.53f; intrin.coeffs[2] = -0.0014f; intrin.coeffs[3] = 0.00012f; intrin.coeffs[4] = 0.47f;
+        break;
+    case RS2_DISTORTION_KANNALA_BRANDT4:
+        intrin.coeffs[0] = -0.0069f; intrin.coeffs[1] = 0.044f; intrin.coeffs[2] = -0.041f; intrin.coeffs[3] = 0.0076f;
+        break;
+    case RS2_DISTORTION_FTHETA:
+        intrin.coeffs[0] = 0.92f;
+        break;
+    default:
+        break;
+    }
+    return intrin;
+}
+
+
+TEST_CASE( "depth_rays deproject like rs2_deproject_pixel_to_point", "[pointcloud]" )
+{
+    parallel_pool pool( 2 );
+    const float depth_scale = 0.001f;
+
+    for( auto model : { RS2_DISTORTION_NONE, RS2_DISTORTION_INVERSE_BROWN_CONRADY, RS2_DISTORTION_BROWN_CONRADY,
+                        RS2_DISTORTION_KANNALA_BRANDT4, RS2_DISTORTION_FTHETA } )
+    {
+        CAPTURE( rs2_distortion_to_string( model ) );
+        auto intrin = make_intrinsics( model );
+
+        std::mt19937 gen( model );
+        std::uniform_int_distribution< int > z( 0, 10000 );
+        std::vector< uint16_t > depth( intrin.width * intrin.height );
+        for( auto & d : depth )
+            d = uint16_t( z( gen ) < 1000 ? 0 : z( gen ) );
+
+        depth_rays rays;
+        CHECK( rays.update( intrin, pool ) );
+        CHECK_FALSE( rays.update( intrin, pool ) );
+
+        std::vector< float3 > points( depth.size() );
+        rays.deproject( depth.data(), depth_scale, points.data(), pool );
+
+        int mismatches = 0;
+        for( int y = 0, i = 0; y < intrin.height; ++y )
+            for( int x = 0; x < intrin.width; ++x, ++i )
+            {
+                const float pixel[] = { (float)x, (float)y };
+                float expected[3];
+                rs2_deproject_pixel_to_point( expected, &intrin, pixel, depth_scale * depth[i] );
+                if( points[i].x != expected[0] || points[i].y != expected[1] || points[i].z != expected[2] )
+                    ++mismatches;
+            }
+        CHECK( mismatches == 0 );
+    }
+}
+
+
+TEST_CASE( "depth_rays rebuild when the intrinsics change", "[pointcloud]" )
+{
+    parallel_pool pool( 0 );
+    depth_rays rays;
+    auto intrin = make_intrinsics( RS2_DISTORTION_NONE );
+    CHECK( rays.update( intrin, pool ) );
+
+    intrin.ppx += 0.5f;
+    CHECK( rays.update( intrin, pool ) );
+
+    std::vector< uint16_t > depth( intrin.width * intrin.height, 1000 );
+    std::vector< float3 > points( depth.size() );
+    rays.deproject( depth.data(), 1.f, points.data(), pool );
+    const float pixel[] = { 0.f, 0.f };
+    float expected[3];
+    rs2_deproject_pixel_to_point( expected, &intrin, pixel, 1000.f );
+    CHECK( points[0].x == expected[0] );
+}
+
+
+TEST_CASE( "depth_rays deproject part of an image", "[pointcloud]" )
+{
+    parallel_pool pool( 0 );
+    depth_rays rays;
+    auto intrin = make_intrinsics( RS2_DISTORTION_BROWN_CONRADY );
+    rays.update( intrin, pool );
+
+    std::vector< uint16_t > depth( intrin.width * intrin.height );
+    for( size_t i = 0; i < depth.size(); ++i )
+        depth[i] = uint16_t( 500 + i );
+
+    // Ranges that start and end anywhere, so every pixel is reached in vectors of 8, then 4, then one at a time
+    for( auto range : { std::make_pair( 0, 1 ), std::make_pair( 3, 61 ), std::make_pair( 5, 12 ), std::make_pair( 64, 64 + 19 ) } )
+    {
+        size_t const first = range.first, last = range.second;
+        CAPTURE( first, last );
+        std::vector< float3 > points( depth.size(), float3{ -1.f, -1.f, -1.f } );
+        rays.deproject( depth.data(), 0.001f, points.data(), first, last );
+
+        int mismatches = 0;
+        for( size_t i = 0; i < points.size(); ++i )
+        {
+            if( i < first || i >= last )
+            {
+                if( points[i].x != -1.f || points[i].y != -1.f || points[i].z != -1.f )
+                    ++mismatches;
+                continue;
+            }
+            const float pixel[] = { float( i % intrin.width ), float( i / intrin.width ) };
+            float expected[3];
+            rs2_deproject_pixel_to_point( expected, &intrin, pixel, 0.001f * depth[i] );
+            if( points[i].x != expected[0] || points[i].y != expected[1] || points[i].z != expected[2] )
+                ++mismatches;
+        }
+        CHECK( mismatches == 0 );
+    }
+}
@@ -0,0 +1,37 @@
+# License: Apache 2.0. See LICENSE file in root directory.
+# Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+import pyrealdds as dds
+from rspy import log, test
+
+dds.debug( log.is_debug_on(), log.nested )
+
+import d435i
+
+
+participant = dds.participant()
+participant.init( 123, "server", { 'device': { 'video': { 'plain-images': True } } } )
+
+
+depth_stream = dds.depth_stream_server( "Depth", "Stereo Module" )
+depth_stream.init_profiles( d435i.depth_stream_profiles(), 0 )
+depth_stream.init_options( [] )
+depth_stream.open( 'rt/plain-images', dds.publisher( participant ) )
+
+
+def new_image( width, height, bpp, timestamp_as_ns ):
+    i = dds.message.image()
+    i.width = width
+    i.height = height
+    size = width * height * bpp
+    i.data = bytearray( ( bytes( range( 256 ) ) * ( size // 256 + 1 ) )[:size] )
+    i.timestamp = dds.time.from_ns( timestamp_as_ns )
+    return i
+
+
+def publish_image( width, height, bpp, timestamp_as_ns ):
+    depth_stream.publish_image( new_image( width, height, bpp, timestamp_as_ns ) )
+
+
+# From here down, we're in "interactive" mode (see test-plain-images.py)
+# ...
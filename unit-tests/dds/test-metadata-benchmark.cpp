@@ -0,0 +1,153 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+//#cmake:dependencies realdds
+//#test:donotrun:!dds
+
+// Per-frame cost of frame metadata as JSON and in binary: the server building and encoding it for the metadata
+// topic, and the client parsing it back into values, for the metadata of a color frame.
+
+#include <unit-tests/test.h>
+#include <realdds/topics/metadata-msg.h>
+#include <realdds/topics/flexible-msg.h>
+#include <realdds/topics/dds-topic-names.h>
+#include <rsutils/time/stopwatch.h>
+#include <rsutils/json.h>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using rsutils::json;
+using rsutils::time::stopwatch;
+using namespace realdds::topics;
+
+
+namespace {
+
+
+std::vector< std::string > const keys = {
+    "Frame Counter", "Frame Timestamp", "Sensor Timestamp", "Actual Exposure", "Gain Level", "Auto Exposure",
+    "White Balance", "Time Of Arrival", "Temperature", "Backend Timestamp", "Actual Fps", "Frame Laser Power",
+    "Frame Laser Power Mode", "Exposure Priority", "Exposure Roi Left", "Exposure Roi Right", "Exposure Roi Top",
+    "Exposure Roi Bottom", "Brightness", "Contrast", "Saturation", "Sharpness", "Auto White Balance Temperature",
+    "Backlight Compensation", "Hue", "Gamma", "Manual White Balance", "Power Line Frequency", "Low Light Compensation"
+};
+
+int const n_frames = 10000;
+
+
+// What the server did for each frame before binary metadata
+flexible_msg encode_json( int frame )
+{
+    json md = json::object();
+    for( size_t k = 0; k < keys.size(); ++k )
+        md[keys[k]] = int64_t( 1000 + frame + k );
+    return flexible_msg( json::object( {
+        { metadata::key::stream_name, "Color" },
+        { metadata::key::header,
+          json::object( { { metadata::header::key::frame_number, frame },
+                          { metadata::header::key::timestamp, 1706012345678901234LL + frame },
+                          { metadata::header::key::timestamp_domain, 2 } } ) },
+        { metadata::key::metadata, std::move( md ) },
+    } ) );
+}
+
+
+flexible_msg encode_binary( int frame )
+{
+    metadata_msg md;
+    md.stream_name = "Color";
+    md.timestamp = 1706012345678901234LL + frame;
+    md.set_frame_number( frame );
+    md.set_timestamp_domain( 2 );
+    md.items.reserve( keys.size() );
+    for( size_t k = 0; k < keys.size(); ++k )
+        md.items.push_back( { uint32_t( k ), int64_t( 1000 + frame + k ) } );
+    return md.to_flexible();
+}
+
+
+// The client looks each value up by name
+int64_t parse_json( flexible_msg const & msg )
+{
+    auto j = msg.json_data();
+    int64_t sum = j.at( metadata::key::header ).at( metadata::header::key::frame_number ).get< int64_t >();
+    for( auto & item : j.at( metadata::key::metadata ).items() )
+        sum += item.value().get< int64_t >();
+    return sum;
+}
+
+
+// ... or by index
+int64_t parse_binary( flexible_msg const & msg )
+{
+    metadata_msg md( msg );
+    int64_t sum = int64_t( md.frame_number );
+    for( auto & item : md.items )
+        sum += item.value;
+    return sum;
+}
+
+
+struct cost
+{
+    double encode_us;
+    double parse_us;
+    size_t size;
+};
+
+
+template< class Encode, class Parse >
+cost measure( Encode encode, Parse parse )
+{
+    std::vector< flexible_msg > messages;
+    messages.reserve( n_frames );
+    stopwatch sw;
+    for( int i = 0; i < n_frames; ++i )
+        messages.push_back( encode( i ) );
+    auto encoded = sw.get_elapsed();
+
+    sw.reset();
+    int64_t sum = 0;
+    for( auto & msg : messages )
+        sum += parse( msg );
+    auto parsed = sw.get_elapsed();
+
+    // Same values either way: the frame number, then 1000 + frame + k for each key
+    int64_t expected = 0;
+    for( int64_t i = 0; i < n_frames; ++i )
+        expected += i + int64_t( keys.size() ) * ( 1000 + i ) + int64_t( keys.size() * ( keys.size() - 1 ) / 2 );
+    CHECK( sum == expected );
+
+    return { std::chrono::duration< double, std::micro >( encoded ).count() / n_frames,
+             std::chrono::duration< double, std::micro >( parsed ).count() / n_frames,
+             messages.back()._data.size() };
+}
+
+
+}  // namespace
+
+
+TEST_CASE( "metadata per-frame cost, JSON vs binary", "[metadata]" )
+{
+    auto json_cost = measure( encode_json, parse_json );
+    auto binary_cost = measure( encode_binary, parse_binary );
+
+    std::cout << std::fixed << std::setprecision( 2 ) << "JSON:   encode " << json_cost.encode_us << " us, parse "
+              << json_cost.parse_us << " us, " << json_cost.size << " bytes\n"
+              << "binary: encode " << binary_cost.encode_us << " us, parse " << binary_cost.parse_us << " us, "
+              << binary_cost.size << " bytes (x" << ( json_cost.encode_us + json_cost.parse_us )
+                                                        / ( binary_cost.encode_us + binary_cost.parse_us )
+              << ")" << std::endl;
+    CHECK( binary_cost.size < json_cost.size );
+}
+
+
+TEST_CASE( "binary metadata converts to the same JSON", "[metadata]" )
+{
+    auto j = encode_json( 7 ).json_data();
+    CHECK( metadata_msg( encode_binary( 7 ) ).to_json( keys ) == j );
+}
@@ -0,0 +1,75 @@
+# License: Apache 2.0. See LICENSE file in root directory.
+# Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#test:donotrun:!dds
+
+import pyrealdds as dds
+from rspy import log, test
+
+dds.debug( log.is_debug_on(), 'C  ' )
+log.nested = 'C  '
+
+
+keys = [ 'Frame Counter', 'Frame Timestamp', 'Sensor Timestamp', 'Actual Exposure', 'Gain Level', 'Auto Exposure',
+         'White Balance', 'Time Of Arrival', 'Temperature', 'Backend Timestamp', 'Actual Fps', 'Frame Laser Power',
+         'Frame Laser Power Mode', 'Exposure Priority', 'Exposure Roi Left', 'Exposure Roi Right', 'Exposure Roi Top',
+         'Exposure Roi Bottom', 'Brightness', 'Contrast', 'Saturation', 'Sharpness', 'Auto White Balance Temperature',
+         'Backlight Compensation', 'Hue', 'Gamma', 'Manual White Balance', 'Power Line Frequency', 'Low Light Compensation' ]
+
+md = {
+    'stream-name': 'Color',
+    'header': { 'frame-number': 1234, 'timestamp': 1706012345678901234, 'timestamp-domain': 2 },
+    'metadata': { key: 1000 + i for i, key in enumerate( keys ) }
+    }
+
+
+#############################################################################################
+#
+with test.closure( "JSON to binary and back" ):
+    binary = dds.message.metadata.from_json( md, keys )
+    test.check_equal( binary.stream_name, 'Color' )
+    test.check_equal( binary.timestamp, 1706012345678901234 )
+    test.check_equal( binary.frame_number, 1234 )
+    test.check_equal( binary.timestamp_domain, 2 )
+    test.check_equal( binary.depth_units, None )
+    test.check_equal( len( binary.items ), len( keys ) )
+    msg = binary.to_flexible()
+    test.check_equal( msg.data_format, dds.message.flexible_format.custom )
+    test.check_equal( msg.version, 1 )
+    test.check( dds.message.metadata.is_binary( msg ) )
+    test.check_equal( dds.message.metadata( msg ).to_json( keys ), md )
+#
+#############################################################################################
+#
+with test.closure( "Depth units" ):
+    depth_md = { 'stream-name': 'Depth', 'header': { 'timestamp': 1, 'depth-units': 0.001 }, 'metadata': {} }
+    binary = dds.message.metadata( dds.message.metadata.from_json( depth_md, keys ).to_flexible() )
+    test.check_equal( binary.frame_number, None )
+    test.check_approx_abs( binary.depth_units, 0.001, 1e-9 )
+    test.check_equal( binary.items, [] )
+#
+#############################################################################################
+#
+with test.closure( "Unknown names and non-integer values are left out" ):
+    odd_md = { 'stream-name': 'Color', 'header': { 'timestamp': 1 },
+               'metadata': { 'Frame Counter': 5, 'Unknown': 6, 'Actual Exposure': 'high' } }
+    binary = dds.message.metadata.from_json( odd_md, keys )
+    test.check_equal( binary.items, [(0, 5)] )
+    # Keys the client does not have are left out, too
+    test.check_equal( binary.to_json( [] )['metadata'], {} )
+#
+#############################################################################################
+#
+with test.closure( "JSON messages are not binary" ):
+    test.check_false( dds.message.metadata.is_binary( dds.message.flexible( md ) ) )
+    test.check_throws( lambda: dds.message.metadata( dds.message.flexible( md ) ), RuntimeError )
+#
+#############################################################################################
+#
+with test.closure( "Malformed binary throws" ):
+    msg = dds.message.metadata.from_json( md, keys ).to_flexible()
+    msg.data = msg.data[:-1]
+    test.check_throws( lambda: dds.message.metadata( msg ), RuntimeError )
+#
+#############################################################################################
+test.print_results_and_exit()
@@ -0,0 +1,81 @@
+# License: Apache 2.0. See LICENSE file in root directory.
+# Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#test:donotrun:!dds
+#test:retries:gha 2
+
+import pyrealdds as dds
+from rspy import log, test
+from rspy.timer import Timer
+
+dds.debug( log.is_debug_on(), 'C  ' )
+log.nested = 'C  '
+
+import d435i
+
+
+# Both sides must agree on plain images
+participant = dds.participant()
+participant.init( 123, "client", { 'device': { 'video': { 'plain-images': True } } } )
+
+
+import os.path
+cwd = os.path.dirname(os.path.realpath(__file__))
+remote_script = os.path.join( cwd, 'plain-images-server.py' )
+with test.remote( remote_script, nested_indent="  S" ) as remote:
+    remote.wait_until_ready()
+
+    import threading
+    image_received = threading.Event()
+    images = []
+    def on_image_available( stream, image ):
+        log.d( f'----> image {image}')
+        images.append( image )
+        image_received.set()
+
+    #############################################################################################
+    #
+    with test.closure( "Open the client stream", on_fail=test.ABORT ):
+        stream = dds.depth_stream( "Depth", "Stereo Module" )
+        stream.init_profiles( d435i.depth_stream_profiles(), 0 )
+        stream.init_options( [] )
+        stream.on_data_available( on_image_available )
+        stream.open( 'rt/plain-images', dds.subscriber( participant ) )
+        stream.start_streaming()
+    #
+    #############################################################################################
+    #
+    with test.closure( "Images arrive whole", on_fail=test.ABORT ):
+        width, height, bpp = 640, 480, 2
+        remote.run( f'depth_stream.start_streaming( dds.video_encoding.z16, {width}, {height} )' )
+        # Best-effort: the first images may go out before the reader is known to the writer
+        timestamp = dds.now()
+        timer = Timer( 5 )
+        while not images and not timer.has_expired():
+            remote.run( f'publish_image( {width}, {height}, {bpp}, {timestamp.to_ns()} )' )
+            image_received.wait( 0.25 )
+        test.check( images, on_fail=test.RAISE )
+        image = images[0]
+        test.check_equal( image.width, width )
+        test.check_equal( image.height, height )
+        test.check_equal( image.timestamp.to_ns(), timestamp.to_ns() )
+        size = width * height * bpp
+        test.check_equal( len( image.data ), size )
+        test.check( bytes( image.data ) == ( bytes( range( 256 ) ) * ( size // 256 + 1 ) )[:size] )
+    #
+    #############################################################################################
+    #
+    with test.closure( "A smaller image in the same samples" ):
+        images.clear()
+        image_received.clear()
+        remote.run( 'depth_stream.stop_streaming()' )
+        remote.run( 'depth_stream.start_streaming( dds.video_encoding.z16, 424, 240 )' )
+        remote.run( 'publish_image( 424, 240, 2, 0 )' )
+        if test.check( image_received.wait( 1 ) ):
+            test.check_equal( images[0].width, 424 )
+            test.check_equal( len( images[0].data ), 424 * 240 * 2 )
+    #
+    #############################################################################################
+    stream.close()
+
+test.print_results_and_exit()
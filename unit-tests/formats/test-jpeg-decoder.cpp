@@ -0,0 +1,254 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include <unit-tests/test.h>
+#include <src/proc/jpeg-decoder.h>
+
+#define STB_IMAGE_WRITE_STATIC
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include <third-party/stb_image_write.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+using namespace librealsense;
+
+
+namespace {
+
+
+// Smooth gradients with a few edges, like a camera image: JPEG reproduces it closely, but not exactly
+std::vector< uint8_t > make_rgb( int w, int h )
+{
+    std::vector< uint8_t > rgb( size_t( w ) * h * 3 );
+    for( int y = 0; y < h; ++y )
+        for( int x = 0; x < w; ++x )
+        {
+            auto p = &rgb[( size_t( y ) * w + x ) * 3];
+            p[0] = uint8_t( 255 * x / ( w - 1 ) );
+            p[1] = uint8_t( 255 * y / ( h - 1 ) );
+            p[2] = ( x / 16 + y / 16 ) % 2 ? 200 : 50;
+        }
+    return rgb;
+}
+
+
+// Quality above 90 keeps the chroma at full resolution, so decoders do not differ in how they upsample it
+std::vector< uint8_t > encode( std::vector< uint8_t > const & rgb, int w, int h, int quality = 95 )
+{
+    std::vector< uint8_t > jpeg;
+    auto append = []( void * context, void * data, int size )
+    {
+        auto bytes = static_cast< uint8_t * >( data );
+        static_cast< std::vector< uint8_t > * >( context )->insert(
+            static_cast< std::vector< uint8_t > * >( context )->end(), bytes, bytes + size );
+    };
+    REQUIRE( stbi_write_jpg_to_func( append, &jpeg, w, h, 3, rgb.data(), quality ) );
+    return jpeg;
+}
+
+
+int bytes_per_pixel( rs2_format format )
+{
+    return format == RS2_FORMAT_Y8 ? 1 : 3;
+}
+
+
+std::vector< uint8_t > decode( jpeg_decoder & decoder, std::vector< uint8_t > const & jpeg, rs2_format format,
+                               int w, int h, int scale = 1 )
+{
+    std::vector< uint8_t > image( size_t( w ) * h * bytes_per_pixel( format ), 0xAA );
+    CHECK( decoder.decode( jpeg.data(), jpeg.size(), format, scale, image.data(), w, h ) );
+    return image;
+}
+
+
+// The average of each scale x scale block, like a decoder scaling in the DCT domain
+std::vector< uint8_t > shrink( std::vector< uint8_t > const & rgb, int w, int h, int scale )
+{
+    int const sw = ( w + scale - 1 ) / scale, sh = ( h + scale - 1 ) / scale;
+    std::vector< uint8_t > out( size_t( sw ) * sh * 3 );
+    for( int y = 0; y < sh; ++y )
+        for( int x = 0; x < sw; ++x )
+            for( int c = 0; c < 3; ++c )
+            {
+                int sum = 0, count = 0;
+                for( int yy = y * scale; yy < std::min( h, ( y + 1 ) * scale ); ++yy )
+                    for( int xx = x * scale; xx < std::min( w, ( x + 1 ) * scale ); ++xx, ++count )
+                        sum += rgb[( size_t( yy ) * w + xx ) * 3 + c];
+                out[( size_t( y ) * sw + x ) * 3 + c] = uint8_t( ( sum + count / 2 ) / count );
+            }
+    return out;
+}
+
+
+struct difference
+{
+    int max = 0;
+    double mean = 0;
+};
+
+
+difference compare( std::vector< uint8_t > const & a, std::vector< uint8_t > const & b )
+{
+    REQUIRE( a.size() == b.size() );
+    difference d;
+    for( size_t i = 0; i < a.size(); ++i )
+    {
+        int diff = std::abs( int( a[i] ) - int( b[i] ) );
+        d.max = std::max( d.max, diff );
+        d.mean += diff;
+    }
+    d.mean /= a.size();
+    return d;
+}
+
+
+}  // namespace
+
+
+TEST_CASE( "stb_image decodes RGB8, BGR8 and Y8", "[jpeg]" )
+{
+    int const w = 64, h = 48;
+    auto original = make_rgb( w, h );
+    auto jpeg = encode( original, w, h );
+    auto stb = jpeg_decoder::create_stb();
+
+    auto rgb = decode( *stb, jpeg, RS2_FORMAT_RGB8, w, h );
+    auto d = compare( rgb, original );
+    CHECK( d.mean < 2. );
+    CHECK( d.max < 40 );  // around the edges
+
+    auto bgr = decode( *stb, jpeg, RS2_FORMAT_BGR8, w, h );
+    for( size_t i = 0; i < rgb.size(); i += 3 )
+    {
+        CHECK( bgr[i] == rgb[i + 2] );
+        CHECK( bgr[i + 1] == rgb[i + 1] );
+        CHECK( bgr[i + 2] == rgb[i] );
+    }
+
+    // Luminance of the same image
+    auto y8 = decode( *stb, jpeg, RS2_FORMAT_Y8, w, h );
+    for( size_t i = 0; i < y8.size(); ++i )
+    {
+        auto p = &rgb[i * 3];
+        CHECK( std::abs( y8[i] - ( 0.299 * p[0] + 0.587 * p[1] + 0.114 * p[2] ) ) < 8 );
+    }
+}
+
+
+TEST_CASE( "the library decoder matches stb_image", "[jpeg]" )
+{
+    auto decoder = jpeg_decoder::create();
+    auto stb = jpeg_decoder::create_stb();
+    INFO( "decoding with " << decoder->get_name() );
+
+    for( auto size : { std::make_pair( 64, 48 ), std::make_pair( 37, 29 ) } )  // odd sizes have partial blocks
+    {
+        int const w = size.first, h = size.second;
+        auto jpeg = encode( make_rgb( w, h ), w, h );
+
+        for( auto format : { RS2_FORMAT_RGB8, RS2_FORMAT_BGR8, RS2_FORMAT_Y8 } )
+        {
+            CAPTURE( w, h, rs2_format_to_string( format ) );
+            // Both follow the JPEG standard, but may round their IDCTs differently
+            auto d = compare( decode( *decoder, jpeg, format, w, h ), decode( *stb, jpeg, format, w, h ) );
+            CHECK( d.max <= 4 );
+            CHECK( d.mean < 1. );
+        }
+
+        // The same decoder is reused for every frame of a stream
+        auto first = decode( *decoder, jpeg, RS2_FORMAT_RGB8, w, h );
+        CHECK( decode( *decoder, jpeg, RS2_FORMAT_RGB8, w, h ) == first );
+    }
+}
+
+
+TEST_CASE( "images are decoded at half and quarter size", "[jpeg]" )
+{
+    std::unique_ptr< jpeg_decoder > decoders[] = { jpeg_decoder::create(), jpeg_decoder::create_stb() };
+    for( auto size : { std::make_pair( 64, 48 ), std::make_pair( 37, 29 ) } )  // with partial blocks at the edges
+    {
+        int const w = size.first, h = size.second;
+        auto original = make_rgb( w, h );
+        auto jpeg = encode( original, w, h );
+        for( auto & decoder : decoders )
+            for( int scale : { 2, 4 } )
+            {
+                CAPTURE( decoder->get_name(), w, h, scale );
+                int const sw = ( w + scale - 1 ) / scale, sh = ( h + scale - 1 ) / scale;
+                auto d = compare( decode( *decoder, jpeg, RS2_FORMAT_RGB8, sw, sh, scale ),
+                                  shrink( original, w, h, scale ) );
+                CHECK( d.mean < 4. );
+                CHECK( d.max < 80 );  // the checkerboard edges, which the decoders blur differently
+
+                // BGR8 is the same image
+                auto rgb = decode( *decoder, jpeg, RS2_FORMAT_RGB8, sw, sh, scale );
+                auto bgr = decode( *decoder, jpeg, RS2_FORMAT_BGR8, sw, sh, scale );
+                for( size_t i = 0; i < rgb.size(); i += 3 )
+                {
+                    CHECK( bgr[i] == rgb[i + 2] );
+                    CHECK( bgr[i + 2] == rgb[i] );
+                }
+            }
+    }
+}
+
+
+TEST_CASE( "an image smaller than the frame leaves the rest untouched", "[jpeg]" )
+{
+    int const w = 32, h = 16;
+    auto jpeg = encode( make_rgb( w, h ), w, h );
+
+    std::unique_ptr< jpeg_decoder > decoders[] = { jpeg_decoder::create(), jpeg_decoder::create_stb() };
+    for( auto & decoder : decoders )
+    {
+        CAPTURE( decoder->get_name() );
+        int const frame_w = 40, frame_h = 20;
+        auto frame = decode( *decoder, jpeg, RS2_FORMAT_RGB8, frame_w, frame_h );
+        auto expected = decode( *decoder, jpeg, RS2_FORMAT_RGB8, w, h );
+        for( int y = 0; y < frame_h; ++y )
+            for( int x = 0; x < frame_w * 3; ++x )
+            {
+                auto value = frame[size_t( y ) * frame_w * 3 + x];
+                if( y < h && x < w * 3 )
+                    CHECK( value == expected[size_t( y ) * w * 3 + x] );
+                else
+                    CHECK( value == 0xAA );
+            }
+    }
+}
+
+
+TEST_CASE( "an image larger than the frame is not decoded", "[jpeg]" )
+{
+    int const w = 32, h = 16;
+    auto jpeg = encode( make_rgb( w, h ), w, h );
+
+    std::unique_ptr< jpeg_decoder > decoders[] = { jpeg_decoder::create(), jpeg_decoder::create_stb() };
+    for( auto & decoder : decoders )
+    {
+        CAPTURE( decoder->get_name() );
+        // Too wide, too high, and too large once scaled (16 x 8 does not fit in 15 x 8)
+        struct { int width, height, scale; } const frames[] = { { 31, 16, 1 }, { 32, 15, 1 }, { 15, 8, 2 } };
+        for( auto & frame : frames )
+        {
+            CAPTURE( frame.width, frame.height, frame.scale );
+            std::vector< uint8_t > image( size_t( frame.width ) * frame.height * 3, 0xAA );
+            CHECK_FALSE( decoder->decode( jpeg.data(), jpeg.size(), RS2_FORMAT_RGB8, frame.scale, image.data(),
+                                          frame.width, frame.height ) );
+            CHECK( std::all_of( image.begin(), image.end(), []( uint8_t b ) { return b == 0xAA; } ) );
+        }
+    }
+}
+
+
+TEST_CASE( "garbage is not decoded", "[jpeg]" )
+{
+    std::vector< uint8_t > garbage( 1000, 0x5A );
+    std::vector< uint8_t > image( 64 * 48 * 3 );
+    CHECK_FALSE( jpeg_decoder::create()->decode( garbage.data(), garbage.size(), RS2_FORMAT_RGB8, 1, image.data(), 64, 48 ) );
+    CHECK_FALSE( jpeg_decoder::create_stb()->decode( garbage.data(), garbage.size(), RS2_FORMAT_RGB8, 1, image.data(), 64, 48 ) );
+}
@@ -0,0 +1,176 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+
+#include <unit-tests/test.h>
+#include <src/proc/formats-converter.h>
+#include <src/proc/color-formats-converter.h>
+#include <src/core/video-frame.h>
+#include <src/core/frame-callback.h>
+#include <src/stream.h>
+
+#define STB_IMAGE_WRITE_STATIC
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include <third-party/stb_image_write.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+using namespace librealsense;
+
+
+namespace {
+
+
+// The MJPEG converters, as the platform camera registers them
+void register_mjpeg_converters( formats_converter & converter )
+{
+    std::vector< rs2_format > const targets = { RS2_FORMAT_RGB8, RS2_FORMAT_BGR8, RS2_FORMAT_Y8 };
+    converter.register_converters(
+        processing_block_factory::create_pbf_vector< mjpeg_converter >( RS2_FORMAT_MJPEG, targets, RS2_STREAM_COLOR ) );
+    converter.register_converters(
+        processing_block_factory::create_pbf_vector< mjpeg_converter >( RS2_FORMAT_MJPEG,
+                                                                        targets,
+                                                                        RS2_STREAM_COLOR,
+                                                                        &stream_profile::half_resolution,
+                                                                        2 ) );
+    converter.register_converters(
+        processing_block_factory::create_pbf_vector< mjpeg_converter >( RS2_FORMAT_MJPEG,
+                                                                        targets,
+                                                                        RS2_STREAM_COLOR,
+                                                                        &stream_profile::quarter_resolution,
+                                                                        4 ) );
+}
+
+
+std::shared_ptr< video_stream_profile > make_raw_profile( int w, int h )
+{
+    auto profile = std::make_shared< video_stream_profile >();
+    profile->set_stream_type( RS2_STREAM_COLOR );
+    profile->set_format( RS2_FORMAT_MJPEG );
+    profile->set_framerate( 30 );
+    profile->set_dims( w, h );
+    return profile;
+}
+
+
+stream_profiles find( stream_profiles const & profiles, rs2_format format, int w, int h )
+{
+    stream_profiles found;
+    for( auto & p : profiles )
+    {
+        auto vp = std::dynamic_pointer_cast< video_stream_profile >( p );
+        if( vp && p->get_format() == format && int( vp->get_width() ) == w && int( vp->get_height() ) == h )
+            found.push_back( p );
+    }
+    return found;
+}
+
+
+}  // namespace
+
+
+TEST_CASE( "MJPEG is offered at half and quarter size", "[jpeg]" )
+{
+    formats_converter converter;
+    register_mjpeg_converters( converter );
+    auto profiles = converter.get_all_possible_profiles( { make_raw_profile( 1280, 720 ), make_raw_profile( 640, 480 ) } );
+
+    for( auto format : { RS2_FORMAT_RGB8, RS2_FORMAT_BGR8, RS2_FORMAT_Y8 } )
+    {
+        CAPTURE( rs2_format_to_string( format ) );
+        for( auto size : { std::make_pair( 1280, 720 ), std::make_pair( 640, 360 ), std::make_pair( 320, 180 ),
+                           std::make_pair( 640, 480 ), std::make_pair( 320, 240 ), std::make_pair( 160, 120 ) } )
+        {
+            CAPTURE( size.first, size.second );
+            CHECK( find( profiles, format, size.first, size.second ).size() == 1 );
+        }
+    }
+    CHECK( profiles.size() == 3 * 6 );
+}
+
+
+TEST_CASE( "a size the camera streams is not also offered scaled", "[jpeg]" )
+{
+    formats_converter converter;
+    register_mjpeg_converters( converter );
+    // Half of 1280x720 is 640x360, which the camera also streams; a quarter of it is half of 640x360
+    auto raw_640 = make_raw_profile( 640, 360 );
+    auto profiles = converter.get_all_possible_profiles( { make_raw_profile( 1280, 720 ), raw_640 } );
+
+    auto rgb = find( profiles, RS2_FORMAT_RGB8, 640, 360 );
+    REQUIRE( rgb.size() == 1 );
+    CHECK( find( profiles, RS2_FORMAT_RGB8, 320, 180 ).size() == 1 );
+    CHECK( find( profiles, RS2_FORMAT_RGB8, 160, 90 ).size() == 1 );
+
+    // It resolves to the camera's own 640x360, not to 1280x720 as well
+    rgb[0]->set_unique_id( 1 );
+    converter.prepare_to_convert( rgb );
+    auto sources = converter.get_active_source_profiles();
+    REQUIRE( sources.size() == 1 );
+    CHECK( sources[0] == raw_640 );
+}
+
+
+TEST_CASE( "a scaled profile gets frames decoded at its size", "[jpeg]" )
+{
+    int const w = 64, h = 48;
+    std::vector< uint8_t > rgb( w * h * 3 );
+    for( int y = 0; y < h; ++y )
+        for( int x = 0; x < w; ++x )
+        {
+            auto p = &rgb[( y * w + x ) * 3];
+            p[0] = uint8_t( 4 * x );
+            p[1] = uint8_t( 5 * y );
+            p[2] = 128;
+        }
+    std::vector< uint8_t > jpeg;  // about 2 KB
+    auto append = []( void * context, void * data, int size )
+    {
+        auto bytes = static_cast< uint8_t * >( data );
+        static_cast< std::vector< uint8_t > * >( context )->insert(
+            static_cast< std::vector< uint8_t > * >( context )->end(), bytes, bytes + size );
+    };
+    REQUIRE( stbi_write_jpg_to_func( append, &jpeg, w, h, 3, rgb.data(), 95 ) );
+
+    formats_converter converter;
+    register_mjpeg_converters( converter );
+    auto raw = make_raw_profile( w, h );
+    auto profiles = converter.get_all_possible_profiles( { raw } );
+    auto quarter = find( profiles, RS2_FORMAT_RGB8, w / 4, h / 4 );
+    REQUIRE( quarter.size() == 1 );
+    quarter[0]->set_unique_id( 1 );
+    converter.prepare_to_convert( quarter );
+    REQUIRE( converter.get_active_source_profiles().size() == 1 );
+
+    std::vector< frame_holder > output;
+    converter.set_frames_callback( make_frame_callback( [&]( frame_holder f ) { output.push_back( std::move( f ) ); } ) );
+
+    // The raw frame, as the sensor would give it: the compressed image, with the size of the profile it is for
+    auto stream = converter.get_active_source_profiles()[0];
+    auto vstream = std::dynamic_pointer_cast< video_stream_profile >( stream );
+    video_frame raw_frame;
+    raw_frame.data = jpeg;  // larger than the decoded image, at this scale
+    raw_frame.assign( vstream->get_width(), vstream->get_height(), vstream->get_width() * 2, 16 );
+    raw_frame.set_stream( stream );
+    frame_holder fh = frame_holder::acquire( &raw_frame );
+    converter.convert_frame( fh );
+
+    REQUIRE( output.size() == 1 );
+    auto decoded = dynamic_cast< video_frame * >( output[0].frame );
+    REQUIRE( decoded );
+    CHECK( decoded->get_width() == w / 4 );
+    CHECK( decoded->get_height() == h / 4 );
+    CHECK( decoded->get_stream()->get_format() == RS2_FORMAT_RGB8 );
+    // Each pixel is about the average of its 4x4 block
+    auto data = decoded->get_frame_data();
+    for( int y = 0; y < h / 4; ++y )
+        for( int x = 0; x < w / 4; ++x )
+        {
+            CAPTURE( x, y );
+            CHECK( std::abs( data[( y * ( w / 4 ) + x ) * 3] - ( 16 * x + 6 ) ) < 8 );
+            CHECK( std::abs( data[( y * ( w / 4 ) + x ) * 3 + 1] - ( 20 * y + 7 ) ) < 8 );
+        }
+}
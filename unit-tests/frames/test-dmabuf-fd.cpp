@@ -0,0 +1,42 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include <unit-tests/test.h>
+#include <librealsense2/rs.hpp>
+#include <librealsense2/hpp/rs_internal.hpp>
+
+#include <vector>
+
+
+// Only frames that reference a capture buffer in-place can be exported; see test-v4l-dmabuf-export for those
+TEST_CASE( "frames that are not in a capture buffer have no DMABUF", "[zero-copy]" )
+{
+    int const W = 16, H = 4;
+    rs2::software_device dev;
+    auto sensor = dev.add_sensor( "Depth" );
+    rs2_intrinsics intrinsics = { W, H, W / 2.f, H / 2.f, 10.f, 10.f, RS2_DISTORTION_NONE, { 0, 0, 0, 0, 0 } };
+    auto profile = sensor.add_video_stream( { RS2_STREAM_DEPTH, 0, 0, W, H, 30, 2, RS2_FORMAT_Z16, intrinsics } );
+
+    rs2::frame_queue queue( 1, true );
+    sensor.open( profile );
+    sensor.start( queue );
+    std::vector< uint16_t > pixels( W * H, 1000 );
+    sensor.on_video_frame( { pixels.data(), []( void * ) {}, W * 2, 2, 0., RS2_TIMESTAMP_DOMAIN_SYSTEM_TIME, 1,
+                             profile, 0.001f } );
+    auto depth = queue.wait_for_frame();
+
+    // A software frame, over memory of the application
+    CHECK( depth.get_dmabuf_fd() == -1 );
+
+    // A frame of a processing block, in memory of the library
+    rs2::colorizer colorizer;
+    auto colorized = colorizer.process( depth );
+    REQUIRE( colorized );
+    CHECK( colorized.get_dmabuf_fd() == -1 );
+
+    // ... and again, now that the block has a pool to recycle from
+    CHECK( colorizer.process( depth ).get_dmabuf_fd() == -1 );
+
+    sensor.stop();
+    sensor.close();
+}
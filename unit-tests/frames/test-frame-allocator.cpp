@@ -0,0 +1,160 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include <unit-tests/test.h>
+#include <librealsense2/rs.hpp>
+#include <librealsense2/hpp/rs_internal.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <vector>
+
+using namespace rs2;
+
+
+namespace {
+
+
+int const W = 64;
+int const H = 48;
+
+
+// Keeps track of the buffers it hands out, so we can check they all come back
+struct counting_allocator
+{
+    std::mutex mutex;
+    std::map< void *, int > live;
+    int n_allocated = 0;
+    int n_deallocated = 0;
+    bool decline = false;
+
+    void * allocate( int size )
+    {
+        std::lock_guard< std::mutex > lock( mutex );
+        if( decline )
+            return nullptr;
+        auto p = std::malloc( size );
+        live[p] = size;
+        ++n_allocated;
+        return p;
+    }
+
+    void deallocate( void * p, int size )
+    {
+        std::lock_guard< std::mutex > lock( mutex );
+        auto it = live.find( p );
+        REQUIRE( it != live.end() );
+        CHECK( it->second == size );
+        live.erase( it );
+        ++n_deallocated;
+        std::free( p );
+    }
+
+    bool owns( void const * p )
+    {
+        std::lock_guard< std::mutex > lock( mutex );
+        return live.count( const_cast< void * >( p ) ) > 0;
+    }
+};
+
+
+// Injects a single depth frame into a software device, and returns it
+frame make_depth_frame( software_sensor & sensor, stream_profile const & profile, std::vector< uint16_t > & pixels )
+{
+    frame_queue q( 1, true );
+    sensor.open( profile );
+    sensor.start( q );
+    sensor.on_video_frame( { pixels.data(),
+                             []( void * ) {},
+                             W * 2,
+                             2,
+                             1000.,
+                             RS2_TIMESTAMP_DOMAIN_SYSTEM_TIME,
+                             1,
+                             profile.get(),
+                             0.001f } );
+    frame f;
+    REQUIRE( q.try_wait_for_frame( &f, 5000 ) );
+    sensor.stop();
+    sensor.close();
+    return f;
+}
+
+
+}  // namespace
+
+
+TEST_CASE( "processing block frames come from the user allocator", "[software-device][frame-allocator]" )
+{
+    counting_allocator allocator;
+    frame colorized;
+    {
+        software_device dev;
+        auto sensor = dev.add_sensor( "Depth" );
+        rs2_intrinsics intrinsics = { W, H, W / 2.f, H / 2.f, 50.f, 50.f, RS2_DISTORTION_NONE, { 0, 0, 0, 0, 0 } };
+        auto profile = sensor.add_video_stream( { RS2_STREAM_DEPTH, 0, 0, W, H, 30, 2, RS2_FORMAT_Z16, intrinsics } );
+        sensor.add_read_only_option( RS2_OPTION_DEPTH_UNITS, 0.001f );
+
+        std::vector< uint16_t > pixels( W * H );
+        for( size_t i = 0; i < pixels.size(); ++i )
+            pixels[i] = uint16_t( 500 + i % 1000 );
+        auto depth = make_depth_frame( sensor, profile, pixels );
+
+        colorizer c;
+        c.set_frame_allocator( [&]( int size ) { return allocator.allocate( size ); },
+                               [&]( void * p, int size ) { allocator.deallocate( p, size ); } );
+        colorized = c.process( depth );
+        REQUIRE( colorized );
+        CHECK( allocator.n_allocated == 1 );
+        CHECK( allocator.owns( colorized.get_data() ) );
+        CHECK( colorized.get_data_size() == W * H * 3 );
+
+        // A second frame gets a buffer of its own
+        auto another = c.process( depth );
+        CHECK( allocator.n_allocated == 2 );
+        CHECK( another.get_data() != colorized.get_data() );
+        another = frame();
+        CHECK( allocator.n_deallocated == 1 );
+
+        // The colorizer, the sensor and the device all go away here...
+    }
+
+    // ... but the frame is still ours to use, and its memory still belongs to the allocator
+    CHECK( allocator.n_deallocated == 1 );
+    CHECK( allocator.owns( colorized.get_data() ) );
+    auto data = static_cast< uint8_t const * >( colorized.get_data() );
+    CHECK( std::count( data, data + W * H * 3, 0 ) < W * H * 3 );
+
+    colorized = frame();
+    CHECK( allocator.n_deallocated == 2 );
+    CHECK( allocator.live.empty() );
+}
+
+
+TEST_CASE( "a declined allocation falls back to internal memory", "[software-device][frame-allocator]" )
+{
+    counting_allocator allocator;
+    allocator.decline = true;
+
+    software_device dev;
+    auto sensor = dev.add_sensor( "Depth" );
+    rs2_intrinsics intrinsics = { W, H, W / 2.f, H / 2.f, 50.f, 50.f, RS2_DISTORTION_NONE, { 0, 0, 0, 0, 0 } };
+    auto profile = sensor.add_video_stream( { RS2_STREAM_DEPTH, 0, 0, W, H, 30, 2, RS2_FORMAT_Z16, intrinsics } );
+
+    std::vector< uint16_t > pixels( W * H, 1000 );
+    auto depth = make_depth_frame( sensor, profile, pixels );
+
+    colorizer c;
+    c.set_frame_allocator( [&]( int size ) { return allocator.allocate( size ); },
+                           [&]( void * p, int size ) { allocator.deallocate( p, size ); } );
+    auto colorized = c.process( depth );
+    REQUIRE( colorized );
+    CHECK( colorized.get_data_size() == W * H * 3 );
+    colorized = frame();
+
+    CHECK( allocator.n_allocated == 0 );
+    CHECK( allocator.n_deallocated == 0 );
+}
@@ -0,0 +1,127 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include <unit-tests/test.h>
+
+//#cmake:add-file ../../src/frame-buffer-pool.h
+#include <src/frame-buffer-pool.h>
+
+#include <thread>
+
+using namespace librealsense;
+
+
+TEST_CASE( "recycled buffers are reused as-is", "[frame-buffer-pool]" )
+{
+    frame_buffer_pool pool;
+    frame_buffer_pool::buffer buf;
+
+    CHECK_FALSE( pool.acquire( 1000, buf ) );
+    CHECK( buf.empty() );
+
+    buf.assign( 1000, 7 );
+    auto data = buf.data();
+    pool.recycle( std::move( buf ), 0. );
+    CHECK( buf.empty() );
+
+    frame_buffer_pool::buffer out;
+    REQUIRE( pool.acquire( 1000, out ) );
+    CHECK( out.data() == data );
+    CHECK( out.size() == 1000 );
+    CHECK( out[999] == 7 );
+
+    // Nothing left to take
+    frame_buffer_pool::buffer another;
+    CHECK_FALSE( pool.acquire( 1000, another ) );
+
+    auto stats = pool.get_stats();
+    CHECK( stats.hits == 1 );
+    CHECK( stats.misses == 2 );
+    CHECK( stats.evictions == 0 );
+}
+
+TEST_CASE( "buffers are matched by size class", "[frame-buffer-pool]" )
+{
+    frame_buffer_pool pool;
+    frame_buffer_pool::buffer buf( 1000 );
+    pool.recycle( std::move( buf ), 0. );
+
+    frame_buffer_pool::buffer out;
+    CHECK_FALSE( pool.acquire( 1001, out ) );  // too big
+    CHECK_FALSE( pool.acquire( 500, out ) );   // different size class
+    REQUIRE( pool.acquire( 600, out ) );
+    CHECK( out.size() == 600 );
+}
+
+TEST_CASE( "stale buffers are evicted", "[frame-buffer-pool]" )
+{
+    frame_buffer_pool pool;
+    pool.recycle( frame_buffer_pool::buffer( 100 ), 0. );
+    pool.recycle( frame_buffer_pool::buffer( 100 ), 500. );
+
+    pool.evict_stale( frame_buffer_pool::MAX_IDLE_TIME + 100. );
+    CHECK( pool.get_stats().evictions == 1 );
+
+    frame_buffer_pool::buffer out;
+    CHECK( pool.acquire( 100, out ) );
+    out.clear();
+    CHECK_FALSE( pool.acquire( 100, out ) );
+}
+
+TEST_CASE( "stale buffers are looked for once per idle time", "[frame-buffer-pool]" )
+{
+    frame_buffer_pool pool;
+    pool.evict_stale( 5000. );  // first scan
+    pool.recycle( frame_buffer_pool::buffer( 100 ), 0. );
+
+    // Stale, but too soon after the last scan
+    pool.evict_stale( 5000. + frame_buffer_pool::MAX_IDLE_TIME / 2 );
+    CHECK( pool.get_stats().evictions == 0 );
+
+    pool.evict_stale( 5000. + frame_buffer_pool::MAX_IDLE_TIME );
+    CHECK( pool.get_stats().evictions == 1 );
+
+    // Time going backwards (e.g., a new session) scans right away
+    pool.recycle( frame_buffer_pool::buffer( 100 ), 0. );
+    pool.evict_stale( 1500. );
+    CHECK( pool.get_stats().evictions == 2 );
+}
+
+TEST_CASE( "full buckets drop returned buffers", "[frame-buffer-pool]" )
+{
+    frame_buffer_pool pool;
+    for( int i = 0; i < frame_buffer_pool::SLOTS_PER_BUCKET + 2; ++i )
+        pool.recycle( frame_buffer_pool::buffer( 64 ), 0. );
+    CHECK( pool.get_stats().evictions == 2 );
+
+    pool.clear();
+    CHECK( pool.get_stats().evictions == 2 + frame_buffer_pool::SLOTS_PER_BUCKET );
+
+    frame_buffer_pool::buffer out;
+    CHECK_FALSE( pool.acquire( 64, out ) );
+}
+
+TEST_CASE( "concurrent acquire and recycle", "[frame-buffer-pool]" )
+{
+    frame_buffer_pool pool;
+    int const N = 10000;
+
+    auto worker = [&]() {
+        for( int i = 0; i < N; ++i )
+        {
+            frame_buffer_pool::buffer buf;
+            if( ! pool.acquire( 4096, buf ) )
+                buf.resize( 4096 );
+            buf[0] = 1;
+            pool.recycle( std::move( buf ), 0. );
+        }
+    };
+    std::thread t1( worker ), t2( worker ), t3( worker );
+    t1.join();
+    t2.join();
+    t3.join();
+
+    auto stats = pool.get_stats();
+    CHECK( stats.hits + stats.misses == 3 * N );
+    CHECK( stats.misses <= frame_buffer_pool::SLOTS_PER_BUCKET + 3 + stats.evictions );
+}
@@ -0,0 +1,62 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+//#test:donotrun:!linux
+
+#include <unit-tests/test.h>
+
+#ifdef __linux__
+
+//#cmake:add-file ../../src/linux/private-mapping.h
+#include <src/linux/private-mapping.h>
+
+#include <sys/syscall.h>
+#include <unistd.h>
+
+using namespace librealsense::platform;
+
+
+// A zero-copy frame references a V4L2 capture buffer through the mapping the backend made of it. Here, a memfd stands
+// in for the driver's buffer: the "frame" maps it just like the backend would, and the "driver" keeps a mapping of its
+// own through which it can see whether the frame still shares its memory.
+TEST_CASE( "frames released after stop keep their data", "[zero-copy]" )
+{
+    size_t const size = 3 * 4096 + 100;
+    int fd = int( syscall( SYS_memfd_create, "capture-buffer", 0 ) );
+    REQUIRE( fd >= 0 );
+    REQUIRE( ftruncate( fd, size ) == 0 );
+
+    auto driver = static_cast< uint8_t * >( mmap( nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 ) );
+    REQUIRE( driver != MAP_FAILED );
+    auto frame = static_cast< uint8_t * >( mmap( nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 ) );
+    REQUIRE( frame != MAP_FAILED );
+    for( size_t i = 0; i < size; ++i )
+        driver[i] = uint8_t( i * 7 );
+    CHECK( frame[size - 1] == uint8_t( ( size - 1 ) * 7 ) );
+
+    // The sensor closes while the frame is still held
+    REQUIRE( replace_with_private_copy( frame, size ) );
+
+    // Same address, same data...
+    bool same = true;
+    for( size_t i = 0; i < size; ++i )
+        same = same && frame[i] == uint8_t( i * 7 );
+    CHECK( same );
+
+    // ... but no longer the driver's memory
+    driver[0] = 0xAB;
+    driver[size - 1] = 0xCD;
+    CHECK( frame[0] == 0 );
+    CHECK( frame[size - 1] == uint8_t( ( size - 1 ) * 7 ) );
+
+    // Writing to the copy (it is private) does not reach the driver either
+    frame[1] = 0xEF;
+    CHECK( driver[1] == 7 );
+
+    // Finally, the frame is released
+    CHECK( munmap( frame, size ) == 0 );
+    CHECK( munmap( driver, size ) == 0 );
+    close( fd );
+}
+
+#endif
@@ -0,0 +1,128 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include <unit-tests/test.h>
+#include <src/small-heap.h>
+#include <src/frame-archive.h>
+
+#include <atomic>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace librealsense;
+
+
+TEST_CASE( "a slab is added whenever all objects are taken", "[slab-heap]" )
+{
+    slab_heap< int > heap( 70, 200 );  // slabs of more than one word of free bits; 3 slabs, rounded up
+    CHECK( heap.get_capacity() == 70 );
+
+    std::set< int * > taken;
+    for( int i = 0; i < 210; ++i )
+    {
+        auto p = heap.allocate();
+        REQUIRE( p );
+        CHECK( taken.insert( p ).second );
+        CHECK( heap.get_capacity() == 70 * ( i / 70 + 1 ) );
+    }
+    CHECK( heap.get_size() == 210 );
+    CHECK_FALSE( heap.allocate() );
+    CHECK( heap.get_size() == 210 );
+
+    // Slots freed in any slab are reused, without growing
+    auto first = *taken.begin();
+    auto last = *taken.rbegin();
+    heap.deallocate( first );
+    heap.deallocate( last );
+    std::set< int * > reused{ heap.allocate(), heap.allocate() };
+    CHECK( reused == std::set< int * >{ first, last } );
+    CHECK( heap.get_capacity() == 210 );
+
+    int other;
+    CHECK_THROWS_AS( heap.deallocate( &other ), invalid_value_exception );
+
+    for( auto p : taken )
+        heap.deallocate( p );
+    CHECK( heap.is_empty() );
+    CHECK( heap.get_capacity() == 210 );  // slabs are kept
+}
+
+
+TEST_CASE( "a stream's pool grows up to RS2_MAX_FRAME_POOL_SIZE", "[slab-heap]" )
+{
+    for( int slab_size : { 4, 32, 128, 1024, 5000 } )
+    {
+        CAPTURE( slab_size );
+        slab_heap< int > heap( slab_size, RS2_MAX_FRAME_POOL_SIZE );
+        int const slabs = ( RS2_MAX_FRAME_POOL_SIZE + slab_size - 1 ) / slab_size;
+
+        std::vector< int * > taken;
+        while( auto p = heap.allocate() )
+            taken.push_back( p );
+        CHECK( taken.size() == size_t( slabs * slab_size ) );
+        CHECK( heap.get_capacity() == slabs * slab_size );
+        CHECK( taken.size() >= size_t( RS2_MAX_FRAME_POOL_SIZE ) );
+
+        for( auto p : taken )
+            heap.deallocate( p );
+        CHECK( heap.is_empty() );
+    }
+}
+
+
+TEST_CASE( "objects are released while the heap grows", "[slab-heap]" )
+{
+    int const slab_size = 8;
+    slab_heap< int > heap( slab_size, 8 * slab_size );
+    std::atomic< int > collisions( 0 );
+
+    // Each thread holds a varying number of objects, so the total keeps crossing slab boundaries
+    std::vector< std::thread > threads;
+    for( int t = 1; t <= 6; ++t )
+        threads.emplace_back( [&, t]() {
+            std::vector< int * > held;
+            for( int round = 0; round < 3000; ++round )
+            {
+                int const want = ( round * t ) % 11;
+                while( (int)held.size() < want )
+                {
+                    auto p = heap.allocate();
+                    if( ! p )
+                        break;
+                    *p = t;
+                    held.push_back( p );
+                }
+                // Give back half, from the oldest, while others allocate
+                size_t const keep = held.size() / 2;
+                while( held.size() > keep )
+                {
+                    auto p = held.front();
+                    if( *p != t )
+                        ++collisions;
+                    heap.deallocate( p );
+                    held.erase( held.begin() );
+                }
+                std::this_thread::yield();
+            }
+            for( auto p : held )
+            {
+                if( *p != t )
+                    ++collisions;
+                heap.deallocate( p );
+            }
+        } );
+
+    // Meanwhile, wait for the heap to drain after it is stopped
+    std::this_thread::sleep_for( std::chrono::milliseconds( 50 ) );
+    heap.stop_allocation();
+    heap.wait_until_empty();
+    CHECK( heap.is_empty() );
+    CHECK_FALSE( heap.allocate() );
+
+    for( auto & t : threads )
+        t.join();
+    CHECK( collisions == 0 );
+    CHECK( heap.is_empty() );
+    CHECK( heap.get_capacity() <= 8 * slab_size );
+}
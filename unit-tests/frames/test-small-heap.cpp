@@ -0,0 +1,168 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include <unit-tests/test.h>
+#include <src/small-heap.h>
+
+#include <atomic>
+#include <chrono>
+#include <iterator>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace librealsense;
+
+
+namespace {
+
+
+// More than one word of free bits, the last one partial
+int const C = 100;
+
+
+}  // namespace
+
+
+TEST_CASE( "every slot is handed out once", "[small-heap]" )
+{
+    small_heap< int, C > heap;
+    std::set< int * > taken;
+    for( int i = 0; i < C; ++i )
+    {
+        auto p = heap.allocate();
+        REQUIRE( p );
+        CHECK( taken.insert( p ).second );
+    }
+    CHECK( heap.get_size() == C );
+    CHECK_FALSE( heap.allocate() );
+    CHECK( heap.get_size() == C );  // a failed allocation is not counted
+
+    // A slot given back in the second word is the one handed out next
+    auto p = *std::next( taken.begin(), 70 );
+    heap.deallocate( p );
+    CHECK( heap.allocate() == p );
+
+    int other;
+    CHECK_THROWS_AS( heap.deallocate( &other ), invalid_value_exception );
+
+    for( auto q : taken )
+        heap.deallocate( q );
+    CHECK( heap.is_empty() );
+}
+
+
+TEST_CASE( "concurrent allocations never share a slot", "[small-heap]" )
+{
+    small_heap< int, C > heap;
+    int const n_threads = 8;
+    int const per_thread = 20;  // together, more than there is room for
+    std::atomic< int > collisions( 0 );
+
+    std::vector< std::thread > threads;
+    for( int t = 1; t <= n_threads; ++t )
+        threads.emplace_back( [&, t]() {
+            std::vector< int * > held;
+            for( int round = 0; round < 2000; ++round )
+            {
+                while( (int)held.size() < per_thread )
+                {
+                    auto p = heap.allocate();
+                    if( ! p )
+                        break;  // full: the other threads hold the rest
+                    *p = t;  // a freed slot holds 0
+                    held.push_back( p );
+                }
+                std::this_thread::yield();
+                for( auto p : held )
+                {
+                    if( *p != t )
+                        ++collisions;
+                    heap.deallocate( p );
+                }
+                held.clear();
+            }
+        } );
+    for( auto & t : threads )
+        t.join();
+
+    CHECK( collisions == 0 );
+    CHECK( heap.is_empty() );
+}
+
+
+TEST_CASE( "wait_until_empty returns once everything is back", "[small-heap]" )
+{
+    for( int round = 0; round < 50; ++round )
+    {
+        small_heap< int, C > heap;
+        std::atomic< int > held( 0 );
+        std::atomic< bool > stopped( false ), drained( false ), allocated_after_drain( false );
+
+        std::vector< std::thread > threads;
+        for( int t = 0; t < 4; ++t )
+            threads.emplace_back( [&]() {
+                while( true )
+                {
+                    bool const was_drained = drained;
+                    auto p = heap.allocate();
+                    if( ! p )
+                    {
+                        if( stopped )
+                            return;
+                        continue;
+                    }
+                    if( was_drained )
+                        allocated_after_drain = true;
+                    ++held;
+                    std::this_thread::yield();
+                    --held;  // before the slot is back, so 'held' is never behind the heap
+                    heap.deallocate( p );
+                }
+            } );
+
+        std::this_thread::sleep_for( std::chrono::milliseconds( 5 ) );
+        heap.stop_allocation();
+        stopped = true;
+        heap.wait_until_empty();
+        drained = true;
+        CHECK( heap.is_empty() );
+        CHECK( held == 0 );
+
+        // Stopped for good: nothing more is allocated
+        CHECK_FALSE( heap.allocate() );
+        CHECK( heap.is_empty() );
+
+        for( auto & t : threads )
+            t.join();
+        CHECK_FALSE( allocated_after_drain );
+    }
+}
+
+
+TEST_CASE( "wait_until_empty wakes up on the last release", "[small-heap]" )
+{
+    small_heap< int, C > heap;
+    std::vector< int * > items;
+    for( int i = 0; i < 10; ++i )
+        items.push_back( heap.allocate() );
+
+    std::atomic< bool > emptied( false );
+    std::thread waiter( [&]() {
+        heap.wait_until_empty();
+        emptied = true;
+    } );
+
+    // Released from several threads at once; only the last one may wake the waiter
+    std::vector< std::thread > releasers;
+    for( int i = 0; i < 9; ++i )
+        releasers.emplace_back( [&, i]() { heap.deallocate( items[i] ); } );
+    for( auto & t : releasers )
+        t.join();
+    std::this_thread::sleep_for( std::chrono::milliseconds( 100 ) );
+    CHECK_FALSE( emptied );
+
+    heap.deallocate( items[9] );
+    waiter.join();
+    CHECK( emptied );
+}
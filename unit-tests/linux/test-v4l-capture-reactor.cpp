@@ -0,0 +1,261 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+//#test:donotrun:!linux
+
+#include <unit-tests/test.h>
+
+#ifdef __linux__
+
+//#cmake:add-file ../../src/linux/v4l-capture-reactor.cpp
+#include <src/linux/v4l-capture-reactor.h>
+#include <src/librealsense-exception.h>
+
+#include <rsutils/json.h>
+
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+using namespace librealsense::platform;
+using rsutils::json;
+using namespace std::chrono;
+
+
+namespace {
+
+
+// Stands in for a device's capture fds: a pipe becomes ready to read whenever a "frame" is written to it
+struct fake_device
+{
+    int fds[2];
+
+    fake_device() { REQUIRE( pipe( fds ) == 0 ); }
+    ~fake_device()
+    {
+        close( fds[0] );
+        close( fds[1] );
+    }
+
+    int fd() const { return fds[0]; }
+    void send() const { REQUIRE( write( fds[1], "x", 1 ) == 1 ); }
+    void receive() const
+    {
+        char c;
+        CHECK( read( fds[0], &c, 1 ) == 1 );
+    }
+};
+
+
+v4l_capture_reactor::settings with_threads( int threads )
+{
+    v4l_capture_reactor::settings s;
+    s.threads = threads;
+    return s;
+}
+
+
+// Waits for a condition that a handler makes true
+template< class Pred >
+bool wait_for( std::mutex & m, std::condition_variable & cv, Pred pred )
+{
+    std::unique_lock< std::mutex > lock( m );
+    return cv.wait_for( lock, seconds( 5 ), pred );
+}
+
+
+}  // namespace
+
+
+TEST_CASE( "settings", "[v4l-capture-reactor]" )
+{
+    auto s = v4l_capture_reactor::settings::from_json( json() );
+    CHECK( s.threads == 0 );
+    CHECK( s.priority == 0 );
+    CHECK( s.cpus.empty() );
+
+    s = v4l_capture_reactor::settings::from_json( json::parse( R"({"threads":2,"cpus":[0,3],"priority":10})" ) );
+    CHECK( s.threads == 2 );
+    CHECK( s.priority == 10 );
+    CHECK( s.cpus == std::vector< int >{ 0, 3 } );
+
+    for( auto bad : { R"(2)", R"({"threads":-1})", R"({"threads":"2"})", R"({"priority":100})",
+                      R"({"cpus":3})", R"({"cpus":[-1]})", R"({"cpus":["a"]})" } )
+    {
+        CAPTURE( bad );
+        CHECK_THROWS_AS( v4l_capture_reactor::settings::from_json( json::parse( bad ) ),
+                         librealsense::invalid_value_exception );
+    }
+}
+
+
+TEST_CASE( "ready fds are passed to the handler", "[v4l-capture-reactor]" )
+{
+    v4l_capture_reactor reactor( with_threads( 1 ) );
+    fake_device a, b;
+
+    std::mutex m;
+    std::condition_variable cv;
+    int calls = 0, a_ready = 0, b_ready = 0, n_ready = 0;
+    auto id = reactor.add( { a.fd(), b.fd() }, seconds( 5 ), [&]( fd_set & fds, int n )
+    {
+        std::lock_guard< std::mutex > lock( m );
+        ++calls;
+        n_ready = n;
+        if( FD_ISSET( a.fd(), &fds ) )
+        {
+            ++a_ready;
+            a.receive();
+        }
+        if( FD_ISSET( b.fd(), &fds ) )
+        {
+            ++b_ready;
+            b.receive();
+        }
+        cv.notify_all();
+        return true;
+    } );
+
+    b.send();
+    REQUIRE( wait_for( m, cv, [&] { return calls == 1; } ) );
+    CHECK( n_ready == 1 );
+    CHECK( a_ready == 0 );
+    CHECK( b_ready == 1 );
+
+    a.send();
+    REQUIRE( wait_for( m, cv, [&] { return calls == 2; } ) );
+    CHECK( a_ready == 1 );
+    CHECK( b_ready == 1 );
+
+    reactor.remove( id );
+    a.send();
+    std::this_thread::sleep_for( milliseconds( 100 ) );
+    CHECK( calls == 2 );
+}
+
+
+TEST_CASE( "the handler is called with nothing ready on timeout", "[v4l-capture-reactor]" )
+{
+    v4l_capture_reactor reactor( with_threads( 1 ) );
+    fake_device a;
+
+    std::mutex m;
+    std::condition_variable cv;
+    int timeouts = 0;
+    auto start = steady_clock::now();
+    auto id = reactor.add( { a.fd() }, milliseconds( 50 ), [&]( fd_set & fds, int n )
+    {
+        std::lock_guard< std::mutex > lock( m );
+        CHECK( n == 0 );
+        CHECK_FALSE( FD_ISSET( a.fd(), &fds ) );
+        ++timeouts;
+        cv.notify_all();
+        return true;
+    } );
+
+    // The timer is re-armed every time the handler is called
+    REQUIRE( wait_for( m, cv, [&] { return timeouts == 2; } ) );
+    CHECK( steady_clock::now() - start >= milliseconds( 100 ) );
+    reactor.remove( id );
+}
+
+
+TEST_CASE( "a handler that returns false is no longer called", "[v4l-capture-reactor]" )
+{
+    v4l_capture_reactor reactor( with_threads( 2 ) );
+    fake_device a;
+
+    std::atomic< int > calls( 0 );
+    auto id = reactor.add( { a.fd() }, seconds( 5 ), [&]( fd_set &, int )
+    {
+        ++calls;
+        return false;  // and leave the fd ready
+    } );
+
+    a.send();
+    std::this_thread::sleep_for( milliseconds( 200 ) );
+    CHECK( calls == 1 );
+    reactor.remove( id );
+}
+
+
+TEST_CASE( "devices are serviced in parallel, each by one thread at a time", "[v4l-capture-reactor]" )
+{
+    v4l_capture_reactor reactor( with_threads( 4 ) );
+    fake_device a, b;
+
+    // a's handler blocks until b's has been called: with a single thread, it would never return
+    std::mutex m;
+    std::condition_variable cv;
+    bool b_called = false;
+    std::atomic< int > a_running( 0 ), a_calls( 0 );
+    bool a_overlapped = false;
+    auto a_id = reactor.add( { a.fd() }, seconds( 5 ), [&]( fd_set &, int )
+    {
+        if( ++a_running > 1 )
+            a_overlapped = true;
+        a.receive();
+        if( ++a_calls == 1 )
+            CHECK( wait_for( m, cv, [&] { return b_called; } ) );
+        else
+            std::this_thread::sleep_for( milliseconds( 1 ) );
+        --a_running;
+        return true;
+    } );
+    auto b_id = reactor.add( { b.fd() }, seconds( 5 ), [&]( fd_set &, int )
+    {
+        b.receive();
+        std::lock_guard< std::mutex > lock( m );
+        b_called = true;
+        cv.notify_all();
+        return true;
+    } );
+
+    a.send();
+    while( ! a_running )
+        std::this_thread::yield();
+    b.send();
+    CHECK( wait_for( m, cv, [&] { return b_called; } ) );
+
+    // Frames keep arriving for a while there are idle threads, but never two a handlers at once
+    for( int i = 0; i < 50; ++i )
+        a.send();
+    auto deadline = steady_clock::now() + seconds( 5 );
+    while( a_calls < 51 && steady_clock::now() < deadline )
+        std::this_thread::sleep_for( milliseconds( 1 ) );
+    CHECK( a_calls >= 2 );
+    CHECK_FALSE( a_overlapped );
+
+    reactor.remove( a_id );
+    reactor.remove( b_id );
+}
+
+
+TEST_CASE( "remove waits for a running handler", "[v4l-capture-reactor]" )
+{
+    v4l_capture_reactor reactor( with_threads( 1 ) );
+    fake_device a;
+
+    std::atomic< bool > running( false ), done( false );
+    auto id = reactor.add( { a.fd() }, seconds( 5 ), [&]( fd_set &, int )
+    {
+        running = true;
+        std::this_thread::sleep_for( milliseconds( 200 ) );
+        a.receive();
+        done = true;
+        return true;
+    } );
+
+    a.send();
+    while( ! running )
+        std::this_thread::yield();
+    reactor.remove( id );
+    CHECK( done );
+}
+
+
+#endif  // __linux__
@@ -0,0 +1,120 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+//#test:donotrun:!linux
+
+// Needs the vivid (Virtual Video Test Driver) module, e.g. 'sudo modprobe vivid'; without it, nothing is checked
+
+#include <unit-tests/test.h>
+
+#ifdef __linux__
+
+#include <src/linux/backend-v4l2.h>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <linux/videodev2.h>
+
+#include <cstring>
+#include <memory>
+#include <string>
+
+using namespace librealsense::platform;
+
+
+namespace {
+
+
+// The first vivid device that captures video, or -1
+int open_vivid()
+{
+    for( int i = 0; i < 64; ++i )
+    {
+        std::string const path = "/dev/video" + std::to_string( i );
+        int fd = open( path.c_str(), O_RDWR | O_NONBLOCK );
+        if( fd < 0 )
+            continue;
+        v4l2_capability cap = {};
+        if( ioctl( fd, VIDIOC_QUERYCAP, &cap ) == 0
+            && std::string( reinterpret_cast< char const * >( cap.driver ) ) == "vivid"
+            && ( cap.device_caps & V4L2_CAP_VIDEO_CAPTURE ) && ( cap.device_caps & V4L2_CAP_STREAMING ) )
+            return fd;
+        close( fd );
+    }
+    return -1;
+}
+
+
+}  // namespace
+
+
+TEST_CASE( "capture buffers are exported on demand", "[zero-copy]" )
+{
+    int fd = open_vivid();
+    if( fd < 0 )
+    {
+        WARN( "no vivid video capture device" );
+        return;
+    }
+
+    v4l2_format fmt = {};
+    fmt.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    fmt.fmt.pix.width = 320;
+    fmt.fmt.pix.height = 240;
+    fmt.fmt.pix.pixelformat = V4L2_PIX_FMT_YUYV;
+    fmt.fmt.pix.field = V4L2_FIELD_NONE;
+    REQUIRE( ioctl( fd, VIDIOC_S_FMT, &fmt ) == 0 );
+
+    v4l2_requestbuffers req = {};
+    req.count = 2;
+    req.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    req.memory = V4L2_MEMORY_MMAP;
+    REQUIRE( ioctl( fd, VIDIOC_REQBUFS, &req ) == 0 );
+    REQUIRE( req.count >= 2 );
+    {
+        auto captured = std::make_shared< buffer >( fd, V4L2_BUF_TYPE_VIDEO_CAPTURE, true, 0 );
+        auto released = std::make_shared< buffer >( fd, V4L2_BUF_TYPE_VIDEO_CAPTURE, true, 1 );
+
+        // A frame into the first buffer
+        v4l2_buffer buf = {};
+        buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        buf.memory = V4L2_MEMORY_MMAP;
+        buf.index = 0;
+        REQUIRE( ioctl( fd, VIDIOC_QBUF, &buf ) == 0 );
+        int type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        REQUIRE( ioctl( fd, VIDIOC_STREAMON, &type ) == 0 );
+        pollfd p = { fd, POLLIN, 0 };
+        REQUIRE( poll( &p, 1, 5000 ) == 1 );
+        REQUIRE( ioctl( fd, VIDIOC_DQBUF, &buf ) == 0 );
+        REQUIRE( buf.bytesused > 0 );
+
+        // Once, then the same descriptor again
+        int dmabuf = captured->export_dmabuf();
+        REQUIRE( dmabuf >= 0 );
+        CHECK( captured->export_dmabuf() == dmabuf );
+
+        // The descriptor holds the pixels of the frame, as the mapping does
+        auto pixels = static_cast< uint8_t * >( mmap( nullptr, buf.bytesused, PROT_READ, MAP_SHARED, dmabuf, 0 ) );
+        REQUIRE( pixels != MAP_FAILED );
+        CHECK( std::memcmp( pixels, captured->get_frame_start(), buf.bytesused ) == 0 );
+        munmap( pixels, buf.bytesused );
+
+        REQUIRE( ioctl( fd, VIDIOC_STREAMOFF, &type ) == 0 );
+
+        // Once its stream is closed, a buffer that was not exported never is
+        released->release_mapping();
+        CHECK( released->export_dmabuf() == -1 );
+        captured->release_mapping();
+    }  // the buffers close their descriptors
+
+    req.count = 0;
+    CHECK( ioctl( fd, VIDIOC_REQBUFS, &req ) == 0 );
+    close( fd );
+}
+
+
+#endif  // __linux__
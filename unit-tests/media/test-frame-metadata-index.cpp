@@ -0,0 +1,259 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+//#cmake:dependencies realsense2 realsense-file
+
+// The metadata of played frames, and the accel and twist of played poses, are read through the reader's
+// frame_metadata_index, which walks the file forward with the frames and reopens itself when asked for an earlier time
+
+#include <unit-tests/test.h>
+#include <librealsense2/rs.hpp>
+#include <librealsense2/hpp/rs_internal.hpp>
+#include <src/media/ros/ros_reader.h>
+#include <src/core/pose-frame.h>
+#include <src/context.h>
+
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <thread>
+#include <vector>
+
+using namespace librealsense;
+using namespace librealsense::device_serializer;
+
+
+namespace {
+
+
+int const W = 16, H = 4;
+int const n_frames = 40;
+std::string const file = "frame-metadata-index.bag";
+std::string const file_without_accel = "frame-metadata-index-no-accel.bag";
+
+stream_identifier const depth_id = { 0, 0, RS2_STREAM_DEPTH, 0 };
+stream_identifier const pose_id = { 0, 1, RS2_STREAM_POSE, 0 };
+
+
+// Depth frames with metadata, and poses, both numbered from 1; each value is a function of the frame number
+void record()
+{
+    std::vector< std::vector< uint16_t > > pixels;  // the frames reference these
+    std::vector< rs2_software_pose_frame::pose_frame_info > poses;
+    rs2::software_device dev;
+    auto depth_sensor = dev.add_sensor( "Depth" );
+    rs2_intrinsics intrinsics = { W, H, W / 2.f, H / 2.f, 10.f, 10.f, RS2_DISTORTION_NONE, { 0, 0, 0, 0, 0 } };
+    auto depth_profile
+        = depth_sensor.add_video_stream( { RS2_STREAM_DEPTH, 0, 0, W, H, 30, 2, RS2_FORMAT_Z16, intrinsics } );
+    auto pose_sensor = dev.add_sensor( "Pose" );
+    auto pose_profile = pose_sensor.add_pose_stream( { RS2_STREAM_POSE, 0, 1, 200, RS2_FORMAT_6DOF } );
+
+    rs2::recorder recorder( file, dev );
+    auto sensors = recorder.query_sensors();
+    for( size_t i = 0; i < sensors.size(); ++i )
+    {
+        sensors[i].open( i ? pose_profile : depth_profile );
+        sensors[i].start( []( rs2::frame ) {} );
+    }
+    pixels.reserve( n_frames );
+    poses.reserve( n_frames );
+    for( int n = 1; n <= n_frames; ++n )
+    {
+        depth_sensor.set_metadata( RS2_FRAME_METADATA_ACTUAL_EXPOSURE, 100 + n );
+        depth_sensor.set_metadata( RS2_FRAME_METADATA_GAIN_LEVEL, 2 * n );
+        pixels.emplace_back( W * H, uint16_t( n ) );
+        depth_sensor.on_video_frame( { pixels.back().data(), []( void * ) {}, W * 2, 2, rs2_time_t( n ),
+                                       RS2_TIMESTAMP_DOMAIN_SYSTEM_TIME, n, depth_profile, 0.001f } );
+
+        rs2_software_pose_frame::pose_frame_info pose = {};
+        pose.rotation[3] = 1.f;
+        pose.velocity[0] = float( n );
+        pose.acceleration[1] = float( n );
+        pose.angular_velocity[2] = float( n );
+        pose.angular_acceleration[0] = float( -n );
+        poses.push_back( pose );
+        pose_sensor.on_pose_frame( { &poses.back(), []( void * ) {}, rs2_time_t( n ),
+                                     RS2_TIMESTAMP_DOMAIN_SYSTEM_TIME, n, pose_profile } );
+
+        std::this_thread::sleep_for( std::chrono::milliseconds( 3 ) );
+    }
+    for( auto & sensor : sensors )
+    {
+        sensor.stop();
+        sensor.close();
+    }
+}
+
+
+// Checks that a played frame carries what was recorded with it, and returns its number
+int check_frame( serialized_frame const & f )
+{
+    REQUIRE( f.frame );
+    int n = int( f.frame->get_frame_number() );
+    CAPTURE( n, f.stream_id );
+    if( f.stream_id == depth_id )
+    {
+        rs2_metadata_type exposure = 0, gain = 0;
+        CHECK( f.frame->find_metadata( RS2_FRAME_METADATA_ACTUAL_EXPOSURE, &exposure ) );
+        CHECK( exposure == 100 + n );
+        CHECK( f.frame->find_metadata( RS2_FRAME_METADATA_GAIN_LEVEL, &gain ) );
+        CHECK( gain == 2 * n );
+    }
+    else
+    {
+        REQUIRE( f.stream_id == pose_id );
+        auto pose = dynamic_cast< pose_frame * >( f.frame.frame );
+        REQUIRE( pose );
+        CHECK( pose->get_velocity().x == n );         // the twist
+        CHECK( pose->get_angular_velocity().z == n );
+        CHECK( pose->get_acceleration().y == n );     // the accel
+        CHECK( pose->get_angular_acceleration().x == -n );
+    }
+    return n;
+}
+
+
+struct played_frame
+{
+    nanoseconds time;
+    stream_identifier stream;
+    int number;
+};
+
+
+// Plays to the end of the file, checking each frame
+std::vector< played_frame > play( ros_reader & reader )
+{
+    std::vector< played_frame > frames;
+    while( true )
+    {
+        auto data = reader.read_next_data();
+        if( data->is< serialized_end_of_file >() )
+            return frames;
+        if( auto f = data->as< serialized_frame >() )
+            frames.push_back( { f->get_timestamp(), f->stream_id, check_frame( *f ) } );
+    }
+}
+
+
+std::shared_ptr< ros_reader > open_reader( std::string const & filename )
+{
+    auto reader = std::make_shared< ros_reader >( filename, context::make( rsutils::json::object() ) );
+    reader->enable_stream( { depth_id, pose_id } );
+    return reader;
+}
+
+
+// The first depth frame played after seeking halfway between two frames
+int seek_between( ros_reader & reader, std::vector< played_frame > const & depth, int i )
+{
+    reader.seek_to_time( ( depth[i - 1].time + depth[i].time ) / 2 );
+    auto played = play( reader );
+    for( auto & f : played )
+        if( f.stream == depth_id )
+            return f.number;
+    return 0;
+}
+
+
+}  // namespace
+
+
+TEST_CASE( "frames play with their own metadata, forward and after seeks", "[playback]" )
+{
+    record();
+    auto reader = open_reader( file );
+
+    auto played = play( *reader );
+    std::map< int, int > counts;  // per frame number
+    std::vector< played_frame > depth;
+    for( auto & f : played )
+    {
+        ++counts[f.number];
+        if( f.stream == depth_id )
+            depth.push_back( f );
+    }
+    REQUIRE( depth.size() == n_frames );
+    for( int n = 1; n <= n_frames; ++n )
+        CHECK( counts[n] == 2 );  // a depth frame and a pose
+
+    // Back from the end, forward, back to near the start, forward past where it was
+    for( int i : { 20, 30, 1, 35, 10, 11, 39 } )
+    {
+        CAPTURE( i );
+        CHECK( seek_between( *reader, depth, i ) == depth[i].number );
+    }
+
+    // The last frame before a time, as played when seeking while paused (poses are not)
+    for( int i : { 25, 5, 30 } )
+    {
+        CAPTURE( i );
+        auto last = reader->fetch_last_frames( depth[i].time );
+        REQUIRE( last.size() == 1 );
+        auto f = last.front()->as< serialized_frame >();
+        REQUIRE( f );
+        CHECK( f->stream_id == depth_id );
+        CHECK( check_frame( *f ) == depth[i].number );
+    }
+
+    reader = nullptr;
+    std::remove( file.c_str() );
+}
+
+
+TEST_CASE( "a pose without its accel does not play", "[playback]" )
+{
+    record();
+
+    // Copy the file, without the accel of the 10th pose
+    auto const accel_topic = ros_topic::pose_accel_topic( pose_id );
+    {
+        rosbag::Bag in, out;
+        in.open( file, rosbag::bagmode::Read );
+        out.open( file_without_accel, rosbag::bagmode::Write );
+        int accels = 0;
+        for( rosbag::MessageInstance const & m : rosbag::View( in ) )
+        {
+            if( m.getTopic() == accel_topic && ++accels == 10 )
+                continue;
+            out.write( m.getTopic(), m.getTime(), m, m.getConnectionHeader() );
+        }
+    }
+
+    auto reader = open_reader( file_without_accel );
+    int poses = 0;
+    bool missing = false;
+    try
+    {
+        while( true )
+        {
+            auto f = reader->read_next_data()->as< serialized_frame >();
+            REQUIRE( f );
+            if( check_frame( *f ) > 9 )
+                CHECK( f->stream_id == depth_id );
+            else if( f->stream_id == pose_id )
+                ++poses;
+        }
+    }
+    catch( io_exception const & )
+    {
+        missing = true;
+    }
+    CHECK( missing );
+    CHECK( poses == 9 );
+
+    // ... and the frames after it still play with theirs
+    int after = 0;
+    for( auto & f : play( *reader ) )
+    {
+        CHECK( f.number > 10 );
+        if( f.stream == pose_id )
+            ++after;
+    }
+    CHECK( after == n_frames - 10 );
+
+    reader = nullptr;
+    std::remove( file.c_str() );
+    std::remove( file_without_accel.c_str() );
+}
@@ -0,0 +1,127 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+//#cmake:dependencies realsense2 realsense-file
+
+// Recorded video frames are written as an image_view_msg, which must be indistinguishable in the file from the
+// sensor_msgs::Image that was written before it
+
+#include <unit-tests/test.h>
+#include <src/media/ros/ros_writer.h>
+#include <rosbag/view.h>
+
+#include <cstdio>
+#include <vector>
+
+using namespace librealsense;
+namespace ser = rs2rosinternal::serialization;
+
+
+namespace {
+
+
+// A frame as the writer fills it in; the pixels are not all the same, so any misplaced byte shows
+sensor_msgs::Image make_image( std::string const & version, uint32_t width, uint32_t height )
+{
+    sensor_msgs::Image image;
+    image.header.seq = 17;
+    image.header.stamp = rs2rosinternal::Time( 1234, 5678 );
+    image.header.version = version;
+    image.width = width;
+    image.height = height;
+    image.step = width * 2;
+    image.encoding = sensor_msgs::image_encodings::MONO16;
+    image.is_bigendian = 0;
+    image.depth_units = 0.001f;
+    image.data.resize( image.step * height );
+    for( size_t i = 0; i < image.data.size(); ++i )
+        image.data[i] = uint8_t( i * 7 + 3 );
+    return image;
+}
+
+
+// The same image, its data left in place
+image_view_msg make_view( sensor_msgs::Image const & image )
+{
+    image_view_msg view;
+    view.image = image;
+    view.image.data.clear();
+    view.data = image.data.data();
+    view.size = uint32_t( image.data.size() );
+    return view;
+}
+
+
+template< class T >
+std::vector< uint8_t > serialize( T const & msg )
+{
+    std::vector< uint8_t > bytes( ser::serializationLength( msg ) );
+    ser::OStream stream( bytes.data(), uint32_t( bytes.size() ) );
+    ser::serialize( stream, msg );
+    CHECK( stream.getLength() == 0 );  // filled exactly
+    return bytes;
+}
+
+
+std::vector< uint8_t > serialize( rosbag::MessageInstance const & m )
+{
+    std::vector< uint8_t > bytes( m.size() );
+    ser::OStream stream( bytes.data(), uint32_t( bytes.size() ) );
+    m.write( stream );
+    return bytes;
+}
+
+
+}  // namespace
+
+
+TEST_CASE( "an image view serializes as the image", "[record]" )
+{
+    // Version "1" adds the depth units; an empty frame has no data to copy
+    for( std::string version : { "1", "" } )
+    {
+        for( uint32_t width : { 16, 3, 0 } )
+        {
+            CAPTURE( version, width );
+            auto image = make_image( version, width, 4 );
+            auto view = make_view( image );
+            CHECK( ser::serializationLength( view ) == ser::serializationLength( image ) );
+            CHECK( serialize( view ) == serialize( image ) );
+        }
+    }
+}
+
+
+TEST_CASE( "an image view reads back from a bag as the image", "[record]" )
+{
+    std::string const file = "image-view-msg.bag";
+    auto image = make_image( "1", 16, 4 );
+    {
+        rosbag::Bag bag;
+        bag.open( file, rosbag::bagmode::Write );
+        bag.write( "/image", rs2rosinternal::Time( 1, 0 ), image );
+        bag.write( "/view", rs2rosinternal::Time( 2, 0 ), make_view( image ) );
+    }
+
+    rosbag::Bag bag;
+    bag.open( file, rosbag::bagmode::Read );
+    std::vector< std::vector< uint8_t > > written;
+    for( rosbag::MessageInstance const & m : rosbag::View( bag ) )
+    {
+        CAPTURE( m.getTopic() );
+        CHECK( m.getDataType() == rs2rosinternal::message_traits::DataType< sensor_msgs::Image >::value() );
+        CHECK( m.getMD5Sum() == rs2rosinternal::message_traits::MD5Sum< sensor_msgs::Image >::value() );
+        auto read = m.instantiate< sensor_msgs::Image >();
+        REQUIRE( read );
+        CHECK( read->data == image.data );
+        CHECK( read->depth_units == image.depth_units );
+        written.push_back( serialize( m ) );
+    }
+    REQUIRE( written.size() == 2 );
+    CHECK( written[1] == written[0] );
+    CHECK( written[0] == serialize( image ) );
+
+    bag.close();
+    std::remove( file.c_str() );
+}
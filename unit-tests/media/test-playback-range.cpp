@@ -0,0 +1,169 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include <unit-tests/test.h>
+#include <librealsense2/rs.hpp>
+#include <librealsense2/hpp/rs_internal.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace {
+
+
+int const W = 16, H = 4;
+int const n_frames = 60;
+std::string const file = "playback-range.bag";
+
+
+// Frames a few milliseconds apart, so each has its own time in the file
+void record()
+{
+    std::vector< std::vector< uint16_t > > pixels;  // the frames reference these
+    rs2::software_device dev;
+    auto sensor = dev.add_sensor( "Depth" );
+    rs2_intrinsics intrinsics = { W, H, W / 2.f, H / 2.f, 10.f, 10.f, RS2_DISTORTION_NONE, { 0, 0, 0, 0, 0 } };
+    auto profile = sensor.add_video_stream( { RS2_STREAM_DEPTH, 0, 0, W, H, 30, 2, RS2_FORMAT_Z16, intrinsics } );
+
+    rs2::recorder recorder( file, dev );
+    rs2::sensor rec_sensor = recorder.query_sensors()[0];
+    rec_sensor.open( profile );
+    rec_sensor.start( []( rs2::frame ) {} );
+    pixels.reserve( n_frames );
+    for( int i = 0; i < n_frames; ++i )
+    {
+        pixels.emplace_back( W * H, uint16_t( i ) );
+        sensor.on_video_frame( { pixels.back().data(), []( void * ) {}, W * 2, 2, rs2_time_t( i ),
+                                 RS2_TIMESTAMP_DOMAIN_SYSTEM_TIME, i + 1, profile, 0.001f } );
+        std::this_thread::sleep_for( std::chrono::milliseconds( 3 ) );
+    }
+    rec_sensor.stop();
+    rec_sensor.close();
+}
+
+
+// Plays the file to its end (or the end of its range) as fast as the callback allows, and keeps the frame numbers
+class player
+{
+    rs2::context _ctx;  // a file can be loaded once per context
+    rs2::playback _playback;
+    rs2::sensor _sensor;
+    std::mutex _m;
+    std::condition_variable _cv;
+    bool _stopped = false;
+
+public:
+    std::vector< unsigned long long > numbers;
+
+    player()
+        : _playback( _ctx.load_device( file ).as< rs2::playback >() )
+        , _sensor( _playback.query_sensors()[0] )
+    {
+        _playback.set_real_time( false );
+        _playback.set_status_changed_callback(
+            [this]( rs2_playback_status status )
+            {
+                std::lock_guard< std::mutex > lock( _m );
+                if( status == RS2_PLAYBACK_STATUS_STOPPED && ! numbers.empty() )
+                {
+                    _stopped = true;
+                    _cv.notify_one();
+                }
+            } );
+    }
+
+    rs2::playback const & playback() const { return _playback; }
+
+    void start( std::chrono::milliseconds callback_time = std::chrono::milliseconds( 0 ) )
+    {
+        _sensor.open( _sensor.get_stream_profiles()[0] );
+        _sensor.start(
+            [this, callback_time]( rs2::frame f )
+            {
+                {
+                    std::lock_guard< std::mutex > lock( _m );
+                    numbers.push_back( f.get_frame_number() );
+                }
+                std::this_thread::sleep_for( callback_time );
+            } );
+    }
+
+    void wait()
+    {
+        {
+            std::unique_lock< std::mutex > lock( _m );
+            _cv.wait_for( lock, std::chrono::seconds( 10 ), [&]() { return _stopped; } );
+        }
+        _sensor.stop();
+        _sensor.close();
+    }
+};
+
+
+void check_all_in_order( std::vector< unsigned long long > const & numbers )
+{
+    REQUIRE( numbers.size() == n_frames );
+    for( int i = 0; i < n_frames; ++i )
+        CHECK( numbers[i] == i + 1 );
+}
+
+
+}  // namespace
+
+
+TEST_CASE( "consecutive ranges play every frame once", "[playback]" )
+{
+    record();
+
+    for( int k : { 2, 3, 5 } )
+    {
+        CAPTURE( k );
+        std::vector< std::unique_ptr< player > > players;
+        for( int i = 0; i < k; ++i )
+            players.emplace_back( new player );
+
+        // [0, d/k), [d/k, 2d/k), ... [(k-1)d/k, end of file)
+        auto duration = players[0]->playback().get_duration();
+        for( int i = 0; i < k; ++i )
+            players[i]->playback().set_range( duration * i / k,
+                                              i + 1 < k ? duration * ( i + 1 ) / k : std::chrono::nanoseconds( 0 ) );
+
+        // All at once, each with its own reader
+        for( auto & p : players )
+            p->start();
+        std::vector< unsigned long long > numbers;
+        for( auto & p : players )
+        {
+            p->wait();
+            CHECK( ! p->numbers.empty() );
+            numbers.insert( numbers.end(), p->numbers.begin(), p->numbers.end() );
+        }
+        check_all_in_order( numbers );
+    }
+
+    std::remove( file.c_str() );
+}
+
+
+TEST_CASE( "read-ahead drops nothing for a slow callback", "[playback]" )
+{
+    record();
+
+    for( unsigned read_ahead : { 0, 1, 8, 100 } )
+    {
+        CAPTURE( read_ahead );
+        player p;
+        p.playback().set_read_ahead( read_ahead );
+        p.start( std::chrono::milliseconds( 2 ) );
+        p.wait();
+        check_all_in_order( p.numbers );
+    }
+
+    std::remove( file.c_str() );
+}
@@ -0,0 +1,79 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include <unit-tests/test.h>
+#include <librealsense2/rs.hpp>
+#include <librealsense2/hpp/rs_internal.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <vector>
+
+
+namespace {
+
+
+int const W = 16, H = 4;
+
+
+}  // namespace
+
+
+TEST_CASE( "a burst of frames is recorded in full", "[record-device]" )
+{
+    // Faster than the writer can keep up with, so frames queue behind the one being written
+    int const n_frames = 500;
+    std::string const file = "record-device.bag";
+
+    std::vector< std::vector< uint16_t > > pixels;  // the frames reference these
+    {
+        rs2::software_device dev;
+        auto sensor = dev.add_sensor( "Depth" );
+        rs2_intrinsics intrinsics = { W, H, W / 2.f, H / 2.f, 10.f, 10.f, RS2_DISTORTION_NONE, { 0, 0, 0, 0, 0 } };
+        auto profile = sensor.add_video_stream( { RS2_STREAM_DEPTH, 0, 0, W, H, 30, 2, RS2_FORMAT_Z16, intrinsics } );
+
+        rs2::recorder recorder( file, dev );
+        rs2::sensor rec_sensor = recorder.query_sensors()[0];
+        rec_sensor.open( profile );
+        rec_sensor.start( []( rs2::frame ) {} );
+        for( int i = 0; i < n_frames; ++i )
+        {
+            pixels.emplace_back( W * H, uint16_t( i ) );
+            sensor.on_video_frame( { pixels.back().data(), []( void * ) {}, W * 2, 2, rs2_time_t( i ),
+                                     RS2_TIMESTAMP_DOMAIN_SYSTEM_TIME, i + 1, profile, 0.001f } );
+        }
+        rec_sensor.stop();
+        rec_sensor.close();
+    }  // the recorder writes whatever is still queued before it closes the file
+
+    std::vector< unsigned long long > numbers;
+    {
+        rs2::context ctx;
+        auto playback = ctx.load_device( file ).as< rs2::playback >();
+        playback.set_real_time( false );
+        auto sensor = playback.query_sensors()[0];
+        std::mutex m;
+        std::condition_variable cv;
+        sensor.open( sensor.get_stream_profiles()[0] );
+        sensor.start( [&]( rs2::frame f )
+        {
+            std::lock_guard< std::mutex > lock( m );
+            numbers.push_back( f.get_frame_number() );
+            cv.notify_one();
+        } );
+        {
+            std::unique_lock< std::mutex > lock( m );
+            cv.wait_for( lock, std::chrono::seconds( 10 ),
+                         [&]() { return ! numbers.empty() && numbers.back() == n_frames; } );
+        }
+        sensor.stop();
+        sensor.close();
+    }
+    std::remove( file.c_str() );
+
+    REQUIRE( numbers.size() == n_frames );
+    for( int i = 0; i < n_frames; ++i )
+        CHECK( numbers[i] == i + 1 );
+}
@@ -0,0 +1,205 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+
+#include <unit-tests/test.h>
+#include <src/media/record/record_queue.h>
+#include <src/frame.h>
+#include <src/stream.h>
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <thread>
+
+using namespace librealsense;
+
+
+namespace {
+
+
+// Frames of given sizes and streams, kept alive for as long as the queue may hold them
+class frame_source
+{
+    std::deque< frame > _frames;
+
+public:
+    record_queue::item make( size_t size, rs2_stream stream = RS2_STREAM_DEPTH, int index = 0 )
+    {
+        auto profile = std::make_shared< video_stream_profile >();
+        profile->set_stream_type( stream );
+        profile->set_stream_index( index );
+
+        _frames.emplace_back();
+        auto & f = _frames.back();
+        f.data.resize( size );
+        f.additional_data.frame_number = _frames.size();
+        f.set_stream( profile );
+
+        record_queue::item item;
+        item.frame = frame_holder::acquire( &f );
+        return item;
+    }
+};
+
+
+unsigned long long number_of( record_queue::item const & item )
+{
+    return item.frame->get_frame_number();
+}
+
+
+}  // namespace
+
+
+TEST_CASE( "queued bytes are accounted for", "[record-queue]" )
+{
+    frame_source frames;
+    record_queue q( 1000, RS2_RECORD_DROP_POLICY_DROP_NEWEST );
+
+    CHECK( q.push( frames.make( 400 ) ) );
+    CHECK( q.push( frames.make( 600 ) ) );  // exactly at the limit
+    auto stats = q.get_stats();
+    CHECK( stats.queued_bytes == 1000 );
+    CHECK( stats.queued_frames == 2 );
+
+    // Dropped: the arriving frame, counted for its own stream
+    CHECK_FALSE( q.push( frames.make( 1, RS2_STREAM_COLOR ) ) );
+    stats = q.get_stats();
+    CHECK( stats.queued_bytes == 1000 );
+    CHECK( stats.dropped_frames == 1 );
+    CHECK( q.get_dropped_frames( RS2_STREAM_COLOR, 0 ) == 1 );
+    CHECK( q.get_dropped_frames( RS2_STREAM_DEPTH, 0 ) == 0 );
+
+    record_queue::item item;
+    REQUIRE( q.pop( item ) );
+    CHECK( number_of( item ) == 1 );
+    q.on_written( item );
+    stats = q.get_stats();
+    CHECK( stats.queued_bytes == 600 );
+    CHECK( stats.queued_frames == 1 );
+    CHECK( stats.peak_queued_bytes == 1000 );
+    CHECK( stats.written_frames == 1 );
+
+    REQUIRE( q.pop( item ) );
+    CHECK( number_of( item ) == 2 );
+    CHECK_FALSE( q.pop( item ) );
+    CHECK( q.get_stats().queued_bytes == 0 );
+
+    // An empty queue takes any frame, however large
+    CHECK( q.push( frames.make( 5000 ) ) );
+    CHECK( q.get_stats().queued_bytes == 5000 );
+    CHECK( q.get_stats().peak_queued_bytes == 5000 );
+}
+
+
+TEST_CASE( "the oldest frames make room for new ones", "[record-queue]" )
+{
+    frame_source frames;
+    record_queue q( 1000, RS2_RECORD_DROP_POLICY_DROP_OLDEST );
+
+    for( int i = 0; i < 4; ++i )
+        CHECK( q.push( frames.make( 300 ) ) );  // frames 1-3 fit, 4 pushes out 1
+    CHECK( q.push( frames.make( 500 ) ) );      // pushes out 2 and 3
+
+    auto stats = q.get_stats();
+    CHECK( stats.queued_bytes == 800 );
+    CHECK( stats.dropped_frames == 3 );
+
+    record_queue::item item;
+    REQUIRE( q.pop( item ) );
+    CHECK( number_of( item ) == 4 );
+    REQUIRE( q.pop( item ) );
+    CHECK( number_of( item ) == 5 );
+}
+
+
+TEST_CASE( "the lowest-priority streams are dropped first", "[record-queue]" )
+{
+    frame_source frames;
+    record_queue q( 1000, RS2_RECORD_DROP_POLICY_DROP_LOWEST_PRIORITY );
+    q.set_stream_priority( RS2_STREAM_DEPTH, 2 );
+    q.set_stream_priority( RS2_STREAM_INFRARED, -1 );
+    // Color stays at the default priority, 0
+
+    CHECK( q.push( frames.make( 300, RS2_STREAM_DEPTH ) ) );     // 1
+    CHECK( q.push( frames.make( 300, RS2_STREAM_COLOR ) ) );     // 2
+    CHECK( q.push( frames.make( 200, RS2_STREAM_INFRARED, 1 ) ) ); // 3
+    CHECK( q.push( frames.make( 200, RS2_STREAM_INFRARED, 2 ) ) ); // 4
+
+    // Room for a depth frame is made from the infrared frames, oldest first
+    CHECK( q.push( frames.make( 300, RS2_STREAM_DEPTH ) ) );     // 5, drops 3 and 4
+    CHECK( q.get_dropped_frames( RS2_STREAM_INFRARED, 1 ) == 1 );
+    CHECK( q.get_dropped_frames( RS2_STREAM_INFRARED, 2 ) == 1 );
+    CHECK( q.get_stats().queued_bytes == 900 );
+
+    // Then from color, before any depth frame
+    CHECK( q.push( frames.make( 400, RS2_STREAM_DEPTH ) ) );     // 6, drops 2
+    CHECK( q.get_dropped_frames( RS2_STREAM_COLOR, 0 ) == 1 );
+    CHECK( q.get_dropped_frames( RS2_STREAM_DEPTH, 0 ) == 0 );
+
+    // A frame of a lower priority than everything queued is the one dropped
+    CHECK_FALSE( q.push( frames.make( 100, RS2_STREAM_COLOR ) ) );
+    CHECK( q.get_dropped_frames( RS2_STREAM_COLOR, 0 ) == 2 );
+
+    // Among equals, the oldest goes
+    CHECK( q.push( frames.make( 300, RS2_STREAM_DEPTH ) ) );     // 8, drops 1
+    CHECK( q.get_stats().dropped_frames == 5 );
+
+    record_queue::item item;
+    for( unsigned long long expected : { 5, 6, 8 } )
+    {
+        REQUIRE( q.pop( item ) );
+        CHECK( number_of( item ) == expected );
+    }
+    CHECK_FALSE( q.pop( item ) );
+}
+
+
+TEST_CASE( "a blocked sensor wakes up when a frame is popped", "[record-queue]" )
+{
+    frame_source frames;
+    record_queue q( 1000, RS2_RECORD_DROP_POLICY_BLOCK );
+    REQUIRE( q.push( frames.make( 800 ) ) );
+
+    auto arriving = frames.make( 800 );
+    std::atomic< bool > pushed( false ), accepted( false );
+    std::thread sensor( [&]()
+    {
+        accepted = q.push( std::move( arriving ) );
+        pushed = true;
+    } );
+
+    std::this_thread::sleep_for( std::chrono::milliseconds( 200 ) );
+    CHECK_FALSE( pushed );
+
+    record_queue::item item;
+    REQUIRE( q.pop( item ) );
+    sensor.join();
+    CHECK( pushed );
+    CHECK( accepted );
+    CHECK( q.get_stats().queued_bytes == 800 );
+    CHECK( q.get_stats().dropped_frames == 0 );
+}
+
+
+TEST_CASE( "a blocked sensor is released by stop", "[record-queue]" )
+{
+    frame_source frames;
+    record_queue q( 1000, RS2_RECORD_DROP_POLICY_BLOCK );
+    REQUIRE( q.push( frames.make( 800 ) ) );
+
+    auto arriving = frames.make( 800 );
+    std::atomic< bool > accepted( true );
+    std::thread sensor( [&]() { accepted = q.push( std::move( arriving ) ); } );
+
+    std::this_thread::sleep_for( std::chrono::milliseconds( 100 ) );
+    q.stop();
+    sensor.join();
+    CHECK_FALSE( accepted );
+    CHECK( q.get_stats().dropped_frames == 1 );
+
+    // From now on, frames that do not fit are dropped right away
+    CHECK_FALSE( q.push( frames.make( 800 ) ) );
+}
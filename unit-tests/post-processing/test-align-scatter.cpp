@@ -0,0 +1,118 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+//#cmake:add-file ../../src/proc/align-scatter.cpp
+//#cmake:add-file ../../src/proc/parallel-pool.cpp
+
+#include <unit-tests/test.h>
+#include <src/proc/align-scatter.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace librealsense;
+
+
+// The original, serial image_transform::move_depth_to_other(), as the reference
+static void reference_scatter( depth_pixel_map const & map, uint16_t * dest, int dest_width, int dest_height )
+{
+    for (int y = 0; y < map.height; ++y)
+    {
+        for (int x = 0; x < map.width; ++x)
+        {
+            auto depth_pixel_index = y * map.width + x;
+            if (map.z_pixels[depth_pixel_index])
+            {
+                for (int other_y = map.top_left[depth_pixel_index].y; other_y <= map.bottom_right[depth_pixel_index].y; ++other_y)
+                {
+                    for (int other_x = map.top_left[depth_pixel_index].x; other_x <= map.bottom_right[depth_pixel_index].x; ++other_x)
+                    {
+                        if (other_x < 0 || other_y < 0 || other_x >= dest_width || other_y >= dest_height)
+                            continue;
+                        auto other_ind = other_y * dest_width + other_x;
+
+                        dest[other_ind] = dest[other_ind] ? std::min(dest[other_ind], map.z_pixels[depth_pixel_index]) : map.z_pixels[depth_pixel_index];
+                    }
+                }
+            }
+        }
+    }
+}
+
+
+namespace {
+
+// A depth image mapped (roughly) onto a larger image, with holes, overlaps, and pixels that fall outside of it
+struct test_map
+{
+    int width, height;
+    std::vector< uint16_t > z;
+    std::vector< int2 > top_left, bottom_right;
+
+    test_map( int w, int h, int dest_width, int dest_height, unsigned seed )
+        : width( w ), height( h ), z( w * h ), top_left( w * h ), bottom_right( w * h )
+    {
+        std::mt19937 gen( seed );
+        std::uniform_int_distribution< int > depth( 0, 4000 );
+        std::uniform_int_distribution< int > jitter( -6, 6 );
+        std::uniform_int_distribution< int > size( -1, 2 );
+        for( int y = 0, i = 0; y < h; ++y )
+            for( int x = 0; x < w; ++x, ++i )
+            {
+                z[i] = depth( gen ) < 400 ? 0 : uint16_t( depth( gen ) );
+                top_left[i] = { x * dest_width / w + jitter( gen ), y * dest_height / h + jitter( gen ) };
+                bottom_right[i] = { top_left[i].x + size( gen ), top_left[i].y + size( gen ) };
+            }
+    }
+
+    depth_pixel_map map() const { return { z.data(), width, height, top_left.data(), bottom_right.data() }; }
+};
+
+}  // namespace
+
+
+TEST_CASE( "scatter_min_depth matches the serial scatter", "[align]" )
+{
+    parallel_pool pool( 3 );
+    struct { int w, h, dest_w, dest_h; } sizes[] = {
+        { 64, 48, 128, 72 },
+        { 848, 480, 1280, 720 },
+        { 640, 480, 320, 180 },
+        { 7, 5, 13, 3 },
+    };
+    unsigned seed = 0;
+    for( auto & s : sizes )
+    {
+        test_map m( s.w, s.h, s.dest_w, s.dest_h, ++seed );
+        std::vector< uint16_t > expected( s.dest_w * s.dest_h, 0 ), actual( s.dest_w * s.dest_h, 0 );
+        reference_scatter( m.map(), expected.data(), s.dest_w, s.dest_h );
+        scatter_min_depth( pool, m.map(), actual.data(), s.dest_w, s.dest_h );
+        CAPTURE( s.w, s.h, s.dest_w, s.dest_h );
+        CHECK( actual == expected );
+    }
+}
+
+
+TEST_CASE( "scatter_min_depth benchmark", "[.][benchmark]" )
+{
+    test_map m( 848, 480, 1280, 720, 1 );
+    std::vector< uint16_t > dest( 1280 * 720 );
+
+    BENCHMARK_ADVANCED( "serial" )( Catch::Benchmark::Chronometer meter )
+    {
+        meter.measure( [&] {
+            std::fill( dest.begin(), dest.end(), 0 );
+            reference_scatter( m.map(), dest.data(), 1280, 720 );
+        } );
+    };
+
+    auto pool = parallel_pool::get();
+    BENCHMARK_ADVANCED( "parallel" )( Catch::Benchmark::Chronometer meter )
+    {
+        meter.measure( [&] {
+            std::fill( dest.begin(), dest.end(), 0 );
+            scatter_min_depth( *pool, m.map(), dest.data(), 1280, 720 );
+        } );
+    };
+}
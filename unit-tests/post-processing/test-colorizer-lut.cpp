@@ -0,0 +1,166 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include <unit-tests/test.h>
+#include <librealsense2/hpp/rs_processing.hpp>
+#include <src/proc/synthetic-stream.h>
+#include <src/proc/colorizer.h>
+
+#include <random>
+#include <vector>
+
+using namespace librealsense;
+
+
+namespace {
+
+
+// Gives access to the Z16 color table, and to the per-pixel coloring that preceded it as the reference
+class colorizer_under_test : public colorizer
+{
+public:
+    void configure( int map_index, bool equalize, float min, float max, float depth_units )
+    {
+        _map_index = map_index;
+        _equalize = equalize;
+        _min = min;
+        _max = max;
+        _depth_units = depth_units;
+    }
+
+    int n_maps() const { return int( _maps.size() ); }
+
+    std::vector< uint8_t > colorize( std::vector< uint16_t > const & depth, int w, int h )
+    {
+        std::vector< uint8_t > rgb( depth.size() * 3, 0xAA );
+        update_z16_lut( depth.data(), w, h );
+        colorize_z16( depth.data(), rgb.data(), depth.size(), _z16_lut.data() );
+        return rgb;
+    }
+
+    // What process_frame() did for Z16 frames before the table
+    std::vector< uint8_t > reference( std::vector< uint16_t > const & depth, int w, int h )
+    {
+        std::vector< uint8_t > rgb( depth.size() * 3, 0xAA );
+        if( _equalize )
+        {
+            auto coloring_function = [&, this]( float data ) {
+                auto hist_data = _hist_data[(int)data];
+                auto pixels = (float)_hist_data[MAX_DEPTH - 1];
+                return ( hist_data / pixels );
+            };
+            update_histogram( _hist_data, depth.data(), w, h );
+            make_rgb_data< uint16_t >( depth.data(), rgb.data(), w, h, coloring_function );
+        }
+        else
+        {
+            auto min = _min;
+            auto max = _max;
+            auto coloring_function = [&, this]( float data ) {
+                if( min >= max )
+                    return 0.f;
+                return ( data * _depth_units - min ) / ( max - min );
+            };
+            make_rgb_data< uint16_t >( depth.data(), rgb.data(), w, h, coloring_function );
+        }
+        return rgb;
+    }
+};
+
+
+// Odd-sized, with holes, and mostly within a few meters like a real scene, with some far values
+std::vector< uint16_t > random_depth( std::mt19937 & gen, int w, int h )
+{
+    std::uniform_int_distribution< int > near( 200, 8000 );
+    std::uniform_int_distribution< int > any( 1, 0xFFFF );
+    std::uniform_int_distribution< int > kind( 0, 9 );
+    std::vector< uint16_t > depth( size_t( w ) * h );
+    for( auto & d : depth )
+    {
+        auto k = kind( gen );
+        d = uint16_t( k == 0 ? 0 : k == 1 ? any( gen ) : near( gen ) );
+    }
+    return depth;
+}
+
+
+}  // namespace
+
+
+TEST_CASE( "Z16 colors match the per-pixel computation", "[colorizer]" )
+{
+    int const w = 173, h = 31;  // w * h is not a multiple of 4
+    std::mt19937 gen( 1234 );
+    auto depth = random_depth( gen, w, h );
+
+    colorizer_under_test tested, reference;
+    for( int map_index = 0; map_index < tested.n_maps(); ++map_index )
+    {
+        for( bool equalize : { true, false } )
+        {
+            CAPTURE( map_index, equalize );
+            tested.configure( map_index, equalize, 0.3f, 4.f, 0.001f );
+            reference.configure( map_index, equalize, 0.3f, 4.f, 0.001f );
+            CHECK( tested.colorize( depth, w, h ) == reference.reference( depth, w, h ) );
+        }
+    }
+}
+
+
+TEST_CASE( "Z16 colors follow range and unit changes", "[colorizer]" )
+{
+    int const w = 64, h = 48;
+    std::mt19937 gen( 5678 );
+    auto depth = random_depth( gen, w, h );
+
+    struct
+    {
+        float min, max, depth_units;
+    } const ranges[] = {
+        { 0.f, 6.f, 0.001f },
+        { 0.3f, 1.5f, 0.001f },
+        { 1.f, 16.f, 0.001f },
+        { 1.f, 16.f, 0.0001f },
+        { 2.f, 2.f, 0.001f },  // empty range
+        { 3.f, 1.f, 0.001f },  // inverted range
+        { 0.f, 6.f, 0.001f },  // back to the first
+    };
+
+    // The same colorizer throughout, so a table that is not rebuilt when it should be is caught
+    colorizer_under_test tested, reference;
+    for( int map_index : { 0, 1, 7 } )
+    {
+        for( auto & r : ranges )
+        {
+            CAPTURE( map_index, r.min, r.max, r.depth_units );
+            tested.configure( map_index, false, r.min, r.max, r.depth_units );
+            reference.configure( map_index, false, r.min, r.max, r.depth_units );
+            CHECK( tested.colorize( depth, w, h ) == reference.reference( depth, w, h ) );
+        }
+    }
+}
+
+
+TEST_CASE( "Z16 equalized colors follow each frame", "[colorizer]" )
+{
+    int const w = 64, h = 48;
+    std::mt19937 gen( 9012 );
+
+    colorizer_under_test tested, reference;
+    tested.configure( 0, true, 0.f, 6.f, 0.001f );
+    reference.configure( 0, true, 0.f, 6.f, 0.001f );
+    for( int i = 0; i < 5; ++i )
+    {
+        CAPTURE( i );
+        auto depth = random_depth( gen, w, h );
+        CHECK( tested.colorize( depth, w, h ) == reference.reference( depth, w, h ) );
+    }
+
+    // Nothing but holes
+    std::vector< uint16_t > empty( size_t( w ) * h, 0 );
+    CHECK( tested.colorize( empty, w, h ) == reference.reference( empty, w, h ) );
+
+    // A single depth value
+    std::vector< uint16_t > flat( size_t( w ) * h, 1000 );
+    CHECK( tested.colorize( flat, w, h ) == reference.reference( flat, w, h ) );
+}
@@ -0,0 +1,410 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+//#cmake:add-file ../../src/proc/decimation-kernels.cpp
+//#cmake:add-file ../../src/proc/parallel-pool.cpp
+
+#include <unit-tests/test.h>
+#include <src/proc/decimation-kernels.h>
+#include <src/proc/parallel-pool.h>
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace librealsense;
+
+
+// The median networks of the original decimation_filter
+#define PIX_SORT(a,b) { if ((a)>(b)) PIX_SWAP((a),(b)); }
+#define PIX_SWAP(a,b) { pixelvalue temp=(a);(a)=(b);(b)=temp; }
+#define PIX_MIN(a,b) ((a)>(b)) ? (b) : (a)
+#define PIX_MAX(a,b) ((a)>(b)) ? (a) : (b)
+
+template <class pixelvalue>
+inline pixelvalue opt_med3(pixelvalue * p)
+{
+    PIX_SORT(p[0], p[1]);
+    PIX_SORT(p[1], p[2]);
+    PIX_SORT(p[0], p[1]);
+    return p[1];
+}
+
+template <class pixelvalue>
+inline pixelvalue opt_med4(pixelvalue * p)
+{
+    PIX_SORT(p[0], p[1]);
+    PIX_SORT(p[2], p[3]);
+    PIX_SORT(p[0], p[2]);
+    PIX_SORT(p[1], p[3]);
+    return PIX_MIN(p[1], p[2]);
+}
+
+template <class pixelvalue>
+inline pixelvalue opt_med5(pixelvalue * p)
+{
+    PIX_SORT(p[0], p[1]);
+    PIX_SORT(p[3], p[4]);
+    p[3] = PIX_MAX(p[0], p[3]);
+    p[1] = PIX_MIN(p[1], p[4]);
+    PIX_SORT(p[1], p[2]);
+    p[2] = PIX_MIN(p[2], p[3]);
+    return PIX_MAX(p[1], p[2]);
+}
+
+template <class pixelvalue>
+inline pixelvalue opt_med6(pixelvalue * p)
+{
+    PIX_SORT(p[1], p[2]);
+    PIX_SORT(p[3], p[4]);
+    PIX_SORT(p[0], p[1]);
+    PIX_SORT(p[2], p[3]);
+    PIX_SORT(p[4], p[5]);
+    PIX_SORT(p[1], p[2]);
+    PIX_SORT(p[3], p[4]);
+    PIX_SORT(p[0], p[1]);
+    PIX_SORT(p[2], p[3]);
+    p[4] = PIX_MIN(p[4], p[5]);
+    p[2] = PIX_MAX(p[1], p[2]);
+    p[3] = PIX_MIN(p[3], p[4]);
+    return PIX_MIN(p[2], p[3]);
+}
+
+template <class pixelvalue>
+inline pixelvalue opt_med7(pixelvalue * p)
+{
+    PIX_SORT(p[0], p[5]);
+    PIX_SORT(p[0], p[3]);
+    PIX_SORT(p[1], p[6]);
+    PIX_SORT(p[2], p[4]);
+    PIX_SORT(p[0], p[1]);
+    PIX_SORT(p[3], p[5]);
+    PIX_SORT(p[2], p[6]);
+    p[3] = PIX_MAX(p[2], p[3]);
+    p[3] = PIX_MIN(p[3], p[6]);
+    p[4] = PIX_MIN(p[4], p[5]);
+    PIX_SORT(p[1], p[4]);
+    p[3] = PIX_MAX(p[1], p[3]);
+    return PIX_MIN(p[3], p[4]);
+}
+
+template <class pixelvalue>
+inline pixelvalue opt_med8(pixelvalue * p)
+{
+    PIX_SORT(p[0], p[1]);
+    PIX_SORT(p[3], p[4]);
+    PIX_SORT(p[6], p[7]);
+    PIX_SORT(p[2], p[3]);
+    PIX_SORT(p[5], p[6]);
+    PIX_SORT(p[3], p[4]);
+    PIX_SORT(p[6], p[7]);
+    p[4] = PIX_MIN(p[4], p[7]);
+    PIX_SORT(p[3], p[6]);
+    p[5] = PIX_MAX(p[2], p[5]);
+    p[3] = PIX_MAX(p[0], p[3]);
+    p[1] = PIX_MIN(p[1], p[4]);
+    p[3] = PIX_MIN(p[3], p[6]);
+    PIX_SORT(p[3], p[1]);
+    p[3] = PIX_MAX(p[5], p[3]);
+    return PIX_MIN(p[3], p[1]);
+}
+
+template <class pixelvalue>
+inline pixelvalue opt_med9(pixelvalue * p)
+{
+    PIX_SORT(p[1], p[2]);
+    PIX_SORT(p[4], p[5]);
+    PIX_SORT(p[7], p[8]);
+    PIX_SORT(p[0], p[1]);
+    PIX_SORT(p[3], p[4]);
+    PIX_SORT(p[6], p[7]);
+    PIX_SORT(p[1], p[2]);
+    PIX_SORT(p[4], p[5]);
+    PIX_SORT(p[7], p[8]);
+    p[3] = PIX_MAX(p[0], p[3]);
+    p[5] = PIX_MIN(p[5], p[8]);
+    PIX_SORT(p[4], p[7]);
+    p[6] = PIX_MAX(p[3], p[6]);
+    p[4] = PIX_MAX(p[1], p[4]);
+    p[2] = PIX_MIN(p[2], p[5]);
+    p[4] = PIX_MIN(p[4], p[7]);
+    PIX_SORT(p[4], p[2]);
+    p[4] = PIX_MAX(p[6], p[4]);
+    return PIX_MIN(p[4], p[2]);
+}
+
+
+// The original decimation_filter methods, as the reference for the results and the benchmark
+static void reference_depth( const uint16_t * frame_data_in, uint16_t * frame_data_out, size_t width_in, size_t scale,
+                             size_t real_width, size_t real_height, size_t padded_width, size_t padded_height )
+{
+    std::vector< uint16_t > working_kernel( scale * scale );
+    auto wk_begin = working_kernel.data();
+    auto wk_itr = wk_begin;
+    std::vector< uint16_t * > pixel_raws( scale );
+    uint16_t * block_start = const_cast< uint16_t * >( frame_data_in );
+
+    for( size_t j = 0; j < real_height; j++ )
+    {
+        uint16_t * p{};
+        for( size_t i = 0; i < pixel_raws.size(); i++ )
+            pixel_raws[i] = block_start + ( width_in * i );
+
+        for( size_t i = 0, chunk_offset = 0; i < real_width; i++ )
+        {
+            if( scale == 2 || scale == 3 )
+            {
+                wk_itr = wk_begin;
+                for( size_t n = 0; n < scale; ++n )
+                {
+                    p = pixel_raws[n] + chunk_offset;
+                    for( size_t m = 0; m < scale; ++m )
+                        if( *( p + m ) )
+                            *wk_itr++ = *( p + m );
+                }
+
+                auto ks = (int)( wk_itr - wk_begin );
+                switch( ks )
+                {
+                case 0: *frame_data_out++ = 0; break;
+                case 1: *frame_data_out++ = working_kernel[0]; break;
+                case 2: *frame_data_out++ = PIX_MIN( working_kernel[0], working_kernel[1] ); break;
+                case 3: *frame_data_out++ = opt_med3< uint16_t >( working_kernel.data() ); break;
+                case 4: *frame_data_out++ = opt_med4< uint16_t >( working_kernel.data() ); break;
+                case 5: *frame_data_out++ = opt_med5< uint16_t >( working_kernel.data() ); break;
+                case 6: *frame_data_out++ = opt_med6< uint16_t >( working_kernel.data() ); break;
+                case 7: *frame_data_out++ = opt_med7< uint16_t >( working_kernel.data() ); break;
+                case 8: *frame_data_out++ = opt_med8< uint16_t >( working_kernel.data() ); break;
+                case 9: *frame_data_out++ = opt_med9< uint16_t >( working_kernel.data() ); break;
+                }
+            }
+            else
+            {
+                int sum = 0;
+                int counter = 0;
+                for( size_t n = 0; n < scale; ++n )
+                {
+                    p = pixel_raws[n] + chunk_offset;
+                    for( size_t m = 0; m < scale; ++m )
+                        if( *( p + m ) )
+                        {
+                            sum += p[m];
+                            ++counter;
+                        }
+                }
+                *frame_data_out++ = ( counter == 0 ? 0 : sum / counter );
+            }
+            chunk_offset += scale;
+        }
+
+        for( size_t i = real_width; i < padded_width; i++ )
+            *frame_data_out++ = 0;
+        block_start += width_in * scale;
+    }
+
+    for( size_t v = real_height; v < padded_height; ++v )
+        for( size_t u = 0; u < padded_width; ++u )
+            *frame_data_out++ = 0;
+}
+
+// The Y8, Y16, RGB8 and RGBA8 cases of decimate_others, which only differ in the number of channels
+template< class T >
+static void reference_others( const T * from, T * q, size_t width_in, size_t channels, size_t scale, size_t real_width,
+                              size_t real_height, size_t padded_width, size_t padded_height )
+{
+    auto patch_size = scale * scale;
+    for( size_t j = 0; j < real_height; ++j )
+    {
+        for( size_t i = 0; i < real_width; ++i )
+            for( size_t k = 0; k < channels; ++k )
+            {
+                const T * p = from + scale * ( j * width_in + i ) * channels + k;
+                int sum = 0;
+                for( size_t n = 0; n < scale; ++n )
+                {
+                    for( size_t m = 0; m < scale; ++m )
+                        sum += p[m * channels];
+                    p += width_in * channels;
+                }
+                *q++ = (T)( sum / patch_size );
+            }
+        for( size_t i = real_width * channels; i < padded_width * channels; ++i )
+            *q++ = 0;
+    }
+    for( size_t j = real_height * padded_width * channels; j < padded_height * padded_width * channels; ++j )
+        *q++ = 0;
+}
+
+
+// As decimation_filter sizes its output: padded to a multiple of 4
+struct geometry
+{
+    size_t real_width, real_height, padded_width, padded_height;
+
+    geometry( size_t width, size_t height, size_t scale )
+        : real_width( width / scale )
+        , real_height( height / scale )
+        , padded_width( ( real_width + 3 ) / 4 * 4 )
+        , padded_height( ( real_height + 3 ) / 4 * 4 )
+    {
+    }
+};
+
+template< class Kernel, class T >
+static void run( Kernel kernel, geometry const & g, T * out, size_t channels, parallel_pool * pool )
+{
+    if( pool )
+        pool->parallel_for( g.real_height, 8, kernel );
+    else
+        kernel( 0, g.real_height );
+    std::fill( out + g.real_height * g.padded_width * channels, out + g.padded_height * g.padded_width * channels, T( 0 ) );
+}
+
+
+// Depth in a few surfaces, with holes scattered at the given rate and some at full range
+static std::vector< uint16_t > make_depth( size_t width, size_t height, float hole_rate, unsigned seed = 0 )
+{
+    std::mt19937 gen( seed );
+    std::uniform_int_distribution< int > noise( 0, 300 );
+    std::uniform_real_distribution< float > uniform( 0.f, 1.f );
+    std::vector< uint16_t > image( width * height );
+    for( size_t v = 0; v < height; ++v )
+        for( size_t u = 0; u < width; ++u )
+        {
+            int level = ( u / 13 + v / 7 ) % 3 ? 2000 : 700;
+            float const r = uniform( gen );
+            image[v * width + u] = r < hole_rate ? 0 : r > 0.99f ? 0xFFFF : uint16_t( level + noise( gen ) );
+        }
+    return image;
+}
+
+template< class T >
+static std::vector< T > make_image( size_t n, unsigned seed = 0 )
+{
+    std::mt19937 gen( seed );
+    std::uniform_int_distribution< int > values( 0, std::numeric_limits< T >::max() );
+    std::vector< T > image( n );
+    for( auto & x : image )
+        x = T( values( gen ) );
+    return image;
+}
+
+
+static std::vector< std::pair< size_t, size_t > > const sizes = { { 848, 480 }, { 640, 360 }, { 37, 11 }, { 17, 9 }, { 8, 8 }, { 3, 3 } };
+
+
+TEST_CASE( "depth decimation matches the original filter", "[decimation]" )
+{
+    parallel_pool pool( 3 );
+    for( size_t scale = 2; scale <= 8; ++scale )
+        for( auto size : sizes )
+            for( float hole_rate : { 0.f, 0.1f, 0.5f, 0.95f } )
+            {
+                auto width = size.first, height = size.second;
+                if( width < scale || height < scale )
+                    continue;
+                CAPTURE( scale, width, height, hole_rate );
+
+                geometry const g( width, height, scale );
+                auto const input = make_depth( width, height, hole_rate );
+                std::vector< uint16_t > expected( g.padded_width * g.padded_height );
+                reference_depth( input.data(), expected.data(), width, scale, g.real_width, g.real_height, g.padded_width, g.padded_height );
+
+                for( auto p : { (parallel_pool *)nullptr, &pool } )
+                {
+                    std::vector< uint16_t > out( expected.size(), 1 );
+                    run( [&]( size_t first, size_t last ) {
+                        if( scale == 2 || scale == 3 )
+                            decimate_depth_median( input.data(), width, out.data(), g.padded_width, scale, first, last );
+                        else
+                            decimate_depth_mean( input.data(), width, out.data(), g.padded_width, scale, first, last );
+                    }, g, out.data(), 1, p );
+                    CHECK( out == expected );
+                }
+            }
+}
+
+
+template< class T >
+static void check_channels( size_t channels, parallel_pool & pool )
+{
+    for( size_t scale = 2; scale <= 8; ++scale )
+        for( auto size : sizes )
+        {
+            auto width = size.first, height = size.second;
+            if( width < scale || height < scale )
+                continue;
+            CAPTURE( channels, scale, width, height );
+
+            geometry const g( width, height, scale );
+            auto const input = make_image< T >( width * height * channels );
+            std::vector< T > expected( g.padded_width * g.padded_height * channels );
+            reference_others( input.data(), expected.data(), width, channels, scale, g.real_width, g.real_height, g.padded_width, g.padded_height );
+
+            for( auto p : { (parallel_pool *)nullptr, &pool } )
+            {
+                std::vector< T > out( expected.size(), 1 );
+                run( [&]( size_t first, size_t last ) {
+                    decimate_mean( input.data(), width, channels, out.data(), g.padded_width, scale, first, last );
+                }, g, out.data(), channels, p );
+                CHECK( out == expected );
+            }
+        }
+}
+
+
+TEST_CASE( "Y8, Y16, RGB and RGBA decimation matches the original filter", "[decimation]" )
+{
+    parallel_pool pool( 3 );
+    check_channels< uint8_t >( 1, pool );
+    check_channels< uint16_t >( 1, pool );
+    check_channels< uint8_t >( 3, pool );
+    check_channels< uint8_t >( 4, pool );
+}
+
+
+// Not run by default: run with the [benchmark] tag to compare
+TEST_CASE( "decimation benchmark", "[.][benchmark]" )
+{
+    size_t const width = 1280, height = 720;
+    auto const input = make_depth( width, height, 0.05f );
+    auto pool = parallel_pool::get();
+
+    for( size_t scale : { 2, 3, 4 } )
+    {
+        geometry const g( width, height, scale );
+        std::vector< uint16_t > out( g.padded_width * g.padded_height );
+        std::string const name = "depth, scale " + std::to_string( scale );
+        auto kernel = [&]( size_t first, size_t last ) {
+            if( scale == 2 || scale == 3 )
+                decimate_depth_median( input.data(), width, out.data(), g.padded_width, scale, first, last );
+            else
+                decimate_depth_mean( input.data(), width, out.data(), g.padded_width, scale, first, last );
+        };
+        BENCHMARK( "original, " + name )
+        {
+            reference_depth( input.data(), out.data(), width, scale, g.real_width, g.real_height, g.padded_width, g.padded_height );
+        };
+        BENCHMARK( "new, " + name ) { run( kernel, g, out.data(), 1, nullptr ); };
+        BENCHMARK( "new, parallel, " + name ) { run( kernel, g, out.data(), 1, pool.get() ); };
+    }
+
+    auto const rgb = make_image< uint8_t >( width * height * 3 );
+    for( size_t scale : { 2, 3, 4 } )
+    {
+        geometry const g( width, height, scale );
+        std::vector< uint8_t > out( g.padded_width * g.padded_height * 3 );
+        std::string const name = "RGB8, scale " + std::to_string( scale );
+        BENCHMARK( "original, " + name )
+        {
+            reference_others( rgb.data(), out.data(), width, 3, scale, g.real_width, g.real_height, g.padded_width, g.padded_height );
+        };
+        BENCHMARK( "new, " + name )
+        {
+            run( [&]( size_t first, size_t last ) { decimate_mean( rgb.data(), width, 3, out.data(), g.padded_width, scale, first, last ); },
+                 g, out.data(), 3, nullptr );
+        };
+    }
+}
@@ -0,0 +1,46 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include <unit-tests/test.h>
+#include <librealsense2/rs.hpp>
+#include <librealsense2/hpp/rs_internal.hpp>
+
+#include <vector>
+
+
+TEST_CASE( "a software sensor with only a stereo baseline gets disparity", "[software-device][disparity]" )
+{
+    int const W = 64, H = 48;
+    rs2::software_device dev;
+    auto sensor = dev.add_sensor( "Depth" );
+    rs2_intrinsics intrinsics = { W, H, W / 2.f, H / 2.f, 420.f, 420.f, RS2_DISTORTION_NONE, { 0, 0, 0, 0, 0 } };
+    auto profile = sensor.add_video_stream( { RS2_STREAM_DEPTH, 0, 0, W, H, 30, 2, RS2_FORMAT_Z16, intrinsics } );
+    sensor.add_read_only_option( RS2_OPTION_STEREO_BASELINE, 50.f );  // mm; no depth units option
+
+    rs2::frame_queue queue;
+    sensor.open( profile );
+    sensor.start( queue );
+    std::vector< uint16_t > depth( W * H, 1000 );
+    depth[0] = 0;
+    sensor.on_video_frame( { depth.data(), []( void * ) {}, W * 2, 2, 0., RS2_TIMESTAMP_DOMAIN_SYSTEM_TIME, 1, profile,
+                             0.001f } );
+    auto f = queue.wait_for_frame();
+
+    rs2::disparity_transform to_disparity( true );
+    auto disparity = to_disparity.process( f );
+    REQUIRE( disparity.is< rs2::disparity_frame >() );
+
+    // Baseline * focal length * 32 (5 fractional bits) / depth, all in depth units
+    auto values = static_cast< float const * >( disparity.get_data() );
+    CHECK( values[0] == 0.f );
+    CHECK( values[1] == Approx( 50.f * 420.f * 32 / 1000.f ) );
+
+    // And back
+    rs2::disparity_transform to_depth( false );
+    auto back = to_depth.process( disparity ).as< rs2::depth_frame >();
+    REQUIRE( back );
+    CHECK( back.get_distance( 1, 0 ) == Approx( 1.f ) );
+
+    sensor.stop();
+    sensor.close();
+}
@@ -0,0 +1,130 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include <unit-tests/test.h>
+#include <librealsense2/rs.hpp>
+#include <librealsense2/hpp/rs_internal.hpp>
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+
+namespace {
+
+
+int const W = 424, H = 240;
+
+
+// Depth of a tilted plane with a few objects, noise that varies from frame to frame, and holes
+std::vector< uint16_t > make_depth( std::mt19937 & gen )
+{
+    std::normal_distribution< float > noise( 0.f, 6.f );
+    std::uniform_int_distribution< int > hole( 0, 19 );
+    std::vector< uint16_t > depth( W * H );
+    for( int y = 0; y < H; ++y )
+        for( int x = 0; x < W; ++x )
+        {
+            float z = 700.f + 4.f * x + 2.f * y;
+            if( ( x / 60 + y / 50 ) % 3 == 0 )
+                z -= 350.f;
+            if( x > 380 )
+                z += 4000.f;  // beyond the threshold
+            depth[y * W + x] = hole( gen ) ? uint16_t( z + noise( gen ) ) : 0;
+        }
+    return depth;
+}
+
+
+// The chain that the fused filter stands for, with its options set as the fused filter sets them in its blocks
+class filter_chain
+{
+    rs2::decimation_filter _decimation;
+    rs2::threshold_filter _threshold;
+    rs2::disparity_transform _to_disparity{ true };
+    rs2::spatial_filter _spatial;
+    rs2::temporal_filter _temporal;
+    rs2::hole_filling_filter _hole_filling;
+    rs2::disparity_transform _to_depth{ false };
+
+    std::vector< rs2::filter * > filters()
+    {
+        return { &_decimation, &_threshold, &_to_disparity, &_spatial, &_temporal, &_hole_filling, &_to_depth };
+    }
+
+public:
+    void set_option( rs2_option option, float value )
+    {
+        for( auto f : filters() )
+            if( f->supports( option ) )
+                f->set_option( option, value );
+    }
+
+    rs2::frame process( rs2::frame f )
+    {
+        for( auto filter : filters() )
+            f = filter->process( f );
+        return f;
+    }
+};
+
+
+}  // namespace
+
+
+TEST_CASE( "fused depth filter output is that of the chain", "[fused-depth-filter]" )
+{
+    rs2::software_device dev;
+    auto sensor = dev.add_sensor( "Depth" );
+    rs2_intrinsics intrinsics = { W, H, W / 2.f, H / 2.f, 420.f, 420.f, RS2_DISTORTION_BROWN_CONRADY, { 0, 0, 0, 0, 0 } };
+    auto profile = sensor.add_video_stream( { RS2_STREAM_DEPTH, 0, 0, W, H, 30, 2, RS2_FORMAT_Z16, intrinsics } );
+    sensor.add_read_only_option( RS2_OPTION_STEREO_BASELINE, 50.f );  // mm; no depth units option
+
+    rs2::frame_queue queue( 1, true );
+    sensor.open( profile );
+    sensor.start( queue );
+
+    // Median (2, 3) and mean (4, 5) decimation, with as many spatial iterations
+    for( float magnitude : { 2.f, 3.f, 4.f, 5.f } )
+    {
+        CAPTURE( magnitude );
+        rs2::fused_depth_filter fused;
+        filter_chain chain;
+        auto set_option = [&]( rs2_option option, float value )
+        {
+            fused.set_option( option, value );
+            chain.set_option( option, value );
+        };
+        set_option( RS2_OPTION_FILTER_MAGNITUDE, magnitude );
+        set_option( RS2_OPTION_MAX_DISTANCE, 3.f );
+        set_option( RS2_OPTION_FILTER_SMOOTH_ALPHA, 0.5f );
+        set_option( RS2_OPTION_FILTER_SMOOTH_DELTA, 30.f );  // not the default
+        set_option( RS2_OPTION_HOLES_FILL, 1.f );
+
+        // Enough frames for the temporal filter to fill holes from its history
+        std::mt19937 gen( 7 );
+        for( int i = 0; i < 6; ++i )
+        {
+            CAPTURE( i );
+            auto depth = make_depth( gen );
+            sensor.on_video_frame( { depth.data(), []( void * ) {}, W * 2, 2, rs2_time_t( i ),
+                                     RS2_TIMESTAMP_DOMAIN_SYSTEM_TIME, i + 1, profile, 0.001f } );
+            auto f = queue.wait_for_frame();
+
+            auto expected = chain.process( f ).as< rs2::depth_frame >();
+            auto actual = fused.process( f ).as< rs2::depth_frame >();
+            REQUIRE( expected );
+            REQUIRE( actual );
+            REQUIRE( actual.get_width() == expected.get_width() );
+            REQUIRE( actual.get_height() == expected.get_height() );
+            CHECK( actual.get_width() < W );
+            CHECK( actual.get_profile().as< rs2::video_stream_profile >().get_intrinsics().fx
+                   == expected.get_profile().as< rs2::video_stream_profile >().get_intrinsics().fx );
+            CHECK( std::memcmp( actual.get_data(), expected.get_data(),
+                                actual.get_height() * actual.get_stride_in_bytes() ) == 0 );
+        }
+    }
+
+    sensor.stop();
+    sensor.close();
+}
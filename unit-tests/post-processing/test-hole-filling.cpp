@@ -0,0 +1,235 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+//#cmake:add-file ../../src/proc/hole-filling-kernels.cpp
+//#cmake:add-file ../../src/proc/parallel-pool.cpp
+
+#include <unit-tests/test.h>
+#include <src/proc/hole-filling-kernels.h>
+#include <src/proc/parallel-pool.h>
+
+#include <functional>
+#include <random>
+#include <vector>
+
+using namespace librealsense;
+
+
+// The original hole_filling_filter methods, in place, as the reference for the results and the benchmark
+template< typename T >
+static void reference_left( T * image_data, size_t width, size_t height )
+{
+    std::function< bool( T * ) > fp_oper = []( T * ptr ) { return ! *( (int *)ptr ); };
+    std::function< bool( T * ) > uint_oper = []( T * ptr ) { return ! ( *ptr ); };
+    auto empty = ( std::is_floating_point< T >::value ) ? fp_oper : uint_oper;
+
+    T * p = image_data;
+    for( size_t j = 0; j < height; ++j )
+    {
+        ++p;
+        for( size_t i = 1; i < width; ++i )
+        {
+            if( empty( p ) )
+                *p = *( p - 1 );
+            ++p;
+        }
+    }
+}
+
+template< typename T >
+static void reference_farest( T * image_data, size_t width, size_t height )
+{
+    std::function< bool( T * ) > fp_oper = []( T * ptr ) { return ! *( (int *)ptr ); };
+    std::function< bool( T * ) > uint_oper = []( T * ptr ) { return ! ( *ptr ); };
+    auto empty = ( std::is_floating_point< T >::value ) ? fp_oper : uint_oper;
+
+    T tmp = 0;
+    T * p = image_data + width;
+    T * q = nullptr;
+    for( int j = 1; j < int( height ) - 1; ++j )
+    {
+        ++p;
+        for( size_t i = 1; i < width; ++i )
+        {
+            if( empty( p ) )
+            {
+                tmp = *( p - width );
+                q = p - width - 1;
+                if( *q > tmp )
+                    tmp = *q;
+                q = p - 1;
+                if( *q > tmp )
+                    tmp = *q;
+                q = p + width - 1;
+                if( *q > tmp )
+                    tmp = *q;
+                q = p + width;
+                if( *q > tmp )
+                    tmp = *q;
+                *p = tmp;
+            }
+            p++;
+        }
+    }
+}
+
+template< typename T >
+static void reference_nearest( T * image_data, size_t width, size_t height )
+{
+    std::function< bool( T * ) > fp_oper = []( T * ptr ) { return ! *( (int *)ptr ); };
+    std::function< bool( T * ) > uint_oper = []( T * ptr ) { return ! ( *ptr ); };
+    auto empty = ( std::is_floating_point< T >::value ) ? fp_oper : uint_oper;
+
+    T tmp = 0;
+    T * p = image_data + width;
+    T * q = nullptr;
+    for( int j = 1; j < int( height ) - 1; ++j )
+    {
+        ++p;
+        for( size_t i = 1; i < width; ++i )
+        {
+            if( empty( p ) )
+            {
+                tmp = *( p - width );
+                q = p - width - 1;
+                if( ! empty( q ) && ( *q < tmp ) )
+                    tmp = *q;
+                q = p - 1;
+                if( ! empty( q ) && ( *q < tmp ) )
+                    tmp = *q;
+                q = p + width - 1;
+                if( ! empty( q ) && ( *q < tmp ) )
+                    tmp = *q;
+                q = p + width;
+                if( ! empty( q ) && ( *q < tmp ) )
+                    tmp = *q;
+                *p = tmp;
+            }
+            p++;
+        }
+    }
+}
+
+template< typename T >
+static void reference( holes_filling_types mode, std::vector< T > & image, size_t width, size_t height )
+{
+    switch( mode )
+    {
+    case hf_fill_from_left: reference_left( image.data(), width, height ); break;
+    case hf_farest_from_around: reference_farest( image.data(), width, height ); break;
+    case hf_nearest_from_around: reference_nearest( image.data(), width, height ); break;
+    default: break;
+    }
+}
+
+template< typename T >
+static void fill( holes_filling_types mode, T const * in, T * out, size_t width, size_t height, parallel_pool * pool )
+{
+    switch( mode )
+    {
+    case hf_fill_from_left: hole_fill< hf_fill_from_left >( in, out, width, height, pool ); break;
+    case hf_farest_from_around: hole_fill< hf_farest_from_around >( in, out, width, height, pool ); break;
+    case hf_nearest_from_around: hole_fill< hf_nearest_from_around >( in, out, width, height, pool ); break;
+    default: break;
+    }
+}
+
+
+// Surfaces at a few depths, with scattered holes and with holes in long vertical runs (which carry filled values from
+// one band of rows into the next)
+template< typename T >
+static std::vector< T > make_depth( size_t width, size_t height, float hole_rate, unsigned seed = 0 )
+{
+    std::mt19937 gen( seed );
+    std::uniform_int_distribution< int > noise( 0, 40 );
+    std::uniform_real_distribution< float > uniform( 0.f, 1.f );
+    std::vector< T > image( width * height );
+    std::vector< bool > column_hole( width );
+    for( size_t u = 0; u < width; ++u )
+        column_hole[u] = uniform( gen ) < hole_rate;
+    for( size_t v = 0; v < height; ++v )
+        for( size_t u = 0; u < width; ++u )
+        {
+            int level = ( u / 29 + v / 17 ) % 3 ? 2000 : 700;
+            bool hole = uniform( gen ) < hole_rate || ( column_hole[u] && ( v / 50 ) % 2 );
+            image[v * width + u] = hole ? T( 0 ) : T( level + noise( gen ) );
+        }
+    return image;
+}
+
+
+template< typename T >
+static void check_all_modes( parallel_pool & pool )
+{
+    for( auto mode : { hf_fill_from_left, hf_farest_from_around, hf_nearest_from_around } )
+        for( auto size : std::vector< std::pair< size_t, size_t > >{ { 848, 480 }, { 640, 360 }, { 37, 11 }, { 9, 3 }, { 5, 2 }, { 1, 1 } } )
+            for( float hole_rate : { 0.02f, 0.3f, 0.9f } )
+            {
+                auto width = size.first, height = size.second;
+                CAPTURE( mode, width, height, hole_rate );
+
+                auto const input = make_depth< T >( width, height, hole_rate );
+                auto expected = input;
+                reference( mode, expected, width, height );
+
+                std::vector< T > out( input.size() );
+                fill( mode, input.data(), out.data(), width, height, nullptr );
+                CHECK( out == expected );
+
+                std::fill( out.begin(), out.end(), T( 1 ) );
+                fill( mode, input.data(), out.data(), width, height, &pool );
+                CHECK( out == expected );
+
+                // In place
+                out = input;
+                fill( mode, out.data(), out.data(), width, height, &pool );
+                CHECK( out == expected );
+            }
+}
+
+
+TEST_CASE( "depth hole filling matches the original filter", "[hole-filling]" )
+{
+    parallel_pool pool( 3 );
+    check_all_modes< uint16_t >( pool );
+}
+
+
+TEST_CASE( "disparity hole filling matches the original filter", "[hole-filling]" )
+{
+    parallel_pool pool( 3 );
+    check_all_modes< float >( pool );
+}
+
+
+// Not run by default: run with the [benchmark] tag to compare
+TEST_CASE( "hole filling benchmark", "[.][benchmark]" )
+{
+    size_t const width = 848, height = 480;
+    auto const input = make_depth< uint16_t >( width, height, 0.05f );
+    auto pool = parallel_pool::get();
+
+    for( auto mode : { hf_farest_from_around, hf_nearest_from_around } )
+    {
+        std::string const name = mode == hf_farest_from_around ? "farest" : "nearest";
+        BENCHMARK_ADVANCED( "original, " + name )( Catch::Benchmark::Chronometer meter )
+        {
+            auto image = input;
+            meter.measure( [&] {
+                // The original copies the input into the target first
+                image = input;
+                reference( mode, image, width, height );
+            } );
+        };
+        BENCHMARK_ADVANCED( "SIMD, " + name )( Catch::Benchmark::Chronometer meter )
+        {
+            std::vector< uint16_t > out( input.size() );
+            meter.measure( [&] { fill( mode, input.data(), out.data(), width, height, nullptr ); } );
+        };
+        BENCHMARK_ADVANCED( "SIMD, parallel, " + name )( Catch::Benchmark::Chronometer meter )
+        {
+            std::vector< uint16_t > out( input.size() );
+            meter.measure( [&] { fill( mode, input.data(), out.data(), width, height, pool.get() ); } );
+        };
+    }
+}
@@ -0,0 +1,83 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include <unit-tests/test.h>
+#include <librealsense2/rs.hpp>
+#include <librealsense2/hpp/rs_internal.hpp>
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+
+namespace {
+
+
+int const W = 320, H = 180;
+
+
+// Steps of 35 mm every 8 columns: edges for a delta of 20, smoothed over with a delta of 50
+std::vector< uint16_t > make_depth( std::mt19937 & gen )
+{
+    std::normal_distribution< float > noise( 0.f, 3.f );
+    std::vector< uint16_t > depth( W * H );
+    for( int y = 0; y < H; ++y )
+        for( int x = 0; x < W; ++x )
+            depth[y * W + x] = uint16_t( 1000.f + 35.f * ( x / 8 ) + noise( gen ) );
+    return depth;
+}
+
+
+bool same_data( rs2::frame const & a, rs2::frame const & b )
+{
+    auto va = a.as< rs2::video_frame >(), vb = b.as< rs2::video_frame >();
+    return va.get_height() * va.get_stride_in_bytes() == vb.get_height() * vb.get_stride_in_bytes()
+        && std::memcmp( va.get_data(), vb.get_data(), va.get_height() * va.get_stride_in_bytes() ) == 0;
+}
+
+
+}  // namespace
+
+
+TEST_CASE( "the spatial delta takes effect on the next frame", "[software-device][spatial-filter]" )
+{
+    rs2::software_device dev;
+    auto sensor = dev.add_sensor( "Depth" );
+    rs2_intrinsics intrinsics = { W, H, W / 2.f, H / 2.f, 300.f, 300.f, RS2_DISTORTION_NONE, { 0, 0, 0, 0, 0 } };
+    auto profile = sensor.add_video_stream( { RS2_STREAM_DEPTH, 0, 0, W, H, 30, 2, RS2_FORMAT_Z16, intrinsics } );
+
+    rs2::frame_queue queue( 2, true );
+    sensor.open( profile );
+    sensor.start( queue );
+
+    // The frames refer to the pixels, which are kept for as long as the frames
+    std::mt19937 gen( 3 );
+    std::vector< std::vector< uint16_t > > pixels;
+    std::vector< rs2::frame > frames;
+    for( int i = 0; i < 2; ++i )
+    {
+        pixels.push_back( make_depth( gen ) );
+        sensor.on_video_frame( { pixels.back().data(), []( void * ) {}, W * 2, 2, rs2_time_t( i ),
+                                 RS2_TIMESTAMP_DOMAIN_SYSTEM_TIME, i + 1, profile, 0.001f } );
+        frames.push_back( queue.wait_for_frame() );
+    }
+
+    // Changed between two frames of the same profile...
+    rs2::spatial_filter changed;
+    changed.process( frames[0] );
+    changed.set_option( RS2_OPTION_FILTER_SMOOTH_DELTA, 50.f );
+    auto after_change = changed.process( frames[1] );
+
+    // ...the delta filters as if it had been set from the start
+    rs2::spatial_filter from_start;
+    from_start.set_option( RS2_OPTION_FILTER_SMOOTH_DELTA, 50.f );
+    from_start.process( frames[0] );
+    CHECK( same_data( after_change, from_start.process( frames[1] ) ) );
+
+    // And not as the default delta, which keeps the edges
+    rs2::spatial_filter by_default;
+    CHECK_FALSE( same_data( after_change, by_default.process( frames[1] ) ) );
+
+    sensor.stop();
+    sensor.close();
+}
@@ -0,0 +1,411 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+//#cmake:add-file ../../src/proc/spatial-filter-fp.cpp
+//#cmake:add-file ../../src/proc/parallel-pool.cpp
+
+#include <unit-tests/test.h>
+#include <src/proc/spatial-filter-fp.h>
+#include <src/proc/parallel-pool.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace librealsense;
+
+
+// The original, scalar spatial_filter::recursive_filter_*_fp(), as the reference for the results and the benchmark
+static void reference_horizontal( void * image_data, int _width, int _height, float alpha, float deltaZ )
+{
+    float *image = reinterpret_cast<float*>(image_data);
+
+    int v, u;
+
+    for (v = 0; v < _height;) {
+        // left to right
+        float *im = image + v * _width;
+        float state = *im;
+        float previousInnovation = state;
+
+        im++;
+        float innovation = *im;
+        u = int(_width) - 1;
+        if (!(*(int*)&previousInnovation > 0))
+            goto CurrentlyInvalidLR;
+        // else fall through
+
+    CurrentlyValidLR:
+        for (;;) {
+            if (*(int*)&innovation > 0) {
+                float delta = previousInnovation - innovation;
+                bool smallDifference = delta < deltaZ && delta > -deltaZ;
+
+                if (smallDifference) {
+                    float filtered = innovation * alpha + state * (1.0f - alpha);
+                    *im = state = filtered;
+                }
+                else {
+                    state = innovation;
+                }
+                u--;
+                if (u <= 0)
+                    goto DoneLR;
+                previousInnovation = innovation;
+                im += 1;
+                innovation = *im;
+            }
+            else {  // switch to CurrentlyInvalid state
+                u--;
+                if (u <= 0)
+                    goto DoneLR;
+                previousInnovation = innovation;
+                im += 1;
+                innovation = *im;
+                goto CurrentlyInvalidLR;
+            }
+        }
+
+    CurrentlyInvalidLR:
+        for (;;) {
+            u--;
+            if (u <= 0)
+                goto DoneLR;
+            if (*(int*)&innovation > 0) { // switch to CurrentlyValid state
+                previousInnovation = state = innovation;
+                im += 1;
+                innovation = *im;
+                goto CurrentlyValidLR;
+            }
+            else {
+                im += 1;
+                innovation = *im;
+            }
+        }
+    DoneLR:
+
+        // right to left
+        im = image + (v + 1) * _width - 2;  // end of row - two pixels
+        previousInnovation = state = im[1];
+        u = int(_width) - 1;
+        innovation = *im;
+        if (!(*(int*)&previousInnovation > 0))
+            goto CurrentlyInvalidRL;
+        // else fall through
+    CurrentlyValidRL:
+        for (;;) {
+            if (*(int*)&innovation > 0) {
+                float delta = previousInnovation - innovation;
+                bool smallDifference = delta < deltaZ && delta > -deltaZ;
+
+                if (smallDifference) {
+                    float filtered = innovation * alpha + state * (1.0f - alpha);
+                    *im = state = filtered;
+                }
+                else {
+                    state = innovation;
+                }
+                u--;
+                if (u <= 0)
+                    goto DoneRL;
+                previousInnovation = innovation;
+                im -= 1;
+                innovation = *im;
+            }
+            else {  // switch to CurrentlyInvalid state
+                u--;
+                if (u <= 0)
+                    goto DoneRL;
+                previousInnovation = innovation;
+                im -= 1;
+                innovation = *im;
+                goto CurrentlyInvalidRL;
+            }
+        }
+
+    CurrentlyInvalidRL:
+        for (;;) {
+            u--;
+            if (u <= 0)
+                goto DoneRL;
+            if (*(int*)&innovation > 0) { // switch to CurrentlyValid state
+                previousInnovation = state = innovation;
+                im -= 1;
+                innovation = *im;
+                goto CurrentlyValidRL;
+            }
+            else {
+                im -= 1;
+                innovation = *im;
+            }
+        }
+    DoneRL:
+        v++;
+    }
+}
+
+static void reference_vertical( void * image_data, int _width, int _height, float alpha, float deltaZ )
+{
+    float *image = reinterpret_cast<float*>(image_data);
+
+    int v, u;
+
+    // we'll do one column at a time, top to bottom, bottom to top, left to right,
+
+    for (u = 0; u < _width;) {
+
+        float *im = image + u;
+        float state = im[0];
+        float previousInnovation = state;
+
+        v = int(_height) - 1;
+        im += _width;
+        float innovation = *im;
+
+        if (!(*(int*)&previousInnovation > 0))
+            goto CurrentlyInvalidTB;
+        // else fall through
+
+    CurrentlyValidTB:
+        for (;;) {
+            if (*(int*)&innovation > 0) {
+                float delta = previousInnovation - innovation;
+                bool smallDifference = delta < deltaZ && delta > -deltaZ;
+
+                if (smallDifference) {
+                    float filtered = innovation * alpha + state * (1.0f - alpha);
+                    *im = state = filtered;
+                }
+                else {
+                    state = innovation;
+                }
+                v--;
+                if (v <= 0)
+                    goto DoneTB;
+                previousInnovation = innovation;
+                im += _width;
+                innovation = *im;
+            }
+            else {  // switch to CurrentlyInvalid state
+                v--;
+                if (v <= 0)
+                    goto DoneTB;
+                previousInnovation = innovation;
+                im += _width;
+                innovation = *im;
+                goto CurrentlyInvalidTB;
+            }
+        }
+
+    CurrentlyInvalidTB:
+        for (;;) {
+            v--;
+            if (v <= 0)
+                goto DoneTB;
+            if (*(int*)&innovation > 0) { // switch to CurrentlyValid state
+                previousInnovation = state = innovation;
+                im += _width;
+                innovation = *im;
+                goto CurrentlyValidTB;
+            }
+            else {
+                im += _width;
+                innovation = *im;
+            }
+        }
+    DoneTB:
+
+        im = image + u + (_height - 2) * _width;
+        state = im[_width];
+        previousInnovation = state;
+        innovation = *im;
+        v = int(_height) - 1;
+        if (!(*(int*)&previousInnovation > 0))
+            goto CurrentlyInvalidBT;
+        // else fall through
+    CurrentlyValidBT:
+        for (;;) {
+            if (*(int*)&innovation > 0) {
+                float delta = previousInnovation - innovation;
+                bool smallDifference = delta < deltaZ && delta > -deltaZ;
+
+                if (smallDifference) {
+                    float filtered = innovation * alpha + state * (1.0f - alpha);
+                    *im = state = filtered;
+                }
+                else {
+                    state = innovation;
+                }
+                v--;
+                if (v <= 0)
+                    goto DoneBT;
+                previousInnovation = innovation;
+                im -= _width;
+                innovation = *im;
+            }
+            else {  // switch to CurrentlyInvalid state
+                v--;
+                if (v <= 0)
+                    goto DoneBT;
+                previousInnovation = innovation;
+                im -= _width;
+                innovation = *im;
+                goto CurrentlyInvalidBT;
+            }
+        }
+
+    CurrentlyInvalidBT:
+        for (;;) {
+            v--;
+            if (v <= 0)
+                goto DoneBT;
+            if (*(int*)&innovation > 0) { // switch to CurrentlyValid state
+                previousInnovation = state = innovation;
+                im -= _width;
+                innovation = *im;
+                goto CurrentlyValidBT;
+            }
+            else {
+                im -= _width;
+                innovation = *im;
+            }
+        }
+    DoneBT:
+        u++;
+    }
+}
+
+
+static std::vector< float > make_disparity( size_t width, size_t height, unsigned seed = 0 )
+{
+    // Smooth surfaces with noise, edges and holes
+    std::mt19937 gen( seed );
+    std::normal_distribution< float > noise( 0.f, 2.f );
+    std::uniform_real_distribution< float > uniform( 0.f, 1.f );
+    std::vector< float > image( width * height );
+    for( size_t v = 0; v < height; ++v )
+        for( size_t u = 0; u < width; ++u )
+        {
+            float level = ( u / 37 + v / 23 ) % 3 ? 400.f : 150.f;
+            float x = level + noise( gen );
+            auto hole = uniform( gen );
+            if( hole < 0.05f )
+                x = 0.f;
+            else if( hole < 0.06f )
+                x = -x;
+            image[v * width + u] = x;
+        }
+    return image;
+}
+
+static void filter_reference( std::vector< float > & image, size_t width, size_t height, fp_filter_params const & p )
+{
+    reference_horizontal( image.data(), int( width ), int( height ), p.alpha, p.delta_z );
+    reference_vertical( image.data(), int( width ), int( height ), p.alpha, p.delta_z );
+}
+
+static void filter_parallel( parallel_pool & pool, std::vector< float > & image, size_t width, size_t height, fp_filter_params const & p )
+{
+    // Same split as spatial_filter
+    pool.parallel_for( ( height + 3 ) / 4, 4, [&]( size_t first, size_t last ) {
+        filter_rows_fp( image.data(), width, first * 4, std::min( height, last * 4 ), p );
+    } );
+    pool.parallel_for( ( width + 15 ) / 16, 2, [&]( size_t first, size_t last ) {
+        filter_columns_fp( image.data(), width, height, first * 16, std::min( width, last * 16 ), p );
+    } );
+}
+
+static void compare( std::vector< float > const & actual, std::vector< float > const & expected )
+{
+    REQUIRE( actual.size() == expected.size() );
+    size_t n_mismatches = 0;
+    for( size_t i = 0; i < actual.size(); ++i )
+        if( std::abs( actual[i] - expected[i] ) > 1e-4f * std::abs( expected[i] ) )
+            ++n_mismatches;
+    CHECK( n_mismatches == 0 );
+}
+
+
+TEST_CASE( "SIMD kernels match the original filter", "[spatial-filter]" )
+{
+    fp_filter_params const p{ 0.5f, 20.f };
+    for( auto size : std::vector< std::pair< size_t, size_t > >{ { 848, 480 }, { 640, 360 }, { 37, 11 }, { 5, 3 }, { 2, 2 } } )
+    {
+        auto width = size.first, height = size.second;
+        CAPTURE( width, height );
+
+        auto expected = make_disparity( width, height );
+        auto actual = expected;
+        filter_reference( expected, width, height, p );
+        filter_rows_fp( actual.data(), width, 0, height, p );
+        filter_columns_fp( actual.data(), width, height, 0, width, p );
+        compare( actual, expected );
+    }
+}
+
+
+TEST_CASE( "parallel filter matches the original filter", "[spatial-filter]" )
+{
+    parallel_pool pool( 3 );
+    for( auto p : { fp_filter_params{ 0.25f, 1.f }, fp_filter_params{ 0.5f, 20.f }, fp_filter_params{ 1.f, 50.f } } )
+    {
+        CAPTURE( p.alpha, p.delta_z );
+        auto expected = make_disparity( 848, 480, 1 );
+        auto actual = expected;
+        for( int i = 0; i < 2; ++i )
+        {
+            filter_reference( expected, 848, 480, p );
+            filter_parallel( pool, actual, 848, 480, p );
+        }
+        compare( actual, expected );
+    }
+}
+
+
+TEST_CASE( "parallel_pool runs every chunk once", "[parallel-pool]" )
+{
+    parallel_pool pool( 3 );
+    std::vector< std::atomic< int > > hits( 1000 );
+    pool.parallel_for( hits.size(), 7, [&]( size_t begin, size_t end ) {
+        CHECK( ( end - begin >= 7 || end == hits.size() ) );
+        for( auto i = begin; i < end; ++i )
+            ++hits[i];
+    } );
+    for( auto & h : hits )
+        CHECK( h == 1 );
+
+    CHECK_THROWS_AS( pool.parallel_for( 100, 1, []( size_t begin, size_t ) {
+                         if( begin == 0 )
+                             throw std::runtime_error( "first chunk" );
+                     } ),
+                     std::runtime_error );
+}
+
+
+// Not run by default: run with the [benchmark] tag to compare
+TEST_CASE( "spatial filter benchmark", "[.][benchmark]" )
+{
+    size_t const width = 848, height = 480;
+    fp_filter_params const p{ 0.5f, 20.f };
+    auto const input = make_disparity( width, height );
+    auto pool = parallel_pool::get();
+
+    BENCHMARK_ADVANCED( "original" )( Catch::Benchmark::Chronometer meter )
+    {
+        auto image = input;
+        meter.measure( [&] { filter_reference( image, width, height, p ); } );
+    };
+    BENCHMARK_ADVANCED( "SIMD" )( Catch::Benchmark::Chronometer meter )
+    {
+        auto image = input;
+        meter.measure( [&] {
+            filter_rows_fp( image.data(), width, 0, height, p );
+            filter_columns_fp( image.data(), width, height, 0, width, p );
+        } );
+    };
+    BENCHMARK_ADVANCED( "SIMD, parallel" )( Catch::Benchmark::Chronometer meter )
+    {
+        auto image = input;
+        meter.measure( [&] { filter_parallel( *pool, image, width, height, p ); } );
+    };
+}
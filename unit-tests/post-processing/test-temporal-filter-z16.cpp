@@ -0,0 +1,217 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+//#cmake:add-file ../../src/proc/temporal-filter-z16.cpp
+
+#include <unit-tests/test.h>
+#include <src/proc/temporal-filter-z16.h>
+
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace librealsense;
+
+
+// The original, table-driven temporal_filter, as the reference for the results and the benchmark
+struct reference_filter
+{
+    std::array< uint8_t, 256 > persistence_map;
+    float alpha, one_minus_alpha;
+    uint16_t delta_z;
+    uint8_t cur_frame_index = 0;
+    std::vector< uint16_t > last_frame;
+    std::vector< uint8_t > history;
+
+    reference_filter( uint8_t persistence_param, float alpha_, uint16_t delta_z_, size_t n )
+        : alpha( alpha_ )
+        , one_minus_alpha( 1.f - alpha_ )
+        , delta_z( delta_z_ )
+        , last_frame( n )
+        , history( n )
+    {
+        std::array< uint8_t, 256 > map;
+        map.fill( 0 );
+        for( int i = 0; i < 256; i++ )
+        {
+            int bits[8];  // bits[0] is the last frame, bits[7] the oldest
+            for( int b = 0; b < 8; ++b )
+                bits[b] = !!( i & ( 128 >> b ) );
+            auto sum = [&]( int n_frames ) {
+                int s = 0;
+                for( int b = 0; b < n_frames; ++b )
+                    s += bits[b];
+                return s;
+            };
+            switch( persistence_param )
+            {
+            case 1: map[i] = sum( 8 ) >= 8; break;
+            case 2: map[i] = sum( 3 ) >= 2; break;
+            case 3: map[i] = sum( 4 ) >= 2; break;
+            case 4: map[i] = sum( 8 ) >= 2; break;
+            case 5: map[i] = sum( 2 ) >= 1; break;
+            case 6: map[i] = sum( 5 ) >= 1; break;
+            case 7: map[i] = sum( 8 ) >= 1; break;
+            case 8: map[i] = 1; break;
+            }
+        }
+        persistence_map.fill( 0 );
+        for( int phase = 0; phase < 8; phase++ )
+            for( int i = 0; i < 256; i++ )
+            {
+                unsigned char pos = (unsigned char)( ( i << ( 8 - phase ) ) | ( i >> phase ) );
+                if( map[pos] )
+                    persistence_map[i] |= 1 << phase;
+            }
+    }
+
+    void filter( uint16_t * frame )
+    {
+        unsigned char mask = 1 << cur_frame_index;
+        for( size_t i = 0; i < last_frame.size(); i++ )
+        {
+            uint16_t cur_val = frame[i];
+            uint16_t prev_val = last_frame[i];
+            if( cur_val )
+            {
+                if( ! prev_val )
+                {
+                    last_frame[i] = cur_val;
+                    history[i] = mask;
+                }
+                else
+                {
+                    uint16_t diff = static_cast< uint16_t >( fabs( cur_val - prev_val ) );
+                    if( diff < delta_z )
+                    {
+                        history[i] |= mask;
+                        float filtered = alpha * cur_val + one_minus_alpha * prev_val;
+                        uint16_t result = static_cast< uint16_t >( filtered );
+                        frame[i] = result;
+                        last_frame[i] = result;
+                    }
+                    else
+                    {
+                        last_frame[i] = cur_val;
+                        history[i] = mask;
+                    }
+                }
+            }
+            else
+            {
+                if( prev_val && ( persistence_map[history[i]] & mask ) )
+                    frame[i] = prev_val;
+                history[i] &= ~mask;
+            }
+        }
+        cur_frame_index = ( cur_frame_index + 1 ) % 8;
+    }
+};
+
+
+static std::vector< uint16_t > make_depth( size_t n, std::mt19937 & gen )
+{
+    // Noisy surfaces with flickering holes, and occasional large jumps
+    std::normal_distribution< float > noise( 0.f, 8.f );
+    std::uniform_real_distribution< float > uniform( 0.f, 1.f );
+    std::vector< uint16_t > frame( n );
+    for( size_t i = 0; i < n; ++i )
+    {
+        auto r = uniform( gen );
+        if( r < 0.3f )
+            frame[i] = 0;
+        else if( r < 0.32f )
+            frame[i] = uint16_t( 60000 + 5000 * uniform( gen ) );
+        else
+            frame[i] = uint16_t( 1000 + ( i % 97 ) * 10 + noise( gen ) );
+    }
+    return frame;
+}
+
+
+TEST_CASE( "persistence rules match the original table", "[temporal-filter]" )
+{
+    for( uint8_t param = 0; param <= 8; ++param )
+    {
+        CAPTURE( param );
+        reference_filter ref( param, 0.4f, 20, 0 );
+        auto rule = persistence_rule::from_option( param );
+        for( uint8_t phase = 0; phase < 8; ++phase )
+        {
+            CAPTURE( phase );
+            auto window = rule.window_mask( phase );
+            for( int history = 0; history < 256; ++history )
+            {
+                CAPTURE( history );
+                bool expected = ( ref.persistence_map[history] >> phase ) & 1;
+                REQUIRE( rule.is_credible( uint8_t( history ), window ) == expected );
+            }
+        }
+    }
+}
+
+
+TEST_CASE( "Z16 kernel matches the original filter", "[temporal-filter]" )
+{
+    size_t const n = 848 * 3 + 5;  // not a multiple of the SIMD width
+    for( uint8_t param : { 0, 1, 3, 4, 7, 8 } )
+        for( auto alpha : { 0.f, 0.4f, 1.f } )
+        {
+            CAPTURE( param, alpha );
+            std::mt19937 gen( param );
+            reference_filter ref( param, alpha, 20, n );
+            temporal_filter_params p{ alpha, 20, persistence_rule::from_option( param ) };
+            std::vector< uint16_t > last( n );
+            std::vector< uint8_t > history( n );
+
+            for( uint8_t frame = 0; frame < 20; ++frame )
+            {
+                CAPTURE( frame );
+                auto input = make_depth( n, gen );
+                auto expected = input;
+                ref.filter( expected.data() );
+
+                // Alternate between in-place and out-of-place
+                std::vector< uint16_t > output( n, 0xbad );
+                auto out = ( frame % 2 ) ? input.data() : output.data();
+                temporal_filter_z16( input.data(), out, last.data(), history.data(), n, frame % 8, p );
+
+                REQUIRE( std::vector< uint16_t >( out, out + n ) == expected );
+                REQUIRE( last == ref.last_frame );
+                REQUIRE( history == ref.history );
+            }
+        }
+}
+
+
+// Not run by default: run with the [benchmark] tag to compare
+TEST_CASE( "temporal filter benchmark", "[.][benchmark]" )
+{
+    size_t const n = 848 * 480;
+    std::mt19937 gen;
+    std::vector< std::vector< uint16_t > > frames;
+    for( int i = 0; i < 8; ++i )
+        frames.push_back( make_depth( n, gen ) );
+
+    BENCHMARK_ADVANCED( "original" )( Catch::Benchmark::Chronometer meter )
+    {
+        reference_filter ref( 3, 0.4f, 20, n );
+        auto frame = frames[0];
+        meter.measure( [&]( int i ) {
+            // The original copies the input into the target first
+            memcpy( frame.data(), frames[i % 8].data(), n * sizeof( uint16_t ) );
+            ref.filter( frame.data() );
+        } );
+    };
+    BENCHMARK_ADVANCED( "SIMD" )( Catch::Benchmark::Chronometer meter )
+    {
+        temporal_filter_params p{ 0.4f, 20, persistence_rule::from_option( 3 ) };
+        std::vector< uint16_t > output( n ), last( n );
+        std::vector< uint8_t > history( n );
+        meter.measure( [&]( int i ) {
+            temporal_filter_z16( frames[i % 8].data(), output.data(), last.data(), history.data(), n, uint8_t( i % 8 ), p );
+        } );
+    };
+}
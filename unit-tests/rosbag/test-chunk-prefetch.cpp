@@ -0,0 +1,168 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+//#cmake:dependencies realsense-file
+
+#include <unit-tests/test.h>
+
+#include <rosbag/bag.h>
+#include <rosbag/view.h>
+#include <std_msgs/String.h>
+
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+
+namespace {
+
+
+std::string const filename = "test-chunk-prefetch.bag";
+int const n_messages = 300;
+
+
+rs2rosinternal::Time stamp( int i )
+{
+    return rs2rosinternal::Time( 1000, uint32_t( i ) );
+}
+
+
+// Many small LZ4 chunks, of messages that do not compress away
+void write_bag()
+{
+    std::mt19937 gen( 42 );
+    std::uniform_int_distribution< int > byte( 0, 255 );
+    rosbag::Bag bag( filename, rosbag::bagmode::Write );
+    bag.setCompression( rosbag::compression::LZ4 );
+    bag.setChunkThreshold( 4096 );
+    for( int i = 0; i < n_messages; ++i )
+    {
+        std_msgs::String msg;
+        msg.data = std::string( 100 + ( i * 37 ) % 900, char( 'a' + i % 26 ) );
+        for( size_t j = 0; j < msg.data.size(); j += 2 )
+            msg.data[j] = char( byte( gen ) );
+        bag.write( i % 3 ? "/camera/depth" : "/camera/color", stamp( i ), msg );
+    }
+}
+
+
+// The messages in [begin, end), in order
+std::vector< std::string > read( rosbag::Bag const & bag, int begin = 0, int end = n_messages )
+{
+    std::vector< std::string > messages;
+    rosbag::View view( bag, stamp( begin ), stamp( end - 1 ) );
+    for( rosbag::MessageInstance const & m : view )
+    {
+        auto msg = m.instantiate< std_msgs::String >();
+        REQUIRE( msg );
+        messages.push_back( msg->data );
+    }
+    return messages;
+}
+
+
+// A walk through the file: forward, back to the start and to the middle, then forward past where it was
+std::vector< std::vector< std::string > > walk( uint32_t prefetch )
+{
+    rosbag::Bag bag;
+    bag.open( filename, rosbag::bagmode::Read );
+    bag.setPrefetch( prefetch );
+    return { read( bag ), read( bag, 0, 50 ), read( bag, 150, 200 ), read( bag, 20, 30 ), read( bag, 250 ),
+             read( bag, 100, 160 ) };
+}
+
+
+}  // namespace
+
+
+TEST_CASE( "prefetched chunks read the same as without", "[rosbag]" )
+{
+    write_bag();
+    auto expected = walk( 0 );
+    REQUIRE( expected[0].size() == n_messages );
+
+    for( uint32_t prefetch : { 1, 2, 4, 100 } )
+    {
+        CAPTURE( prefetch );
+        CHECK( walk( prefetch ) == expected );
+    }
+    std::remove( filename.c_str() );
+}
+
+
+TEST_CASE( "two views of one bag read in turns", "[rosbag]" )
+{
+    // Each message is in a different part of the file than the one before it, so every read seeks
+    write_bag();
+    rosbag::Bag bag;
+    bag.open( filename, rosbag::bagmode::Read );
+    auto const expected = read( bag );
+
+    bag.setPrefetch( 4 );
+    rosbag::View front( bag, stamp( 0 ), stamp( n_messages / 2 - 1 ) );
+    rosbag::View back( bag, stamp( n_messages / 2 ), stamp( n_messages - 1 ) );
+    auto f = front.begin(), b = back.begin();
+    for( int i = 0; i < n_messages / 2; ++i, ++f, ++b )
+    {
+        CAPTURE( i );
+        REQUIRE( f != front.end() );
+        REQUIRE( b != back.end() );
+        CHECK( ( *f ).instantiate< std_msgs::String >()->data == expected[i] );
+        CHECK( ( *b ).instantiate< std_msgs::String >()->data == expected[n_messages / 2 + i] );
+    }
+    CHECK( f == front.end() );
+    CHECK( b == back.end() );
+    std::remove( filename.c_str() );
+}
+
+
+TEST_CASE( "a bag closes with chunks still being prefetched", "[rosbag]" )
+{
+    write_bag();
+    for( int i = 0; i < 20; ++i )
+    {
+        CAPTURE( i );
+        rosbag::Bag bag;
+        bag.open( filename, rosbag::bagmode::Read );
+        bag.setPrefetch( 100 );
+        {
+            // The first message asks for the rest of the file
+            rosbag::View view( bag );
+            REQUIRE( view.begin() != view.end() );
+            CHECK( ( *view.begin() ).instantiate< std_msgs::String >() );
+        }
+        bag.close();
+
+        // ... and opens again
+        bag.open( filename, rosbag::bagmode::Read );
+        bag.setPrefetch( 100 );
+        CHECK( read( bag ).size() == n_messages );
+    }
+    std::remove( filename.c_str() );
+}
+
+
+TEST_CASE( "prefetch can be turned off while reading", "[rosbag]" )
+{
+    write_bag();
+    rosbag::Bag bag;
+    bag.open( filename, rosbag::bagmode::Read );
+    auto const expected = read( bag );
+
+    bag.setPrefetch( 4 );
+    std::vector< std::string > messages;
+    rosbag::View view( bag );
+    int i = 0;
+    for( rosbag::MessageInstance const & m : view )
+    {
+        if( i == 100 )
+            bag.setPrefetch( 0 );
+        else if( i == 200 )
+            bag.setPrefetch( 8 );
+        messages.push_back( m.instantiate< std_msgs::String >()->data );
+        ++i;
+    }
+    CHECK( messages == expected );
+    std::remove( filename.c_str() );
+}
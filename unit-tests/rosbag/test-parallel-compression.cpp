@@ -0,0 +1,257 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+//#cmake:dependencies realsense-file
+
+#include <unit-tests/test.h>
+
+#include <rosbag/bag.h>
+#include <rosbag/view.h>
+#include <std_msgs/String.h>
+
+#ifdef __linux__
+#include <sys/resource.h>
+#include <csignal>
+#endif
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+
+namespace {
+
+
+// Enough messages, of varying sizes, for many small chunks; half random, so they do not compress away
+std::vector< std::string > make_messages()
+{
+    std::mt19937 gen( 42 );
+    std::uniform_int_distribution< int > byte( 0, 255 );
+    std::vector< std::string > messages;
+    for( int i = 0; i < 300; ++i )
+    {
+        std::string message( 100 + ( i * 37 ) % 900, char( 'a' + i % 26 ) );
+        for( size_t j = 0; j < message.size(); j += 2 )
+            message[j] = char( byte( gen ) );
+        messages.push_back( message );
+    }
+    return messages;
+}
+
+
+std::string topic( size_t i )
+{
+    return i % 3 ? "/camera/depth" : "/camera/color";
+}
+
+
+void write_messages( rosbag::Bag & bag, std::vector< std::string > const & messages )
+{
+    bag.setChunkThreshold( 4096 );
+    for( size_t i = 0; i < messages.size(); ++i )
+    {
+        std_msgs::String msg;
+        msg.data = messages[i];
+        bag.write( topic( i ), rs2rosinternal::Time( 1000, uint32_t( i ) ), msg );
+    }
+}
+
+
+std::vector< std::string > read_messages( std::string const & filename, std::vector< std::string > & topics )
+{
+    rosbag::Bag bag;
+    bag.open( filename, rosbag::bagmode::Read );
+    std::vector< std::string > messages;
+    rosbag::View view( bag );
+    for( rosbag::MessageInstance const & m : view )
+    {
+        auto msg = m.instantiate< std_msgs::String >();
+        REQUIRE( msg );
+        messages.push_back( msg->data );
+        topics.push_back( m.getTopic() );
+    }
+    return messages;
+}
+
+
+std::vector< char > read_file( std::string const & filename )
+{
+    std::ifstream f( filename, std::ios::binary );
+    return std::vector< char >( std::istreambuf_iterator< char >( f ), std::istreambuf_iterator< char >() );
+}
+
+
+}  // namespace
+
+
+TEST_CASE( "chunks compressed in the background read back", "[rosbag]" )
+{
+    auto messages = make_messages();
+
+    std::string const inline_file = "test-parallel-compression-inline.bag";
+    {
+        rosbag::Bag bag( inline_file, rosbag::bagmode::Write );
+        bag.setCompression( rosbag::compression::LZ4 );
+        write_messages( bag, messages );
+    }
+
+    for( uint32_t threads : { 1, 3 } )
+    {
+        for( int level : { 0, 9 } )
+        {
+            CAPTURE( threads, level );
+            std::string const parallel_file = "test-parallel-compression.bag";
+            {
+                rosbag::Bag bag( parallel_file, rosbag::bagmode::Write );
+                bag.setParallelCompression( threads, level );
+                write_messages( bag, messages );
+                bag.close();
+            }
+
+            std::vector< std::string > topics;
+            CHECK( read_messages( parallel_file, topics ) == messages );
+            REQUIRE( topics.size() == messages.size() );
+            for( size_t i = 0; i < topics.size(); ++i )
+                CHECK( topics[i] == topic( i ) );
+
+            // Plain LZ4 compresses the same way inline
+            if( level == 0 )
+                CHECK( read_file( parallel_file ) == read_file( inline_file ) );
+
+            std::remove( parallel_file.c_str() );
+        }
+    }
+    std::remove( inline_file.c_str() );
+}
+
+
+#ifdef __linux__
+
+// Limits the size of the files this process writes, like a disk that fills up: writes past the limit fail with EFBIG
+class file_size_limit
+{
+    struct rlimit _original;
+    void ( *_original_handler )( int );
+
+public:
+    explicit file_size_limit( rlim_t max_size )
+    {
+        REQUIRE( getrlimit( RLIMIT_FSIZE, &_original ) == 0 );
+        _original_handler = signal( SIGXFSZ, SIG_IGN );  // instead of being killed
+        struct rlimit limit = _original;
+        limit.rlim_cur = max_size;
+        REQUIRE( setrlimit( RLIMIT_FSIZE, &limit ) == 0 );
+    }
+    ~file_size_limit()
+    {
+        setrlimit( RLIMIT_FSIZE, &_original );
+        signal( SIGXFSZ, _original_handler );
+    }
+};
+
+
+TEST_CASE( "a chunk that cannot be written fails the bag", "[rosbag]" )
+{
+    auto messages = make_messages();
+    std::string const filename = "test-parallel-compression-full.bag";
+    {
+        // Room for the header and a few chunks
+        file_size_limit limit( 32 * 1024 );
+
+        rosbag::Bag bag( filename, rosbag::bagmode::Write );
+        bag.setParallelCompression( 2 );
+        bag.setChunkThreshold( 4096 );
+
+        // The failure surfaces at a later chunk, and then at every write after it
+        size_t failures = 0;
+        for( size_t i = 0; i < messages.size(); ++i )
+        {
+            std_msgs::String msg;
+            msg.data = messages[i];
+            try
+            {
+                bag.write( topic( i ), rs2rosinternal::Time( 1000, uint32_t( i ) ), msg );
+            }
+            catch( rosbag::BagException const & )
+            {
+                ++failures;
+            }
+        }
+        CHECK( failures > 0 );
+        CHECK_THROWS_AS( bag.close(), rosbag::BagException );
+        CHECK( bag.getFileName().empty() );  // closed anyway
+
+        // Closed, so there is nothing left to fail on destruction
+        CHECK_NOTHROW( bag.close() );
+    }
+
+    // The file is left without an index, rather than with one pointing at chunks that are not there
+    std::vector< std::string > topics;
+    CHECK_THROWS_AS( read_messages( filename, topics ), rosbag::BagUnindexedException );
+    std::remove( filename.c_str() );
+}
+
+
+TEST_CASE( "writes after a chunk failed are rejected", "[rosbag]" )
+{
+    auto messages = make_messages();
+    std::string const filename = "test-parallel-compression-full.bag";
+    {
+        file_size_limit limit( 16 * 1024 );
+
+        rosbag::Bag bag( filename, rosbag::bagmode::Write );
+        bag.setParallelCompression( 1 );
+        bag.setChunkThreshold( 4096 );
+
+        // Until the failure is seen, on a chunk closed by one of these writes
+        size_t i = 0;
+        bool failed = false;
+        for( ; i < messages.size() && ! failed; ++i )
+        {
+            std_msgs::String msg;
+            msg.data = messages[i];
+            try
+            {
+                bag.write( topic( i ), rs2rosinternal::Time( 1000, uint32_t( i ) ), msg );
+            }
+            catch( rosbag::BagException const & )
+            {
+                failed = true;
+            }
+        }
+        REQUIRE( failed );
+
+        // Then every write fails, also those that do not close a chunk, so nothing piles up in the bag
+        for( int round = 0; round < 20; ++round )
+            for( size_t j = 0; j < messages.size(); ++j )
+            {
+                std_msgs::String msg;
+                msg.data = messages[j];
+                CHECK_THROWS_AS( bag.write( topic( j ), rs2rosinternal::Time( 2000 + round, uint32_t( j ) ), msg ),
+                                 rosbag::BagException );
+            }
+
+        CHECK_THROWS_AS( bag.close(), rosbag::BagException );
+    }
+    std::remove( filename.c_str() );
+}
+
+
+TEST_CASE( "a bag that fails to close does not throw from its destructor", "[rosbag]" )
+{
+    auto messages = make_messages();
+    std::string const filename = "test-parallel-compression-full.bag";
+    {
+        file_size_limit limit( 8 * 1024 );
+        rosbag::Bag bag( filename, rosbag::bagmode::Write );
+        bag.setParallelCompression( 1 );
+        write_messages( bag, { messages[0], messages[1] } );  // a single chunk, only written at close
+    }
+    std::remove( filename.c_str() );
+    SUCCEED();
+}
+
+#endif  // __linux__
@@ -0,0 +1,189 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+//#cmake:dependencies rsutils
+
+#include <unit-tests/test.h>
+#include <rsutils/time/timer.h>
+#include <rsutils/concurrency/concurrency.h>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace rsutils::time;
+
+
+TEST_CASE( "lock-free queue drops the oldest when full" )
+{
+    std::vector< int > dropped;
+    lock_free_queue< int > q( 3, [&]( int const & x ) { dropped.push_back( x ); } );
+
+    for( int i = 0; i < 5; ++i )
+        REQUIRE( q.enqueue( std::move( i ) ) );
+    REQUIRE( q.size() == 3 );
+    REQUIRE( dropped == std::vector< int >{ 0, 1 } );
+
+    int x;
+    for( int i = 2; i < 5; ++i )
+    {
+        REQUIRE( q.try_dequeue( &x ) );
+        REQUIRE( x == i );
+    }
+    REQUIRE_FALSE( q.try_dequeue( &x ) );
+    REQUIRE( q.empty() );
+}
+
+TEST_CASE( "lock-free queue holds at least two items" )
+{
+    lock_free_queue< int > q( 1 );
+    q.enqueue( 1 );
+    q.enqueue( 2 );
+    REQUIRE( q.size() == 2 );
+}
+
+TEST_CASE( "lock-free queue dequeue waits for an item" )
+{
+    lock_free_queue< int > q( 10 );
+    int x = 0;
+
+    timer t( std::chrono::milliseconds( 900 ) );
+    t.start();
+    REQUIRE_FALSE( q.dequeue( &x, 1000 ) );
+    REQUIRE( t.has_expired() );
+
+    std::thread producer( [&]() {
+        std::this_thread::sleep_for( std::chrono::milliseconds( 200 ) );
+        q.enqueue( 7 );
+    } );
+    stopwatch sw;
+    REQUIRE( q.dequeue( &x, 5000 ) );
+    REQUIRE( x == 7 );
+    REQUIRE( sw.get_elapsed_ms() < 2000 );
+    producer.join();
+}
+
+TEST_CASE( "lock-free queue dequeue doesn't wait after stop" )
+{
+    lock_free_queue< int > q( 10 );
+    q.enqueue( 1 );
+    q.stop();
+    REQUIRE( q.stopped() );
+    REQUIRE( q.empty() );
+    REQUIRE_FALSE( q.enqueue( 2 ) );
+
+    int x;
+    timer t( std::chrono::seconds( 1 ) );
+    t.start();
+    REQUIRE_FALSE( q.dequeue( &x, 2000 ) );
+    REQUIRE_FALSE( t.has_expired() );
+
+    q.start();
+    REQUIRE( q.enqueue( 3 ) );
+    REQUIRE( q.try_dequeue( &x ) );
+    REQUIRE( x == 3 );
+}
+
+TEST_CASE( "lock-free queue blocking enqueue waits for room" )
+{
+    lock_free_queue< int > q( 2 );
+    q.blocking_enqueue( 1 );
+    q.blocking_enqueue( 2 );
+
+    std::thread consumer( [&]() {
+        std::this_thread::sleep_for( std::chrono::seconds( 1 ) );
+        int x;
+        q.dequeue( &x, 1000 );
+    } );
+    stopwatch sw;
+    REQUIRE( q.blocking_enqueue( 3 ) );
+    REQUIRE( sw.get_elapsed_ms() > 900 );
+    consumer.join();
+
+    int x;
+    REQUIRE( q.try_dequeue( &x ) );
+    REQUIRE( x == 2 );
+    REQUIRE( q.try_dequeue( &x ) );
+    REQUIRE( x == 3 );
+}
+
+TEST_CASE( "lock-free queue with many producers loses nothing when blocking" )
+{
+    const int producers = 4;
+    const int per_producer = 100000;
+    lock_free_queue< int > q( 64 );
+
+    std::vector< std::thread > threads;
+    for( int p = 0; p < producers; ++p )
+        threads.emplace_back( [&, p]() {
+            for( int i = 0; i < per_producer; ++i )
+                q.blocking_enqueue( p * per_producer + i );
+        } );
+
+    // Each producer's items come out in the order it pushed them
+    std::vector< int > last( producers, -1 );
+    int x;
+    for( int n = 0; n < producers * per_producer; ++n )
+    {
+        REQUIRE( q.dequeue( &x, 5000 ) );
+        int const p = x / per_producer;
+        REQUIRE( x > last[p] );
+        last[p] = x;
+    }
+    for( auto & t : threads )
+        t.join();
+    REQUIRE( q.empty() );
+}
+
+TEST_CASE( "lock-free queue takes nothing once stopped" )
+{
+    lock_free_queue< int > q( 8 );
+    std::atomic< bool > done( false );
+
+    // Half the producers drop the oldest when full, half wait for room
+    std::vector< std::thread > threads;
+    for( int p = 0; p < 4; ++p )
+        threads.emplace_back( [&, p]() {
+            for( int i = 0; ! done; ++i )
+            {
+                if( p % 2 )
+                    q.blocking_enqueue( std::move( i ) );
+                else
+                    q.enqueue( std::move( i ) );
+            }
+        } );
+
+    for( int round = 0; round < 200; ++round )
+    {
+        int x;
+        q.try_dequeue( &x );
+        q.stop();
+        // An item that was being pushed while we stopped would show up here
+        REQUIRE( q.empty() );
+        std::this_thread::yield();
+        REQUIRE( q.empty() );
+        REQUIRE_FALSE( q.try_dequeue( &x ) );
+        q.start();
+    }
+
+    done = true;
+    q.stop();
+    for( auto & t : threads )
+        t.join();
+    REQUIRE( q.empty() );
+}
+
+TEST_CASE( "lock-free dispatcher" )
+{
+    dispatcher d( 4, nullptr, true );
+    std::atomic< int > runs( 0 );
+
+    d.start();
+    for( int i = 0; i < 100; ++i )
+        d.invoke( [&]( dispatcher::cancellable_timer ) { ++runs; }, true );
+    REQUIRE( d.flush() );
+    REQUIRE( runs == 100 );
+    d.stop();
+    REQUIRE( d.empty() );
+}
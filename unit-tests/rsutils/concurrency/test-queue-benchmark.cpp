@@ -0,0 +1,65 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+//#cmake:dependencies rsutils
+//#test:donotrun:!nightly
+
+// Compares the locking single_consumer_queue with lock_free_queue: items/second through a queue of
+// 16 items, with one consumer and 1 or N producers that block for room (so nothing is dropped).
+
+#include <unit-tests/test.h>
+#include <rsutils/time/stopwatch.h>
+#include <rsutils/concurrency/concurrency.h>
+
+#include <algorithm>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace rsutils::time;
+
+
+template< class Queue >
+double items_per_second( int producers, int items_per_producer )
+{
+    Queue q( 16 );
+    std::vector< std::thread > threads;
+    stopwatch sw;
+    for( int p = 0; p < producers; ++p )
+        threads.emplace_back( [&]() {
+            for( int i = 0; i < items_per_producer; ++i )
+                q.blocking_enqueue( [i]() { return i; } );
+        } );
+
+    std::function< int() > item;
+    int const total = producers * items_per_producer;
+    for( int n = 0; n < total; ++n )
+        REQUIRE( q.dequeue( &item, 5000 ) );
+    auto elapsed = sw.get_elapsed();
+    for( auto & t : threads )
+        t.join();
+
+    return total / std::chrono::duration< double >( elapsed ).count();
+}
+
+void compare( int producers )
+{
+    int const items = 1000000 / producers;
+    double locking = items_per_second< single_consumer_queue< std::function< int() > > >( producers, items );
+    double lock_free = items_per_second< lock_free_queue< std::function< int() > > >( producers, items );
+    std::cout << std::fixed << std::setprecision( 2 ) << producers << "P1C: single_consumer_queue " << locking / 1e6
+              << " M items/s, lock_free_queue " << lock_free / 1e6 << " M items/s (x" << lock_free / locking << ")"
+              << std::endl;
+}
+
+TEST_CASE( "queue benchmark 1P1C" )
+{
+    compare( 1 );
+}
+
+TEST_CASE( "queue benchmark NP1C" )
+{
+    compare( std::max( 2, int( std::thread::hardware_concurrency() ) - 1 ) );
+}
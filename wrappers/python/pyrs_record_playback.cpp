@@ -22,6 +22,11 @@ void init_record_playback(py::module &m) {
              "play the same way the file was recorded. If the application takes too long to handle the callback, frames may be dropped. In non real time "
              "mode, playback will wait for each callback to finish handling the data before reading the next frame. In this mode no frames will be dropped, "
              "and the application controls the framerate of playback via callback duration.", "real_time"_a)
+        .def("set_read_ahead", &rs2::playback::set_read_ahead, "Set how many frames each stream may read ahead of the application in non real time "
+             "mode. With 0, playback waits for each callback to return before reading the next frame; otherwise it waits only when a stream's queue "
+             "is full. Takes effect when the sensors are next opened.", "frames"_a)
+        .def("set_range", &rs2::playback::set_range, "Limit playback to the time range [start, end) of the file; an end of zero means the end "
+             "of the file. Several playback devices on the same file can each play one of a set of consecutive ranges.", "start"_a, "end"_a)
         // set_playback_speed?
         .def("set_status_changed_callback", [](rs2::playback& self, std::function<void(rs2_playback_status)> callback) {
             self.set_status_changed_callback(callback);
@@ -33,8 +38,24 @@ void init_record_playback(py::module &m) {
     py::class_<rs2::recorder, rs2::device> recorder(m, "recorder", "Records the given device and saves it to the given file as rosbag format.");
     recorder.def(py::init<const std::string&, rs2::device>())
         .def(py::init<const std::string&, rs2::device, bool>())
+        .def(py::init<const std::string&, rs2::device, int, int>(), "file"_a, "device"_a, "compression_level"_a, "compression_threads"_a)
         .def("pause", &rs2::recorder::pause, "Pause the recording device without stopping the actual device from streaming.")
-        .def("resume", &rs2::recorder::resume, "Unpauses the recording device, making it resume recording.");
+        .def("resume", &rs2::recorder::resume, "Unpauses the recording device, making it resume recording.")
+        .def("set_queue_limit", &rs2::recorder::set_queue_limit, "Limits the memory taken by frames waiting to be written, "
+             "and sets what is given up when that limit is reached.", "max_queued_bytes"_a, "policy"_a)
+        .def("set_stream_priority", &rs2::recorder::set_stream_priority, "Sets the priority of a stream for drop_lowest_priority.", "stream"_a, "priority"_a)
+        .def("get_queue_stats", &rs2::recorder::get_queue_stats, "Gets the state of the queue of frames waiting to be written.")
+        .def("get_dropped_frames", &rs2::recorder::get_dropped_frames, "Gets the number of frames of a stream that were dropped by the drop policy.", "stream"_a, "index"_a = 0);
+
+    py::class_<rs2_record_queue_stats> record_queue_stats(m, "record_queue_stats", "State of the queue of frames waiting to be written by a recorder.");
+    record_queue_stats.def(py::init<>())
+        .def_readonly("queued_bytes", &rs2_record_queue_stats::queued_bytes, "Size of the frames waiting to be written")
+        .def_readonly("peak_queued_bytes", &rs2_record_queue_stats::peak_queued_bytes, "Highest queued_bytes since recording started")
+        .def_readonly("queued_frames", &rs2_record_queue_stats::queued_frames, "Number of frames waiting to be written")
+        .def_readonly("written_frames", &rs2_record_queue_stats::written_frames, "Number of frames written to file")
+        .def_readonly("dropped_frames", &rs2_record_queue_stats::dropped_frames, "Number of frames dropped by the drop policy")
+        .def_readonly("average_latency", &rs2_record_queue_stats::average_latency, "Average time, in milliseconds, from a frame's arrival until it was written")
+        .def_readonly("max_latency", &rs2_record_queue_stats::max_latency, "Longest time, in milliseconds, from a frame's arrival until it was written");
     // filename?
     /** end rs_record_playback.hpp **/
 }